@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QObject>
+#include <QtQmlIntegration>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+struct ProbeStats
+{
+  Q_GADGET
+  QML_VALUE_TYPE(probeStats)
+  QML_UNCREATABLE("Created by AbstractProbe")
+
+  Q_PROPERTY(quint64 transfers MEMBER transfers)
+  Q_PROPERTY(quint64 bytesRead MEMBER bytesRead)
+  Q_PROPERTY(quint64 bytesWritten MEMBER bytesWritten)
+  Q_PROPERTY(quint64 errors MEMBER errors)
+  Q_PROPERTY(qint64 busyNs MEMBER busyNs)
+  Q_PROPERTY(double bandwidth READ bandwidth)
+
+public:
+  quint64 transfers    = 0;
+  quint64 bytesRead    = 0;
+  quint64 bytesWritten = 0;
+  quint64 errors       = 0;
+  qint64  busyNs       = 0;
+
+  // Effective link throughput in bytes per second
+  double bandwidth() const noexcept
+  {
+    return busyNs > 0 ? double(bytesRead + bytesWritten) * 1e9 / double(busyNs) : 0.0;
+  }
+};
+Q_DECLARE_METATYPE(ProbeStats)
+
+// Target memory transport.
+//
+// Implementations only provide doRead()/doWrite(); the public entry points serialize accesses
+// and account link statistics. At most one target probe (StLinkProbe, SimulatedProbe, ...) is
+// declared at a time and becomes the instance(); without one, the Debugger reads through the
+// debugged process.
+class AbstractProbe : public QObject
+{
+  Q_OBJECT
+  QML_ELEMENT
+  QML_UNCREATABLE("abstract element")
+
+  Q_PROPERTY(Capabilities capabilities READ capabilities CONSTANT)
+
+public:
+  enum class CapabilityBits : uint32_t
+  {
+    None = 0,
+    // Memory can be written
+    Write = (1u << 0),
+    // Memory can be read while the target runs
+    NonIntrusive = (1u << 1),
+    // readBatch() fetches all ranges within a single round trip
+    BatchRead = (1u << 2),
+    // Addresses are load addresses (relocated process), ELF file addresses otherwise
+    LoadAddresses = (1u << 3),
+  };
+  Q_DECLARE_FLAGS(Capabilities, CapabilityBits);
+  Q_FLAG(Capabilities)
+
+  using address_t = uint64_t;
+
+  struct ReadRequest
+  {
+    address_t            address = 0;
+    std::span<std::byte> data;
+  };
+
+  using QObject::QObject;
+  virtual ~AbstractProbe();
+
+  static AbstractProbe* instance() noexcept
+  {
+    return instance_;
+  }
+
+  virtual Capabilities capabilities() const noexcept = 0;
+
+  bool hasCapability(CapabilityBits capability) const noexcept
+  {
+    return capabilities().testFlag(capability);
+  }
+
+  // Thread-safe: accesses are serialized on the probe
+  bool read(address_t address, std::span<std::byte> data);
+  bool write(address_t address, std::span<std::byte const> data);
+  bool readBatch(std::span<ReadRequest const> requests);
+
+  template <typename T> T read(address_t address)
+  {
+    T value{};
+    read(address, std::as_writable_bytes(std::span{&value, 1}));
+    return value;
+  }
+
+  Q_INVOKABLE ProbeStats stats() const noexcept;
+  Q_INVOKABLE void       resetStats() noexcept;
+
+protected:
+  // Registers this probe as the instance(); throws if another one is already registered
+  void makeInstance();
+
+  virtual bool doRead(address_t address, std::span<std::byte> data) = 0;
+
+  virtual bool doWrite(address_t address, std::span<std::byte const> data)
+  {
+    return false;
+  }
+
+  // Default implementation issues one read per request
+  virtual bool doReadBatch(std::span<ReadRequest const> requests);
+
+private:
+  void account(int64_t startNs, size_t transfers, size_t read, size_t written, bool ok) noexcept;
+
+  static AbstractProbe* instance_;
+
+  std::mutex           mutex_;
+  std::atomic<quint64> transfers_    = 0;
+  std::atomic<quint64> bytesRead_    = 0;
+  std::atomic<quint64> bytesWritten_ = 0;
+  std::atomic<quint64> errors_       = 0;
+  std::atomic<qint64>  busyNs_       = 0;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(AbstractProbe::Capabilities)
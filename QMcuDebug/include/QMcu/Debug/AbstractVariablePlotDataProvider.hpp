@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QMcu/Debug/SampleRing.hpp>
 #include <QMcu/Debug/VariableProxy.hpp>
 #include <QMcu/Plot/AbstractPlotDataProvider.hpp>
 
@@ -10,7 +11,9 @@
 
 #include <lldb/API/LLDB.h>
 
+class Acquisition;
 class Debugger;
+class Trigger;
 
 class AbstractVariablePlotDataProvider : public AbstractPlotDataProvider
 {
@@ -20,7 +23,7 @@ class AbstractVariablePlotDataProvider : public AbstractPlotDataProvider
 
 public:
   AbstractVariablePlotDataProvider(QObject* parent = nullptr);
-  virtual ~AbstractVariablePlotDataProvider() = default;
+  virtual ~AbstractVariablePlotDataProvider();
 
   VariableProxy* proxy() noexcept
   {
@@ -44,9 +47,35 @@ protected:
   virtual void onValueChanged() = 0;
   virtual void onValueUnChanged() {};
 
+  // Samples pushed by the Acquisition thread (null when no acquisition is running)
+  std::shared_ptr<SampleRing> sampleRing() const noexcept
+  {
+    return ring_.load(std::memory_order_acquire);
+  }
+  QMetaType::Type sampleType() const noexcept
+  {
+    return sampleType_;
+  }
+
+  // Subscribes to the acquisition again, ie. for a new trigger; only while it runs, and again
+  // when it starts or stops
+  void subscribe();
+  // A trigger fed by the acquisition thread instead of the ring, `valueSize` bytes per sample
+  virtual std::shared_ptr<Trigger> createTrigger(size_t /*valueSize*/)
+  {
+    return nullptr;
+  }
+
 private:
+  void subscribeTo(Acquisition& acq);
+  void unsubscribe();
+
+  std::atomic<std::shared_ptr<SampleRing>> ring_;
+  QMetaType::Type                          sampleType_ = QMetaType::UnknownType;
+
   static QElapsedTimer    time_;
   VariableProxy*          proxy_ = nullptr;
   QMetaObject::Connection proxyValueChangedConnection_;
   QMetaObject::Connection proxyValueUnChangedConnection_;
+  QMetaObject::Connection proxyVariableResolvedConnection_;
 };
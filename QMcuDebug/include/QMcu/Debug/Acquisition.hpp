@@ -0,0 +1,137 @@
+#pragma once
+
+#include <QMcu/Debug/Sample.hpp>
+#include <QMcu/Debug/SampleRing.hpp>
+
+#include <QObject>
+#include <QtQmlIntegration>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class Expression;
+class Trigger;
+class Variable;
+
+// Samples subscribed variables on a dedicated thread.
+//
+// The acquisition thread owns probe access while running: at each tick it reads all subscribed
+// ranges (coalesced like VariableProxyGroup does) and pushes one timestamped sample per
+// subscription into its SampleRing. Plot providers drain their rings on the render side, so the
+// sample rate no longer depends on the frame rate, and UI hitches do not lose samples as long
+// as the rings are large enough.
+//
+// Subscriptions with a compiled transform also read the variables it references: their values
+// are batched for a few milliseconds, then the expression runs over the whole batch and the
+// results are pushed as doubles.
+//
+// Subscriptions with a Trigger feed it every sample instead of their ring, so that triggers are
+// evaluated at the acquisition rate; only its completed captures reach the plots.
+class Acquisition : public QObject
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(double rate READ rate WRITE setRate NOTIFY rateChanged)
+  Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
+  Q_PROPERTY(int ringCapacity READ ringCapacity WRITE setRingCapacity NOTIFY ringCapacityChanged)
+  Q_PROPERTY(int coalesceGap READ coalesceGap WRITE setCoalesceGap NOTIFY coalesceGapChanged)
+
+public:
+  Acquisition(QObject* parent = nullptr);
+  virtual ~Acquisition();
+
+  static Acquisition* instance() noexcept
+  {
+    return instance_;
+  }
+
+  // Samples per second
+  double rate() const noexcept
+  {
+    return rate_;
+  }
+  bool running() const noexcept
+  {
+    return thread_.joinable();
+  }
+  // Samples buffered per subscription
+  int ringCapacity() const noexcept
+  {
+    return ringCapacity_;
+  }
+  int coalesceGap() const noexcept
+  {
+    return coalesceGap_;
+  }
+
+  // Number of ticks that could not be serviced in time
+  Q_INVOKABLE quint64 lateTicks() const noexcept
+  {
+    return lateTicks_.load(std::memory_order_relaxed);
+  }
+
+  // Creates a ring receiving the samples of `variable` (current load range), or the results of
+  // `expression` over them (basic variables only). With a trigger, the samples go to the
+  // trigger, that compares the first element (or the result) to its level.
+  std::shared_ptr<SampleRing> subscribe(Variable*                         variable,
+                                        std::shared_ptr<Expression const> expression = nullptr,
+                                        std::shared_ptr<Trigger>          trigger    = nullptr);
+  void                        unsubscribe(std::shared_ptr<SampleRing> const& ring);
+
+  static int64_t nsTime() noexcept;
+
+public slots:
+  void setRate(double rate);
+  void setRunning(bool running);
+  void setRingCapacity(int capacity);
+  void setCoalesceGap(int gap);
+
+signals:
+  void rateChanged();
+  void runningChanged();
+  void ringCapacityChanged();
+  void coalesceGapChanged();
+
+  // Emitted (coalesced, on the object's thread) when new samples were pushed
+  void samplesAvailable();
+
+private:
+  struct Input
+  {
+    uint64_t    address = 0;
+    size_t      size    = 0;
+    RealDecoder decode  = nullptr;
+  };
+
+  struct Channel
+  {
+    uint64_t                          address = 0;
+    size_t                            size    = 0;
+    std::shared_ptr<SampleRing>       ring;
+    std::shared_ptr<Expression const> expression;
+    QList<Input>                      inputs; // of the expression: the variable, its references
+    std::shared_ptr<Trigger>          trigger;
+    RealDecoder                       decode = nullptr; // of the trigger level
+  };
+
+  void run(std::stop_token stop);
+  void notifySamplesAvailable();
+
+  static Acquisition* instance_;
+
+  double rate_         = 1000.0;
+  int    ringCapacity_ = 4096;
+  int    coalesceGap_  = 256;
+
+  std::mutex        channelsMutex_;
+  QList<Channel>    channels_;
+  std::atomic<bool> channelsChanged_ = true;
+
+  std::atomic<int64_t> periodNs_      = 1'000'000;
+  std::atomic<bool>    notifyPending_ = false;
+  std::atomic<quint64> lateTicks_     = 0;
+  std::jthread         thread_;
+};
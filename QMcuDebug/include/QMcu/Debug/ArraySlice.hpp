@@ -0,0 +1,159 @@
+#pragma once
+
+#include <QList>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <type_traits>
+
+// Elements of an array, `stride` apart: a view, never a copy.
+template <typename T> class StridedSpan
+{
+public:
+  StridedSpan() = default;
+  StridedSpan(T* data, size_t count, size_t stride) : data_{data}, count_{count}, stride_{stride} {}
+
+  size_t size() const noexcept
+  {
+    return count_;
+  }
+  bool empty() const noexcept
+  {
+    return count_ == 0;
+  }
+  size_t stride() const noexcept
+  {
+    return stride_;
+  }
+  bool isContiguous() const noexcept
+  {
+    return stride_ == 1 or count_ <= 1;
+  }
+
+  T& operator[](size_t index) const noexcept
+  {
+    return data_[index * stride_];
+  }
+
+  // Copies at most out.size() elements, returns how many
+  size_t copyTo(std::span<std::remove_const_t<T>> out) const noexcept
+  {
+    const auto count = std::min(count_, out.size());
+    if(isContiguous())
+    {
+      std::copy_n(data_, count, out.data());
+    }
+    else
+    {
+      for(size_t ii = 0; ii < count; ++ii)
+      {
+        out[ii] = data_[ii * stride_];
+      }
+    }
+    return count;
+  }
+
+private:
+  T*     data_   = nullptr;
+  size_t count_  = 0;
+  size_t stride_ = 1;
+};
+
+// Part of a row-major N-D array: `count` elements, `stride` apart, from `offset` (all counted
+// in elements).
+//
+// The array is read in one transfer, slices only select what a consumer needs from it: a row
+// (one index of the outermost dimension), a column (one index of the innermost dimension, ie.
+// one channel of an interleaved buffer) or every n-th element of either.
+struct ArraySlice
+{
+  size_t offset = 0;
+  size_t count  = 0;
+  size_t stride = 1;
+
+  static size_t elements(QList<int> const& extents) noexcept
+  {
+    return std::accumulate(extents.begin(),
+                           extents.end(),
+                           size_t(1),
+                           [](size_t n, int extent) { return n * size_t(std::max(extent, 0)); });
+  }
+
+  static ArraySlice all(QList<int> const& extents) noexcept
+  {
+    return {0, elements(extents), 1};
+  }
+
+  // Elements of the inner dimensions at `index` of the outermost one, contiguous
+  static ArraySlice row(QList<int> const& extents, size_t index) noexcept
+  {
+    if(extents.isEmpty() or index >= size_t(std::max(extents.first(), 0)))
+    {
+      return {};
+    }
+    const auto inner = elements(extents.sliced(1));
+    return {index * inner, inner, 1};
+  }
+
+  // Elements at `index` of the innermost dimension, across all the outer ones
+  static ArraySlice column(QList<int> const& extents, size_t index) noexcept
+  {
+    if(extents.isEmpty() or index >= size_t(std::max(extents.last(), 0)))
+    {
+      return {};
+    }
+    const auto columns = size_t(extents.last());
+    return {index, elements(extents) / columns, columns};
+  }
+
+  // Every `step`-th element of this slice, starting with its first one
+  ArraySlice every(size_t step) const noexcept
+  {
+    step = std::max<size_t>(step, 1);
+    return {offset, (count + step - 1) / step, stride * step};
+  }
+
+  // Whether the slice lies within an array of `size` elements
+  bool fits(size_t size) const noexcept
+  {
+    return count == 0 or (offset < size and (count - 1) * stride < size - offset);
+  }
+
+  // View of the slice within `data`, empty if it does not fit
+  template <typename T> StridedSpan<T> view(std::span<T> data) const noexcept
+  {
+    if(not fits(data.size()))
+    {
+      return {};
+    }
+    return {data.data() + offset, count, stride};
+  }
+
+  // Copies the slice of `data` (elements of `elementSize` bytes) into `out`, packed; returns the
+  // number of elements copied
+  size_t gather(std::span<std::byte const> data,
+                size_t                     elementSize,
+                std::span<std::byte>       out) const noexcept
+  {
+    if(elementSize == 0 or not fits(data.size() / elementSize))
+    {
+      return 0;
+    }
+    const auto copied = std::min(count, out.size() / elementSize);
+    if(stride == 1)
+    {
+      std::memcpy(out.data(), data.data() + offset * elementSize, copied * elementSize);
+      return copied;
+    }
+    for(size_t ii = 0; ii < copied; ++ii)
+    {
+      std::memcpy(out.data() + ii * elementSize,
+                  data.data() + (offset + ii * stride) * elementSize,
+                  elementSize);
+    }
+    return copied;
+  }
+};
@@ -1,19 +1,67 @@
 #pragma once
 
 #include <QMcu/Debug/AbstractVariablePlotDataProvider.hpp>
+#include <QMcu/Debug/ArraySlice.hpp>
+#include <QMcu/Debug/FrameSlots.hpp>
 #include <QMcu/Debug/Variable.hpp>
 
 #include <QtGraphs/QLineSeries>
 #include <QtGraphs/QValueAxis>
 
+#include <mutex>
+
+// Plots the elements of an array, or a slice of them.
+//
+// The whole array is read, then `row` and `column` select the elements plotted: a row of a 2D
+// buffer, one of its columns (ie. a channel of an interleaved buffer, `interleave` values per
+// frame for 1D buffers) or a single element. Changing the selection initializes the plot again.
+//
+// With `zeroCopy`, a contiguous selection is read by the probe straight into the GPU buffer: one
+// slot per frame in flight (and two spare), so a frame never draws a slot being written. The
+// proxy then publishes no value, and every read is drawn, changed or not.
 class BufferPlotProvider : public AbstractVariablePlotDataProvider
 {
   Q_OBJECT
   QML_ELEMENT
 
+  Q_PROPERTY(int row READ row WRITE setRow NOTIFY sliceChanged)
+  Q_PROPERTY(int column READ column WRITE setColumn NOTIFY sliceChanged)
+  Q_PROPERTY(int interleave READ interleave WRITE setInterleave NOTIFY sliceChanged)
+  Q_PROPERTY(bool zeroCopy READ zeroCopy WRITE setZeroCopy NOTIFY zeroCopyChanged)
+
 public:
   BufferPlotProvider(QObject* parent = nullptr);
-  virtual ~BufferPlotProvider() = default;
+  virtual ~BufferPlotProvider();
+
+  // Index of the outermost dimension, -1 for all
+  int row() const noexcept
+  {
+    return row_;
+  }
+  // Index of the innermost dimension, -1 for all
+  int column() const noexcept
+  {
+    return column_;
+  }
+  // Values per frame of an interleaved 1D buffer, 0 to use the array extents
+  int interleave() const noexcept
+  {
+    return interleave_;
+  }
+  bool zeroCopy() const noexcept
+  {
+    return zeroCopy_;
+  }
+
+public slots:
+  void setRow(int row);
+  void setColumn(int column);
+  void setInterleave(int interleave);
+  void setZeroCopy(bool zeroCopy);
+
+signals:
+  void sliceChanged();
+  void zeroCopyChanged();
 
 protected:
   void        onValueChanged() final;
@@ -22,5 +70,31 @@ protected:
   UpdateRange update(PlotContext& ctx) final;
 
 private:
-  std::span<std::byte> mappedData_;
+  // Selected elements out of the `elements` read
+  ArraySlice slice(size_t elements);
+  // Selected elements into the mapped storage, only the `dirty` ones once it holds a sample
+  void copy(std::span<std::byte const>  data,
+            size_t                      elementSize,
+            std::span<DirtyRange const> dirty = {});
+
+  // Zero-copy mode
+  bool initializeSlots(PlotContext const& ctx, QMetaType::Type tid, size_t bytes);
+  // Sets the proxy's direct reader, or drops it, as the slots were last initialized
+  void updateDirectReader();
+  void onVariableChanged();
+  void readSlot();
+
+  std::span<std::byte>        mappedData_;
+  QMetaType::Type             tid_         = QMetaType::UnknownType;
+  size_t                      elementSize_ = 0;
+  int                         row_         = -1;
+  int                         column_      = -1;
+  int                         interleave_  = 0;
+  bool                        zeroCopy_    = false;
+  bool                        synced_      = false; // mapped storage holds the previous sample
+  std::mutex                  slotsMutex_; // slots and mapped storage, swapped while written to
+  std::unique_ptr<FrameSlots> slots_;
+  uint64_t                    slotAddress_ = 0; // of the selection, read into every slot
+  size_t                      slotStride_  = 0; // bytes
+  size_t                      slotSize_    = 0; // bytes
 };
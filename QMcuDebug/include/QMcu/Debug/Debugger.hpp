@@ -1,29 +1,44 @@
 #pragma once
 
+#include <QMcu/Debug/AbstractProbe.hpp>
 #include <QMcu/Debug/Variable.hpp>
 
 #include <QObject>
+#include <QPointer>
+#include <QStringList>
 #include <QUrl>
 
 #include <qqmlintegration.h>
 
 #include <lldb/API/LLDB.h>
 
-
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 
+class ElfFile;
+class ShadowMemory;
+class SymbolIndex;
+
 class Debugger : public QObject
 {
   Q_OBJECT
   QML_ELEMENT
 
   Q_PROPERTY(QList<Variable*> globals READ globals NOTIFY targetLoadingCompleted)
+  Q_PROPERTY(QStringList globalNames READ globalNames NOTIFY symbolsChanged)
   Q_PROPERTY(bool ready READ ready NOTIFY readyChanged)
   Q_PROPERTY(bool launching READ launching NOTIFY launchedChanged)
   Q_PROPERTY(bool launched READ launched WRITE launchProcess NOTIFY launchedChanged)
   Q_PROPERTY(bool running READ running NOTIFY runningChanged)
   Q_PROPERTY(QString executable READ executable WRITE load NOTIFY launchedChanged)
   Q_PROPERTY(QString targetArchitecture READ targetArchitecture NOTIFY launchedChanged)
+  Q_PROPERTY(double stopLatency READ stopLatency NOTIFY stopTimeChanged)
+  Q_PROPERTY(double haltTime READ haltTime NOTIFY stopTimeChanged)
+  Q_PROPERTY(quint64 stopCount READ stopCount NOTIFY stopTimeChanged)
 
 public:
   Debugger(QObject* parent = nullptr);
@@ -36,6 +51,9 @@ public:
 
   QList<Variable*> globals();
   bool             ready();
+
+  // Names of the global variables, from the symbol index: empty until it is loaded or built
+  QStringList globalNames() const;
   bool             launched()
   {
     return process_.IsValid();
@@ -56,18 +74,68 @@ public:
   {
     return process_;
   }
-  QString executable()
+  QString executable();
+  QString executablePath() const
   {
-    if(module_.IsValid())
+    return executable_;
+  }
+  QString targetArchitecture();
+  // Target pointer size, in bytes
+  size_t addressByteSize();
+
+  // The declared target probe when present, the debugged process probe otherwise.
+  AbstractProbe* probe() noexcept
+  {
+    if(auto* p = AbstractProbe::instance(); p != nullptr)
     {
-      return module_.GetFileSpec().GetFilename();
+      return p;
     }
-    return {};
+    return processProbe_;
   }
-  QString targetArchitecture();
+
+  // Address of `address` as seen by probe()
+  uint64_t probeAddress(lldb::SBAddress address);
+
+  // Address of the global variable `name` as seen by probe()
+  std::optional<uint64_t> symbolAddress(QString const& name);
+
+  // Reads target memory through the shadow memory: within a tick (an event loop pass, a group
+  // refresh or a stop window), a range is fetched from the probe only once. GUI thread only.
+  bool readMemory(uint64_t address, std::span<std::byte> data);
+
+  // Records memory fetched by other means into the shadow memory
+  void shadowMemory(uint64_t address, std::span<std::byte const> data);
+
+  // Starts a new tick: memory is fetched again from the probe
+  void invalidateShadowMemory();
 
   Q_INVOKABLE Variable* variable(QString const& name);
 
+  // Indexed description of a global variable or member (name, typeName, address, size, extents
+  // and members), without resolving it through LLDB. Empty if unknown.
+  Q_INVOKABLE QVariantMap symbol(QString const& name) const;
+
+  // Runs `fn` while the process is stopped, stopping it if needed. Requests issued before the
+  // stop is reached share the same stop window, then the process is continued once.
+  // `fn` is dropped if `context` is destroyed meanwhile, or if the process exits or does not
+  // stop within a second.
+  void whenStopped(QObject* context, std::function<void()> fn);
+
+  // Microseconds between the last stop request and the actual stop
+  double stopLatency() const noexcept
+  {
+    return stopLatency_;
+  }
+  // Microseconds the process was halted during the last stop window
+  double haltTime() const noexcept
+  {
+    return haltTime_;
+  }
+  quint64 stopCount() const noexcept
+  {
+    return stopCount_;
+  }
+
 public slots:
   void load(QUrl const& executable);
   void load(QString const& executable);
@@ -85,8 +153,44 @@ signals:
 
   void continueProcess();
 
+  void stopTimeChanged();
+
+  void symbolsChanged();
+
 private:
+  struct StopRequest
+  {
+    QPointer<QObject>     context;
+    std::function<void()> fn;
+  };
+
+  // Services the stop requests, then continues the process
+  void serviceStop();
+  // Forgets the stop requests when no stop is to come (process gone, or not stopping)
+  void dropStopRequests();
+
+  // Ends the current tick with the current event loop pass
+  void scheduleShadowInvalidation();
+
+  // Without a process to launch nor load addresses to resolve, the symbol index is enough
+  bool needsLldb();
+  void initializeLldb();
+  void initializeLldbOnce();
+
+  // Maps the symbol index read from the ELF file, then loads LLDB if needed
+  void openImage(QString const& executable, QString const& key);
+
+  // Creates the LLDB target, in the background then synchronously
+  void loadTarget(QString const& executable, QString const& key);
+  bool createTarget(QString const& executable);
+
+  // Maps the cached symbol index of the loaded module, builds it in the background if missing
+  void loadSymbols(QString const& key);
+
   QList<Variable*> globals_;
+  AbstractProbe*   processProbe_ = nullptr;
+  std::once_flag   lldbInitialized_;
+  bool             lldb_ = false;
   lldb::SBDebugger debugger_;
   lldb::SBTarget   target_;
   lldb::SBModule   module_;
@@ -95,4 +199,21 @@ private:
   lldb::SBListener listener_{"QMcu.Debugger"};
   std::jthread     listener_thread_;
   static Debugger* instance_;
+
+  QList<StopRequest>   stopRequests_;
+  bool                 stopPending_     = false;
+  int64_t              stopRequestedNs_ = 0;
+  std::atomic<int64_t> stoppedNs_       = 0;
+  double               stopLatency_     = 0.0;
+  double               haltTime_        = 0.0;
+  quint64              stopCount_       = 0;
+
+  std::unique_ptr<ShadowMemory> shadow_;
+  bool                          shadowInvalidationPending_ = false;
+
+  QString                      executable_;
+  std::unique_ptr<ElfFile>     elf_;
+  bool                         nativeReady_ = false;
+  std::unique_ptr<SymbolIndex> symbols_;
+  quint64                      symbolsGeneration_ = 0; // drops indices built for a former target
 };
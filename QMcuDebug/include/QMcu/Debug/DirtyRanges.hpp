@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Byte range of a sample that changed since the previous one
+struct DirtyRange
+{
+  size_t offset = 0;
+  size_t size   = 0;
+
+  size_t end() const noexcept
+  {
+    return offset + size;
+  }
+
+  bool operator==(DirtyRange const&) const = default;
+};
+
+// Compares `previous` and `next` and stores in `out` the ranges where they differ, sorted and
+// block-aligned (32 bytes, clipped to the buffer size). Ranges less than `gap` bytes apart are
+// merged: copying a few unchanged bytes is cheaper than one more copy. Bytes past the end of the
+// shortest buffer are dirty.
+//
+// Uses AVX2 when the CPU has it (NEON on aarch64), 64 bits words otherwise; returns whether
+// anything changed.
+bool findDirtyRanges(std::span<std::byte const> previous,
+                     std::span<std::byte const> next,
+                     std::vector<DirtyRange>&   out,
+                     size_t                     gap = 64);
+
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Slots of a mapped buffer shared by one writer and the frames the GPU renders.
+//
+// The writer fills a slot no frame can be reading, then publishes it; frames present the latest
+// published slot. Presents happen at most once per frame, so the slots of the last
+// `framesInFlight` presents may still be read by the GPU: they are only handed out again once
+// as many other slots were presented. `framesInFlight + 2` slots always leave the writer one.
+class FrameSlots
+{
+public:
+  explicit FrameSlots(size_t framesInFlight = 1)
+      : framesInFlight_{std::max<size_t>(framesInFlight, 1)},
+        states_(framesInFlight_ + 2, State::Free)
+  {
+  }
+
+  size_t count() const noexcept
+  {
+    return states_.size();
+  }
+
+  // Writer side: a slot to fill, then to publish() or release()
+  size_t acquire()
+  {
+    std::lock_guard lock{mutex_};
+    auto            it = std::ranges::find(states_, State::Free);
+    if(it == states_.end())
+    {
+      // cannot happen with a single writer, unless it did not give its slot back
+      it = states_.begin() + *published_;
+      published_.reset();
+    }
+    *it = State::Writing;
+    return size_t(it - states_.begin());
+  }
+
+  // Writer side: `slot` holds the latest data, the previous one is dropped if not presented
+  void publish(size_t slot)
+  {
+    std::lock_guard lock{mutex_};
+    if(published_)
+    {
+      states_[*published_] = State::Free;
+    }
+    states_[slot] = State::Published;
+    published_    = slot;
+  }
+
+  // Writer side: gives `slot` back, ie. when it could not be filled
+  void release(size_t slot)
+  {
+    std::lock_guard lock{mutex_};
+    states_[slot] = State::Free;
+  }
+
+  // Render side, when a frame is updated: the slot to draw, nullopt until one was published
+  std::optional<size_t> present()
+  {
+    std::lock_guard lock{mutex_};
+    if(published_)
+    {
+      states_[*published_] = State::Presented;
+      presented_.push_back(*published_);
+      published_.reset();
+      if(presented_.size() > framesInFlight_)
+      {
+        states_[presented_.front()] = State::Free;
+        presented_.pop_front();
+      }
+    }
+    if(presented_.empty())
+    {
+      return std::nullopt;
+    }
+    return presented_.back();
+  }
+
+private:
+  enum class State
+  {
+    Free,
+    Writing,
+    Published,
+    Presented,
+  };
+
+  const size_t          framesInFlight_;
+  std::mutex            mutex_;
+  std::vector<State>    states_;
+  std::deque<size_t>    presented_; // by the last frames, oldest first
+  std::optional<size_t> published_;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QMcu/Debug/RecordingWriter.hpp>
+
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+#include <QtQmlIntegration>
+
+class VariableProxy;
+class VariableProxyGroup;
+
+// Records every tick of a VariableProxyGroup to a file (see RecordingFormat.hpp).
+//
+// Each tick is a row: its timestamp, then the last value of each proxy, in their native type
+// (or as a double with a transform). Proxies not due at a tick repeat their previous value. The
+// channels are the resolved proxies of the group when the recording starts, but the zero-copy
+// ones (see BufferPlotProvider), that publish no sample.
+class GroupRecorder : public QObject
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(VariableProxyGroup* group READ group WRITE setGroup NOTIFY groupChanged)
+  Q_PROPERTY(QUrl file READ file WRITE setFile NOTIFY fileChanged)
+  Q_PROPERTY(bool recording READ recording WRITE setRecording NOTIFY recordingChanged)
+  Q_PROPERTY(int chunkSamples READ chunkSamples WRITE setChunkSamples NOTIFY chunkSamplesChanged)
+  Q_PROPERTY(quint64 samples READ samples NOTIFY progress)
+  Q_PROPERTY(quint64 bytesWritten READ bytesWritten NOTIFY progress)
+
+public:
+  GroupRecorder(QObject* parent = nullptr);
+  virtual ~GroupRecorder();
+
+  VariableProxyGroup* group() const noexcept
+  {
+    return group_;
+  }
+  QUrl const& file() const noexcept
+  {
+    return file_;
+  }
+  bool recording() const noexcept
+  {
+    return writer_ != nullptr;
+  }
+  // Rows per chunk, the unit of file writes and of the per-chunk statistics
+  int chunkSamples() const noexcept
+  {
+    return chunkSamples_;
+  }
+  quint64 samples() const noexcept
+  {
+    return writer_ != nullptr ? writer_->rows() : samples_;
+  }
+  quint64 bytesWritten() const noexcept
+  {
+    return writer_ != nullptr ? writer_->bytesWritten() : bytesWritten_;
+  }
+
+public slots:
+  void setGroup(VariableProxyGroup* group);
+  void setFile(QUrl const& file);
+  void setRecording(bool recording);
+  void setChunkSamples(int count);
+
+signals:
+  void groupChanged();
+  void fileChanged();
+  void recordingChanged();
+  void chunkSamplesChanged();
+  void progress();
+
+private:
+  bool start();
+  void stop();
+  void record();
+
+  QPointer<VariableProxyGroup>            group_;
+  QUrl                                    file_;
+  int                                     chunkSamples_ = 16384;
+  std::unique_ptr<RecordingWriter>        writer_;
+  QList<QPointer<VariableProxy>>          channels_;
+  std::vector<std::span<std::byte const>> row_;
+  QMetaObject::Connection                 connection_;
+  quint64                                 samples_      = 0; // of the last recording
+  quint64                                 bytesWritten_ = 0;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractProbe.hpp>
+
+// Reads the memory of a process running on the host, without stopping it.
+//
+// The process is the one launched by the Debugger, LLDB being only used for symbols and launch.
+// Batches are fetched with a single process_vm_readv() scatter-gather call; when the kernel
+// refuses it, reads fall back to pread() on /proc/<pid>/mem.
+class HostProcessProbe : public AbstractProbe
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(qint64 pid READ pid NOTIFY pidChanged)
+  Q_PROPERTY(Method method READ method NOTIFY methodChanged)
+
+public:
+  enum class Method
+  {
+    None,
+    VmReadv, // process_vm_readv/process_vm_writev
+    ProcMem, // pread/pwrite on /proc/<pid>/mem
+  };
+  Q_ENUM(Method)
+
+  HostProcessProbe(QObject* parent = nullptr);
+  virtual ~HostProcessProbe();
+
+  Capabilities capabilities() const noexcept override
+  {
+    return CapabilityBits::Write
+         | CapabilityBits::NonIntrusive
+         | CapabilityBits::BatchRead
+         | CapabilityBits::LoadAddresses;
+  }
+
+  qint64 pid() const noexcept
+  {
+    return pid_;
+  }
+  Method method() const noexcept
+  {
+    return method_.load(std::memory_order_relaxed);
+  }
+
+public slots:
+  // Targets `pid`, 0 to detach
+  void attach(qint64 pid);
+
+signals:
+  void pidChanged();
+  void methodChanged();
+
+protected:
+  bool doRead(address_t address, std::span<std::byte> data) override;
+  bool doWrite(address_t address, std::span<std::byte const> data) override;
+  bool doReadBatch(std::span<ReadRequest const> requests) override;
+
+private:
+  bool vmRead(std::span<ReadRequest const> requests);
+  bool memRead(std::span<ReadRequest const> requests);
+  void fallback(int error);
+
+  // guards pid_ and memFd_ against attach() from the GUI thread
+  std::mutex          mutex_;
+  qint64              pid_    = 0;
+  int                 memFd_  = -1;
+  std::atomic<Method> method_ = Method::None;
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QMcu/Debug/SampleRing.hpp>
+#include <QMcu/Debug/VariableProxy.hpp>
+#include <QMcu/Plot/AbstractPlotDataProvider.hpp>
+
+#include <QPointer>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class ScrollWindow;
+class SegmentTracker;
+
+// Streams a buffer the target fills one segment after the other (ie. ping-pong halves).
+//
+// `index` is the target variable telling which segment is being written, which one was just
+// completed or how many were (`indexMode`). Whenever it changes, only the segments completed
+// since are read and appended to a continuous stream; segments the target went over first are
+// reported as overruns. Samples are `1 / sampleRate` apart, the rate being estimated from the
+// completions when not given.
+class PingPongPlotProvider : public AbstractPlotDataProvider
+{
+  Q_OBJECT
+  QML_ELEMENT
+  Q_CLASSINFO("DefaultProperty", "buffer")
+
+  Q_PROPERTY(VariableProxy* buffer READ buffer WRITE setBuffer NOTIFY bufferChanged)
+  Q_PROPERTY(VariableProxy* index READ index WRITE setIndex NOTIFY indexChanged)
+  Q_PROPERTY(IndexMode indexMode READ indexMode WRITE setIndexMode NOTIFY settingsChanged)
+  Q_PROPERTY(int segments READ segments WRITE setSegments NOTIFY settingsChanged)
+  Q_PROPERTY(double sampleRate READ sampleRate WRITE setSampleRate NOTIFY settingsChanged)
+  Q_PROPERTY(int sampleCount READ sampleCount WRITE setSampleCount NOTIFY settingsChanged)
+  Q_PROPERTY(double measuredRate READ measuredRate NOTIFY statsChanged)
+  Q_PROPERTY(quint64 samples READ samples NOTIFY statsChanged)
+  Q_PROPERTY(quint64 overruns READ overruns NOTIFY statsChanged)
+  Q_PROPERTY(quint64 lostSamples READ lostSamples NOTIFY statsChanged)
+
+public:
+  enum class IndexMode
+  {
+    Active,    // segment being written (ie. a half-complete flag)
+    Completed, // last completed segment
+    Count,     // completed segments so far, which makes overruns exact
+  };
+  Q_ENUM(IndexMode)
+
+  PingPongPlotProvider(QObject* parent = nullptr);
+  virtual ~PingPongPlotProvider();
+
+  VariableProxy* buffer() const noexcept
+  {
+    return buffer_;
+  }
+  VariableProxy* index() const noexcept
+  {
+    return index_;
+  }
+  IndexMode indexMode() const noexcept
+  {
+    return indexMode_;
+  }
+  // 0: the outer extent of a 2D buffer, halves otherwise
+  int segments() const noexcept
+  {
+    return segments_;
+  }
+  // Target samples per second, 0 to estimate it
+  double sampleRate() const noexcept
+  {
+    return sampleRate_;
+  }
+  int sampleCount() const noexcept
+  {
+    return sampleCount_;
+  }
+
+  double measuredRate() const noexcept
+  {
+    return measuredRate_;
+  }
+  quint64 samples() const noexcept
+  {
+    return samples_;
+  }
+  // Segments overwritten before they could be read
+  quint64 overruns() const noexcept
+  {
+    return overruns_;
+  }
+  quint64 lostSamples() const noexcept
+  {
+    return lostSamples_;
+  }
+
+public slots:
+  void setBuffer(VariableProxy* buffer);
+  void setIndex(VariableProxy* index);
+  void setIndexMode(IndexMode mode);
+  void setSegments(int segments);
+  void setSampleRate(double rate);
+  void setSampleCount(int count);
+
+signals:
+  void bufferChanged();
+  void indexChanged();
+  void settingsChanged();
+  void statsChanged();
+  void overrun(quint64 segments);
+
+protected:
+  bool        initializePlotContext(PlotContext& ctx) final;
+  UpdateRange update(PlotContext& ctx) final;
+
+private:
+  void configure();
+  void follow();
+
+  QPointer<VariableProxy> buffer_;
+  QPointer<VariableProxy> index_;
+  IndexMode               indexMode_   = IndexMode::Active;
+  int                     segments_    = 0;
+  double                  sampleRate_  = 0.0;
+  int                     sampleCount_ = 1000;
+
+  double  measuredRate_ = 0.0;
+  quint64 samples_      = 0;
+  quint64 overruns_     = 0;
+  quint64 lostSamples_  = 0;
+
+  std::unique_ptr<SegmentTracker> tracker_;
+  QMetaType::Type                 type_           = QMetaType::UnknownType;
+  size_t                          segmentSamples_ = 0;
+  int64_t                         lastUpdateNs_   = 0;
+  int64_t                         lastSampleNs_   = 0;
+  std::vector<std::byte>          scratch_;
+
+  std::atomic<std::shared_ptr<SampleRing>> ring_;
+
+  // render thread
+  std::unique_ptr<ScrollWindow> window_;
+  QMetaType::Type               tid_ = QMetaType::UnknownType;
+};
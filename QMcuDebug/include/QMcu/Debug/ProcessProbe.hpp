@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractProbe.hpp>
+
+class Debugger;
+
+// Reads the memory of the process debugged by LLDB.
+//
+// LLDB only accesses memory of a stopped process, hence the missing NonIntrusive capability:
+// reads are issued within Debugger::whenStopped() windows.
+class ProcessProbe : public AbstractProbe
+{
+  Q_OBJECT
+
+public:
+  explicit ProcessProbe(Debugger* parent);
+
+  Capabilities capabilities() const noexcept override
+  {
+    return CapabilityBits::Write | CapabilityBits::LoadAddresses;
+  }
+
+protected:
+  bool doRead(address_t address, std::span<std::byte> data) override;
+  bool doWrite(address_t address, std::span<std::byte const> data) override;
+
+private:
+  Debugger* debugger() const noexcept;
+};
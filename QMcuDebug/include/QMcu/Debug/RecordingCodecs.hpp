@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QMcu/Debug/RecordingFormat.hpp>
+
+#include <QMetaType>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Encodings of the columns of a recording chunk (see recording::Codec).
+//
+// Columns are rows of `width` bytes holding elements of `type`, `elementSize` bytes each; the
+// numeric codecs work element by element, each one against the same element of the previous
+// row. Decoding checks its input: a corrupt column fails rather than reading out of bounds.
+namespace recording
+{
+// Whether a codec can encode elements of a type
+bool supports(Codec codec, QMetaType::Type type, size_t elementSize) noexcept;
+
+// Appends `rows` encoded to `out`; false when the codec does not support the type
+bool encode(Codec                      codec,
+            QMetaType::Type            type,
+            size_t                     elementSize,
+            size_t                     width,
+            std::span<std::byte const> rows,
+            std::vector<std::byte>&    out);
+
+// Decodes `in` to `out`, sized for the rows it holds
+bool decode(Codec                      codec,
+            QMetaType::Type            type,
+            size_t                     elementSize,
+            size_t                     width,
+            std::span<std::byte const> in,
+            std::span<std::byte>       out);
+
+// Codec giving the smallest encoding of the first rows, none when none saves an eighth of them
+Codec pick(QMetaType::Type type, size_t elementSize, size_t width, std::span<std::byte const> rows);
+} // namespace recording
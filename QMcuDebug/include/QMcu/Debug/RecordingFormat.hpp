@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of recordings (see RecordingWriter, RecordingReader).
+//
+// Little-endian, append-only, every structure and column 8-byte aligned so that a mapped file
+// is read in place:
+//
+//   FileHeader
+//   ChannelHeader[channelCount]
+//   chunks, each:
+//     ChunkHeader
+//     ColumnHeader[channelCount]
+//     timestamps                      int64_t[count] shared by all channels, in ns, encoded
+//     columns, one per channel:       count rows of `width` bytes, native type, encoded
+//
+// A chunk is written at once; a truncated last chunk (the recorder was killed) is ignored.
+//
+// Timestamps and columns are encoded by chunk (see Codec, RecordingCodecs.hpp); a column
+// stored as is (Codec::none) is read in place.
+//
+// Levels of detail (see MinMaxPyramid) of the first element of each channel are stored next to
+// the recording, in "<recording>.lod":
+//
+//   LodHeader
+//   LodLevel[levelCount]
+//   levels, each:                     (min, max) pairs in the type of their channel
+namespace recording
+{
+inline constexpr char     magic[8]    = {'Q', 'M', 'c', 'u', 'R', 'e', 'c', '\0'};
+inline constexpr char     lodMagic[8] = {'Q', 'M', 'c', 'u', 'L', 'o', 'd', '\0'};
+inline constexpr uint32_t version     = 2;
+inline constexpr uint32_t chunkMagic  = 0x4b4e4843; // "CHNK"
+inline constexpr size_t   maxNameSize = 47;
+
+enum class Codec : uint32_t
+{
+  none         = 0, // rows as sampled
+  delta        = 1, // integers: zig-zag varints of the differences to the previous row
+  deltaOfDelta = 2, // integers: the same, of the differences of the differences
+  gorilla      = 3, // floating points: bits XORed with the previous row, leading and
+                    // trailing zeros stripped
+  runLength    = 4, // any type: varint repeat count, then the row
+};
+inline constexpr uint32_t codecCount = 5;
+
+struct FileHeader
+{
+  char     magic[8];
+  uint32_t version      = recording::version;
+  uint32_t channelCount = 0;
+  uint64_t chunkRows    = 0; // rows of a full chunk
+  uint64_t reserved[5]  = {};
+};
+
+struct ChannelHeader
+{
+  uint32_t typeId      = 0; // QMetaType::Type of the elements, qplot::TypeId::qt
+  uint32_t elementSize = 0;
+  uint32_t width       = 0; // bytes per row: elementSize times the number of elements
+  uint32_t nameSize    = 0;
+  char     name[48]    = {}; // null-terminated, truncated to maxNameSize
+};
+
+struct ChunkHeader
+{
+  uint32_t magic      = chunkMagic;
+  uint32_t count      = 0; // rows
+  uint64_t size       = 0; // bytes, headers included: offset of the next chunk
+  int64_t  firstNs    = 0;
+  int64_t  lastNs     = 0;
+  uint64_t timesSize  = 0; // bytes, as stored
+  uint32_t timesCodec = 0;
+  uint32_t reserved   = 0;
+};
+
+struct ColumnHeader
+{
+  uint64_t offset   = 0;   // from the chunk header
+  uint64_t size     = 0;   // bytes, as stored
+  double   min      = 0.0; // over all elements of the chunk, NaN when not numeric
+  double   max      = 0.0;
+  uint32_t codec    = 0;
+  uint32_t reserved = 0;
+};
+
+struct LodHeader
+{
+  char     magic[8];
+  uint32_t version     = recording::version;
+  uint32_t levelCount  = 0;
+  uint64_t rows        = 0; // of the recording when the levels were built
+  uint64_t factor      = 0; // samples per bucket of a level, per bucket of the level below
+  uint64_t reserved[4] = {};
+};
+
+struct LodLevel
+{
+  uint32_t channel  = 0;
+  uint32_t level    = 0; // from 1, in order for each channel
+  uint64_t offset   = 0; // from the file start
+  uint64_t size     = 0; // bytes
+  uint64_t reserved = 0;
+};
+
+constexpr uint64_t align(uint64_t size) noexcept
+{
+  return (size + 7) & ~uint64_t(7);
+}
+
+static_assert(sizeof(FileHeader) == 64);
+static_assert(sizeof(ChannelHeader) == 64);
+static_assert(sizeof(ChunkHeader) == 48);
+static_assert(sizeof(ColumnHeader) == 40);
+static_assert(sizeof(LodHeader) == 64);
+static_assert(sizeof(LodLevel) == 32);
+} // namespace recording
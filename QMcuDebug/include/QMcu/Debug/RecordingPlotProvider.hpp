@@ -0,0 +1,159 @@
+#pragma once
+
+#include <QMcu/Debug/RecordingReader.hpp>
+#include <QMcu/Plot/AbstractPlotDataProvider.hpp>
+
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Replays a channel of a recording (see GroupRecorder), as a ScrollPlotProvider would have
+// plotted it live: the last `sampleCount` samples before the playback position.
+//
+// Samples are copied straight from the mapped file into the plot buffer, chunk by chunk, in their
+// recorded type (the first element of arrays). Playback runs at `speed` times the recorded pace
+// (0.1 to 100), or with a `speed` of 0, as fast as the plot draws: a whole new window per frame,
+// a deterministic workload for benchmarks. Setting `position` seeks.
+//
+// Only the visible part of the window is drawn. When it holds more samples than the plot has
+// pixel columns, the (min, max) envelope of the recording (see MinMaxPyramid) is drawn instead,
+// so that windows of millions of samples draw as fast as a thousand, their peaks included.
+// Recordings without up to date levels have them built in the background; their samples are
+// drawn meanwhile.
+class RecordingPlotProvider : public AbstractPlotDataProvider
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QUrl file READ file WRITE setFile NOTIFY fileChanged)
+  Q_PROPERTY(QString channel READ channel WRITE setChannel NOTIFY channelChanged)
+  Q_PROPERTY(QStringList channels READ channels NOTIFY fileChanged)
+  Q_PROPERTY(double duration READ duration NOTIFY fileChanged)
+  Q_PROPERTY(int sampleCount READ sampleCount WRITE setSampleCount NOTIFY sampleCountChanged)
+  Q_PROPERTY(bool playing READ playing WRITE setPlaying NOTIFY playingChanged)
+  Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+  Q_PROPERTY(bool loop READ loop WRITE setLoop NOTIFY loopChanged)
+  Q_PROPERTY(double position READ position WRITE setPosition NOTIFY positionChanged)
+
+public:
+  RecordingPlotProvider(QObject* parent = nullptr);
+  virtual ~RecordingPlotProvider();
+
+  QUrl const& file() const noexcept
+  {
+    return file_;
+  }
+  QString const& channel() const noexcept
+  {
+    return channel_;
+  }
+  QStringList channels() const;
+  // Seconds
+  double duration() const noexcept;
+  int    sampleCount() const noexcept
+  {
+    return sampleCount_;
+  }
+  bool playing() const noexcept
+  {
+    return timer_.isActive();
+  }
+  double speed() const noexcept
+  {
+    return speed_;
+  }
+  bool loop() const noexcept
+  {
+    return loop_;
+  }
+  // Seconds from the start of the recording
+  double position() const noexcept
+  {
+    return position_;
+  }
+
+public slots:
+  void setFile(QUrl const& file);
+  void setChannel(QString const& channel);
+  void setSampleCount(int count);
+  void setPlaying(bool playing);
+  void setSpeed(double speed);
+  void setLoop(bool loop);
+  void setPosition(double seconds);
+
+signals:
+  void fileChanged();
+  void channelChanged();
+  void sampleCountChanged();
+  void playingChanged();
+  void speedChanged();
+  void loopChanged();
+  void positionChanged();
+
+protected:
+  bool        initializePlotContext(PlotContext& ctx) final;
+  UpdateRange update(PlotContext& ctx) final;
+
+private:
+  using Levels = std::vector<MinMaxPyramid>;
+
+  // What the render thread plays, swapped as a whole
+  struct Source
+  {
+    std::shared_ptr<RecordingReader const> reader;
+    size_t                                 channel = 0;
+    std::shared_ptr<Levels const>          levels; // built, when the reader has none
+
+    MinMaxPyramid const& pyramid() const noexcept
+    {
+      return levels != nullptr ? (*levels)[channel] : reader->pyramid(channel);
+    }
+  };
+
+  static constexpr size_t npos = size_t(-1);
+
+  void     select();
+  void     buildLevels();
+  uint64_t advance(Source const& source);
+  void     copy(Source const& source, uint64_t first, uint64_t end);
+
+  QUrl                                   file_;
+  QString                                channel_;
+  std::shared_ptr<RecordingReader const> reader_;
+  std::shared_ptr<Levels const>          levels_; // of reader_, once built
+  int                                    sampleCount_ = 1000;
+  double                                 speed_       = 1.0;
+  bool                                   loop_        = false;
+  double                                 position_    = 0.0;
+  QTimer                                 timer_;
+
+  std::atomic<std::shared_ptr<Source const>> source_;
+  std::atomic<int64_t>                       seekNs_  = -1; // from the start, -1 when none
+  std::atomic<double>                        pace_    = 1.0;
+  std::atomic<bool>                          running_ = false;
+  std::atomic<bool>                          looping_ = false;
+
+  // render thread
+  std::shared_ptr<Source const> shown_;
+  std::span<std::byte>          mappedData_;
+  QMetaType::Type               tid_         = QMetaType::UnknownType;
+  size_t                        elementSize_ = 0;
+  size_t                        capacity_    = 0;
+  uint64_t                      end_         = 0; // row after the last shown
+  size_t                        level_       = 0; // of detail shown
+  uint64_t                      lo_          = 0; // visible rows, from the window start
+  uint64_t                      hi_          = 0;
+  size_t                        shownCount_  = 0;
+  int64_t                       clockNs_     = 0; // playback position, recording time
+  int64_t                       lastFrameNs_ = 0; // wall time, 0 when paused
+
+  std::vector<std::byte>      decoded_;             // rows of an encoded chunk
+  size_t                      decodedChunk_ = npos; // of decoded_
+  RecordingReader::TimesCache times_;               // of the chunk holding the clock
+
+  std::jthread levelsBuilder_; // last: stopped first
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QMcu/Debug/RecordingFormat.hpp>
+#include <QMcu/Plot/MinMaxPyramid.hpp>
+
+#include <QMetaType>
+#include <QString>
+
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+class QFile;
+
+// Read-only view of a recording file (see RecordingFormat.hpp), mapped in memory.
+//
+// Opening only walks the chunk headers, whatever the length of the recording: samples are read
+// in place, the system paging them in as they are accessed, and decoded by chunk when encoded.
+// The levels of detail stored next to the recording are mapped as well. When they are missing or
+// out of date (ie. a recording cut short, or still running), buildLevels() makes them from the
+// samples; the reader never writes next to the recording.
+class RecordingReader
+{
+public:
+  struct Channel
+  {
+    QString         name;
+    QMetaType::Type typeId      = QMetaType::UnknownType;
+    size_t          elementSize = 0;
+    size_t          width       = 0; // bytes per row
+  };
+
+  struct Chunk
+  {
+    uint64_t                                 row     = 0; // of its first sample in the recording
+    recording::ChunkHeader const*            header  = nullptr;
+    std::span<recording::ColumnHeader const> columns = {};
+    std::span<std::byte const>               times   = {}; // as stored, see RecordingReader::times
+
+    size_t count() const noexcept
+    {
+      return header->count;
+    }
+    recording::Codec codec(size_t channel) const noexcept
+    {
+      return recording::Codec(columns[channel].codec);
+    }
+    // Rows of a channel as stored: packed when not encoded
+    std::span<std::byte const> column(size_t channel) const noexcept;
+  };
+
+  RecordingReader();
+  ~RecordingReader();
+
+  bool open(QString const& path);
+  void close();
+  bool isOpen() const noexcept
+  {
+    return file_ != nullptr;
+  }
+
+  std::vector<Channel> const& channels() const noexcept
+  {
+    return channels_;
+  }
+  std::vector<Chunk> const& chunks() const noexcept
+  {
+    return chunks_;
+  }
+  uint64_t rows() const noexcept
+  {
+    return rows_;
+  }
+  int64_t firstNs() const noexcept
+  {
+    return chunks_.empty() ? 0 : chunks_.front().header->firstNs;
+  }
+  int64_t lastNs() const noexcept
+  {
+    return chunks_.empty() ? 0 : chunks_.back().header->lastNs;
+  }
+
+  // Chunk holding the sample at or right before `timestampNs` (the first one before them all)
+  size_t chunkAt(int64_t timestampNs) const noexcept;
+  // Chunk holding a row
+  size_t chunkOfRow(uint64_t row) const noexcept;
+  // Decoded timestamps of the chunk last looked up: kept by callers looking up the same chunks
+  // again and again, ie. every frame of a playback
+  struct TimesCache
+  {
+    std::vector<int64_t> times;
+    size_t               chunk = size_t(-1);
+  };
+
+  // Number of samples at or before `timestampNs`
+  uint64_t rowsUntil(int64_t timestampNs) const;
+  uint64_t rowsUntil(int64_t timestampNs, TimesCache& cache) const;
+  // Timestamp of a row
+  int64_t timeAt(uint64_t row) const;
+  int64_t timeAt(uint64_t row, TimesCache& cache) const;
+
+  // Decode the timestamps, or the rows of a channel, of a chunk to `out`, sized for them
+  bool times(Chunk const& chunk, std::span<int64_t> out) const;
+  bool read(Chunk const& chunk, size_t channel, std::span<std::byte> out) const;
+
+  // Levels of detail of the first element of a channel, invalid when it is not a basic type or
+  // when the levels were not mapped
+  MinMaxPyramid const& pyramid(size_t channel) const noexcept
+  {
+    return pyramids_[channel];
+  }
+  bool hasLevels() const noexcept
+  {
+    return lodFile_ != nullptr;
+  }
+
+  // Levels of detail of every channel, from the samples: decodes the whole recording, so better
+  // off the GUI thread. Empty when stopped
+  std::vector<MinMaxPyramid> buildLevels(std::stop_token stop = {}) const;
+
+private:
+  // Timestamps of a chunk, decoded to the cache unless it holds them, empty when corrupt
+  std::span<int64_t const> chunkTimes(size_t chunk, TimesCache& cache) const;
+
+  bool mapLevels(QString const& path);
+
+  std::unique_ptr<QFile>     file_;
+  std::span<std::byte const> data_;
+  std::vector<Channel>       channels_;
+  std::vector<Chunk>         chunks_;
+  uint64_t                   rows_ = 0;
+
+  std::unique_ptr<QFile>     lodFile_;
+  std::vector<MinMaxPyramid> pyramids_;
+};
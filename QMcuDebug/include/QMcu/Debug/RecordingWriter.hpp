@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QMcu/Debug/RecordingFormat.hpp>
+#include <QMcu/Plot/MinMaxPyramid.hpp>
+
+#include <QMetaType>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+class QFile;
+
+// Streams rows of samples to a recording file (see RecordingFormat.hpp).
+//
+// append() fills the current chunk in memory, column by column; full chunks are handed to a
+// background thread that computes their statistics, encodes and writes them, so the caller
+// never waits on the disk. The same thread builds the levels of detail of the channels, written
+// next to the recording by close(), after the last, partial chunk.
+class RecordingWriter
+{
+public:
+  struct Channel
+  {
+    QString         name;
+    QMetaType::Type typeId      = QMetaType::UnknownType;
+    size_t          elementSize = 0;
+    size_t          width       = 0; // bytes per row
+
+    std::optional<recording::Codec> codec; // picked for each chunk when unset
+  };
+
+  explicit RecordingWriter(size_t chunkRows = 16384);
+  ~RecordingWriter();
+
+  bool open(QString const& path, std::vector<Channel> channels);
+  void close();
+  bool isOpen() const noexcept
+  {
+    return file_ != nullptr;
+  }
+
+  std::vector<Channel> const& channels() const noexcept
+  {
+    return channels_;
+  }
+
+  // One value per channel, in order, of their width; shorter ones are zero-padded
+  void append(int64_t timestampNs, std::span<std::span<std::byte const> const> row);
+
+  uint64_t rows() const noexcept
+  {
+    return rows_;
+  }
+  // Written to the file so far
+  uint64_t bytesWritten() const noexcept
+  {
+    return bytesWritten_.load(std::memory_order_relaxed);
+  }
+  // A write failed: the rest of the recording is dropped
+  bool failed() const noexcept
+  {
+    return failed_.load(std::memory_order_relaxed);
+  }
+
+  // Writes the levels of detail of the channels of a recording of `rows` rows
+  static bool writeLevels(QString const&                    path,
+                          std::vector<MinMaxPyramid> const& pyramids,
+                          uint64_t                          rows);
+  static QString levelsPath(QString const& path)
+  {
+    return path + ".lod";
+  }
+
+private:
+  struct Chunk
+  {
+    std::vector<int64_t>                times;
+    std::vector<std::vector<std::byte>> columns;
+  };
+
+  void newChunk();
+  void queue();
+  void run(std::stop_token stop);
+  bool write(Chunk const& chunk);
+
+  const size_t           chunkRows_;
+  std::vector<Channel>   channels_;
+  std::unique_ptr<QFile> file_;
+  std::unique_ptr<Chunk> current_;
+  uint64_t               rows_ = 0;
+
+  std::vector<MinMaxPyramid> pyramids_; // writer thread
+
+  std::mutex                         queueMutex_;
+  std::condition_variable_any        queueReady_;
+  std::deque<std::unique_ptr<Chunk>> queue_;
+  std::atomic<uint64_t>              bytesWritten_ = 0;
+  std::atomic<bool>                  failed_       = false;
+  std::jthread                       thread_;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QMcu/Debug/SampleRing.hpp>
+#include <QMcu/Plot/AbstractPlotDataProvider.hpp>
+
+#include <QPointer>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class RttReader;
+class ScrollWindow;
+
+// Plots the samples streamed on an RTT up buffer.
+//
+// The channel bytes are a sequence of `format` values; the last `sampleCount` ones are shown,
+// scrolling. Every received sample is queued for the renderer, so none is skipped between two
+// frames.
+class RttChannel : public AbstractPlotDataProvider
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(RttReader* reader READ reader WRITE setReader NOTIFY readerChanged)
+  Q_PROPERTY(int index READ index WRITE setIndex NOTIFY indexChanged)
+  Q_PROPERTY(Format format READ format WRITE setFormat NOTIFY formatChanged)
+  Q_PROPERTY(int sampleCount READ sampleCount WRITE setSampleCount NOTIFY sampleCountChanged)
+  Q_PROPERTY(quint64 samples READ samples NOTIFY samplesChanged)
+  Q_PROPERTY(quint64 dropped READ dropped NOTIFY samplesChanged)
+
+public:
+  enum class Format
+  {
+    Int8   = QMetaType::Char,
+    UInt8  = QMetaType::UChar,
+    Int16  = QMetaType::Short,
+    UInt16 = QMetaType::UShort,
+    Int32  = QMetaType::Int,
+    UInt32 = QMetaType::UInt,
+    Int64  = QMetaType::LongLong,
+    UInt64 = QMetaType::ULongLong,
+    Float  = QMetaType::Float,
+    Double = QMetaType::Double,
+  };
+  Q_ENUM(Format)
+
+  RttChannel(QObject* parent = nullptr);
+  virtual ~RttChannel();
+
+  RttReader* reader() const noexcept
+  {
+    return reader_;
+  }
+  // Up buffer index within the control block
+  int index() const noexcept
+  {
+    return index_;
+  }
+  Format format() const noexcept
+  {
+    return format_;
+  }
+  int sampleCount() const noexcept
+  {
+    return sampleCount_;
+  }
+
+  // Samples received so far
+  quint64 samples() const noexcept
+  {
+    return samples_;
+  }
+  // Samples the renderer could not keep up with
+  quint64 dropped() const noexcept;
+
+  // Called by the reader with the bytes received since the previous poll
+  void receive(std::span<std::byte const> bytes, int64_t timestampNs);
+
+public slots:
+  void setReader(RttReader* reader);
+  void setIndex(int index);
+  void setFormat(Format format);
+  void setSampleCount(int count);
+
+signals:
+  void readerChanged();
+  void indexChanged();
+  void formatChanged();
+  void sampleCountChanged();
+  void samplesChanged();
+
+protected:
+  bool        initializePlotContext(PlotContext& ctx) final;
+  UpdateRange update(PlotContext& ctx) final;
+
+private:
+  void resetRing();
+
+  QPointer<RttReader>    reader_;
+  int                    index_       = 0;
+  Format                 format_      = Format::UInt8;
+  int                    sampleCount_ = 1000;
+  quint64                samples_     = 0;
+  std::vector<std::byte> partial_; // incomplete sample, completed by the next poll
+
+  std::atomic<std::shared_ptr<SampleRing>> ring_;
+
+  // render thread
+  std::unique_ptr<ScrollWindow> window_;
+  QMetaType::Type               tid_ = QMetaType::UnknownType;
+};
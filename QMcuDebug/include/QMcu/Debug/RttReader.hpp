@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QtQmlIntegration>
+
+#include <memory>
+#include <vector>
+
+class RttChannel;
+class RttControlBlock;
+
+// Streams the up buffers of a SEGGER RTT control block out of target RAM.
+//
+// The control block is found through the `controlBlock` symbol, or by scanning
+// [searchAddress, searchAddress + searchSize) for `magic`. Every poll only transfers the bytes
+// written since the previous one and writes the read offsets back, so nothing is lost as long as
+// a buffer does not fill up between two polls. Each channel is a plot data provider.
+class RttReader : public QObject
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString controlBlock READ controlBlock WRITE setControlBlock NOTIFY settingsChanged)
+  Q_PROPERTY(QString magic READ magic WRITE setMagic NOTIFY settingsChanged)
+  Q_PROPERTY(quint64 searchAddress READ searchAddress WRITE setSearchAddress NOTIFY settingsChanged)
+  Q_PROPERTY(quint64 searchSize READ searchSize WRITE setSearchSize NOTIFY settingsChanged)
+  Q_PROPERTY(double rate READ rate WRITE setRate NOTIFY rateChanged)
+  Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
+  Q_PROPERTY(quint64 address READ address NOTIFY connectedChanged)
+  Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
+  Q_PROPERTY(QStringList channelNames READ channelNames NOTIFY connectedChanged)
+  Q_PROPERTY(quint64 bytesReceived READ bytesReceived NOTIFY bytesReceivedChanged)
+
+public:
+  RttReader(QObject* parent = nullptr);
+  virtual ~RttReader();
+
+  QString const& controlBlock() const noexcept
+  {
+    return controlBlock_;
+  }
+  QString const& magic() const noexcept
+  {
+    return magic_;
+  }
+  quint64 searchAddress() const noexcept
+  {
+    return searchAddress_;
+  }
+  quint64 searchSize() const noexcept
+  {
+    return searchSize_;
+  }
+
+  // Polls per second
+  double rate() const noexcept
+  {
+    return rate_;
+  }
+  bool running() const noexcept
+  {
+    return timer_.isActive();
+  }
+
+  // Address of the control block, 0 until found
+  quint64     address() const noexcept;
+  bool        connected() const noexcept;
+  QStringList channelNames() const;
+
+  quint64 bytesReceived() const noexcept
+  {
+    return bytesReceived_;
+  }
+
+  void addChannel(RttChannel* channel);
+  void removeChannel(RttChannel* channel);
+
+public slots:
+  void setControlBlock(QString const& symbol);
+  void setMagic(QString const& magic);
+  void setSearchAddress(quint64 address);
+  void setSearchSize(quint64 size);
+  void setRate(double rate);
+  void setRunning(bool running);
+
+  // Reads the pending bytes of every channel
+  void poll();
+  // Looks for the control block again
+  void reset();
+
+signals:
+  void settingsChanged();
+  void rateChanged();
+  void runningChanged();
+  void connectedChanged();
+  void bytesReceivedChanged();
+
+private:
+  bool locate();
+  void receive();
+
+  QString controlBlock_  = "_SEGGER_RTT";
+  QString magic_         = "SEGGER RTT";
+  quint64 searchAddress_ = 0x20000000;
+  quint64 searchSize_    = 0x10000;
+  double  rate_          = 100.0;
+  quint64 bytesReceived_ = 0;
+  int64_t lastScanNs_    = 0;
+
+  QTimer                              timer_;
+  std::unique_ptr<RttControlBlock>    block_;
+  std::vector<std::vector<std::byte>> data_;
+  QList<RttChannel*>                  channels_;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QMcu/Debug/DirtyRanges.hpp>
+#include <QMcu/Plot/VK/Types.hpp>
+
+#include <QVariant>
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+// Last value read from a variable, unboxed: `bytes` holds count() packed elements of `typeId`
+// (a whole struct when typeId is unknown).
+//
+// It is a view into the buffers of the variable, valid until its next read: plot providers copy
+// or decode it directly, QVariant being left to the QML display path.
+struct SampleView
+{
+  QMetaType::Type            typeId      = QMetaType::UnknownType;
+  size_t                     elementSize = 0;
+  std::span<std::byte const> bytes       = {};
+  bool                       isArray     = false;
+  // Bytes that differ from the previous sample; empty when unknown, ie. take all of them
+  std::span<DirtyRange const> dirty = {};
+
+  bool isValid() const noexcept
+  {
+    return elementSize != 0 and not bytes.empty();
+  }
+
+  size_t count() const noexcept
+  {
+    return elementSize != 0 ? bytes.size() / elementSize : 0;
+  }
+
+  // Elements as T, empty if the sample holds another type
+  template <typename T> std::span<T const> as() const noexcept
+  {
+    if(typeId != qplot::typeIdOf<T>().qt or elementSize != sizeof(T))
+    {
+      return {};
+    }
+    return {reinterpret_cast<T const*>(bytes.data()), count()};
+  }
+
+  // First element as T (T must be the sample type)
+  template <typename T> T first() const noexcept
+  {
+    T value{};
+    if(bytes.size() >= sizeof(T))
+    {
+      std::memcpy(&value, bytes.data(), sizeof(T));
+    }
+    return value;
+  }
+
+  // First element converted to an integer, 0 for non-numeric samples
+  qint64 toInteger() const noexcept;
+  // First element converted to a double, 0 for non-numeric samples
+  double toReal() const noexcept;
+
+  // Boxed copy: a basic value, a QList of them for arrays, a QByteArray for structs
+  QVariant toVariant() const;
+};
+
+// Converts one element of a sample type to a double; null for structs
+using RealDecoder = double (*)(std::byte const*) noexcept;
+RealDecoder realDecoder(QMetaType::Type typeId) noexcept;
+
+// Calls fn.template operator()<T>() with the type plot buffers hold for `typeId`; returns false
+// without calling it when samples of this type cannot be plotted (booleans, structs)
+template <typename Fn> bool visitSampleType(QMetaType::Type typeId, Fn&& fn)
+{
+  if(false)
+  {
+  }
+#define X(__type, __qt_type)                            \
+  else if(typeId == __qt_type)                          \
+  {                                                     \
+    std::forward<Fn>(fn).template operator()<__type>(); \
+    return true;                                        \
+  }
+  QPLOT_BASIC_TYPE_MAP(X)
+#undef X
+  return false;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// Single-producer/single-consumer lock-free ring of timestamped samples.
+//
+// Each record holds a nanosecond timestamp followed by `valueSize` bytes of raw value. The
+// producer (acquisition thread) never blocks: when the ring is full the sample is dropped and
+// counted. The consumer (render thread) drains every available record at once.
+class SampleRing
+{
+public:
+  SampleRing(size_t valueSize, size_t capacity)
+      : valueSize_{valueSize},
+        recordSize_{(sizeof(int64_t) + valueSize + alignof(int64_t) - 1) & ~(alignof(int64_t) - 1)},
+        mask_{std::bit_ceil(std::max<size_t>(capacity, 2)) - 1},
+        storage_((mask_ + 1) * recordSize_)
+  {
+  }
+
+  size_t valueSize() const noexcept
+  {
+    return valueSize_;
+  }
+
+  size_t capacity() const noexcept
+  {
+    return mask_ + 1;
+  }
+
+  // Samples dropped because the consumer fell behind
+  size_t dropped() const noexcept
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  size_t size() const noexcept
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  // Producer side
+  bool push(int64_t timestampNs, std::span<std::byte const> value) noexcept
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if(head - tail_.load(std::memory_order_acquire) > mask_)
+    {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    auto* record = storage_.data() + (head & mask_) * recordSize_;
+    std::memcpy(record, &timestampNs, sizeof(timestampNs));
+    std::memcpy(record + sizeof(timestampNs), value.data(), std::min(value.size(), valueSize_));
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side: calls fn(int64_t timestampNs, std::span<std::byte const> value) for each
+  // available sample, oldest first; returns the number of consumed samples
+  template <typename Fn> size_t drain(Fn&& fn)
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    for(auto ii = tail; ii != head; ++ii)
+    {
+      auto const* record = storage_.data() + (ii & mask_) * recordSize_;
+      int64_t     timestampNs;
+      std::memcpy(&timestampNs, record, sizeof(timestampNs));
+      fn(timestampNs, std::span{record + sizeof(timestampNs), valueSize_});
+    }
+    tail_.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+  // Consumer side: discards all available samples but the newest one, passed to
+  // fn(int64_t timestampNs, std::span<std::byte const> value); returns false if none
+  template <typename Fn> bool drainLatest(Fn&& fn)
+  {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    if(head == tail)
+    {
+      return false;
+    }
+    auto const* record = storage_.data() + ((head - 1) & mask_) * recordSize_;
+    int64_t     timestampNs;
+    std::memcpy(&timestampNs, record, sizeof(timestampNs));
+    fn(timestampNs, std::span{record + sizeof(timestampNs), valueSize_});
+    tail_.store(head, std::memory_order_release);
+    return true;
+  }
+
+  // Typed variant of drain(): calls fn(int64_t timestampNs, T value)
+  template <typename T, typename Fn> size_t drainAs(Fn&& fn)
+  {
+    return drain(
+        [&](int64_t timestampNs, std::span<std::byte const> bytes)
+        {
+          T value;
+          std::memcpy(&value, bytes.data(), sizeof(T));
+          fn(timestampNs, value);
+        });
+  }
+
+private:
+  static constexpr size_t cacheLine_ = 64;
+
+  const size_t           valueSize_;
+  const size_t           recordSize_;
+  const size_t           mask_;
+  std::vector<std::byte> storage_;
+
+  alignas(cacheLine_) std::atomic<size_t> head_{0};
+  alignas(cacheLine_) std::atomic<size_t> tail_{0};
+  alignas(cacheLine_) std::atomic<size_t> dropped_{0};
+};
@@ -35,11 +35,15 @@ protected:
   UpdateRange update(PlotContext& ctx) final;
 
 private:
-  void pushLastValue();
+  using PushFn = void (ScrollPlotProvider::*)(SampleView const&);
+
+  template <typename T> void pushValue(T value);
+  template <typename T> void pushSample(SampleView const& sample);
 
   int                  sampleCount_ = 50;
   std::span<std::byte> mappedData_;
   size_t               currentOffset_ = 0;
-  size_t               readIndex_ = 0;
-  QVariant             lastValue_;
+  size_t               readIndex_     = 0;
+  QMetaType::Type      tid_           = QMetaType::UnknownType;
+  PushFn               pushSample_    = nullptr; // typed once, not per sample
 };
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <QMetaType>
+#include <QObject>
+#include <QtQmlIntegration>
+
+#include <cstdint>
+#include <span>
+
+class Variable;
+
+// Drives a simulated memory location with a periodic waveform.
+//
+// The location is either the variable `name` (resolved through the Debugger) or a raw `address`.
+// Arrays get `count` consecutive samples, `interval` seconds apart. Integer formats get the
+// nearest value of their range.
+class SignalGenerator : public QObject
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString name READ name WRITE setName NOTIFY changed)
+  Q_PROPERTY(quint64 address READ address WRITE setAddress NOTIFY changed)
+  Q_PROPERTY(Format format READ format WRITE setFormat NOTIFY changed)
+  Q_PROPERTY(int count READ count WRITE setCount NOTIFY changed)
+  Q_PROPERTY(Waveform waveform READ waveform WRITE setWaveform NOTIFY changed)
+  Q_PROPERTY(double frequency READ frequency WRITE setFrequency NOTIFY changed)
+  Q_PROPERTY(double amplitude READ amplitude WRITE setAmplitude NOTIFY changed)
+  Q_PROPERTY(double offset READ offset WRITE setOffset NOTIFY changed)
+  Q_PROPERTY(double phase READ phase WRITE setPhase NOTIFY changed)
+  Q_PROPERTY(double interval READ interval WRITE setInterval NOTIFY changed)
+
+public:
+  enum class Waveform
+  {
+    Constant,
+    Sine,
+    Square,
+    Triangle,
+    Sawtooth,
+    Counter,
+    Noise,
+  };
+  Q_ENUM(Waveform)
+
+  enum class Format
+  {
+    Auto   = QMetaType::UnknownType, // from the variable type
+    Int8   = QMetaType::Char,
+    UInt8  = QMetaType::UChar,
+    Int16  = QMetaType::Short,
+    UInt16 = QMetaType::UShort,
+    Int32  = QMetaType::Int,
+    UInt32 = QMetaType::UInt,
+    Int64  = QMetaType::LongLong,
+    UInt64 = QMetaType::ULongLong,
+    Float  = QMetaType::Float,
+    Double = QMetaType::Double,
+  };
+  Q_ENUM(Format)
+
+  // Immutable copy of the generator settings, evaluated on the probe's thread
+  struct State
+  {
+    uint64_t        address   = 0;
+    QMetaType::Type type      = QMetaType::UnknownType;
+    size_t          count     = 1;
+    Waveform        waveform  = Waveform::Sine;
+    double          frequency = 1.0;
+    double          amplitude = 1.0;
+    double          offset    = 0.0;
+    double          phase     = 0.0;
+    double          interval  = 0.0;
+
+    size_t size() const noexcept;
+    bool   valid() const noexcept
+    {
+      return type != QMetaType::UnknownType and count != 0;
+    }
+
+    // Value of the waveform at `t` seconds
+    double valueAt(double t) const noexcept;
+
+    // Renders the samples at `t` seconds into `out` (size() bytes)
+    void render(double t, std::span<std::byte> out) const noexcept;
+  };
+
+  using QObject::QObject;
+
+  QString const& name() const noexcept
+  {
+    return name_;
+  }
+  quint64 address() const noexcept
+  {
+    return address_;
+  }
+  Format format() const noexcept
+  {
+    return format_;
+  }
+  int count() const noexcept
+  {
+    return count_;
+  }
+  Waveform waveform() const noexcept
+  {
+    return waveform_;
+  }
+  // Hz
+  double frequency() const noexcept
+  {
+    return frequency_;
+  }
+  double amplitude() const noexcept
+  {
+    return amplitude_;
+  }
+  double offset() const noexcept
+  {
+    return offset_;
+  }
+  // Fraction of period
+  double phase() const noexcept
+  {
+    return phase_;
+  }
+  // Seconds between two consecutive array elements
+  double interval() const noexcept
+  {
+    return interval_;
+  }
+
+  // Settings snapshot, resolving `name` when set; invalid if the location is unknown
+  State state() const;
+
+public slots:
+  void setName(QString const& name);
+  void setAddress(quint64 address);
+  void setFormat(Format format);
+  void setCount(int count);
+  void setWaveform(Waveform waveform);
+  void setFrequency(double frequency);
+  void setAmplitude(double amplitude);
+  void setOffset(double offset);
+  void setPhase(double phase);
+  void setInterval(double interval);
+
+signals:
+  void changed();
+
+private:
+  QString  name_;
+  quint64  address_   = 0;
+  Format   format_    = Format::Auto;
+  int      count_     = 0; // 0: from the variable type
+  Waveform waveform_  = Waveform::Sine;
+  double   frequency_ = 1.0;
+  double   amplitude_ = 1.0;
+  double   offset_    = 0.0;
+  double   phase_     = 0.0;
+  double   interval_  = 0.0;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractProbe.hpp>
+#include <QMcu/Debug/SignalGenerator.hpp>
+
+#include <QQmlListProperty>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+// In-process target: a sparse memory image driven by signal generators.
+//
+// Memory is seeded from the loaded ELF sections (initialized globals read their initial values),
+// reads back zeros elsewhere and keeps whatever is written to it. Generators overwrite their
+// location with a fresh sample whenever it is read. `latency` and `bandwidth` emulate the cost of
+// a real link, so that the whole acquisition pipeline can be load-tested without hardware.
+class SimulatedProbe : public AbstractProbe
+{
+  Q_OBJECT
+  QML_ELEMENT
+  Q_CLASSINFO("DefaultProperty", "generators")
+
+  Q_PROPERTY(QQmlListProperty<SignalGenerator> generators READ generators NOTIFY generatorsChanged)
+  Q_PROPERTY(double latency READ latency WRITE setLatency NOTIFY latencyChanged)
+  Q_PROPERTY(double bandwidth READ bandwidth WRITE setBandwidth NOTIFY bandwidthChanged)
+  Q_PROPERTY(bool loadSections READ loadSections WRITE setLoadSections NOTIFY loadSectionsChanged)
+
+public:
+  SimulatedProbe(QObject* parent = nullptr);
+  virtual ~SimulatedProbe();
+
+  Capabilities capabilities() const noexcept override
+  {
+    return CapabilityBits::Write | CapabilityBits::NonIntrusive | CapabilityBits::BatchRead;
+  }
+
+  QQmlListProperty<SignalGenerator> generators();
+
+  void addGenerator(SignalGenerator* generator);
+  void removeGenerator(SignalGenerator* generator);
+
+  // Microseconds per round trip
+  double latency() const noexcept
+  {
+    return latencyNs_.load(std::memory_order_relaxed) / 1e3;
+  }
+  // Bytes per second, 0 for unlimited
+  double bandwidth() const noexcept
+  {
+    return bandwidth_.load(std::memory_order_relaxed);
+  }
+  bool loadSections() const noexcept
+  {
+    return loadSections_;
+  }
+
+  // Seconds elapsed since the probe creation, as seen by the generators
+  double time() const noexcept;
+
+public slots:
+  void setLatency(double latency);
+  void setBandwidth(double bandwidth);
+  void setLoadSections(bool load);
+
+  // Re-evaluates the generator locations and settings
+  void updateGenerators();
+  // Resets memory to the target sections
+  void reloadImage();
+
+signals:
+  void generatorsChanged();
+  void latencyChanged();
+  void bandwidthChanged();
+  void loadSectionsChanged();
+
+protected:
+  bool doRead(address_t address, std::span<std::byte> data) override;
+  bool doWrite(address_t address, std::span<std::byte const> data) override;
+  bool doReadBatch(std::span<ReadRequest const> requests) override;
+
+private:
+  static constexpr size_t pageSize_ = 4096;
+  using page_t                      = std::array<std::byte, pageSize_>;
+
+  void copyFrom(address_t address, std::span<std::byte> data);
+  void copyTo(address_t address, std::span<std::byte const> data);
+  void generate(address_t address, size_t size, double t);
+  void wait(size_t bytes) const noexcept;
+
+  QList<SignalGenerator*> generators_;
+  bool                    loadSections_ = true;
+
+  std::atomic<int64_t> latencyNs_ = 0;
+  std::atomic<double>  bandwidth_ = 0.0;
+  int64_t              epochNs_   = 0;
+
+  // guards the image and the generator states, shared by the GUI and acquisition threads
+  std::mutex                                   mutex_;
+  std::map<address_t, std::unique_ptr<page_t>> pages_;
+  std::vector<SignalGenerator::State>          states_;
+  std::vector<std::byte>                       scratch_;
+};
@@ -1,9 +1,8 @@
 #pragma once
 
-#include <QObject>
-#include <QtQmlIntegration>
+#include <QMcu/Debug/AbstractProbe.hpp>
 
-class StLinkProbe : public QObject
+class StLinkProbe : public AbstractProbe
 {
   Q_OBJECT
   QML_ELEMENT
@@ -17,7 +16,12 @@ public:
 
   static StLinkProbe* instance() noexcept
   {
-    return instance_;
+    return qobject_cast<StLinkProbe*>(AbstractProbe::instance());
+  }
+
+  Capabilities capabilities() const noexcept override
+  {
+    return CapabilityBits::Write | CapabilityBits::NonIntrusive;
   }
 
   QString const& serial() const noexcept
@@ -29,17 +33,6 @@ public:
     return speed_;
   }
 
-  using address_t = uint64_t;
-
-  bool read(address_t address, std::span<std::byte> data);
-
-  template <typename T> T read(address_t address)
-  {
-    T value;
-    read(address, std::as_writable_bytes(std::span{&value, 1}));
-    return value;
-  }
-
 public slots:
   void setSerial(QString const& serial)
   {
@@ -62,10 +55,13 @@ signals:
   void serialChanged();
   void speedChanged();
 
+protected:
+  bool doRead(address_t address, std::span<std::byte> data) override;
+  bool doWrite(address_t address, std::span<std::byte const> data) override;
+
 private:
-  static StLinkProbe* instance_;
-  QString             serial_;
-  int                 speed_ = 1000;
+  QString serial_;
+  int     speed_ = 1000;
 
   struct _stlink* sl_ = nullptr;
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QtQmlIntegration>
+
+#include <QMcu/Debug/Type.hpp>
+#include <QMcu/Debug/VariableProxy.hpp>
+
+// Samples a struct (or an array of structs) in a single read.
+//
+// The bytes are decoded into one channel per basic field, ie. "axes[1].gain": channels are
+// VariableProxy objects plots and recorders bind to as usual, refreshed along with the struct
+// instead of being read on their own.
+class StructProxy : public VariableProxy
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QStringList fields READ fields NOTIFY fieldsChanged)
+
+public:
+  explicit StructProxy(QObject* parent = nullptr);
+  virtual ~StructProxy();
+
+  // Field names, relative to the struct
+  QStringList fields() const;
+
+  // Channel of the field `name`, bound once the struct is resolved
+  Q_INVOKABLE VariableProxy* channel(QString const& name);
+
+signals:
+  void fieldsChanged();
+
+protected:
+  void publish(SampleView const& sample, bool changed) override;
+
+private:
+  struct Binding
+  {
+    Type::Field    field;
+    VariableProxy* channel = nullptr;
+  };
+
+  void bind();
+  void bind(QString const& name, VariableProxy* channel);
+
+  QList<Type::Field>             fields_;
+  QHash<QString, VariableProxy*> channels_; // by field name
+  QList<Binding>                 bindings_; // channels of existing fields
+};
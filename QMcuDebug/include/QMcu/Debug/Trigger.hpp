@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Oscilloscope-like trigger over a stream of samples, evaluated for each of them by their
+// producer (the acquisition thread).
+//
+// The last `pre` samples are kept; when the condition holds, `post` more (the triggering one
+// first) are recorded, then published with those before as one frozen Capture. Another trigger
+// is accepted once `holdoffNs` elapsed since the previous one. In Auto mode, a capture is forced
+// when nothing triggered for `autoNs`; in Single mode, the trigger disarms after a capture until
+// rearm().
+class Trigger
+{
+public:
+  enum class Edge
+  {
+    Rising,  // crosses the level upwards
+    Falling, // crosses the level downwards
+    Level,   // at or above the level
+  };
+
+  enum class Mode
+  {
+    Auto,
+    Normal,
+    Single,
+  };
+
+  struct Settings
+  {
+    Edge    edge      = Edge::Rising;
+    Mode    mode      = Mode::Normal;
+    double  level     = 0.0;
+    size_t  pre       = 100;
+    size_t  post      = 400;
+    int64_t holdoffNs = 0;
+    int64_t autoNs    = 100'000'000;
+  };
+
+  struct Capture
+  {
+    std::vector<int64_t>   times;
+    std::vector<std::byte> values;           // valueSize bytes per sample
+    size_t                 triggerIndex = 0; // of the triggering sample
+    bool                   forced       = false;
+    uint64_t               sequence     = 0; // 1 for the first capture
+
+    size_t size() const noexcept
+    {
+      return times.size();
+    }
+  };
+
+  Trigger(size_t valueSize, Settings const& settings);
+
+  size_t valueSize() const noexcept
+  {
+    return valueSize_;
+  }
+  Settings const& settings() const noexcept
+  {
+    return settings_;
+  }
+
+  // Producer side: `level` is the value compared to the settings level, `value` what is
+  // captured; returns true when it completed a capture
+  bool push(int64_t timestampNs, double level, std::span<std::byte const> value);
+
+  // Consumer side: latest capture, null before the first one
+  std::shared_ptr<Capture const> capture() const noexcept
+  {
+    return capture_.load(std::memory_order_acquire);
+  }
+
+  // Single mode: waiting for a trigger
+  bool armed() const noexcept
+  {
+    return armed_.load(std::memory_order_acquire);
+  }
+  void rearm() noexcept
+  {
+    armed_.store(true, std::memory_order_release);
+  }
+
+private:
+  bool fires(double level) const noexcept;
+  void keep(int64_t timestampNs, std::span<std::byte const> value);
+  void append(int64_t timestampNs, std::span<std::byte const> value);
+
+  const size_t   valueSize_;
+  const Settings settings_;
+
+  // pre-trigger samples, circular
+  std::vector<int64_t>   preTimes_;
+  std::vector<std::byte> preValues_;
+  size_t                 preHead_  = 0;
+  size_t                 preCount_ = 0;
+
+  double                   last_        = 0.0;
+  bool                     hasLast_     = false;
+  int64_t                  lastTrigger_ = 0;
+  bool                     triggered_   = false; // ever, for holdoff
+  int64_t                  waitingFrom_ = 0;     // Auto mode timeout
+  bool                     waiting_     = false;
+  std::unique_ptr<Capture> current_;    // being recorded
+  size_t                   remaining_ = 0;
+  uint64_t                 sequence_  = 0;
+
+  std::atomic<bool>                           armed_ = true;
+  std::atomic<std::shared_ptr<Capture const>> capture_;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractVariablePlotDataProvider.hpp>
+#include <QMcu/Debug/Trigger.hpp>
+
+#include <atomic>
+#include <memory>
+
+// Plots frozen captures of a variable around trigger events, like an oscilloscope.
+//
+// Under an Acquisition, the trigger (see Trigger) runs on the acquisition thread, on every
+// sample; without one, on every refresh of the proxy. The condition applies to the plotted value,
+// after its compiled transform if any, so it can be a derived expression. Each completed capture
+// replaces the plotted one: `preSamples` before the trigger, `postSamples` from it.
+class TriggerPlotProvider : public AbstractVariablePlotDataProvider
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(Edge edge READ edge WRITE setEdge NOTIFY settingsChanged)
+  Q_PROPERTY(Mode mode READ mode WRITE setMode NOTIFY settingsChanged)
+  Q_PROPERTY(double level READ level WRITE setLevel NOTIFY settingsChanged)
+  Q_PROPERTY(int preSamples READ preSamples WRITE setPreSamples NOTIFY settingsChanged)
+  Q_PROPERTY(int postSamples READ postSamples WRITE setPostSamples NOTIFY settingsChanged)
+  Q_PROPERTY(double holdoff READ holdoff WRITE setHoldoff NOTIFY settingsChanged)
+  Q_PROPERTY(double autoTimeout READ autoTimeout WRITE setAutoTimeout NOTIFY settingsChanged)
+  Q_PROPERTY(bool armed READ armed NOTIFY stateChanged)
+  Q_PROPERTY(quint64 captures READ captures NOTIFY stateChanged)
+  Q_PROPERTY(int triggerIndex READ triggerIndex NOTIFY stateChanged)
+
+public:
+  enum class Edge
+  {
+    Rising  = int(Trigger::Edge::Rising),
+    Falling = int(Trigger::Edge::Falling),
+    Level   = int(Trigger::Edge::Level),
+  };
+  Q_ENUM(Edge)
+
+  enum class Mode
+  {
+    Auto   = int(Trigger::Mode::Auto),
+    Normal = int(Trigger::Mode::Normal),
+    Single = int(Trigger::Mode::Single),
+  };
+  Q_ENUM(Mode)
+
+  TriggerPlotProvider(QObject* parent = nullptr);
+  virtual ~TriggerPlotProvider();
+
+  Edge edge() const noexcept
+  {
+    return Edge(settings_.edge);
+  }
+  Mode mode() const noexcept
+  {
+    return Mode(settings_.mode);
+  }
+  double level() const noexcept
+  {
+    return settings_.level;
+  }
+  int preSamples() const noexcept
+  {
+    return int(settings_.pre);
+  }
+  int postSamples() const noexcept
+  {
+    return int(settings_.post);
+  }
+  // Seconds after a trigger during which others are ignored
+  double holdoff() const noexcept
+  {
+    return settings_.holdoffNs / 1e9;
+  }
+  // Seconds without trigger after which Auto mode captures anyway
+  double autoTimeout() const noexcept
+  {
+    return settings_.autoNs / 1e9;
+  }
+
+  bool armed() const noexcept;
+  // Plotted since the settings last changed
+  quint64 captures() const noexcept
+  {
+    return captures_;
+  }
+  // Index of the triggering sample in the plotted capture
+  int triggerIndex() const noexcept
+  {
+    return triggerIndex_;
+  }
+
+  // Single mode: waits for the next trigger
+  Q_INVOKABLE void rearm();
+
+public slots:
+  void setEdge(Edge edge);
+  void setMode(Mode mode);
+  void setLevel(double level);
+  void setPreSamples(int count);
+  void setPostSamples(int count);
+  void setHoldoff(double seconds);
+  void setAutoTimeout(double seconds);
+
+signals:
+  void settingsChanged();
+  void stateChanged();
+
+protected:
+  void                     onValueChanged() final;
+  void                     onValueUnChanged() final;
+  bool                     initializePlotContext(PlotContext& ctx) final;
+  UpdateRange              update(PlotContext& ctx) final;
+  std::shared_ptr<Trigger> createTrigger(size_t valueSize) final;
+
+private:
+  void restart();
+
+  Trigger::Settings settings_;
+  quint64           captures_     = 0;
+  int               triggerIndex_ = 0;
+
+  std::atomic<std::shared_ptr<Trigger>> trigger_;
+  std::atomic<size_t>                   capacity_ = 0; // samples the mapped storage holds
+
+  // render thread
+  std::span<std::byte>                    mappedData_;
+  size_t                                  elementSize_ = 0;
+  std::shared_ptr<Trigger::Capture const> shown_;
+  size_t                                  shownCount_ = 0;
+};
@@ -5,6 +5,8 @@
 
 #include <lldb/API/LLDB.h>
 
+#include <vector>
+
 class Variable;
 
 class Type : public QObject
@@ -46,48 +48,92 @@ public:
   Q_DECLARE_FLAGS(Kind, KindBits);
   Q_FLAG(Kind)
 
+  // A struct member, with its own members if it is (an array of) structs
+  struct Member
+  {
+    QString             name;
+    size_t              offset        = 0; // bytes, within the parent struct
+    size_t              sizeBytes     = 0;
+    QMetaType::Type     elementTypeId = QMetaType::UnknownType;
+    QList<int>          extents       = {};
+    std::vector<Member> members       = {};
+  };
+
+  // A basic value within a struct, ie. "axes[1].gain"
+  struct Field
+  {
+    QString         name;
+    size_t          offset = 0; // bytes, within the variable
+    QMetaType::Type typeId = QMetaType::UnknownType;
+    size_t          size   = 0;
+  };
+
+  // What a Type describes, resolved by LLDB or read from the symbol index
+  struct Layout
+  {
+    QString             name;
+    Kind                kind          = KindBits::Invalid;
+    size_t              sizeBytes     = 0;
+    size_t              align         = 0;
+    QMetaType::Type     elementTypeId = QMetaType::UnknownType; // basic (element) type, if any
+    size_t              elementSize   = 0;
+    QList<int>          extents;
+    std::vector<Member> members; // of the struct, or of the structs it is an array of
+  };
+
+  // Flattens the basic values of a struct (or array of structs) into a table: nested structs
+  // are expanded, as well as every element of the arrays, up to `maxFields` fields
+  static QList<Field> compile(Layout const& layout, qsizetype maxFields = 4096);
+
   Type(lldb::SBType type, Variable* parent);
+  Type(Layout layout, Variable* parent);
   virtual ~Type() = default;
 
-  QString name();
+  QString name()
+  {
+    return layout_.name;
+  }
 
   inline Kind kind() const noexcept
   {
-    return kind_;
+    return layout_.kind;
   }
 
-  inline bool isBasic()
+  // A single basic value (enumerations included)
+  inline bool isBasic() const noexcept
   {
-    return canonicalBasicType() != lldb::eBasicTypeInvalid;
+    return not isArray() and layout_.elementTypeId != QMetaType::UnknownType;
   }
 
-  inline lldb::BasicType canonicalBasicType()
+  inline bool isArray() const noexcept
   {
-    if(isEnum())
-    {
-      return elementType_.GetCanonicalType().GetEnumerationIntegerType().GetBasicType();
-    }
-    return type_.GetCanonicalType().GetBasicType();
+    return (layout_.kind & KindBits::Array) != 0;
+  }
+
+  inline bool isEnum() const noexcept
+  {
+    return (layout_.kind & KindBits::Enumeration) != 0;
   }
 
-  inline bool isArray()
+  // Structs and arrays of structs, read at once and decoded field by field
+  inline bool hasFields() const noexcept
   {
-    return (kind_ & KindBits::Array) != 0;
+    return not fields_.isEmpty();
   }
 
-  inline bool isEnum()
+  inline QList<Field> const& fields() const noexcept
   {
-    return (kind_ & KindBits::Enumeration) != 0;
+    return fields_;
   }
 
-  inline size_t sizeBytes() noexcept
+  inline size_t sizeBytes() const noexcept
   {
-    return type_.GetByteSize();
+    return layout_.sizeBytes;
   }
 
-  inline size_t align() noexcept
+  inline size_t align() const noexcept
   {
-    return type_.GetByteAlign();
+    return layout_.align;
   }
 
   static QMetaType::Type getQtType(lldb::SBType& type)
@@ -143,27 +189,22 @@ public:
     }
   }
 
-  inline lldb::SBType& elementType() noexcept
-  {
-    return elementType_;
-  }
-
-  inline QMetaType::Type elementTypeId()
+  inline QMetaType::Type elementTypeId() const noexcept
   {
-    return getQtType(elementType_);
+    return layout_.elementTypeId;
   }
 
-  inline size_t elementSize() noexcept
+  inline size_t elementSize() const noexcept
   {
-    return elementType_.GetByteSize();
+    return layout_.elementSize;
   }
 
-  inline QList<int> const& extents() noexcept
+  inline QList<int> const& extents() const noexcept
   {
-    return extents_;
+    return layout_.extents;
   }
 
-  inline size_t size() noexcept
+  inline size_t size() const noexcept
   {
     if(isArray())
     {
@@ -178,10 +219,8 @@ public:
 
 private:
   inline Variable* variable();
-  lldb::SBType     type_;
-  lldb::SBType     elementType_;
-  QList<int>       extents_;
-  Kind             kind_ = KindBits::Invalid;
+  Layout           layout_;
+  QList<Field>     fields_;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Type::Kind)
@@ -7,8 +7,12 @@
 
 #include <lldb/API/LLDB.h>
 
+#include <QMcu/Debug/Sample.hpp>
 #include <QMcu/Debug/Type.hpp>
 
+#include <array>
+#include <vector>
+
 class Debugger;
 
 class Variable : public QObject
@@ -29,6 +33,8 @@ class Variable : public QObject
 
 public:
   Variable(lldb::SBValue value, Debugger* parent);
+  // Without LLDB: `address` as seen by the probe, `layout` from the symbol index
+  Variable(QString name, uint64_t address, Type::Layout layout, Debugger* parent);
   virtual ~Variable() = default;
 
   bool isResolved() noexcept
@@ -58,10 +64,29 @@ public:
 
   qreal readAsReal();
 
-  inline QVariant const& read() noexcept
+  // Reads the variable; the buffers holding the last value and the one before are swapped when
+  // the value changed
+  bool load();
+
+  // Whether the last load() read a different value than the one before
+  bool changed() const noexcept
+  {
+    return changed_;
+  }
+
+  // Last value loaded, valid until the next load()
+  SampleView sample() const noexcept;
+  // Value before the last change
+  SampleView previousSample() const noexcept;
+
+  // Memory range fetched by load() once resolved
+  uint64_t loadAddress() const noexcept
+  {
+    return loadAddress_;
+  }
+  size_t loadSize() const noexcept
   {
-    loadValue_(local_);
-    return local_;
+    return loadSize_;
   }
 
   uint64_t arrayElementCount() const noexcept
@@ -102,12 +127,21 @@ signals:
   void resolved();
 
 private:
-  inline Debugger*               debugger();
-  void                           resolve();
-  lldb::SBValue                  value_;
-  QVariant                       local_;
-  QVariant                       cache_;
-  std::function<bool(QVariant&)> loadValue_;
-  uint64_t                       arrayElementCount_  = std::numeric_limits<uint64_t>::max();
-  uint64_t                       arrayElementOffset_ = 0;
+  using ByteSpan = std::span<std::byte>;
+
+  inline Debugger*                      debugger();
+  void                                  resolve();
+  lldb::SBValue                         value_; // invalid without LLDB
+  QString                               name_;
+  uint64_t                              address_            = 0;
+  std::function<bool(ByteSpan)>         loadValue_;
+  std::array<std::vector<std::byte>, 2> samples_; // last value and the one before
+  size_t                                front_              = 0; // index of the last value
+  bool                                  changed_            = false;
+  std::vector<DirtyRange>               dirty_; // of the last value, from the one before
+  SampleView                            sample_; // type of the samples
+  uint64_t                              arrayElementCount_  = std::numeric_limits<uint64_t>::max();
+  uint64_t                              arrayElementOffset_ = 0;
+  uint64_t                              loadAddress_        = 0;
+  size_t                                loadSize_           = 0;
 };
@@ -6,9 +6,18 @@
 
 #include <QMcu/Debug/Variable.hpp>
 #include <QMcu/Debug/VariableProxyGroup.hpp>
+#include <QMcu/Plot/Expression.hpp>
+
+#include <memory>
+
+class StructProxy;
+class TransformReferences;
 
 class VariableProxy : public QObject
 {
+  friend VariableProxyGroup;
+  friend StructProxy;
+
   Q_OBJECT
   QML_ELEMENT
 
@@ -17,10 +26,12 @@ class VariableProxy : public QObject
   Q_PROPERTY(QVariant value READ value NOTIFY valueChanged)
   Q_PROPERTY(QJSValue transform READ transform WRITE setTransform NOTIFY transformChanged)
   Q_PROPERTY(VariableProxyGroup* group READ group WRITE setGroup NOTIFY groupChanged)
+  Q_PROPERTY(double rate READ rate WRITE setRate NOTIFY rateChanged)
+  Q_PROPERTY(int priority READ priority WRITE setPriority NOTIFY priorityChanged)
 
 public:
   explicit VariableProxy(QObject* parent = nullptr);
-  virtual ~VariableProxy() = default;
+  virtual ~VariableProxy();
 
   QString const& name() const noexcept
   {
@@ -32,9 +43,26 @@ public:
     return variable_;
   }
 
-  QVariant const& value() const noexcept
+  // Boxed on demand, for QML
+  QVariant const& value() const;
+
+  // Last value, unboxed: what plot providers consume (valid until the next refresh). With a
+  // transform, basic values are the transformed value as a double; arrays are left as read, only
+  // `value` goes through a JS transform
+  SampleView const& sample() const noexcept
   {
-    return value_;
+    return sample_;
+  }
+
+  // Type of the samples, known once the variable is resolved
+  QMetaType::Type sampleType() noexcept;
+
+  // Zero-copy refreshes: `reader` is called instead of loading the variable, to read it straight
+  // into the consumer's storage. The proxy then publishes no value, only triggered()
+  void setDirectReader(std::function<void()> reader);
+  bool isDirect() const noexcept
+  {
+    return directReader_ != nullptr;
   }
 
   Q_INVOKABLE int readInt8() const noexcept
@@ -87,18 +115,46 @@ public:
     return variable_->read<double>().value_or(0);
   }
 
+  // A JS function, or an expression string (see Expression) compiled once: the fast path, that
+  // acquisition threads can also run. The other variables an expression reads are loaded along
+  // with the sample, and count as 0 until resolved
   QJSValue const& transform() const noexcept
   {
     return transform_;
   }
 
+  // Compiled transform, null without one or with a JS function
+  std::shared_ptr<Expression const> expression() const noexcept
+  {
+    return expression_;
+  }
+
+  bool hasTransform() const noexcept
+  {
+    return expression_ != nullptr or transform_.isCallable();
+  }
+
   VariableProxyGroup* group() noexcept;
 
+  // Samples per second within its group, 0 to follow the group rate
+  double rate() const noexcept
+  {
+    return rate_;
+  }
+
+  // Higher priorities are served first when the link is saturated
+  int priority() const noexcept
+  {
+    return priority_;
+  }
+
 public slots:
   void update();
   void setName(QString const& name);
   void setTransform(QJSValue const& fn);
   void setGroup(VariableProxyGroup* group);
+  void setRate(double rate);
+  void setPriority(int priority);
 
 signals:
   void nameChanged();
@@ -109,16 +165,38 @@ signals:
   void transformChanged();
   void triggered();
   void groupChanged();
+  void rateChanged();
+  void priorityChanged();
+  void directChanged();
 
 private slots:
   void refresh();
 
+protected:
+  // Publishes a value read from the variable, `changed` if it differs from the previous one
+  virtual void publish(SampleView const& sample, bool changed);
+
 private:
   static inline Debugger* debugger() noexcept;
 
-  QString             name_;
-  QJSValue            transform_;
-  Variable*           variable_ = nullptr;
-  VariableProxyGroup* group_    = nullptr;
-  QVariant            value_;
+  // Runs the compiled transform over a basic sample
+  double evaluate(SampleView const& sample);
+
+  QString                              name_;
+  QJSValue                             transform_;
+  std::shared_ptr<Expression const>    expression_;
+  std::unique_ptr<TransformReferences> references_; // looked up with the variable
+  std::vector<double>                  inputs_;
+  Variable*                            variable_    = nullptr;
+  VariableProxyGroup*                  group_       = nullptr;
+  SampleView                           sample_;
+  std::function<void()>                directReader_;
+  double                               transformed_ = 0.0; // backs sample_ with a transform
+  mutable QVariant                     value_;
+  mutable bool                         boxed_       = false; // value_ is up to date
+  bool                                 published_   = false;
+  bool                                 warned_      = false; // about an unresolved reference
+  double                               rate_        = 0.0;
+  int                                  priority_    = 0;
+  int64_t                              nextDueNs_   = 0; // scheduled by the group
 };
@@ -2,32 +2,120 @@
 
 #include <QObject>
 #include <QQmlListProperty>
+#include <QTimer>
 #include <QtQmlIntegration>
 
+#include <memory>
+
+class AbstractProbe;
+class GroupRecorder;
 class VariableProxy;
+class ReadPlan;
+class SampleScheduler;
+
+// Refreshes a set of proxies with coalesced reads.
+//
+// Each update() is a tick: proxies whose rate is due are served by priority, within the byte
+// budget the probe's measured bandwidth allows for a tick. `load` reports the requested
+// bandwidth relative to what the link delivers. When `running`, ticks are driven internally at
+// the fastest requested rate; otherwise update() is expected to be called (ie. by a Timer).
 
 class VariableProxyGroup : public QObject
 {
+  friend GroupRecorder;
+
   Q_OBJECT
   QML_ELEMENT
   // Q_CLASSINFO("DefaultProperty", "proxies")
 
   Q_PROPERTY(QQmlListProperty<VariableProxy> proxies READ proxies NOTIFY proxiesChanged)
+  Q_PROPERTY(int coalesceGap READ coalesceGap WRITE setCoalesceGap NOTIFY coalesceGapChanged)
+  Q_PROPERTY(int transferCount READ transferCount NOTIFY transferCountChanged)
+  Q_PROPERTY(double rate READ rate WRITE setRate NOTIFY rateChanged)
+  Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
+  Q_PROPERTY(double load READ load NOTIFY loadChanged)
+  Q_PROPERTY(bool overloaded READ overloaded NOTIFY loadChanged)
+  Q_PROPERTY(quint64 skippedSamples READ skippedSamples NOTIFY loadChanged)
 
 public:
   explicit VariableProxyGroup(QObject* parent = nullptr);
+  virtual ~VariableProxyGroup();
 
   QQmlListProperty<VariableProxy> proxies();
 
   void addProxy(VariableProxy* proxy);
   void removeProxy(VariableProxy* proxy);
 
+  // Maximum byte gap between two variables fetched within the same transfer
+  int coalesceGap() const noexcept
+  {
+    return coalesceGap_;
+  }
+
+  // Number of transfers issued per update
+  int transferCount() const noexcept
+  {
+    return transferCount_;
+  }
+
+  // Samples per second of the proxies without their own rate
+  double rate() const noexcept
+  {
+    return rate_;
+  }
+  bool running() const noexcept
+  {
+    return timer_.isActive();
+  }
+
+  // Requested bandwidth over the measured link bandwidth
+  double load() const noexcept
+  {
+    return load_;
+  }
+  bool overloaded() const noexcept
+  {
+    return load_ > 1.0;
+  }
+  // Due samples postponed because the link was saturated
+  quint64 skippedSamples() const noexcept;
+
 public slots:
   void update();
+  void setCoalesceGap(int gap);
+  void setRate(double rate);
+  void setRunning(bool running);
 
 signals:
   void proxiesChanged();
+  void coalesceGapChanged();
+  void transferCountChanged();
+  void rateChanged();
+  void runningChanged();
+  void loadChanged();
+  // After each tick, once its due proxies published their values
+  void refreshed();
 
 private:
-  QList<VariableProxy*> proxies_;
+  void invalidatePlan() noexcept
+  {
+    planDirty_ = true;
+  }
+  void compilePlan(QList<VariableProxy*> const& proxies);
+  void schedule(AbstractProbe& probe);
+  void refresh(AbstractProbe& probe, QList<VariableProxy*> due);
+  void updateTimer();
+
+  QList<VariableProxy*>            proxies_;
+  std::unique_ptr<ReadPlan>        plan_;
+  std::unique_ptr<SampleScheduler> scheduler_;
+  QList<VariableProxy*>            due_;
+  QList<VariableProxy*>            planned_;
+  QTimer                           timer_;
+  bool                             planDirty_     = true;
+  int                              coalesceGap_   = 256;
+  int                              transferCount_ = 0;
+  double                           rate_          = 10.0;
+  double                           load_          = 0.0;
+  int64_t                          lastTickNs_    = 0;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SymbolIndex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+class ElfFile;
+
+// Global variables described by the DWARF (versions 2 to 5) of an ELF file.
+//
+// Covers what can be watched: variables with a static address, at file or namespace scope,
+// with base, enumeration, struct, union, array, typedef and qualified types. Compilation units
+// are parsed independently, in parallel, and a type is only decoded when a variable uses it.
+//
+// Variables the linker dropped keep their debug information: when the symbol table lists
+// objects, only the variables found at one of their addresses are kept.
+class DwarfReader
+{
+public:
+  explicit DwarfReader(ElfFile const& elf);
+
+  // False without (uncompressed) debug information
+  bool isValid() const noexcept
+  {
+    return not sections_.info.empty() and not sections_.abbrev.empty();
+  }
+
+  // Variables and their members, as stored in a SymbolIndex
+  std::vector<SymbolIndex::Symbol> globals(size_t threads = std::thread::hardware_concurrency())
+      const;
+
+  struct Sections
+  {
+    std::span<std::byte const> info;
+    std::span<std::byte const> abbrev;
+    std::span<std::byte const> str;
+    std::span<std::byte const> lineStr;
+    std::span<std::byte const> strOffsets;
+    std::span<std::byte const> addr;
+  };
+
+private:
+  Sections              sections_;
+  std::vector<uint64_t> objects_; // sorted addresses of the symbol table objects
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class QFile;
+
+// Read-only view of a little-endian ELF file (32 or 64 bits), mapped in memory.
+//
+// Only what is needed to find variables without LLDB: the sections, the symbol table and the
+// GNU build-id.
+class ElfFile
+{
+public:
+  struct Section
+  {
+    std::string_view name;
+    uint32_t         type    = 0;
+    uint64_t         flags   = 0;
+    uint64_t         address = 0;
+    uint64_t         offset  = 0;
+    uint64_t         size    = 0;
+    uint32_t         link    = 0;
+
+    bool isAllocated() const noexcept
+    {
+      return (flags & 0x2) != 0; // SHF_ALLOC
+    }
+    bool isCompressed() const noexcept
+    {
+      return (flags & 0x800) != 0; // SHF_COMPRESSED
+    }
+    bool hasContents() const noexcept
+    {
+      return type != 8; // SHT_NOBITS
+    }
+  };
+
+  struct Symbol
+  {
+    std::string_view name;
+    uint64_t         address = 0;
+    uint64_t         size    = 0;
+    uint8_t          type    = 0; // STT_*
+    uint16_t         section = 0; // 0 when undefined
+
+    bool isObject() const noexcept
+    {
+      return type == 1; // STT_OBJECT
+    }
+  };
+
+  ElfFile();
+  ~ElfFile();
+
+  bool open(QString const& path);
+  void close();
+
+  bool isOpen() const noexcept
+  {
+    return file_ != nullptr;
+  }
+
+  // 4 or 8 bytes
+  size_t addressSize() const noexcept
+  {
+    return is64_ ? 8 : 4;
+  }
+  uint16_t machine() const noexcept
+  {
+    return machine_;
+  }
+  // As in the target triple (ie. "arm", "x86_64")
+  QString architecture() const;
+
+  std::span<Section const> sections() const noexcept
+  {
+    return sections_;
+  }
+  Section const* section(std::string_view name) const noexcept;
+
+  // Empty for sections without contents in the file
+  std::span<std::byte const> contents(Section const& section) const noexcept;
+
+  // Defined symbols of the symbol table
+  std::vector<Symbol> symbols() const;
+
+  // Uppercase hexadecimal, empty without a build-id note
+  std::string buildId() const;
+
+private:
+  std::unique_ptr<QFile>     file_;
+  std::span<std::byte const> data_;
+  bool                       is64_    = false;
+  uint16_t                   machine_ = 0;
+  std::vector<Section>       sections_;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+constexpr bool is_aligned(std::integral auto addr, std::size_t alignment) noexcept
+{
+  return (addr & (alignment - 1)) == 0;
+}
+
+constexpr auto align_up(std::integral auto addr, std::size_t alignment) noexcept
+{
+  return (addr + alignment - 1) & ~(alignment - 1);
+}
+
+constexpr auto align_down(std::integral auto addr, std::size_t alignment) noexcept
+{
+  return addr & ~(alignment - 1);
+}
+
+// A memory access backend exposing the three primitives debug adapters usually provide:
+//  - readWord:    a single aligned 32-bit access (one round trip per word)
+//  - readBlock32: a block read of aligned words, up to maxBlock32 bytes per transfer
+//  - readBlock8:  a byte-wise block read, up to maxBlock8 bytes per transfer
+template <typename Backend>
+concept memory_access_backend_c = requires(Backend&              backend,
+                                           uint32_t              address,
+                                           uint32_t&             word,
+                                           std::span<std::byte>  data) {
+  { backend.readWord(address, word) } -> std::same_as<bool>;
+  { backend.readBlock32(address, data) } -> std::same_as<bool>;
+  { backend.readBlock8(address, data) } -> std::same_as<bool>;
+  { Backend::maxBlock32 } -> std::convertible_to<std::size_t>;
+  { Backend::maxBlock8 } -> std::convertible_to<std::size_t>;
+};
+
+static constexpr std::size_t word_alignment = sizeof(uint32_t);
+
+// Reads data one 32-bit word at a time (one round trip per word).
+template <memory_access_backend_c Backend>
+bool word_read(Backend& backend, uint64_t address, std::span<std::byte> data)
+{
+  const auto   first  = align_down(address, word_alignment);
+  const size_t skip   = address - first;
+  size_t       offset = 0;
+
+  for(auto addr = first; offset < data.size_bytes(); addr += word_alignment)
+  {
+    uint32_t value = 0;
+    if(not backend.readWord(uint32_t(addr), value))
+    {
+      return false;
+    }
+    const size_t from  = (addr == first) ? skip : 0;
+    const size_t count = std::min(word_alignment - from, data.size_bytes() - offset);
+    std::memcpy(data.data() + offset, reinterpret_cast<std::byte*>(&value) + from, count);
+    offset += count;
+  }
+  return true;
+}
+
+// Reads data with as few transfers as possible:
+//  - accesses contained in a single word use one word read,
+//  - unaligned heads and tails use byte-wise block reads,
+//  - the aligned body is split into maxBlock32 transfers.
+// Falls back to word reads for any block transfer the backend rejects.
+template <memory_access_backend_c Backend>
+bool block_read(Backend& backend, uint64_t address, std::span<std::byte> data)
+{
+  if(data.empty())
+  {
+    return true;
+  }
+
+  const uint64_t end = address + data.size_bytes();
+  if(align_down(address, word_alignment) == align_down(end - 1, word_alignment))
+  {
+    return word_read(backend, address, data);
+  }
+
+  const auto read8 = [&](uint64_t addr, std::span<std::byte> chunk)
+  {
+    for(size_t done = 0; done < chunk.size_bytes(); done += Backend::maxBlock8)
+    {
+      auto part = chunk.subspan(done, std::min(Backend::maxBlock8, chunk.size_bytes() - done));
+      if(not backend.readBlock8(uint32_t(addr + done), part)
+         and not word_read(backend, addr + done, part))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const uint64_t body_begin = std::min(align_up(address, word_alignment), end);
+  const uint64_t body_end   = std::max(align_down(end, word_alignment), body_begin);
+
+  if(body_begin == body_end)
+  {
+    // no aligned word in between, a single byte-wise transfer does it
+    return read8(address, data);
+  }
+
+  if(body_begin != address and not read8(address, data.first(body_begin - address)))
+  {
+    return false;
+  }
+
+  for(uint64_t addr = body_begin; addr < body_end; addr += Backend::maxBlock32)
+  {
+    const size_t count = std::min<uint64_t>(Backend::maxBlock32, body_end - addr);
+    auto         chunk = data.subspan(addr - address, count);
+    if(not backend.readBlock32(uint32_t(addr), chunk) and not word_read(backend, addr, chunk))
+    {
+      return false;
+    }
+  }
+
+  if(body_end != end and not read8(body_end, data.last(end - body_end)))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+// A memory write backend exposing block writes:
+//  - writeBlock32: a block write of aligned words, up to maxBlock32 bytes per transfer
+//  - writeBlock8:  a byte-wise block write, up to maxBlock8 bytes per transfer
+template <typename Backend>
+concept memory_write_backend_c = requires(Backend&                    backend,
+                                          uint32_t                    address,
+                                          std::span<std::byte const>  data) {
+  { backend.writeBlock32(address, data) } -> std::same_as<bool>;
+  { backend.writeBlock8(address, data) } -> std::same_as<bool>;
+  { Backend::maxBlock32 } -> std::convertible_to<std::size_t>;
+  { Backend::maxBlock8 } -> std::convertible_to<std::size_t>;
+};
+
+// Writes data with byte-wise transfers for the unaligned head and tail, and maxBlock32 transfers
+// for the aligned body.
+template <memory_write_backend_c Backend>
+bool block_write(Backend& backend, uint64_t address, std::span<std::byte const> data)
+{
+  const auto write8 = [&](uint64_t addr, std::span<std::byte const> chunk)
+  {
+    for(size_t done = 0; done < chunk.size_bytes(); done += Backend::maxBlock8)
+    {
+      auto part = chunk.subspan(done, std::min(Backend::maxBlock8, chunk.size_bytes() - done));
+      if(not backend.writeBlock8(uint32_t(addr + done), part))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const uint64_t end        = address + data.size_bytes();
+  const uint64_t body_begin = std::min(align_up(address, word_alignment), end);
+  const uint64_t body_end   = std::max(align_down(end, word_alignment), body_begin);
+
+  if(body_begin == body_end)
+  {
+    return write8(address, data);
+  }
+
+  if(body_begin != address and not write8(address, data.first(body_begin - address)))
+  {
+    return false;
+  }
+
+  for(uint64_t addr = body_begin; addr < body_end; addr += Backend::maxBlock32)
+  {
+    const size_t count = std::min<uint64_t>(Backend::maxBlock32, body_end - addr);
+    if(not backend.writeBlock32(uint32_t(addr), data.subspan(addr - address, count)))
+    {
+      return false;
+    }
+  }
+
+  return body_end == end or write8(body_end, data.last(end - body_end));
+}
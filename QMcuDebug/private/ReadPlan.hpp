@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractProbe.hpp>
+
+#include <QList>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+class Variable;
+
+// Coalesces the memory ranges of several variables into as few transfers as possible.
+//
+// Ranges are sorted by address and merged into contiguous spans whenever the gap between
+// two neighbours is below `maxGap` bytes. Each span is fetched at once.
+class ReadPlan
+{
+public:
+  using reader_fn = std::function<bool(uint64_t address, std::span<std::byte> data)>;
+
+  struct Entry
+  {
+    uint64_t  address  = 0;
+    size_t    size     = 0;
+    Variable* variable = nullptr;
+  };
+
+  struct Span
+  {
+    uint64_t               address = 0;
+    std::vector<std::byte> data;
+    QList<Entry>           entries;
+    bool                   fetched = false; // by the last execute()
+
+    uint64_t end() const noexcept
+    {
+      return address + data.size();
+    }
+  };
+
+  void clear() noexcept
+  {
+    entries_.clear();
+    spans_.clear();
+    requests_.clear();
+  }
+
+  void add(Entry const& entry)
+  {
+    entries_.append(entry);
+  }
+
+  void add(Variable* variable);
+
+  // Sorts and merges entries into spans
+  void compile(size_t maxGap);
+
+  // Fetches every span; returns false if any transfer failed
+  bool execute(reader_fn const& reader);
+
+  // Same as above, with all spans fetched through a single probe batch
+  bool execute(AbstractProbe& probe);
+
+  QList<Span> const& spans() const noexcept
+  {
+    return spans_;
+  }
+
+private:
+  QList<Entry> entries_;
+  QList<Span>  spans_;
+
+  std::vector<AbstractProbe::ReadRequest> requests_;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QMcu/Debug/AbstractProbe.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Host side of a SEGGER RTT control block living in target RAM.
+//
+//   char     id[16];           // "SEGGER RTT"
+//   int32_t  maxNumUpBuffers;
+//   int32_t  maxNumDownBuffers;
+//   struct { char const* name; char* buffer; uint32_t size, writeOffset, readOffset, flags; }
+//            up[maxNumUpBuffers], down[maxNumDownBuffers];
+//
+// The target appends to the up buffers and advances `writeOffset`; the host consumes the bytes
+// up to it and writes `readOffset` back, which frees the space for the target.
+class RttControlBlock
+{
+public:
+  using address_t = AbstractProbe::address_t;
+
+  static constexpr std::string_view defaultMagic = "SEGGER RTT";
+
+  struct Channel
+  {
+    std::string name;
+    address_t   buffer     = 0;
+    uint32_t    size       = 0;
+    uint32_t    readOffset = 0;
+    uint64_t    received   = 0; // bytes
+    bool        valid      = false;
+  };
+
+  // `pointerSize` is the target's (4 on MCUs, 8 for 64 bits hosts)
+  RttControlBlock(AbstractProbe& probe, address_t address, size_t pointerSize = 4);
+
+  // Scans [begin, begin + size) for `magic`; returns the address of the control block
+  static std::optional<address_t> find(AbstractProbe&   probe,
+                                       address_t        begin,
+                                       size_t           size,
+                                       std::string_view magic = defaultMagic);
+
+  AbstractProbe& probe() const noexcept
+  {
+    return probe_;
+  }
+  address_t address() const noexcept
+  {
+    return address_;
+  }
+
+  // Reads the channel descriptors; false until the target has initialized the control block
+  bool open(std::string_view magic = defaultMagic);
+
+  bool isOpen() const noexcept
+  {
+    return not up_.empty();
+  }
+
+  std::vector<Channel> const& channels() const noexcept
+  {
+    return up_;
+  }
+
+  // Appends the bytes written to each up channel since the last poll to `data[index]`, and
+  // releases them on the target. Costs one read for the write offsets, one batch for the data
+  // and one write per channel that received something. Closes the block when it looks corrupted.
+  bool poll(std::vector<std::vector<std::byte>>& data);
+
+private:
+  size_t descriptorSize() const noexcept
+  {
+    return 2 * pointerSize_ + 4 * sizeof(uint32_t);
+  }
+  address_t descriptorAddress(size_t index) const noexcept
+  {
+    return address_ + headerSize_ + index * descriptorSize();
+  }
+  address_t pointerAt(std::span<std::byte const> bytes) const noexcept;
+  uint32_t  wordAt(std::span<std::byte const> bytes) const noexcept;
+  void      readName(Channel& channel, address_t name);
+
+  static constexpr size_t idSize_     = 16;
+  static constexpr size_t headerSize_ = idSize_ + 2 * sizeof(int32_t);
+
+  AbstractProbe&       probe_;
+  address_t            address_;
+  size_t               pointerSize_;
+  std::vector<Channel> up_;
+
+  std::vector<std::byte>                  offsets_;
+  std::vector<AbstractProbe::ReadRequest> requests_;
+};
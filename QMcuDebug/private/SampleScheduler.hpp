@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Decides which variables are sampled at each tick.
+//
+// Each task has a rate (0: every tick), a priority and a size. At each tick, the due tasks are
+// served by decreasing priority, then oldest first, until the byte budget the link can deliver
+// within a tick is spent. The other ones stay due and are counted as skipped.
+class SampleScheduler
+{
+public:
+  struct Task
+  {
+    double  rate      = 0.0; // Hz
+    int     priority  = 0;
+    size_t  size      = 0; // bytes
+    int64_t nextDueNs = 0;
+  };
+
+  // Rate of a variable within a group sampled at `groupRate`: 0 follows the group. The group
+  // ticks as fast as its fastest variable, so that the others must not be due every tick
+  static double resolveRate(double rate, double groupRate) noexcept
+  {
+    return rate > 0.0 ? rate : groupRate;
+  }
+
+  // Selects the tasks served at `nowNs` within `budget` bytes (0: unlimited) and reschedules
+  // them; returns their indices
+  std::vector<size_t> const& tick(std::span<Task> tasks, int64_t nowNs, double budget);
+
+  // Due tasks left out by the budget so far
+  size_t skipped() const noexcept
+  {
+    return skipped_;
+  }
+
+private:
+  std::vector<size_t> due_;
+  std::vector<size_t> selected_;
+  size_t              skipped_ = 0;
+};
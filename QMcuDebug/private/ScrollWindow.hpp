@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+// The last samples of a stream, in a mapped buffer of twice the window size.
+//
+// Every sample is stored twice, half a buffer apart, so that the visible window is always a
+// contiguous range whatever the write position.
+class ScrollWindow
+{
+public:
+  void reset(std::span<std::byte> storage) noexcept
+  {
+    storage_ = storage;
+    offset_  = 0;
+  }
+
+  template <typename T> void push(T value) noexcept
+  {
+    const auto data  = typed<T>();
+    const auto count = data.size() / 2;
+    if(count == 0)
+    {
+      return;
+    }
+    data[offset_]         = value;
+    data[offset_ + count] = value;
+    offset_               = (offset_ + 1) % count;
+  }
+
+  // Oldest sample first
+  template <typename T> std::span<std::byte const> visible() const noexcept
+  {
+    const auto data = typed<T>();
+    return std::as_bytes(data.subspan(offset_, data.size() / 2));
+  }
+
+private:
+  template <typename T> std::span<T> typed() const noexcept
+  {
+    return {reinterpret_cast<T*>(storage_.data()), storage_.size_bytes() / sizeof(T)};
+  }
+
+  std::span<std::byte> storage_;
+  size_t               offset_ = 0;
+};
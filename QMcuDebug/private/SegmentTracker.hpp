@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Follows a buffer split into segments the target fills one after the other, from the variable
+// the target updates when it moves to the next segment.
+//
+// Each new value of that variable tells which segments were completed since the previous one:
+// those are the ones to read, oldest first. Segments the target went over before they could be
+// read are reported as lost: exactly with a completion counter, from the elapsed time otherwise
+// (when the segment period is known).
+class SegmentTracker
+{
+public:
+  enum class Mode
+  {
+    Active,    // index of the segment being written
+    Completed, // index of the last completed segment
+    Count,     // number of segments completed so far
+  };
+
+  struct Update
+  {
+    size_t   first = 0; // segment index
+    size_t   count = 0; // consecutive segments to read, wrapping around
+    uint64_t lost  = 0; // overwritten segments, before `first`
+  };
+
+  SegmentTracker(Mode mode = Mode::Active, size_t segments = 2) noexcept
+      : mode_{mode}, segments_{segments}
+  {
+  }
+
+  Mode mode() const noexcept
+  {
+    return mode_;
+  }
+  size_t segments() const noexcept
+  {
+    return segments_;
+  }
+
+  // Forgets the previous index: the next one only synchronizes
+  void reset() noexcept
+  {
+    synchronized_ = false;
+  }
+
+  // Consumes a value of the index variable observed at `nowNs`; `periodNs` is the time the
+  // target takes to fill a segment, 0 when unknown
+  Update next(int64_t index, int64_t nowNs, int64_t periodNs = 0) noexcept;
+
+private:
+  Mode    mode_;
+  size_t  segments_;
+  bool    synchronized_ = false;
+  int64_t last_         = 0; // Active position or completion count
+  int64_t lastNs_       = 0; // time of the last completion seen
+};
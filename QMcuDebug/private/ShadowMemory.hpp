@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <vector>
+
+// Copy of target memory shared by every Variable for the duration of one tick.
+//
+// Fetched ranges are kept merged and disjoint. Reads they cover are served without probe access;
+// other reads are fetched exactly as requested (no read-ahead, since peripheral registers may
+// have read side effects) and recorded. invalidate() starts a new tick.
+class ShadowMemory
+{
+public:
+  using reader_fn = std::function<bool(uint64_t address, std::span<std::byte> data)>;
+
+  // Serves `data` from the shadow memory, fetching it through `reader` if not covered
+  bool read(uint64_t address, std::span<std::byte> data, reader_fn const& reader);
+
+  // Records memory fetched by other means (ie. read plans)
+  void fill(uint64_t address, std::span<std::byte const> data);
+
+  void invalidate() noexcept
+  {
+    ranges_.clear();
+  }
+
+  bool empty() const noexcept
+  {
+    return ranges_.empty();
+  }
+
+  size_t rangeCount() const noexcept
+  {
+    return ranges_.size();
+  }
+
+  // Reads served from the shadow memory
+  size_t hits() const noexcept
+  {
+    return hits_;
+  }
+
+  // Reads forwarded to the reader
+  size_t misses() const noexcept
+  {
+    return misses_;
+  }
+
+private:
+  std::map<uint64_t, std::vector<std::byte>> ranges_;
+  size_t                                     hits_   = 0;
+  size_t                                     misses_ = 0;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class QFile;
+
+// Global variables of an executable: address, size, basic type, array extents and the layout of
+// their members, flattened into dotted names (ie. "state.gain"). Arrays of structs describe the
+// members of their first element (ie. "axes[].gain").
+//
+// Collecting them through LLDB resolves every data symbol, which takes seconds on a large
+// firmware. The index is thus saved once per executable, keyed by its build-id, then mapped as
+// is on the next loads: entries are read from the mapped file, sorted by name.
+//
+//   Header   { char magic[8]; uint32_t version, count, extentCount, stringSize, key, keySize; }
+//   Record   records[count];     // sorted by name
+//   uint32_t extents[extentCount];
+//   char     strings[stringSize];
+class SymbolIndex
+{
+public:
+  static constexpr uint32_t version = 2;
+
+  // One variable or member
+  struct Entry
+  {
+    std::string_view          name;
+    std::string_view          typeName;
+    uint64_t                  address = 0; // file address
+    uint64_t                  size    = 0; // bytes
+    int                       type    = 0; // QMetaType id of the (element) basic type, if any
+    std::span<uint32_t const> extents;     // outermost first, empty if not an array
+    uint32_t                  depth = 0;   // 0 for globals
+
+    bool isGlobal() const noexcept
+    {
+      return depth == 0;
+    }
+  };
+
+  // Owning counterpart of Entry, to build an index
+  struct Symbol
+  {
+    std::string           name;
+    std::string           typeName;
+    uint64_t              address = 0;
+    uint64_t              size    = 0;
+    int                   type    = 0;
+    std::vector<uint32_t> extents = {};
+    uint32_t              depth   = 0;
+  };
+
+  SymbolIndex();
+  ~SymbolIndex();
+
+  // Where the index of the executable identified by `key` is cached
+  static QString cachePath(QString const& key);
+
+  // Writes `symbols` (any order, duplicated names are dropped) as the index of `key`
+  static bool save(QString const& path, std::string_view key, std::vector<Symbol> symbols);
+
+  // Maps the index saved at `path`; false if missing, corrupted or built for another key
+  bool load(QString const& path, std::string_view key);
+  void unload();
+
+  bool isLoaded() const noexcept
+  {
+    return file_ != nullptr;
+  }
+  // Entries, members included
+  size_t size() const noexcept
+  {
+    return count_;
+  }
+  Entry at(size_t index) const noexcept;
+
+  std::optional<Entry> find(std::string_view name) const noexcept;
+
+  // Indices of the members of `name`, all levels, in name order ("name[]" for the members of
+  // the elements of an array of structs)
+  std::pair<size_t, size_t> members(std::string_view name) const noexcept;
+
+  template <typename Fn> void forEachGlobal(Fn&& fn) const
+  {
+    for(size_t ii = 0; ii < count_; ++ii)
+    {
+      if(const auto entry = at(ii); entry.isGlobal())
+      {
+        fn(entry);
+      }
+    }
+  }
+
+private:
+  struct Header;
+  struct Record;
+
+  size_t lowerBound(std::string_view name) const noexcept;
+
+  std::unique_ptr<QFile>    file_;
+  Record const*             records_ = nullptr;
+  size_t                    count_   = 0;
+  std::span<uint32_t const> extents_;
+  std::string_view          strings_;
+};
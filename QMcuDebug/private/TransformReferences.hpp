@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QMcu/Debug/Variable.hpp>
+
+#include <QList>
+#include <QPointer>
+
+#include <span>
+
+// Variables a compiled transform reads besides its own.
+//
+// They are owned (unless the debugger, their parent, goes first), and loaded with every
+// evaluation: through the shadow memory, a variable that a proxy of its own already read within
+// the tick costs no probe access.
+class TransformReferences
+{
+public:
+  TransformReferences() = default;
+  TransformReferences(TransformReferences const&) = delete;
+  ~TransformReferences();
+
+  // Takes the variables, in order of the expression inputs; null for the unknown ones
+  void reset(QList<Variable*> const& variables = {});
+
+  qsizetype size() const noexcept
+  {
+    return variables_.size();
+  }
+
+  // Loads the variables into `inputs` (one each), unknown and unresolved ones as 0. Returns
+  // false if some were read as 0
+  bool load(std::span<double> inputs);
+
+private:
+  QList<QPointer<Variable>> variables_;
+};
@@ -0,0 +1,107 @@
+#include <QMcu/Debug/AbstractProbe.hpp>
+
+#include <chrono>
+
+AbstractProbe* AbstractProbe::instance_ = nullptr;
+
+namespace
+{
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+AbstractProbe::~AbstractProbe()
+{
+  if(instance_ == this)
+  {
+    instance_ = nullptr;
+  }
+}
+
+void AbstractProbe::makeInstance()
+{
+  if(instance_ != nullptr)
+  {
+    throw std::runtime_error("only one probe can be declared");
+  }
+  instance_ = this;
+}
+
+bool AbstractProbe::read(address_t address, std::span<std::byte> data)
+{
+  std::lock_guard lock{mutex_};
+  const auto      start = now_ns();
+  const bool      ok    = doRead(address, data);
+  account(start, 1, data.size_bytes(), 0, ok);
+  return ok;
+}
+
+bool AbstractProbe::write(address_t address, std::span<std::byte const> data)
+{
+  std::lock_guard lock{mutex_};
+  const auto      start = now_ns();
+  const bool      ok    = doWrite(address, data);
+  account(start, 1, 0, data.size_bytes(), ok);
+  return ok;
+}
+
+bool AbstractProbe::readBatch(std::span<ReadRequest const> requests)
+{
+  std::lock_guard lock{mutex_};
+  const auto      start = now_ns();
+  const bool      ok    = doReadBatch(requests);
+  size_t          size  = 0;
+  for(auto const& r : requests)
+  {
+    size += r.data.size_bytes();
+  }
+  const size_t transfers = hasCapability(CapabilityBits::BatchRead) ? 1 : requests.size();
+  account(start, transfers, size, 0, ok);
+  return ok;
+}
+
+bool AbstractProbe::doReadBatch(std::span<ReadRequest const> requests)
+{
+  bool ok = true;
+  for(auto const& r : requests)
+  {
+    ok = doRead(r.address, r.data) and ok;
+  }
+  return ok;
+}
+
+void AbstractProbe::account(
+    int64_t startNs, size_t transfers, size_t read, size_t written, bool ok) noexcept
+{
+  busyNs_.fetch_add(now_ns() - startNs, std::memory_order_relaxed);
+  transfers_.fetch_add(transfers, std::memory_order_relaxed);
+  bytesRead_.fetch_add(read, std::memory_order_relaxed);
+  bytesWritten_.fetch_add(written, std::memory_order_relaxed);
+  if(not ok)
+  {
+    errors_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ProbeStats AbstractProbe::stats() const noexcept
+{
+  ProbeStats stats;
+  stats.transfers    = transfers_.load(std::memory_order_relaxed);
+  stats.bytesRead    = bytesRead_.load(std::memory_order_relaxed);
+  stats.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+  stats.errors       = errors_.load(std::memory_order_relaxed);
+  stats.busyNs       = busyNs_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AbstractProbe::resetStats() noexcept
+{
+  transfers_.store(0, std::memory_order_relaxed);
+  bytesRead_.store(0, std::memory_order_relaxed);
+  bytesWritten_.store(0, std::memory_order_relaxed);
+  errors_.store(0, std::memory_order_relaxed);
+  busyNs_.store(0, std::memory_order_relaxed);
+}
@@ -1,4 +1,5 @@
 #include <QMcu/Debug/AbstractVariablePlotDataProvider.hpp>
+#include <QMcu/Debug/Acquisition.hpp>
 #include <QMcu/Debug/Debugger.hpp>
 #include <QMcu/Debug/StLinkProbe.hpp>
 #include <QMcu/Debug/Type.hpp>
@@ -42,6 +43,77 @@ AbstractVariablePlotDataProvider::AbstractVariablePlotDataProvider(QObject* pare
 {
 }
 
+AbstractVariablePlotDataProvider::~AbstractVariablePlotDataProvider()
+{
+  unsubscribe();
+}
+
+void AbstractVariablePlotDataProvider::subscribe()
+{
+  const bool subscribed = sampleRing() != nullptr;
+  unsubscribe();
+
+  if(auto* const acq = Acquisition::instance(); acq != nullptr)
+  {
+    // the proxy feeds the plot while the acquisition is stopped
+    connect(acq,
+            &Acquisition::runningChanged,
+            this,
+            &AbstractVariablePlotDataProvider::subscribe,
+            Qt::UniqueConnection);
+    if(acq->running())
+    {
+      subscribeTo(*acq);
+    }
+  }
+  if(subscribed != (sampleRing() != nullptr))
+  {
+    reinitialize(); // the samples change source, and maybe type
+  }
+}
+
+void AbstractVariablePlotDataProvider::subscribeTo(Acquisition& acq)
+{
+  auto* const var = variable();
+  if(var == nullptr or not var->isResolved())
+  {
+    return;
+  }
+
+  // compiled transforms run on the acquisition thread, JS ones cannot
+  auto       expression = proxy_->expression();
+  const auto sample     = var->sample();
+  if(sample.isArray or sample.typeId == QMetaType::UnknownType)
+  {
+    expression = nullptr;
+  }
+  else if(expression == nullptr and proxy_->transform().isCallable())
+  {
+    qWarning(lcWatcher) << name() << ": JS transforms do not apply to acquired samples";
+  }
+  sampleType_          = expression != nullptr ? QMetaType::Double : var->type()->elementTypeId();
+  const auto valueSize = expression != nullptr ? sizeof(double) : var->loadSize();
+  ring_.store(acq.subscribe(var, std::move(expression), createTrigger(valueSize)),
+              std::memory_order_release);
+  connect(&acq,
+          &Acquisition::samplesAvailable,
+          this,
+          &AbstractPlotDataProvider::dataChanged,
+          Qt::UniqueConnection);
+}
+
+void AbstractVariablePlotDataProvider::unsubscribe()
+{
+  if(auto ring = ring_.exchange(nullptr, std::memory_order_acq_rel); ring != nullptr)
+  {
+    if(auto* acq = Acquisition::instance())
+    {
+      acq->unsubscribe(ring);
+      disconnect(acq, &Acquisition::samplesAvailable, this, &AbstractPlotDataProvider::dataChanged);
+    }
+  }
+}
+
 Debugger* AbstractVariablePlotDataProvider::debugger()
 {
   return Debugger::instance();
@@ -62,6 +134,7 @@ void AbstractVariablePlotDataProvider::setProxy(VariableProxy* proxy)
   {
     disconnect(proxyValueChangedConnection_);
     disconnect(proxyValueUnChangedConnection_);
+    disconnect(proxyVariableResolvedConnection_);
     proxy_ = proxy;
     if(name().isEmpty())
     {
@@ -71,10 +144,18 @@ void AbstractVariablePlotDataProvider::setProxy(VariableProxy* proxy)
                                            &VariableProxy::valueChanged,
                                            this,
                                            &AbstractVariablePlotDataProvider::onValueChanged);
-    proxyValueChangedConnection_ = connect(proxy_,
-                                           &VariableProxy::valueUnChanged,
-                                           this,
-                                           &AbstractVariablePlotDataProvider::onValueUnChanged);
+    proxyValueUnChangedConnection_ = connect(proxy_,
+                                             &VariableProxy::valueUnChanged,
+                                             this,
+                                             &AbstractVariablePlotDataProvider::onValueUnChanged);
+    proxyVariableResolvedConnection_ = connect(proxy_,
+                                               &VariableProxy::variableResolved,
+                                               this,
+                                               &AbstractVariablePlotDataProvider::subscribe);
+    if(auto* v = variable(); v != nullptr and v->isResolved())
+    {
+      subscribe();
+    }
     emit proxyChanged();
   }
 }
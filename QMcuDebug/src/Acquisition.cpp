@@ -0,0 +1,362 @@
+#include <QMcu/Debug/Acquisition.hpp>
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/Trigger.hpp>
+#include <QMcu/Debug/Variable.hpp>
+#include <QMcu/Plot/Expression.hpp>
+
+#include <Logging.hpp>
+#include <ReadPlan.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+Acquisition* Acquisition::instance_ = nullptr;
+
+namespace
+{
+// Transformed samples are evaluated by batches of at most `batchSize` samples, and wait at most
+// `batchNs`, well under a frame: a batch is flushed when it would be older by the next tick
+constexpr size_t  batchSize = 256;
+constexpr int64_t batchNs   = 4'000'000;
+} // namespace
+
+Acquisition::Acquisition(QObject* parent) : QObject(parent)
+{
+  if(instance_ != nullptr)
+  {
+    throw std::runtime_error("Acquisition is a singleton");
+  }
+  instance_ = this;
+}
+
+Acquisition::~Acquisition()
+{
+  setRunning(false);
+  instance_ = nullptr;
+}
+
+int64_t Acquisition::nsTime() noexcept
+{
+  using namespace std::chrono;
+  static const auto t0 = steady_clock::now();
+  return duration_cast<nanoseconds>(steady_clock::now() - t0).count();
+}
+
+void Acquisition::setRate(double rate)
+{
+  if(rate != rate_ and rate > 0.0)
+  {
+    rate_ = rate;
+    periodNs_.store(int64_t(1e9 / rate_), std::memory_order_relaxed);
+    emit rateChanged();
+  }
+}
+
+void Acquisition::setRingCapacity(int capacity)
+{
+  if(capacity != ringCapacity_)
+  {
+    ringCapacity_ = capacity;
+    emit ringCapacityChanged();
+  }
+}
+
+void Acquisition::setCoalesceGap(int gap)
+{
+  if(gap != coalesceGap_)
+  {
+    {
+      std::lock_guard lock{channelsMutex_};
+      coalesceGap_ = gap;
+    }
+    channelsChanged_ = true;
+    emit coalesceGapChanged();
+  }
+}
+
+void Acquisition::setRunning(bool running)
+{
+  if(running == this->running())
+  {
+    return;
+  }
+  if(running)
+  {
+    if(auto* dbg = Debugger::instance();
+       dbg == nullptr
+       or not dbg->probe()->hasCapability(AbstractProbe::CapabilityBits::NonIntrusive))
+    {
+      qCritical(lcWatcher) << "Acquisition requires a non-intrusive probe";
+      return;
+    }
+    thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+  }
+  else
+  {
+    thread_.request_stop();
+    thread_.join();
+    thread_ = {};
+  }
+  emit runningChanged();
+}
+
+std::shared_ptr<SampleRing> Acquisition::subscribe(Variable*                         variable,
+                                                   std::shared_ptr<Expression const> expression,
+                                                   std::shared_ptr<Trigger>          trigger)
+{
+  if(variable == nullptr or not variable->isResolved())
+  {
+    return nullptr;
+  }
+  Channel channel{variable->loadAddress(), variable->loadSize()};
+  if(expression != nullptr)
+  {
+    const auto input = [](Variable* v) -> Input
+    {
+      const auto sample = v->sample();
+      if(sample.isArray)
+      {
+        return {};
+      }
+      return {v->loadAddress(), sample.elementSize, realDecoder(sample.typeId)};
+    };
+    channel.inputs.append(input(variable));
+    for(const auto& name : expression->references())
+    {
+      // only its address and type are kept
+      const std::unique_ptr<Variable> ref{Debugger::instance()->variable(name)};
+      channel.inputs.append(ref != nullptr and ref->isResolved() ? input(ref.get()) : Input{});
+    }
+    if(std::ranges::any_of(channel.inputs, [](Input const& i) { return i.decode == nullptr; }))
+    {
+      qCritical(lcWatcher) << "Cannot acquire" << expression->source() << "for"
+                           << variable->name() << ": its inputs must be basic values";
+      return nullptr;
+    }
+    channel.expression = std::move(expression);
+  }
+  if(trigger != nullptr)
+  {
+    channel.decode = channel.expression != nullptr ? realDecoder(QMetaType::Double)
+                                                   : realDecoder(variable->sample().typeId);
+    if(channel.decode == nullptr)
+    {
+      qCritical(lcWatcher) << "Cannot trigger on" << variable->name()
+                           << ": it must hold basic values";
+      return nullptr;
+    }
+    channel.trigger = std::move(trigger);
+  }
+
+  const auto valueSize = channel.expression != nullptr ? sizeof(double) : variable->loadSize();
+  auto       ring      = std::make_shared<SampleRing>(valueSize, ringCapacity_);
+  channel.ring         = ring;
+  {
+    std::lock_guard lock{channelsMutex_};
+    channels_.append(std::move(channel));
+  }
+  channelsChanged_ = true;
+  return ring;
+}
+
+void Acquisition::unsubscribe(std::shared_ptr<SampleRing> const& ring)
+{
+  {
+    std::lock_guard lock{channelsMutex_};
+    channels_.removeIf([&](Channel const& c) { return c.ring == ring; });
+  }
+  channelsChanged_ = true;
+}
+
+void Acquisition::notifySamplesAvailable()
+{
+  if(not notifyPending_.exchange(true))
+  {
+    QMetaObject::invokeMethod(
+        this,
+        [this]
+        {
+          notifyPending_ = false;
+          emit samplesAvailable();
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+void Acquisition::run(std::stop_token stop)
+{
+  using clock = std::chrono::steady_clock;
+
+  struct Slot
+  {
+    qsizetype span   = 0;
+    size_t    offset = 0;
+  };
+
+  struct Target
+  {
+    std::shared_ptr<SampleRing>       ring;
+    Slot                              value;
+    std::shared_ptr<Expression const> expression;
+    QList<Slot>                       inputs;
+    QList<RealDecoder>                decoders;
+    std::shared_ptr<Trigger>          trigger;
+    RealDecoder                       decode = nullptr;
+
+    // batched inputs of the expression, one column per input
+    std::vector<std::vector<double>> columns;
+    std::vector<int64_t>             times;
+    std::vector<double>              results;
+
+    // Returns true when something reached the consumer
+    bool push(int64_t t, std::span<std::byte const> value)
+    {
+      if(trigger != nullptr)
+      {
+        return trigger->push(t, decode(value.data()), value);
+      }
+      ring->push(t, value);
+      return true;
+    }
+
+    bool flush()
+    {
+      if(times.empty())
+      {
+        return false;
+      }
+      const std::vector<std::span<double const>> batch(columns.begin(), columns.end());
+      results.resize(times.size());
+      expression->evaluate(batch, results);
+      bool pushed = false;
+      for(size_t ii = 0; ii < times.size(); ++ii)
+      {
+        pushed |= push(times[ii], std::as_bytes(std::span{&results[ii], 1}));
+      }
+      for(auto& column : columns)
+      {
+        column.clear();
+      }
+      times.clear();
+      return pushed;
+    }
+  };
+
+  QList<Channel> channels;
+  QList<Target>  targets;
+  ReadPlan       plan;
+
+  auto* const probe = Debugger::instance()->probe();
+
+  const auto locate = [&plan](uint64_t address, size_t size)
+  {
+    auto const& spans = plan.spans();
+    for(qsizetype ii = 0; ii < spans.size(); ++ii)
+    {
+      if(address >= spans[ii].address and address + size <= spans[ii].end())
+      {
+        return Slot{ii, size_t(address - spans[ii].address)};
+      }
+    }
+    return Slot{-1};
+  };
+  const auto bytes = [&plan](Slot const& slot)
+  { return std::span<std::byte const>{plan.spans()[slot.span].data}.subspan(slot.offset); };
+
+  auto next = clock::now();
+  while(not stop.stop_requested())
+  {
+    const auto periodNs = periodNs_.load(std::memory_order_relaxed);
+    if(channelsChanged_.exchange(false))
+    {
+      for(auto& target : targets)
+      {
+        if(target.expression != nullptr)
+        {
+          target.flush();
+        }
+      }
+
+      int gap = 0;
+      {
+        std::lock_guard lock{channelsMutex_};
+        channels = channels_;
+        gap      = coalesceGap_;
+      }
+      plan.clear();
+      for(auto const& c : channels)
+      {
+        if(c.expression == nullptr)
+        {
+          plan.add({c.address, c.size});
+        }
+        for(auto const& input : c.inputs)
+        {
+          plan.add({input.address, input.size});
+        }
+      }
+      plan.compile(std::max(gap, 0));
+
+      targets.clear();
+      for(auto const& c : channels)
+      {
+        Target target{c.ring, locate(c.address, c.size), c.expression};
+        target.trigger = c.trigger;
+        target.decode  = c.decode;
+        for(auto const& input : c.inputs)
+        {
+          target.inputs.append(locate(input.address, input.size));
+          target.decoders.append(input.decode);
+        }
+        target.columns.resize(c.inputs.size());
+        if(target.value.span >= 0 and
+           std::ranges::none_of(target.inputs, [](Slot const& s) { return s.span < 0; }))
+        {
+          targets.append(std::move(target));
+        }
+      }
+    }
+
+    if(not targets.isEmpty())
+    {
+      plan.execute(*probe);
+      const auto t      = nsTime();
+      bool       pushed = false;
+      for(auto& target : targets)
+      {
+        if(target.expression == nullptr)
+        {
+          pushed |= target.push(t, bytes(target.value).first(target.ring->valueSize()));
+          continue;
+        }
+        for(qsizetype ii = 0; ii < target.inputs.size(); ++ii)
+        {
+          target.columns[ii].push_back(target.decoders[ii](bytes(target.inputs[ii]).data()));
+        }
+        target.times.push_back(t);
+        if(target.times.size() >= batchSize or t + periodNs - target.times.front() > batchNs)
+        {
+          pushed |= target.flush();
+        }
+      }
+      if(pushed)
+      {
+        notifySamplesAvailable();
+      }
+    }
+
+    const auto period = std::chrono::nanoseconds{periodNs};
+    next += period;
+    const auto now = clock::now();
+    if(now > next)
+    {
+      // cannot keep up: skip the missed ticks instead of bursting
+      lateTicks_.fetch_add((now - next) / period + 1, std::memory_order_relaxed);
+      next = now;
+    }
+    else
+    {
+      std::this_thread::sleep_until(next);
+    }
+  }
+}
@@ -4,38 +4,173 @@
 #include <QMcu/Debug/StLinkProbe.hpp>
 
 #include <Logging.hpp>
-#include <VariantUtils.hpp>
 
 #include <QtGraphs/QValueAxis>
 
 #include <QTimer>
 
+#include <cstring>
+
 #include <magic_enum/magic_enum.hpp>
 
 BufferPlotProvider::BufferPlotProvider(QObject* parent) : AbstractVariablePlotDataProvider(parent)
 {
+  // another variable, or one resolved again, may have moved: the slots read from its new address
+  connect(this,
+          &AbstractVariablePlotDataProvider::proxyChanged,
+          this,
+          [this]
+          {
+            if(proxy() == nullptr)
+            {
+              return;
+            }
+            connect(proxy(),
+                    &VariableProxy::variableChanged,
+                    this,
+                    &BufferPlotProvider::onVariableChanged,
+                    Qt::UniqueConnection);
+            connect(proxy(),
+                    &VariableProxy::variableResolved,
+                    this,
+                    &BufferPlotProvider::onVariableChanged,
+                    Qt::UniqueConnection);
+          });
+}
+
+BufferPlotProvider::~BufferPlotProvider()
+{
+  // the reader would call a dangling provider
+  if(auto* p = proxy(); p != nullptr)
+  {
+    p->setDirectReader({});
+  }
+}
+
+void BufferPlotProvider::setRow(int row)
+{
+  if(row != row_)
+  {
+    row_ = row;
+    reinitialize();
+    emit sliceChanged();
+  }
+}
+
+void BufferPlotProvider::setColumn(int column)
+{
+  if(column != column_)
+  {
+    column_ = column;
+    reinitialize();
+    emit sliceChanged();
+  }
+}
+
+void BufferPlotProvider::setInterleave(int interleave)
+{
+  if(interleave != interleave_ and interleave >= 0)
+  {
+    interleave_ = interleave;
+    reinitialize();
+    emit sliceChanged();
+  }
+}
+
+void BufferPlotProvider::setZeroCopy(bool zeroCopy)
+{
+  if(zeroCopy != zeroCopy_)
+  {
+    zeroCopy_ = zeroCopy;
+    reinitialize();
+    emit zeroCopyChanged();
+  }
+}
+
+ArraySlice BufferPlotProvider::slice(size_t elements)
+{
+  // shape of what was read: the variable may be limited to some of its rows
+  QList<int> extents;
+  if(interleave_ > 0)
+  {
+    extents = {int(elements / interleave_), interleave_};
+  }
+  else if(auto* v = variable(); v != nullptr and v->type()->isArray())
+  {
+    extents            = v->type()->extents().sliced(1);
+    const size_t inner = ArraySlice::elements(extents);
+    extents.prepend(int(inner != 0 ? elements / inner : 0));
+  }
+  else
+  {
+    extents = {int(elements)};
+  }
+
+  auto out = ArraySlice::all(extents);
+  if(row_ >= 0)
+  {
+    out     = ArraySlice::row(extents, row_);
+    extents = extents.sliced(1);
+  }
+  if(out.count == 0)
+  {
+    return out; // out of range: no column in it either
+  }
+  if(column_ >= 0)
+  {
+    const auto column = ArraySlice::column(extents, column_);
+    out               = {out.offset + column.offset, column.count, column.stride};
+  }
+  return out;
+}
+
+void BufferPlotProvider::copy(std::span<std::byte const>  data,
+                              size_t                      elementSize,
+                              std::span<DirtyRange const> dirty)
+{
+  if(elementSize == 0)
+  {
+    return;
+  }
+  const auto selected = slice(data.size() / elementSize);
+  if(not selected.fits(data.size() / elementSize))
+  {
+    return;
+  }
+  if(not synced_ or dirty.empty() or selected.stride != 1)
+  {
+    // the selected elements only, straight into the mapped storage
+    selected.gather(data, elementSize, mappedData_);
+    synced_ = true;
+    return;
+  }
+
+  // contiguous selection already holding the previous sample: only what changed
+  const size_t begin = selected.offset * elementSize;
+  const size_t end   = begin + std::min(selected.count * elementSize, mappedData_.size());
+  for(const auto& range : dirty)
+  {
+    const size_t lo = std::max(range.offset, begin);
+    const size_t hi = std::min(range.end(), end);
+    if(lo < hi)
+    {
+      std::memcpy(mappedData_.data() + (lo - begin), data.data() + lo, hi - lo);
+    }
+  }
 }
 
 void BufferPlotProvider::onValueChanged()
 {
-  if(not mappedData_.empty())
-  {
-    const auto& var = proxy()->value();
-    qVisitSomeContainer<QList, //
-                        int,
-                        int8_t,
-                        uint8_t, //
-                        int16_t,
-                        uint16_t, //
-                        int32_t,
-                        uint32_t, //
-                        int64_t,
-                        uint64_t, //
-                        float,
-                        double>(
-        var,
-        [this]<typename T>(QList<T> const& v) mutable
-        { memcpy(mappedData_.data(), v.constData(), mappedData_.size_bytes()); });
+  if(sampleRing())
+  {
+    return; // fed by the acquisition thread
+  }
+  {
+    std::lock_guard lock{slotsMutex_};
+    if(const auto& sample = proxy()->sample(); not mappedData_.empty() and sample.typeId == tid_)
+    {
+      copy(sample.bytes, sample.elementSize, sample.dirty);
+    }
   }
   dataChanged();
 }
@@ -53,40 +188,154 @@ bool BufferPlotProvider::initializePlotContext(PlotContext& ctx)
   }
   else
   {
+    // the proxy may be reading into the previous slots; its reader follows once done here
+    std::lock_guard lock{slotsMutex_};
+    mappedData_ = {};
+    slots_.reset();
+    updateDirectReader();
+
     auto const* v = p->variable();
     if(v == nullptr)
     {
       return false;
     }
 
-    const auto& var = proxy()->value();
-    const bool  ok  = qVisitSomeContainer<QList, //
-                                          int,
-                                          int8_t,
-                                          uint8_t, //
-                                          int16_t,
-                                          uint16_t, //
-                                          int32_t,
-                                          uint32_t, //
-                                          int64_t,
-                                          uint64_t, //
-                                          float,
-                                          double>(
-        var,
-        [this]<typename T>(QList<T> const& v) mutable
-        { mappedData_ = std::as_writable_bytes(createMappedStorageBuffer<T>(v.size())); });
-    if(not ok)
+    // the values pushed by the acquisition thread or read by the proxy, as they are in memory
+    auto       ring  = sampleRing();
+    const auto tid   = ring ? sampleType() : p->sampleType();
+    const auto bytes = ring ? ring->valueSize() : v->loadSize();
+
+    if(zeroCopy_ and ring == nullptr)
+    {
+      if(initializeSlots(ctx, tid, bytes))
+      {
+        tid_ = tid;
+        return true;
+      }
+      qWarning(lcWatcher) << "Copying" << name() << "samples: zero-copy needs a contiguous slice";
+    }
+
+    visitSampleType(tid,
+                    [&]<typename T>
+                    {
+                      if(const auto count = slice(bytes / sizeof(T)).count; count != 0)
+                      {
+                        mappedData_  = std::as_writable_bytes(createMappedStorageBuffer<T>(count));
+                        elementSize_ = sizeof(T);
+                      }
+                    });
+    if(mappedData_.empty())
     {
+      qWarning(lcWatcher) << "Nothing to plot for" << name();
       return false;
-      // qFatal(lcWatcher) << "cannot handle given type:" << var.typeName();
     }
 
+    tid_    = tid;
+    synced_ = false;
     std::ranges::fill(mappedData_, std::byte(0));
     return true;
   }
 }
 
+bool BufferPlotProvider::initializeSlots(PlotContext const& ctx,
+                                         QMetaType::Type    tid,
+                                         size_t             bytes)
+{
+  auto* const var = variable();
+  visitSampleType(tid,
+                  [&]<typename T>
+                  {
+                    const auto selected = slice(bytes / sizeof(T));
+                    if(selected.count == 0 or (selected.stride != 1 and selected.count > 1))
+                    {
+                      return;
+                    }
+                    slots_ = std::make_unique<FrameSlots>(ctx.frame.inFlight);
+
+                    // slots start on 8 bytes boundaries, shaders read whole words
+                    const size_t stride = (selected.count * sizeof(T) + 7) & ~size_t(7);
+                    const auto   count  = stride / sizeof(T) * slots_->count();
+                    mappedData_  = std::as_writable_bytes(createMappedStorageBuffer<T>(count));
+                    slotAddress_ = var->loadAddress() + selected.offset * sizeof(T);
+                    slotStride_  = stride;
+                    slotSize_    = selected.count * sizeof(T);
+                    elementSize_ = sizeof(T);
+                  });
+  if(slots_ == nullptr)
+  {
+    return false;
+  }
+  std::ranges::fill(mappedData_, std::byte(0));
+  return true;
+}
+
+void BufferPlotProvider::updateDirectReader()
+{
+  // refreshes happen on the proxy's thread
+  QMetaObject::invokeMethod(this,
+                            [this]
+                            {
+                              auto* const p = proxy();
+                              if(p == nullptr)
+                              {
+                                return;
+                              }
+                              std::unique_lock lock{slotsMutex_};
+                              const bool       direct = slots_ != nullptr;
+                              lock.unlock();
+                              if(direct)
+                              {
+                                p->setDirectReader([this] { readSlot(); });
+                              }
+                              else if(p->isDirect())
+                              {
+                                // back to the samples published by the proxy
+                                p->setDirectReader({});
+                              }
+                            });
+}
+
+void BufferPlotProvider::onVariableChanged()
+{
+  if(zeroCopy_)
+  {
+    reinitialize();
+  }
+}
+
+void BufferPlotProvider::readSlot()
+{
+  std::lock_guard lock{slotsMutex_};
+  if(slots_ == nullptr)
+  {
+    return; // dropped, the reader is about to be
+  }
+  // from the probe to the GPU buffer, bypassing the shadow memory and the variable buffers
+  const auto slot = slots_->acquire();
+  if(Debugger::instance()->probe()->read(slotAddress_,
+                                          mappedData_.subspan(slot * slotStride_, slotSize_)))
+  {
+    slots_->publish(slot);
+    dataChanged();
+  }
+  else
+  {
+    slots_->release(slot);
+  }
+}
+
 BufferPlotProvider::UpdateRange BufferPlotProvider::update(PlotContext& ctx)
 {
+  if(slots_ != nullptr)
+  {
+    const auto slot = slots_->present().value_or(0);
+    return mappedData_.subspan(slot * slotStride_, slotSize_);
+  }
+  if(auto ring = sampleRing())
+  {
+    // only the most recent capture is displayed
+    ring->drainLatest([this](int64_t, std::span<std::byte const> value)
+                      { copy(value, elementSize_); });
+  }
   return ctx.vbo.full_range();
 }
\ No newline at end of file
@@ -1,28 +1,311 @@
 #include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/ProcessProbe.hpp>
 
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
 #include <QTimer>
 
+#include <DwarfReader.hpp>
+#include <ElfFile.hpp>
+#include <Logging.hpp>
+#include <ShadowMemory.hpp>
+#include <SymbolIndex.hpp>
+
+#include <chrono>
 #include <thread>
 
 #include <magic_enum/magic_enum.hpp>
 
 using namespace lldb;
 
-Debugger* Debugger::instance_ = nullptr;
+namespace
+{
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
 
-#include <Logging.hpp>
+// nested structs indexed, at most
+constexpr uint32_t max_member_depth = 8;
+
+// stop requests not serviced by then are dropped, ie. the process never stopped
+constexpr int stop_timeout_ms = 1000;
+
+// Identifies executables without a build-id
+QString file_hash(QString const& executable)
+{
+  QFile              file{executable};
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  if(file.open(QIODevice::ReadOnly) and hash.addData(&file))
+  {
+    return hash.result().toHex();
+  }
+  return {};
+}
+
+// The ELF build-id, the file content when there is none
+QString symbol_index_key(SBModule module, QString const& executable)
+{
+  if(auto const* uuid = module.GetUUIDString(); uuid != nullptr and *uuid != '\0')
+  {
+    return QString{uuid}.remove('-');
+  }
+  return file_hash(executable);
+}
+
+// Same key as symbol_index_key(), without LLDB
+QString symbol_index_key(ElfFile const& elf, QString const& executable)
+{
+  if(auto id = elf.buildId(); not id.empty())
+  {
+    return QString::fromStdString(id);
+  }
+  return file_hash(executable);
+}
+
+// QMetaType id of the elements of `type`, UnknownType if they are not basic values
+int basic_type_id(SBType type)
+{
+  while(type.IsArrayType())
+  {
+    type = type.GetArrayElementType();
+  }
+  type = type.GetCanonicalType();
+  if(type.GetTypeClass() & eTypeClassEnumeration)
+  {
+    type = type.GetEnumerationIntegerType().GetCanonicalType();
+  }
+  if(type.GetBasicType() == eBasicTypeInvalid)
+  {
+    return QMetaType::UnknownType;
+  }
+  if(type.GetBasicType() == eBasicTypeBool)
+  {
+    return QMetaType::Bool;
+  }
+  const auto flags     = type.GetTypeFlags();
+  const bool is_signed = (flags & eTypeIsSigned) != 0;
+  switch(type.GetByteSize())
+  {
+    case 1:
+      return (flags & eTypeIsInteger) ? (is_signed ? QMetaType::Char : QMetaType::UChar)
+                                      : QMetaType::UnknownType;
+    case 2:
+      return (flags & eTypeIsInteger) ? (is_signed ? QMetaType::Short : QMetaType::UShort)
+                                      : QMetaType::UnknownType;
+    case 4:
+      return (flags & eTypeIsFloat) ? QMetaType::Float
+                                    : (is_signed ? QMetaType::Int : QMetaType::UInt);
+    case 8:
+      return (flags & eTypeIsFloat) ? QMetaType::Double
+                                    : (is_signed ? QMetaType::LongLong : QMetaType::ULongLong);
+    default:
+      return QMetaType::UnknownType;
+  }
+}
+
+// Appends `name` and its members, structs being flattened into dotted names
+void index_value(std::vector<SymbolIndex::Symbol>& out,
+                 std::string                       name,
+                 uint64_t                          address,
+                 SBType                            type,
+                 uint32_t                          depth)
+{
+  SymbolIndex::Symbol symbol{
+      .name     = std::move(name),
+      .typeName = type.GetName() != nullptr ? type.GetName() : "",
+      .address  = address,
+      .size     = type.GetByteSize(),
+      .type     = basic_type_id(type),
+      .depth    = depth,
+  };
+  auto element = type.GetCanonicalType();
+  while(element.IsArrayType())
+  {
+    auto       next   = element.GetArrayElementType().GetCanonicalType();
+    const auto extent = element.GetByteSize() / std::max<uint64_t>(next.GetByteSize(), 1);
+    symbol.extents.push_back(uint32_t(extent));
+    element = next;
+  }
+
+  // array elements share their layout: members of the first one only, as "name[].member"
+  const auto fields = depth < max_member_depth ? element.GetNumberOfFields() : 0;
+  const auto prefix = symbol.name + (symbol.extents.empty() ? "." : "[].");
+  for(uint32_t ii = 0; ii < fields; ++ii)
+  {
+    auto member = element.GetFieldAtIndex(ii);
+    if(member.IsValid() and not member.IsBitfield() and member.GetName() != nullptr)
+    {
+      index_value(out,
+                  prefix + member.GetName(),
+                  address + member.GetOffsetInBytes(),
+                  member.GetType(),
+                  depth + 1);
+    }
+  }
+  out.push_back(std::move(symbol));
+}
+
+// Every global variable of `module`, as found by Debugger::globals()
+std::vector<SymbolIndex::Symbol> collect_symbols(SBTarget target, SBModule module)
+{
+  std::vector<SymbolIndex::Symbol> out;
+  const size_t                     n = module.GetNumSymbols();
+  for(size_t ii = 0; ii < n; ++ii)
+  {
+    auto sym = module.GetSymbolAtIndex(ii);
+    if(sym.IsValid() and sym.GetName() and sym.GetType() == lldb::eSymbolTypeData)
+    {
+      auto value = target.FindGlobalVariables(sym.GetName(), 1).GetValueAtIndex(0);
+      if(value.IsValid() and value.GetName())
+      {
+        index_value(out, value.GetName(), value.GetAddress().GetFileAddress(), value.GetType(), 0);
+      }
+    }
+  }
+  return out;
+}
+
+// Direct members of `parent` (of its elements, for an array of structs)
+std::vector<Type::Member> index_members(SymbolIndex const& index, SymbolIndex::Entry const& parent)
+{
+  const auto prefix = std::string{parent.name} + (parent.extents.empty() ? "" : "[]");
+
+  std::vector<Type::Member> out;
+  for(auto [ii, last] = index.members(prefix); ii < last; ++ii)
+  {
+    const auto entry = index.at(ii);
+    if(entry.depth != parent.depth + 1)
+    {
+      continue;
+    }
+    Type::Member member;
+    member.name          = QString::fromUtf8(entry.name.substr(prefix.size() + 1));
+    member.offset        = entry.address - parent.address;
+    member.sizeBytes     = entry.size;
+    member.elementTypeId = QMetaType::Type(entry.type);
+    for(const auto extent : entry.extents)
+    {
+      member.extents.append(int(extent));
+    }
+    member.members = index_members(index, entry);
+    out.push_back(std::move(member));
+  }
+  return out;
+}
+
+// Variable read at the address of an index entry, null if its type cannot be sampled
+Variable* index_variable(SymbolIndex const& index, SymbolIndex::Entry const& entry, Debugger* dbg)
+{
+  Type::Layout layout;
+  layout.name          = QString::fromUtf8(entry.typeName);
+  layout.sizeBytes     = entry.size;
+  layout.elementTypeId = QMetaType::Type(entry.type);
+
+  size_t count = 1;
+  for(const auto extent : entry.extents)
+  {
+    layout.extents.append(int(extent));
+    count *= extent;
+  }
+  layout.elementSize = count != 0 ? entry.size / count : 0;
+  layout.align       = layout.elementSize;
+  layout.members     = index_members(index, entry);
+
+  if(not layout.extents.isEmpty())
+  {
+    layout.kind = Type::KindBits::Array;
+  }
+  else if(not layout.members.empty())
+  {
+    layout.kind = Type::KindBits::Struct;
+  }
+  else
+  {
+    layout.kind = entry.type != QMetaType::UnknownType ? Type::KindBits::Builtin
+                                                       : Type::KindBits::Other;
+  }
+
+  // basic values, N-D arrays of them, structs and arrays of structs
+  if(layout.elementTypeId == QMetaType::UnknownType and layout.members.empty())
+  {
+    qDebug(lcDebugger) << "Skipping symbol" << QString::fromUtf8(entry.name) << "(unhandled type"
+                       << layout.name << ")";
+    return nullptr;
+  }
+  return new Variable(QString::fromUtf8(entry.name), entry.address, std::move(layout), dbg);
+}
+} // namespace
+
+Debugger* Debugger::instance_ = nullptr;
 
 Q_LOGGING_CATEGORY(lcDebugger, "qmcu.debugger")
 Q_LOGGING_CATEGORY(lcDebuggerLLDB, "qmcu.debugger.lldb")
 
-Debugger::Debugger(QObject* parent) : QObject(parent)
+Debugger::Debugger(QObject* parent)
+    : QObject(parent),
+      shadow_{std::make_unique<ShadowMemory>()},
+      elf_{std::make_unique<ElfFile>()},
+      symbols_{std::make_unique<SymbolIndex>()}
 {
   if(instance_ != nullptr)
   {
     throw std::runtime_error("debugger is a singleton");
   }
-  instance_ = this;
+  instance_     = this;
+  processProbe_ = new ProcessProbe(this);
+
+  connect(this, &Debugger::targetLoadingStarted, this, [this] { emit readyChanged(false); });
+  connect(this, &Debugger::targetLoadingCompleted, this, [this] { emit readyChanged(ready()); });
+
+  connect(this, &Debugger::continueProcess, this, [this] { process_.Continue(); });
+
+  listener_thread_ = std::jthread(
+      [this](std::stop_token stop)
+      {
+        lldb::SBEvent event;
+        while(not stop.stop_requested())
+        {
+          if(listener_.WaitForEvent(1, event))
+          { // 1 second timeout
+            if(lldb::SBProcess::EventIsProcessEvent(event))
+            {
+              auto state = lldb::SBProcess::GetStateFromEvent(event);
+              // qDebug(lcDebugger) << "State" << magic_enum::enum_name(state);
+              if(launching_)
+              {
+                launching_ = false;
+                emit launchingChanged(false);
+              }
+              emit runningChanged(state == lldb::eStateRunning);
+              if(state == lldb::eStateStopped)
+              {
+                stoppedNs_ = now_ns();
+                QMetaObject::invokeMethod(this, &Debugger::serviceStop, Qt::QueuedConnection);
+              }
+              else if(state == lldb::eStateExited or state == lldb::eStateDetached or
+                      state == lldb::eStateCrashed)
+              {
+                // no stop to come
+                QMetaObject::invokeMethod(this, &Debugger::dropStopRequests, Qt::QueuedConnection);
+              }
+            }
+          }
+        }
+      });
+}
+
+void Debugger::initializeLldb()
+{
+  std::call_once(lldbInitialized_, [this] { initializeLldbOnce(); });
+}
+
+void Debugger::initializeLldbOnce()
+{
   SBDebugger::Initialize();
   debugger_ = SBDebugger::Create();
   debugger_.SetAsync(true);
@@ -80,53 +363,34 @@ Debugger::Debugger(QObject* parent) : QObject(parent)
         qDebug(lcDebuggerLLDB) << msg;
       },
       this);
-
-  connect(this, &Debugger::targetLoadingStarted, this, [this] { emit readyChanged(false); });
-  connect(this, &Debugger::targetLoadingCompleted, this, [this] { emit readyChanged(ready()); });
-
-  connect(this, &Debugger::continueProcess, this, [this] { process_.Continue(); });
-
-  listener_thread_ = std::jthread(
-      [this](std::stop_token stop)
-      {
-        lldb::SBEvent event;
-        while(not stop.stop_requested())
-        {
-          if(listener_.WaitForEvent(1, event))
-          { // 1 second timeout
-            if(lldb::SBProcess::EventIsProcessEvent(event))
-            {
-              auto state = lldb::SBProcess::GetStateFromEvent(event);
-              // qDebug(lcDebugger) << "State" << magic_enum::enum_name(state);
-              if(launching_)
-              {
-                launching_ = false;
-                emit launchingChanged(false);
-              }
-              emit runningChanged(state == lldb::eStateRunning);
-              if(state == lldb::eStateStopped)
-              {
-                emit processStopped();
-                emit continueProcess();
-              }
-            }
-          }
-        }
-      });
+  lldb_ = true;
 }
 
 Debugger::~Debugger()
 {
   listener_thread_.request_stop();
-  SBDebugger::Terminate();
+  if(lldb_)
+  {
+    SBDebugger::Terminate();
+  }
   instance_ = nullptr;
 }
 
 bool Debugger::ready()
 {
+  if(nativeReady_ and not needsLldb())
+  {
+    return true;
+  }
   return target_.IsValid() and module_.IsValid();
 }
 
+bool Debugger::needsLldb()
+{
+  // load addresses are only known from a process launched by LLDB
+  return launched() or probe()->hasCapability(AbstractProbe::CapabilityBits::LoadAddresses);
+}
+
 void Debugger::load(QString const& executable)
 {
   for(auto* var : globals_)
@@ -136,36 +400,110 @@ void Debugger::load(QString const& executable)
   globals_.clear();
   target_ = SBTarget{};
   module_ = SBModule{};
+  elf_->close();
+  symbols_->unload();
+  executable_  = executable;
+  nativeReady_ = false;
 
   emit targetLoadingStarted();
+  emit symbolsChanged();
 
+  // the ELF file is indexed without LLDB, which is only loaded when the session needs it
   std::jthread(
-      [this, executable]
+      [this, executable, generation = ++symbolsGeneration_]
       {
-        qDebug(lcDebugger) << "Loading target" << executable << "...";
-        target_ = debugger_.CreateTarget(executable.toUtf8());
-        if(!target_.IsValid())
+        QString key;
+        if(ElfFile elf; elf.open(executable))
         {
-          target_ = SBTarget{};
-          qCritical(lcDebugger) << "Failed to create target";
-          emit targetLoadingCompleted();
-          return;
+          key             = symbol_index_key(elf, executable);
+          const auto path = SymbolIndex::cachePath(key);
+          if(SymbolIndex cached; not cached.load(path, key.toStdString()))
+          {
+            QElapsedTimer timer;
+            timer.start();
+            // nothing found (ie. split DWARF): left to LLDB
+            if(auto symbols = DwarfReader{elf}.globals(); not symbols.empty())
+            {
+              qDebug(lcDebugger) << "Debug information read in" << timer.elapsed() << "ms";
+              if(not SymbolIndex::save(path, key.toStdString(), std::move(symbols)))
+              {
+                qCritical(lcDebugger) << "Failed to write symbol index" << path;
+              }
+            }
+          }
         }
-        qDebug(lcDebugger) << "Loading module...";
-        module_ = target_.GetModuleAtIndex(0);
-        if(!module_.IsValid())
+        QMetaObject::invokeMethod(
+            this,
+            [this, executable, key, generation]
+            {
+              if(generation == symbolsGeneration_)
+              {
+                openImage(executable, key);
+              }
+            },
+            Qt::QueuedConnection);
+      })
+      .detach();
+}
+
+void Debugger::openImage(QString const& executable, QString const& key)
+{
+  if(not key.isEmpty()
+     and symbols_->load(SymbolIndex::cachePath(key), key.toStdString())
+     and elf_->open(executable))
+  {
+    nativeReady_ = true;
+    qDebug(lcDebugger) << "Target" << executable << "indexed," << symbols_->size() << "entries";
+    emit symbolsChanged();
+    if(not needsLldb())
+    {
+      emit targetLoadingCompleted();
+      return;
+    }
+  }
+  loadTarget(executable, key);
+}
+
+void Debugger::loadTarget(QString const& executable, QString const& key)
+{
+  std::jthread(
+      [this, executable, key]
+      {
+        if(createTarget(executable))
         {
-          target_ = SBTarget{};
-          qCritical(lcDebugger) << "Failed to load module";
-          emit targetLoadingCompleted();
-          return;
+          QMetaObject::invokeMethod(
+              this,
+              [this, key = key.isEmpty() ? symbol_index_key(module_, executable) : key]
+              { loadSymbols(key); },
+              Qt::QueuedConnection);
         }
-        qDebug(lcDebugger) << "Target" << executable << "loaded !";
         emit targetLoadingCompleted();
         // QTimer::singleShot(1000, [this] { emit targetLoadingCompleted(); });
       })
       .detach();
-  // qDebug() << "load exited !";
+}
+
+bool Debugger::createTarget(QString const& executable)
+{
+  initializeLldb();
+  qDebug(lcDebugger) << "Loading target" << executable << "...";
+  target_ = debugger_.CreateTarget(executable.toUtf8());
+  if(!target_.IsValid())
+  {
+    target_ = SBTarget{};
+    qCritical(lcDebugger) << "Failed to create target";
+    return false;
+  }
+  qDebug(lcDebugger) << "Loading module...";
+  module_ = target_.GetModuleAtIndex(0);
+  if(!module_.IsValid())
+  {
+    target_ = SBTarget{};
+    qCritical(lcDebugger) << "Failed to load module";
+    return false;
+  }
+  qDebug(lcDebugger) << "Target" << executable << "loaded !";
+  return true;
 }
 
 void Debugger::load(QUrl const& executable)
@@ -175,31 +513,53 @@ void Debugger::load(QUrl const& executable)
 
 QList<Variable*> Debugger::globals()
 {
-  if(globals_.empty())
+  if(globals_.empty() and nativeReady_ and not needsLldb())
+  {
+    symbols_->forEachGlobal(
+        [this](SymbolIndex::Entry const& entry)
+        {
+          if(auto* var = index_variable(*symbols_, entry, this))
+          {
+            globals_.append(var);
+          }
+        });
+  }
+  if(globals_.empty() and target_.IsValid())
   {
+    const auto add = [this](char const* s_name)
+    {
+      auto value = target_.FindGlobalVariables(s_name, 1).GetValueAtIndex(0);
+      if(not value.IsValid())
+      {
+        qDebug(lcDebugger) << "Skipping symbol" << s_name << "(invalid)";
+        return;
+      }
+      if(not value.GetName())
+      {
+        qDebug(lcDebugger) << "Skipping symbol" << s_name << "(unamed value)";
+        return;
+      }
+      globals_.append(new Variable(value, this));
+    };
+
+    if(symbols_->isLoaded())
+    {
+      // only the variables, not every symbol of the module
+      symbols_->forEachGlobal([&add](SymbolIndex::Entry const& entry)
+                              { add(std::string{entry.name}.c_str()); });
+      return globals_;
+    }
+
     const size_t n = module_.GetNumSymbols();
     if(n > 0)
     {
       qDebug(lcDebugger) << "Loading global variables...";
-      QList<Variable*> out(n);
       for(size_t ii = 0; ii < n; ++ii)
       {
         auto sym = module_.GetSymbolAtIndex(ii);
         if(sym.IsValid() and sym.GetName() and sym.GetType() == lldb::eSymbolTypeData)
         {
-          const auto s_name = sym.GetName();
-          auto       value  = target_.FindGlobalVariables(s_name, 1).GetValueAtIndex(0);
-          if(not value.IsValid())
-          {
-            qDebug(lcDebugger) << "Skipping symbol" << s_name << "(invalid)";
-            continue;
-          }
-          if(not value.GetName())
-          {
-            qDebug(lcDebugger) << "Skipping symbol" << s_name << "(unamed value)";
-            continue;
-          }
-          globals_.append(new Variable(value, this));
+          add(sym.GetName());
         }
       }
       qDebug(lcDebugger) << "Global variables loaded !";
@@ -208,12 +568,102 @@ QList<Variable*> Debugger::globals()
   return globals_;
 }
 
+QStringList Debugger::globalNames() const
+{
+  QStringList names;
+  symbols_->forEachGlobal([&names](SymbolIndex::Entry const& entry)
+                          { names.append(QString::fromUtf8(entry.name)); });
+  return names;
+}
+
+QVariantMap Debugger::symbol(QString const& name) const
+{
+  const auto key   = name.toStdString();
+  const auto entry = symbols_->find(key);
+  if(not entry)
+  {
+    return {};
+  }
+  QVariantList extents;
+  for(const auto extent : entry->extents)
+  {
+    extents.append(extent);
+  }
+  QStringList members;
+  for(auto [ii, last] = symbols_->members(key); ii < last; ++ii)
+  {
+    if(const auto member = symbols_->at(ii); member.depth == entry->depth + 1)
+    {
+      members.append(QString::fromUtf8(member.name));
+    }
+  }
+  return {
+      {"name", name},
+      {"typeName", QString::fromUtf8(entry->typeName)},
+      {"address", quint64(entry->address)},
+      {"size", quint64(entry->size)},
+      {"extents", extents},
+      {"members", members},
+  };
+}
+
+void Debugger::loadSymbols(QString const& key)
+{
+  if(key.isEmpty() or symbols_->isLoaded())
+  {
+    return;
+  }
+  const auto path = SymbolIndex::cachePath(key);
+  if(symbols_->load(path, key.toStdString()))
+  {
+    qDebug(lcDebugger) << "Symbol index" << path << "loaded," << symbols_->size() << "entries";
+    emit symbolsChanged();
+    return;
+  }
+
+  // first load of this executable: resolved once through LLDB, off the GUI thread
+  std::jthread(
+      [this, key, path, target = target_, module = module_, generation = symbolsGeneration_]
+      {
+        qDebug(lcDebugger) << "Building symbol index...";
+        if(not SymbolIndex::save(path, key.toStdString(), collect_symbols(target, module)))
+        {
+          qCritical(lcDebugger) << "Failed to write symbol index" << path;
+          return;
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, key, path, generation]
+            {
+              if(generation == symbolsGeneration_ and symbols_->load(path, key.toStdString()))
+              {
+                qDebug(lcDebugger) << "Symbol index built," << symbols_->size() << "entries";
+                emit symbolsChanged();
+              }
+            },
+            Qt::QueuedConnection);
+      })
+      .detach();
+}
+
 // #include <lldb/Host/HostInfoBase.h>
 
 Variable* Debugger::variable(QString const& name)
 {
+  if(nativeReady_ and not needsLldb())
+  {
+    // members are indexed by their dotted name as well
+    const auto entry = symbols_->find(name.toStdString());
+    if(not entry)
+    {
+      qCritical(lcDebugger) << "Skipping symbol" << name << "(not found)";
+      return nullptr;
+    }
+    return index_variable(*symbols_, *entry, this);
+  }
+
   const auto parts = name.split('.', Qt::SkipEmptyParts);
-  if(parts.isEmpty())
+  if(parts.isEmpty() or not target_.IsValid())
     return nullptr;
 
   auto value = target_.FindGlobalVariables(parts[0].toUtf8(), 1).GetValueAtIndex(0);
@@ -247,11 +697,20 @@ Variable* Debugger::variable(QString const& name)
   return new Variable(value, this);
 }
 
+QString Debugger::executable()
+{
+  if(not ready())
+  {
+    return {};
+  }
+  return QFileInfo{executable_}.fileName();
+}
+
 QString Debugger::targetArchitecture()
 {
   if(not target_.IsValid())
   {
-    return "<target-not-loaded>";
+    return elf_->isOpen() ? elf_->architecture() : "<target-not-loaded>";
   }
   // auto triple = std::string_view{target_.GetTriple()};
   // auto spec = lldb_private::HostInfoBase::GetAugmentedArchSpec(target_.GetTriple());
@@ -260,6 +719,148 @@ QString Debugger::targetArchitecture()
   return triple.split('-')[0];
 }
 
+size_t Debugger::addressByteSize()
+{
+  if(elf_->isOpen())
+  {
+    return elf_->addressSize();
+  }
+  return target_.IsValid() ? target_.GetAddressByteSize() : 4;
+}
+
+bool Debugger::readMemory(uint64_t address, std::span<std::byte> data)
+{
+  scheduleShadowInvalidation();
+  return shadow_->read(address,
+                       data,
+                       [probe = probe()](uint64_t address, std::span<std::byte> data)
+                       { return probe->read(address, data); });
+}
+
+void Debugger::shadowMemory(uint64_t address, std::span<std::byte const> data)
+{
+  scheduleShadowInvalidation();
+  shadow_->fill(address, data);
+}
+
+void Debugger::invalidateShadowMemory()
+{
+  shadow_->invalidate();
+}
+
+void Debugger::scheduleShadowInvalidation()
+{
+  if(not shadowInvalidationPending_)
+  {
+    shadowInvalidationPending_ = true;
+    QTimer::singleShot(0,
+                       this,
+                       [this]
+                       {
+                         shadowInvalidationPending_ = false;
+                         shadow_->invalidate();
+                       });
+  }
+}
+
+uint64_t Debugger::probeAddress(lldb::SBAddress address)
+{
+  if(probe()->hasCapability(AbstractProbe::CapabilityBits::LoadAddresses))
+  {
+    return address.GetLoadAddress(target_);
+  }
+  return address.GetFileAddress();
+}
+
+std::optional<uint64_t> Debugger::symbolAddress(QString const& name)
+{
+  if(nativeReady_ and not needsLldb())
+  {
+    if(const auto entry = symbols_->find(name.toStdString()))
+    {
+      return entry->address;
+    }
+    return std::nullopt;
+  }
+  if(auto symbol = target_.FindFirstGlobalVariable(name.toUtf8()); symbol.IsValid())
+  {
+    return probeAddress(symbol.GetAddress());
+  }
+  return std::nullopt;
+}
+
+void Debugger::whenStopped(QObject* context, std::function<void()> fn)
+{
+  if(not process_.IsValid())
+  {
+    return;
+  }
+  stopRequests_.append({context, std::move(fn)});
+  if(stopPending_)
+  {
+    return;
+  }
+  stopPending_     = true;
+  stopRequestedNs_ = now_ns();
+  if(process_.GetState() == lldb::eStateStopped)
+  {
+    stoppedNs_ = stopRequestedNs_;
+    QMetaObject::invokeMethod(this, &Debugger::serviceStop, Qt::QueuedConnection);
+  }
+  else if(auto error = process_.Stop(); error.Fail())
+  {
+    qCritical(lcDebugger) << "Failed to stop process:" << error.GetCString();
+    dropStopRequests();
+  }
+  else
+  {
+    QTimer::singleShot(stop_timeout_ms,
+                       this,
+                       [this, requested = stopRequestedNs_]
+                       {
+                         if(stopPending_ and stopRequestedNs_ == requested)
+                         {
+                           qWarning(lcDebugger) << "Process did not stop, dropping"
+                                                << stopRequests_.size() << "requests";
+                           dropStopRequests();
+                         }
+                       });
+  }
+}
+
+void Debugger::dropStopRequests()
+{
+  stopPending_ = false;
+  stopRequests_.clear();
+}
+
+void Debugger::serviceStop()
+{
+  const auto stopped = stoppedNs_.load();
+  if(stopPending_)
+  {
+    stopLatency_ = double(stopped - stopRequestedNs_) / 1e3;
+    stopPending_ = false;
+  }
+
+  // all requests are serviced from the same halted state
+  invalidateShadowMemory();
+  for(auto& request : std::exchange(stopRequests_, {}))
+  {
+    if(request.context != nullptr)
+    {
+      request.fn();
+    }
+  }
+  emit processStopped();
+  emit continueProcess();
+  invalidateShadowMemory();
+
+  haltTime_ = double(now_ns() - stopped) / 1e3;
+  ++stopCount_;
+  emit stopTimeChanged();
+}
+
 bool Debugger::launchProcess(bool launch)
 {
   const bool was_launched = this->launched();
@@ -273,10 +874,18 @@ bool Debugger::launchProcess(bool launch)
       }
       launching_ = true;
       emit launchingChanged(true);
+      dropStopRequests(); // made to a former process
 
       std::jthread(
           [this]
           {
+            // probe-only sessions did not need the LLDB target so far
+            if(not target_.IsValid() and not createTarget(executable_))
+            {
+              launching_ = false;
+              emit launchingChanged(false);
+              return;
+            }
             qDebug(lcDebugger) << "Launching process...";
 
             SBLaunchInfo launch_info(nullptr);
@@ -322,6 +931,7 @@ bool Debugger::launchProcess(bool launch)
     {
       process_.Kill();
       process_ = SBProcess();
+      dropStopRequests();
     }
   }
   // const bool success = launch == this->launched();
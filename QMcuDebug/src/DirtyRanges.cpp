@@ -0,0 +1,163 @@
+#include <QMcu/Debug/DirtyRanges.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define QMCU_DIRTY_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define QMCU_DIRTY_NEON 1
+#endif
+
+namespace
+{
+constexpr size_t block = 32;
+
+// Appends the dirty blocks found by the kernels, merging the close ones
+struct Marker
+{
+  std::vector<DirtyRange>& out;
+  size_t                   gap;
+
+  void mark(size_t offset, size_t size)
+  {
+    if(not out.empty() and offset <= out.back().end() + gap)
+    {
+      out.back().size = offset + size - out.back().offset;
+    }
+    else
+    {
+      out.push_back({offset, size});
+    }
+  }
+};
+
+// Kernels: compare the first `blocks` blocks of a and b
+
+void scanScalar(std::byte const* a, std::byte const* b, size_t blocks, Marker& m)
+{
+  for(size_t i = 0; i < blocks; ++i)
+  {
+    uint64_t diff = 0;
+    for(size_t w = 0; w < block; w += sizeof(uint64_t))
+    {
+      uint64_t x, y;
+      std::memcpy(&x, a + i * block + w, sizeof(x));
+      std::memcpy(&y, b + i * block + w, sizeof(y));
+      diff |= x ^ y;
+    }
+    if(diff != 0)
+    {
+      m.mark(i * block, block);
+    }
+  }
+}
+
+#if QMCU_DIRTY_AVX2
+// no lambdas in there: they would not inherit the target
+__attribute__((target("avx2"))) inline __m256i
+    diffAvx2(std::byte const* a, std::byte const* b, size_t i)
+{
+  const auto* pa = reinterpret_cast<__m256i const*>(a + i * block);
+  const auto* pb = reinterpret_cast<__m256i const*>(b + i * block);
+  return _mm256_xor_si256(_mm256_loadu_si256(pa), _mm256_loadu_si256(pb));
+}
+
+__attribute__((target("avx2"))) void
+    scanAvx2(std::byte const* a, std::byte const* b, size_t blocks, Marker& m)
+{
+  size_t i = 0;
+  // samples mostly do not change: skip 4 equal blocks at once
+  for(; i + 4 <= blocks; i += 4)
+  {
+    const __m256i d[4] = {diffAvx2(a, b, i),
+                          diffAvx2(a, b, i + 1),
+                          diffAvx2(a, b, i + 2),
+                          diffAvx2(a, b, i + 3)};
+    const __m256i any  = _mm256_or_si256(_mm256_or_si256(d[0], d[1]),
+                                        _mm256_or_si256(d[2], d[3]));
+    if(_mm256_testz_si256(any, any))
+    {
+      continue;
+    }
+    for(size_t k = 0; k < 4; ++k)
+    {
+      if(not _mm256_testz_si256(d[k], d[k]))
+      {
+        m.mark((i + k) * block, block);
+      }
+    }
+  }
+  for(; i < blocks; ++i)
+  {
+    if(const __m256i d = diffAvx2(a, b, i); not _mm256_testz_si256(d, d))
+    {
+      m.mark(i * block, block);
+    }
+  }
+}
+
+bool hasAvx2()
+{
+  static const bool has = __builtin_cpu_supports("avx2");
+  return has;
+}
+#endif
+
+#if QMCU_DIRTY_NEON
+void scanNeon(std::byte const* a, std::byte const* b, size_t blocks, Marker& m)
+{
+  for(size_t i = 0; i < blocks; ++i)
+  {
+    const auto* pa = reinterpret_cast<uint8_t const*>(a + i * block);
+    const auto* pb = reinterpret_cast<uint8_t const*>(b + i * block);
+    const auto  d  = vorrq_u8(veorq_u8(vld1q_u8(pa), vld1q_u8(pb)),
+                            veorq_u8(vld1q_u8(pa + 16), vld1q_u8(pb + 16)));
+    if(vmaxvq_u8(d) != 0)
+    {
+      m.mark(i * block, block);
+    }
+  }
+}
+#endif
+} // namespace
+
+bool findDirtyRanges(std::span<std::byte const> previous,
+                     std::span<std::byte const> next,
+                     std::vector<DirtyRange>&   out,
+                     size_t                     gap)
+{
+  out.clear();
+  Marker m{out, gap};
+
+  const size_t size   = std::min(previous.size(), next.size());
+  const size_t blocks = size / block;
+#if QMCU_DIRTY_AVX2
+  if(hasAvx2())
+  {
+    scanAvx2(previous.data(), next.data(), blocks, m);
+  }
+  else
+  {
+    scanScalar(previous.data(), next.data(), blocks, m);
+  }
+#elif QMCU_DIRTY_NEON
+  scanNeon(previous.data(), next.data(), blocks, m);
+#else
+  scanScalar(previous.data(), next.data(), blocks, m);
+#endif
+
+  const size_t tail = blocks * block;
+  if(tail < size and std::memcmp(previous.data() + tail, next.data() + tail, size - tail) != 0)
+  {
+    m.mark(tail, size - tail);
+  }
+  if(const size_t longest = std::max(previous.size(), next.size()); longest > size)
+  {
+    m.mark(size, longest - size);
+  }
+  return not out.empty();
+}
@@ -0,0 +1,1156 @@
+#include <DwarfReader.hpp>
+#include <ElfFile.hpp>
+
+#include <QMetaType>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+// nested structs flattened, at most (as through LLDB)
+constexpr uint32_t max_member_depth = 8;
+
+constexpr uint32_t npos = UINT32_MAX;
+
+enum Tag : uint16_t
+{
+  DW_TAG_array_type       = 0x01,
+  DW_TAG_class_type       = 0x02,
+  DW_TAG_enumeration_type = 0x04,
+  DW_TAG_member           = 0x0d,
+  DW_TAG_pointer_type     = 0x0f,
+  DW_TAG_reference_type   = 0x10,
+  DW_TAG_compile_unit     = 0x11,
+  DW_TAG_structure_type   = 0x13,
+  DW_TAG_typedef          = 0x16,
+  DW_TAG_union_type       = 0x17,
+  DW_TAG_subrange_type    = 0x21,
+  DW_TAG_base_type        = 0x24,
+  DW_TAG_const_type       = 0x26,
+  DW_TAG_variable         = 0x34,
+  DW_TAG_volatile_type    = 0x35,
+  DW_TAG_restrict_type    = 0x37,
+  DW_TAG_namespace        = 0x39,
+  DW_TAG_partial_unit     = 0x3c,
+  DW_TAG_rvalue_ref_type  = 0x42,
+  DW_TAG_atomic_type      = 0x47,
+};
+
+enum Attribute : uint16_t
+{
+  DW_AT_location             = 0x02,
+  DW_AT_name                 = 0x03,
+  DW_AT_byte_size            = 0x0b,
+  DW_AT_bit_size             = 0x0d,
+  DW_AT_lower_bound          = 0x22,
+  DW_AT_upper_bound          = 0x2f,
+  DW_AT_count                = 0x37,
+  DW_AT_data_member_location = 0x38,
+  DW_AT_declaration          = 0x3c,
+  DW_AT_encoding             = 0x3e,
+  DW_AT_specification        = 0x47,
+  DW_AT_type                 = 0x49,
+  DW_AT_str_offsets_base     = 0x72,
+  DW_AT_addr_base            = 0x73,
+  DW_AT_GNU_addr_base        = 0x2133,
+};
+
+enum Form : uint16_t
+{
+  DW_FORM_addr           = 0x01,
+  DW_FORM_block2         = 0x03,
+  DW_FORM_block4         = 0x04,
+  DW_FORM_data2          = 0x05,
+  DW_FORM_data4          = 0x06,
+  DW_FORM_data8          = 0x07,
+  DW_FORM_string         = 0x08,
+  DW_FORM_block          = 0x09,
+  DW_FORM_block1         = 0x0a,
+  DW_FORM_data1          = 0x0b,
+  DW_FORM_flag           = 0x0c,
+  DW_FORM_sdata          = 0x0d,
+  DW_FORM_strp           = 0x0e,
+  DW_FORM_udata          = 0x0f,
+  DW_FORM_ref_addr       = 0x10,
+  DW_FORM_ref1           = 0x11,
+  DW_FORM_ref2           = 0x12,
+  DW_FORM_ref4           = 0x13,
+  DW_FORM_ref8           = 0x14,
+  DW_FORM_ref_udata      = 0x15,
+  DW_FORM_indirect       = 0x16,
+  DW_FORM_sec_offset     = 0x17,
+  DW_FORM_exprloc        = 0x18,
+  DW_FORM_flag_present   = 0x19,
+  DW_FORM_strx           = 0x1a,
+  DW_FORM_addrx          = 0x1b,
+  DW_FORM_ref_sup4       = 0x1c,
+  DW_FORM_strp_sup       = 0x1d,
+  DW_FORM_data16         = 0x1e,
+  DW_FORM_line_strp      = 0x1f,
+  DW_FORM_ref_sig8       = 0x20,
+  DW_FORM_implicit_const = 0x21,
+  DW_FORM_loclistx       = 0x22,
+  DW_FORM_rnglistx       = 0x23,
+  DW_FORM_ref_sup8       = 0x24,
+  DW_FORM_strx1          = 0x25,
+  DW_FORM_strx2          = 0x26,
+  DW_FORM_strx3          = 0x27,
+  DW_FORM_strx4          = 0x28,
+  DW_FORM_addrx1         = 0x29,
+  DW_FORM_addrx2         = 0x2a,
+  DW_FORM_addrx3         = 0x2b,
+  DW_FORM_addrx4         = 0x2c,
+  DW_FORM_GNU_addr_index = 0x1f01,
+  DW_FORM_GNU_str_index  = 0x1f02,
+  DW_FORM_GNU_ref_alt    = 0x1f20,
+  DW_FORM_GNU_strp_alt   = 0x1f21,
+};
+
+enum Operation : uint8_t
+{
+  DW_OP_addr           = 0x03,
+  DW_OP_plus_uconst    = 0x23,
+  DW_OP_addrx          = 0xa1,
+  DW_OP_GNU_addr_index = 0xfb,
+};
+
+enum Encoding : uint8_t
+{
+  DW_ATE_boolean       = 0x02,
+  DW_ATE_float         = 0x04,
+  DW_ATE_signed        = 0x05,
+  DW_ATE_signed_char   = 0x06,
+  DW_ATE_unsigned      = 0x07,
+  DW_ATE_unsigned_char = 0x08,
+  DW_ATE_UTF           = 0x10,
+};
+
+// Sequential reads within a section; reading past its end flags the cursor and yields zeroes
+class Cursor
+{
+public:
+  Cursor(std::span<std::byte const> data, uint64_t offset = 0) noexcept
+      : data_{data}, offset_{std::min<uint64_t>(offset, data.size())}, ok_{offset <= data.size()}
+  {
+  }
+
+  bool ok() const noexcept
+  {
+    return ok_;
+  }
+  uint64_t offset() const noexcept
+  {
+    return offset_;
+  }
+  bool atEnd() const noexcept
+  {
+    return offset_ >= data_.size();
+  }
+
+  std::span<std::byte const> bytes(uint64_t count) noexcept
+  {
+    if(count > data_.size() - offset_)
+    {
+      ok_     = false;
+      offset_ = data_.size();
+      return {};
+    }
+    const auto out  = data_.subspan(offset_, count);
+    offset_        += count;
+    return out;
+  }
+
+  // 1 to 8 bytes, little-endian
+  uint64_t unsigned_(size_t size) noexcept
+  {
+    uint64_t value = 0;
+    const auto in  = bytes(size);
+    for(size_t ii = 0; ii < in.size(); ++ii)
+    {
+      value |= uint64_t(std::to_integer<uint8_t>(in[ii])) << (8 * ii);
+    }
+    return value;
+  }
+
+  uint64_t uleb() noexcept
+  {
+    uint64_t value = 0;
+    for(unsigned shift = 0; not atEnd(); shift += 7)
+    {
+      const auto byte = std::to_integer<uint8_t>(data_[offset_++]);
+      if(shift < 64)
+      {
+        value |= uint64_t(byte & 0x7f) << shift;
+      }
+      if((byte & 0x80) == 0)
+      {
+        return value;
+      }
+    }
+    ok_ = false;
+    return value;
+  }
+
+  int64_t sleb() noexcept
+  {
+    int64_t  value = 0;
+    unsigned shift = 0;
+    while(not atEnd())
+    {
+      const auto byte = std::to_integer<uint8_t>(data_[offset_++]);
+      if(shift < 64)
+      {
+        value |= int64_t(byte & 0x7f) << shift;
+      }
+      shift += 7;
+      if((byte & 0x80) == 0)
+      {
+        if(shift < 64 and (byte & 0x40) != 0)
+        {
+          value |= -(int64_t(1) << shift);
+        }
+        return value;
+      }
+    }
+    ok_ = false;
+    return value;
+  }
+
+  std::string_view cstring() noexcept
+  {
+    const auto* begin = reinterpret_cast<char const*>(data_.data()) + offset_;
+    const auto  size  = strnlen(begin, data_.size() - offset_);
+    bytes(std::min(size + 1, data_.size() - offset_));
+    return {begin, size};
+  }
+
+private:
+  std::span<std::byte const> data_;
+  uint64_t                   offset_;
+  bool                       ok_;
+};
+
+struct AttributeSpec
+{
+  uint16_t name          = 0;
+  uint16_t form          = 0;
+  int64_t  implicitConst = 0;
+};
+
+struct Abbrev
+{
+  uint16_t                   tag      = 0;
+  bool                       children = false;
+  std::vector<AttributeSpec> attributes;
+};
+
+using AbbrevTable = std::unordered_map<uint64_t, Abbrev>;
+
+struct Die
+{
+  uint64_t      offset     = 0; // within .debug_info
+  uint64_t      attributes = 0; // attribute values offset
+  Abbrev const* abbrev     = nullptr;
+  uint32_t      parent     = npos;
+  uint32_t      next       = npos; // sibling
+  uint32_t      firstChild = npos;
+
+  uint16_t tag() const noexcept
+  {
+    return abbrev->tag;
+  }
+};
+
+struct Unit
+{
+  uint64_t                     offset         = 0;
+  uint16_t                     version        = 0;
+  uint8_t                      addressSize    = 0;
+  uint8_t                      offsetSize     = 4;
+  uint64_t                     strOffsetsBase = 0;
+  uint64_t                     addrBase       = 0;
+  std::shared_ptr<AbbrevTable> abbrevs;
+  std::vector<Die>             dies; // in offset order, the unit DIE first
+};
+
+struct Value
+{
+  uint16_t                   form = 0;
+  uint64_t                   u    = 0;
+  int64_t                    s    = 0;
+  std::span<std::byte const> block;
+  std::string_view           string;
+};
+
+struct DieRef
+{
+  Unit const* unit  = nullptr;
+  uint32_t    index = npos;
+
+  explicit operator bool() const noexcept
+  {
+    return unit != nullptr and index != npos;
+  }
+  Die const& die() const noexcept
+  {
+    return unit->dies[index];
+  }
+  uint16_t tag() const noexcept
+  {
+    return die().tag();
+  }
+};
+
+// Parses the units of one worker, and the ones they reference
+class Parser
+{
+public:
+  Parser(DwarfReader::Sections const& sections,
+         std::span<uint64_t const>    units,
+         std::span<uint64_t const>    objects)
+      : s_{sections}, units_{units}, objects_{objects}
+  {
+  }
+
+  void globals(uint64_t unitOffset, std::vector<SymbolIndex::Symbol>& out)
+  {
+    cache_.clear(); // units referenced by the previous one, seldom by this one
+    abbrevs_.clear();
+    auto const* unit = this->unit(unitOffset);
+    if(unit == nullptr or unit->dies.empty())
+    {
+      return;
+    }
+    scope(DieRef{unit, 0}, out);
+  }
+
+private:
+  Unit const* unit(uint64_t offset);
+  bool        read(Cursor& c, Unit const& unit, uint16_t form, int64_t implicitConst, Value& v);
+
+  std::optional<Value> attribute(DieRef ref, uint16_t name);
+  std::string_view     string(Unit const& unit, Value const& v);
+  std::string_view     name(DieRef ref);
+  DieRef               reference(DieRef ref, uint16_t name);
+  DieRef               locate(uint64_t offset);
+
+  std::optional<uint64_t> constant(DieRef ref, uint16_t name)
+  {
+    if(const auto v = attribute(ref, name); v and v->block.empty() and v->string.empty())
+    {
+      return v->u;
+    }
+    return std::nullopt;
+  }
+
+  void scope(DieRef parent, std::vector<SymbolIndex::Symbol>& out);
+  void variable(DieRef var, std::vector<SymbolIndex::Symbol>& out);
+  std::optional<uint64_t> location(DieRef var);
+
+  DieRef              strip(DieRef type);
+  std::string         typeName(DieRef type);
+  uint64_t            sizeOf(DieRef type);
+  int                 basicType(DieRef type);
+  DieRef              arrayExtents(DieRef type, std::vector<uint32_t>& extents);
+  void                flatten(std::vector<SymbolIndex::Symbol>& out,
+                              std::string                       name,
+                              uint64_t                          address,
+                              DieRef                            type,
+                              uint32_t                          depth);
+  DwarfReader::Sections const&                        s_;
+  std::span<uint64_t const>                           units_;
+  std::span<uint64_t const>                           objects_;
+  std::map<uint64_t, std::unique_ptr<Unit>>           cache_;
+  std::map<uint64_t, std::shared_ptr<AbbrevTable>>    abbrevs_;
+};
+
+std::shared_ptr<AbbrevTable> parse_abbrevs(std::span<std::byte const> data, uint64_t offset)
+{
+  auto   table = std::make_shared<AbbrevTable>();
+  Cursor c{data, offset};
+  while(c.ok() and not c.atEnd())
+  {
+    const auto code = c.uleb();
+    if(code == 0)
+    {
+      break;
+    }
+    Abbrev abbrev;
+    abbrev.tag      = uint16_t(c.uleb());
+    abbrev.children = c.unsigned_(1) != 0;
+    while(c.ok())
+    {
+      AttributeSpec spec;
+      spec.name = uint16_t(c.uleb());
+      spec.form = uint16_t(c.uleb());
+      if(spec.form == DW_FORM_implicit_const)
+      {
+        spec.implicitConst = c.sleb();
+      }
+      if(spec.name == 0 and spec.form == 0)
+      {
+        break;
+      }
+      abbrev.attributes.push_back(spec);
+    }
+    table->emplace(code, std::move(abbrev));
+  }
+  return table;
+}
+
+Unit const* Parser::unit(uint64_t offset)
+{
+  if(auto it = cache_.find(offset); it != cache_.end())
+  {
+    return it->second.get();
+  }
+  auto& unit   = *cache_.emplace(offset, std::make_unique<Unit>()).first->second;
+  unit.offset  = offset;
+  Cursor c{s_.info, offset};
+  uint64_t length = c.unsigned_(4);
+  if(length == 0xffffffff)
+  {
+    unit.offsetSize = 8;
+    length          = c.unsigned_(8);
+  }
+  const auto end  = std::min<uint64_t>(c.offset() + length, s_.info.size());
+  unit.version    = uint16_t(c.unsigned_(2));
+  uint64_t abbrev = 0;
+  if(unit.version >= 5)
+  {
+    const auto type  = c.unsigned_(1);
+    unit.addressSize = uint8_t(c.unsigned_(1));
+    abbrev           = c.unsigned_(unit.offsetSize);
+    if(type == 4 or type == 5) // skeleton and split units
+    {
+      c.bytes(8);
+    }
+    else if(type != 1 and type != 3) // type units: types only come with variables
+    {
+      return &unit;
+    }
+  }
+  else
+  {
+    abbrev           = c.unsigned_(unit.offsetSize);
+    unit.addressSize = uint8_t(c.unsigned_(1));
+  }
+  if(not c.ok() or unit.version < 2 or unit.version > 5)
+  {
+    return &unit;
+  }
+  auto& table = abbrevs_[abbrev];
+  if(table == nullptr)
+  {
+    table = parse_abbrevs(s_.abbrev, abbrev);
+  }
+  unit.abbrevs = table;
+
+  // the tree, attributes are decoded on demand
+  std::vector<uint32_t> parents;
+  std::vector<uint32_t> previous; // last child of each parent
+  while(c.ok() and c.offset() < end)
+  {
+    const auto dieOffset = c.offset();
+    const auto code      = c.uleb();
+    if(code == 0)
+    {
+      if(parents.empty())
+      {
+        continue; // padding
+      }
+      parents.pop_back();
+      previous.pop_back();
+      continue;
+    }
+    const auto it = table->find(code);
+    if(it == table->end())
+    {
+      break; // corrupted, keeps what was read
+    }
+    const auto index = uint32_t(unit.dies.size());
+    auto&      die   = unit.dies.emplace_back(Die{
+        .offset     = dieOffset,
+        .attributes = c.offset(),
+        .abbrev     = &it->second,
+    });
+    if(not parents.empty())
+    {
+      die.parent = parents.back();
+      if(previous.back() == npos)
+      {
+        unit.dies[parents.back()].firstChild = index;
+      }
+      else
+      {
+        unit.dies[previous.back()].next = index;
+      }
+      previous.back() = index;
+    }
+    Value value;
+    for(auto const& spec : it->second.attributes)
+    {
+      if(not read(c, unit, spec.form, spec.implicitConst, value))
+      {
+        unit.dies.pop_back();
+        return &unit;
+      }
+    }
+    if(it->second.children)
+    {
+      parents.push_back(index);
+      previous.push_back(npos);
+    }
+  }
+
+  if(not unit.dies.empty())
+  {
+    const DieRef root{&unit, 0};
+    const auto   strOffsetsBase = constant(root, DW_AT_str_offsets_base);
+    const auto   addrBase       = constant(root, DW_AT_addr_base);
+    unit.strOffsetsBase = strOffsetsBase.value_or(unit.version >= 5 ? 8 : 0);
+    unit.addrBase       = addrBase ? *addrBase : constant(root, DW_AT_GNU_addr_base).value_or(0);
+  }
+  return &unit;
+}
+
+bool Parser::read(Cursor& c, Unit const& unit, uint16_t form, int64_t implicitConst, Value& v)
+{
+  v      = Value{};
+  v.form = form;
+  switch(form)
+  {
+    case DW_FORM_addr:
+      v.u = c.unsigned_(unit.addressSize);
+      break;
+    case DW_FORM_data1:
+    case DW_FORM_ref1:
+    case DW_FORM_flag:
+    case DW_FORM_strx1:
+    case DW_FORM_addrx1:
+      v.u = c.unsigned_(1);
+      break;
+    case DW_FORM_data2:
+    case DW_FORM_ref2:
+    case DW_FORM_strx2:
+    case DW_FORM_addrx2:
+      v.u = c.unsigned_(2);
+      break;
+    case DW_FORM_strx3:
+    case DW_FORM_addrx3:
+      v.u = c.unsigned_(3);
+      break;
+    case DW_FORM_data4:
+    case DW_FORM_ref4:
+    case DW_FORM_strx4:
+    case DW_FORM_addrx4:
+    case DW_FORM_ref_sup4:
+      v.u = c.unsigned_(4);
+      break;
+    case DW_FORM_data8:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_sig8:
+    case DW_FORM_ref_sup8:
+      v.u = c.unsigned_(8);
+      break;
+    case DW_FORM_data16:
+      v.block = c.bytes(16);
+      break;
+    case DW_FORM_sdata:
+      v.s = c.sleb();
+      v.u = uint64_t(v.s);
+      break;
+    case DW_FORM_udata:
+    case DW_FORM_ref_udata:
+    case DW_FORM_strx:
+    case DW_FORM_addrx:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
+      v.u = c.uleb();
+      break;
+    case DW_FORM_string:
+      v.string = c.cstring();
+      break;
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_sec_offset:
+    case DW_FORM_strp_sup:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_GNU_strp_alt:
+      v.u = c.unsigned_(unit.offsetSize);
+      break;
+    case DW_FORM_ref_addr:
+      v.u = c.unsigned_(unit.version == 2 ? unit.addressSize : unit.offsetSize);
+      break;
+    case DW_FORM_block1:
+      v.block = c.bytes(c.unsigned_(1));
+      break;
+    case DW_FORM_block2:
+      v.block = c.bytes(c.unsigned_(2));
+      break;
+    case DW_FORM_block4:
+      v.block = c.bytes(c.unsigned_(4));
+      break;
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+      v.block = c.bytes(c.uleb());
+      break;
+    case DW_FORM_flag_present:
+      v.u = 1;
+      break;
+    case DW_FORM_implicit_const:
+      v.s = implicitConst;
+      v.u = uint64_t(implicitConst);
+      break;
+    case DW_FORM_indirect:
+      return read(c, unit, uint16_t(c.uleb()), 0, v);
+    default:
+      return false; // unknown size, the rest of the unit cannot be parsed
+  }
+  return c.ok();
+}
+
+std::optional<Value> Parser::attribute(DieRef ref, uint16_t name)
+{
+  auto const& die = ref.die();
+  Cursor      c{s_.info, die.attributes};
+  Value       v;
+  for(auto const& spec : die.abbrev->attributes)
+  {
+    if(not read(c, *ref.unit, spec.form, spec.implicitConst, v))
+    {
+      break;
+    }
+    if(spec.name == name)
+    {
+      return v;
+    }
+  }
+  return std::nullopt;
+}
+
+std::string_view Parser::string(Unit const& unit, Value const& v)
+{
+  switch(v.form)
+  {
+    case DW_FORM_string:
+      return v.string;
+    case DW_FORM_strp:
+      return Cursor{s_.str, v.u}.cstring();
+    case DW_FORM_line_strp:
+      return Cursor{s_.lineStr, v.u}.cstring();
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index:
+    {
+      Cursor     c{s_.strOffsets, unit.strOffsetsBase + v.u * unit.offsetSize};
+      const auto offset = c.unsigned_(unit.offsetSize);
+      return c.ok() ? Cursor{s_.str, offset}.cstring() : std::string_view{};
+    }
+    default:
+      return {};
+  }
+}
+
+std::string_view Parser::name(DieRef ref)
+{
+  const auto v = attribute(ref, DW_AT_name);
+  return v ? string(*ref.unit, *v) : std::string_view{};
+}
+
+DieRef Parser::locate(uint64_t offset)
+{
+  // the unit starting last before `offset`
+  const auto it = std::ranges::upper_bound(units_, offset);
+  if(it == units_.begin())
+  {
+    return {};
+  }
+  auto const* unit = this->unit(*(it - 1));
+  const auto  die  = std::ranges::lower_bound(unit->dies, offset, {}, &Die::offset);
+  if(die == unit->dies.end() or die->offset != offset)
+  {
+    return {};
+  }
+  return {unit, uint32_t(die - unit->dies.begin())};
+}
+
+DieRef Parser::reference(DieRef ref, uint16_t name)
+{
+  const auto v = attribute(ref, name);
+  if(not v)
+  {
+    return {};
+  }
+  switch(v->form)
+  {
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+      return locate(ref.unit->offset + v->u);
+    case DW_FORM_ref_addr:
+      return locate(v->u);
+    default:
+      return {}; // type units and supplementary files are not read
+  }
+}
+
+void Parser::scope(DieRef parent, std::vector<SymbolIndex::Symbol>& out)
+{
+  for(auto index = parent.die().firstChild; index != npos; index = parent.unit->dies[index].next)
+  {
+    const DieRef child{parent.unit, index};
+    switch(child.tag())
+    {
+      case DW_TAG_variable:
+        variable(child, out);
+        break;
+      case DW_TAG_namespace:
+        scope(child, out);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::optional<uint64_t> Parser::location(DieRef var)
+{
+  const auto v = attribute(var, DW_AT_location);
+  if(not v or v->block.empty())
+  {
+    return std::nullopt; // optimized out, or a location list: not a static address
+  }
+  Cursor      c{v->block};
+  const auto  op      = uint8_t(c.unsigned_(1));
+  auto const& unit    = *var.unit;
+  uint64_t    address = 0;
+  if(op == DW_OP_addr)
+  {
+    address = c.unsigned_(unit.addressSize);
+  }
+  else if(op == DW_OP_addrx or op == DW_OP_GNU_addr_index)
+  {
+    address = Cursor{s_.addr, unit.addrBase + c.uleb() * unit.addressSize}.unsigned_(
+        unit.addressSize);
+  }
+  else
+  {
+    return std::nullopt;
+  }
+  // anything else (ie. thread local storage) is not at this address
+  if(not c.ok() or not c.atEnd())
+  {
+    return std::nullopt;
+  }
+  return address;
+}
+
+void Parser::variable(DieRef var, std::vector<SymbolIndex::Symbol>& out)
+{
+  if(attribute(var, DW_AT_declaration))
+  {
+    return;
+  }
+  const auto address = location(var);
+  if(not address)
+  {
+    return;
+  }
+  // definitions of a declaration (ie. static members) may only refer to it
+  auto declaration = var;
+  auto type        = reference(var, DW_AT_type);
+  auto varName     = name(var);
+  if(varName.empty() or not type)
+  {
+    declaration = reference(var, DW_AT_specification);
+    if(not declaration)
+    {
+      return;
+    }
+    varName = name(declaration);
+    type    = type ? type : reference(declaration, DW_AT_type);
+  }
+  if(varName.empty() or not type)
+  {
+    return;
+  }
+  // dropped by the linker, yet still described
+  if(objects_.empty() ? *address == 0 : not std::ranges::binary_search(objects_, *address))
+  {
+    return;
+  }
+
+  // scopes of the declaration, the definition may be outside of them
+  std::string qualified{varName};
+  for(auto parent = declaration.die().parent; parent != npos;
+      parent      = declaration.unit->dies[parent].parent)
+  {
+    const DieRef owner{declaration.unit, parent};
+    switch(owner.tag())
+    {
+      case DW_TAG_namespace:
+      case DW_TAG_structure_type:
+      case DW_TAG_class_type:
+      case DW_TAG_union_type:
+        if(const auto ownerName = name(owner); not ownerName.empty())
+        {
+          qualified = std::string{ownerName} + "::" + qualified;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  flatten(out, std::move(qualified), *address, type, 0);
+}
+
+DieRef Parser::strip(DieRef type)
+{
+  for(size_t ii = 0; type and ii < 64; ++ii)
+  {
+    switch(type.tag())
+    {
+      case DW_TAG_typedef:
+      case DW_TAG_const_type:
+      case DW_TAG_volatile_type:
+      case DW_TAG_restrict_type:
+      case DW_TAG_atomic_type:
+        type = reference(type, DW_AT_type);
+        break;
+      default:
+        return type;
+    }
+  }
+  return type;
+}
+
+std::string Parser::typeName(DieRef type)
+{
+  if(not type)
+  {
+    return "void";
+  }
+  switch(type.tag())
+  {
+    case DW_TAG_const_type:
+      return "const " + typeName(reference(type, DW_AT_type));
+    case DW_TAG_volatile_type:
+      return "volatile " + typeName(reference(type, DW_AT_type));
+    case DW_TAG_restrict_type:
+    case DW_TAG_atomic_type:
+      return typeName(reference(type, DW_AT_type));
+    case DW_TAG_pointer_type:
+      return typeName(reference(type, DW_AT_type)) + " *";
+    case DW_TAG_reference_type:
+      return typeName(reference(type, DW_AT_type)) + " &";
+    case DW_TAG_rvalue_ref_type:
+      return typeName(reference(type, DW_AT_type)) + " &&";
+    case DW_TAG_array_type:
+    {
+      std::vector<uint32_t> extents;
+      auto                  out = typeName(arrayExtents(type, extents));
+      for(const auto extent : extents)
+      {
+        out += '[' + std::to_string(extent) + ']';
+      }
+      return out;
+    }
+    default:
+      return std::string{name(type)};
+  }
+}
+
+uint64_t Parser::sizeOf(DieRef type)
+{
+  if(not type)
+  {
+    return 0;
+  }
+  if(const auto size = constant(type, DW_AT_byte_size))
+  {
+    return *size;
+  }
+  switch(type.tag())
+  {
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_ref_type:
+      return type.unit->addressSize;
+    case DW_TAG_array_type:
+    {
+      std::vector<uint32_t> extents;
+      uint64_t              size = sizeOf(arrayExtents(type, extents));
+      for(const auto extent : extents)
+      {
+        size *= extent;
+      }
+      return size;
+    }
+    case DW_TAG_typedef:
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+    case DW_TAG_atomic_type:
+    case DW_TAG_enumeration_type:
+      return sizeOf(reference(type, DW_AT_type));
+    default:
+      return 0;
+  }
+}
+
+int Parser::basicType(DieRef type)
+{
+  type = strip(type);
+  if(type and type.tag() == DW_TAG_array_type)
+  {
+    std::vector<uint32_t> extents;
+    type = strip(arrayExtents(type, extents));
+  }
+  if(not type)
+  {
+    return QMetaType::UnknownType;
+  }
+
+  // enumerations are read as their underlying integer
+  const auto size     = sizeOf(type);
+  auto       encoding = uint64_t(DW_ATE_unsigned);
+  if(type.tag() == DW_TAG_enumeration_type)
+  {
+    if(const auto underlying = strip(reference(type, DW_AT_type)); underlying)
+    {
+      encoding = constant(underlying, DW_AT_encoding).value_or(DW_ATE_unsigned);
+    }
+  }
+  else if(type.tag() == DW_TAG_base_type)
+  {
+    encoding = constant(type, DW_AT_encoding).value_or(0);
+  }
+  else
+  {
+    return QMetaType::UnknownType;
+  }
+
+  switch(encoding)
+  {
+    case DW_ATE_boolean:
+      return size == 1 ? QMetaType::Bool : QMetaType::UnknownType;
+    case DW_ATE_float:
+      return size == 4 ? QMetaType::Float : size == 8 ? QMetaType::Double : QMetaType::UnknownType;
+    case DW_ATE_signed:
+    case DW_ATE_signed_char:
+      switch(size)
+      {
+        case 1:
+          return QMetaType::Char;
+        case 2:
+          return QMetaType::Short;
+        case 4:
+          return QMetaType::Int;
+        case 8:
+          return QMetaType::LongLong;
+      }
+      break;
+    case DW_ATE_unsigned:
+    case DW_ATE_unsigned_char:
+    case DW_ATE_UTF:
+      switch(size)
+      {
+        case 1:
+          return QMetaType::UChar;
+        case 2:
+          return QMetaType::UShort;
+        case 4:
+          return QMetaType::UInt;
+        case 8:
+          return QMetaType::ULongLong;
+      }
+      break;
+  }
+  return QMetaType::UnknownType;
+}
+
+// Appends the extents of `type`, arrays of arrays merged; returns the element type
+DieRef Parser::arrayExtents(DieRef type, std::vector<uint32_t>& extents)
+{
+  for(size_t depth = 0; type and type.tag() == DW_TAG_array_type and depth < 16; ++depth)
+  {
+    for(auto index = type.die().firstChild; index != npos; index = type.unit->dies[index].next)
+    {
+      const DieRef range{type.unit, index};
+      if(range.tag() != DW_TAG_subrange_type)
+      {
+        continue;
+      }
+      uint64_t extent = 0; // flexible
+      if(const auto count = constant(range, DW_AT_count))
+      {
+        extent = *count;
+      }
+      else if(const auto upper = constant(range, DW_AT_upper_bound))
+      {
+        extent = *upper + 1 - constant(range, DW_AT_lower_bound).value_or(0);
+      }
+      extents.push_back(uint32_t(std::min<uint64_t>(extent, UINT32_MAX)));
+    }
+    type = strip(reference(type, DW_AT_type));
+  }
+  return type;
+}
+
+void Parser::flatten(std::vector<SymbolIndex::Symbol>& out,
+                     std::string                       name,
+                     uint64_t                          address,
+                     DieRef                            type,
+                     uint32_t                          depth)
+{
+  SymbolIndex::Symbol symbol{
+      .name     = std::move(name),
+      .typeName = typeName(type),
+      .address  = address,
+      .size     = sizeOf(type),
+      .type     = basicType(type),
+      .depth    = depth,
+  };
+  auto element = strip(type);
+  if(element and element.tag() == DW_TAG_array_type)
+  {
+    element = arrayExtents(element, symbol.extents);
+  }
+
+  // array elements share their layout: members of the first one only, as "name[].member"
+  const bool aggregate = element
+                     and (element.tag() == DW_TAG_structure_type
+                          or element.tag() == DW_TAG_class_type
+                          or element.tag() == DW_TAG_union_type);
+  const auto prefix    = symbol.name + (symbol.extents.empty() ? "." : "[].");
+  if(aggregate and depth < max_member_depth)
+  {
+    for(auto index = element.die().firstChild; index != npos;
+        index      = element.unit->dies[index].next)
+    {
+      const DieRef member{element.unit, index};
+      if(member.tag() != DW_TAG_member or attribute(member, DW_AT_bit_size))
+      {
+        continue;
+      }
+      uint64_t offset = 0; // union members
+      if(const auto v = attribute(member, DW_AT_data_member_location); v)
+      {
+        if(v->block.empty())
+        {
+          offset = v->u;
+        }
+        else if(Cursor c{v->block}; c.unsigned_(1) == DW_OP_plus_uconst)
+        {
+          offset = c.uleb();
+        }
+        else
+        {
+          continue;
+        }
+      }
+      const auto memberName = this->name(member);
+      if(not memberName.empty())
+      {
+        flatten(out,
+                prefix + std::string{memberName},
+                address + offset,
+                reference(member, DW_AT_type),
+                depth + 1);
+      }
+    }
+  }
+  out.push_back(std::move(symbol));
+}
+} // namespace
+
+DwarfReader::DwarfReader(ElfFile const& elf)
+{
+  const auto section = [&elf](std::string_view name)
+  {
+    auto const* s = elf.section(name);
+    return s != nullptr and not s->isCompressed() ? elf.contents(*s)
+                                                  : std::span<std::byte const>{};
+  };
+  sections_.info       = section(".debug_info");
+  sections_.abbrev     = section(".debug_abbrev");
+  sections_.str        = section(".debug_str");
+  sections_.lineStr    = section(".debug_line_str");
+  sections_.strOffsets = section(".debug_str_offsets");
+  sections_.addr       = section(".debug_addr");
+
+  for(auto const& symbol : elf.symbols())
+  {
+    if(symbol.isObject())
+    {
+      objects_.push_back(symbol.address);
+    }
+  }
+  std::ranges::sort(objects_);
+}
+
+std::vector<SymbolIndex::Symbol> DwarfReader::globals(size_t threads) const
+{
+  if(not isValid())
+  {
+    return {};
+  }
+
+  // unit headers only tell where the next one starts
+  std::vector<uint64_t> units;
+  for(Cursor c{sections_.info}; c.ok() and not c.atEnd();)
+  {
+    const auto offset = c.offset();
+    uint64_t   length = c.unsigned_(4);
+    if(length == 0xffffffff)
+    {
+      length = c.unsigned_(8);
+    }
+    if(not c.ok() or length == 0)
+    {
+      break;
+    }
+    units.push_back(offset);
+    c.bytes(std::min<uint64_t>(length, sections_.info.size() - c.offset()));
+  }
+
+  std::vector<std::vector<SymbolIndex::Symbol>> results(units.size());
+  std::atomic<size_t>                           next = 0;
+  {
+    std::vector<std::jthread> workers;
+    for(size_t ii = 0; ii < std::clamp<size_t>(threads, 1, units.size()); ++ii)
+    {
+      workers.emplace_back(
+          [&]
+          {
+            Parser parser{sections_, units, objects_};
+            for(auto unit = next++; unit < units.size(); unit = next++)
+            {
+              parser.globals(units[unit], results[unit]);
+            }
+          });
+    }
+  }
+
+  std::vector<SymbolIndex::Symbol> out;
+  for(auto& result : results)
+  {
+    std::ranges::move(result, std::back_inserter(out));
+  }
+  return out;
+}
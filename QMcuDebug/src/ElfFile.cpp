@@ -0,0 +1,234 @@
+#include <ElfFile.hpp>
+
+#include <QFile>
+
+#include <cstring>
+
+namespace
+{
+// Little-endian fields at any alignment; 0 past the end
+template <typename T> T field(std::span<std::byte const> data, uint64_t offset) noexcept
+{
+  T value{};
+  if(offset <= data.size() and sizeof(T) <= data.size() - offset)
+  {
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+  }
+  return value;
+}
+
+// 32 or 64 bits wide field
+uint64_t word(std::span<std::byte const> data, uint64_t offset, bool is64) noexcept
+{
+  return is64 ? field<uint64_t>(data, offset) : field<uint32_t>(data, offset);
+}
+
+std::string_view string_at(std::span<std::byte const> table, uint64_t offset) noexcept
+{
+  if(offset >= table.size())
+  {
+    return {};
+  }
+  auto const* begin = reinterpret_cast<char const*>(table.data()) + offset;
+  return {begin, strnlen(begin, table.size() - offset)};
+}
+
+constexpr uint32_t sht_symtab = 2;
+constexpr uint32_t sht_note   = 7;
+constexpr uint32_t nt_gnu_id  = 3;
+} // namespace
+
+ElfFile::ElfFile()  = default;
+ElfFile::~ElfFile() = default;
+
+bool ElfFile::open(QString const& path)
+{
+  close();
+
+  auto file = std::make_unique<QFile>(path);
+  if(not file->open(QIODevice::ReadOnly) or file->size() < 52)
+  {
+    return false;
+  }
+  auto const* mapped = file->map(0, file->size());
+  if(mapped == nullptr)
+  {
+    return false;
+  }
+  const std::span data{reinterpret_cast<std::byte const*>(mapped), size_t(file->size())};
+
+  // "\x7fELF", ELFCLASS32/64, ELFDATA2LSB
+  const auto ident = field<uint32_t>(data, 0);
+  const auto cls   = field<uint8_t>(data, 4);
+  if(ident != 0x464c457f or (cls != 1 and cls != 2) or field<uint8_t>(data, 5) != 1)
+  {
+    return false;
+  }
+  const bool is64      = cls == 2;
+  const auto shoff     = word(data, is64 ? 0x28 : 0x20, is64);
+  const auto shentsize = field<uint16_t>(data, is64 ? 0x3a : 0x2e);
+  size_t     shnum     = field<uint16_t>(data, is64 ? 0x3c : 0x30);
+  size_t     shstrndx  = field<uint16_t>(data, is64 ? 0x3e : 0x32);
+  if(shoff == 0 or shentsize < (is64 ? 64 : 40) or shoff >= data.size())
+  {
+    return false;
+  }
+  // extended numbering, stored in the first section header
+  if(shnum == 0)
+  {
+    shnum = word(data, shoff + (is64 ? 0x20 : 0x14), is64);
+  }
+  if(shstrndx == 0xffff)
+  {
+    shstrndx = field<uint32_t>(data, shoff + (is64 ? 0x28 : 0x18));
+  }
+  if(shnum > (data.size() - shoff) / shentsize or shstrndx >= shnum)
+  {
+    return false;
+  }
+
+  std::vector<Section>  sections(shnum);
+  std::vector<uint32_t> names(shnum);
+  for(size_t ii = 0; ii < shnum; ++ii)
+  {
+    const auto header = shoff + ii * shentsize;
+    auto&      s      = sections[ii];
+    names[ii]         = field<uint32_t>(data, header);
+    s.type            = field<uint32_t>(data, header + 4);
+    s.flags           = word(data, header + 8, is64);
+    s.address         = word(data, header + (is64 ? 0x10 : 0x0c), is64);
+    s.offset          = word(data, header + (is64 ? 0x18 : 0x10), is64);
+    s.size            = word(data, header + (is64 ? 0x20 : 0x14), is64);
+    s.link            = field<uint32_t>(data, header + (is64 ? 0x28 : 0x18));
+  }
+
+  file_              = std::move(file);
+  data_              = data;
+  is64_              = is64;
+  machine_           = field<uint16_t>(data, 0x12);
+  sections_          = std::move(sections);
+  const auto strings = contents(sections_[shstrndx]);
+  for(size_t ii = 0; ii < shnum; ++ii)
+  {
+    sections_[ii].name = string_at(strings, names[ii]);
+  }
+  return true;
+}
+
+void ElfFile::close()
+{
+  file_.reset();
+  data_    = {};
+  is64_    = false;
+  machine_ = 0;
+  sections_.clear();
+}
+
+QString ElfFile::architecture() const
+{
+  switch(machine_)
+  {
+    case 0x03:
+      return "i386";
+    case 0x28:
+      return "arm";
+    case 0x3e:
+      return "x86_64";
+    case 0xb7:
+      return "aarch64";
+    case 0xf3:
+      return is64_ ? "riscv64" : "riscv32";
+    default:
+      return QString("elf-machine-%1").arg(machine_);
+  }
+}
+
+ElfFile::Section const* ElfFile::section(std::string_view name) const noexcept
+{
+  for(auto const& s : sections_)
+  {
+    if(s.name == name)
+    {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+std::span<std::byte const> ElfFile::contents(Section const& section) const noexcept
+{
+  if(not section.hasContents()
+     or section.offset > data_.size()
+     or section.size > data_.size() - section.offset)
+  {
+    return {};
+  }
+  return data_.subspan(section.offset, section.size);
+}
+
+std::vector<ElfFile::Symbol> ElfFile::symbols() const
+{
+  std::vector<Symbol> out;
+  for(auto const& table : sections_)
+  {
+    if(table.type != sht_symtab or table.link >= sections_.size())
+    {
+      continue;
+    }
+    const auto entries = contents(table);
+    const auto strings = contents(sections_[table.link]);
+    const auto size    = is64_ ? 24 : 16;
+    out.reserve(out.size() + entries.size() / size);
+    for(size_t offset = size; offset + size <= entries.size(); offset += size)
+    {
+      Symbol symbol;
+      symbol.name    = string_at(strings, field<uint32_t>(entries, offset));
+      symbol.type    = field<uint8_t>(entries, offset + (is64_ ? 4 : 12)) & 0xf;
+      symbol.section = field<uint16_t>(entries, offset + (is64_ ? 6 : 14));
+      symbol.address = word(entries, offset + (is64_ ? 8 : 4), is64_);
+      symbol.size    = word(entries, offset + (is64_ ? 16 : 8), is64_);
+      if(symbol.section != 0)
+      {
+        out.push_back(symbol);
+      }
+    }
+  }
+  return out;
+}
+
+std::string ElfFile::buildId() const
+{
+  for(auto const& note : sections_)
+  {
+    if(note.type != sht_note)
+    {
+      continue;
+    }
+    const auto data = contents(note);
+    for(uint64_t offset = 0; offset + 12 <= data.size();)
+    {
+      const auto nameSize = field<uint32_t>(data, offset);
+      const auto descSize = field<uint32_t>(data, offset + 4);
+      const auto type     = field<uint32_t>(data, offset + 8);
+      const auto name     = offset + 12;
+      const auto desc     = name + ((uint64_t(nameSize) + 3) & ~uint64_t(3));
+      if(desc + descSize > data.size())
+      {
+        break;
+      }
+      if(type == nt_gnu_id and nameSize == 4 and string_at(data, name) == "GNU")
+      {
+        static constexpr char digits[] = "0123456789ABCDEF";
+        std::string           id;
+        for(const auto byte : data.subspan(desc, descSize))
+        {
+          id += digits[std::to_integer<uint8_t>(byte) >> 4];
+          id += digits[std::to_integer<uint8_t>(byte) & 0xf];
+        }
+        return id;
+      }
+      offset = desc + ((uint64_t(descSize) + 3) & ~uint64_t(3));
+    }
+  }
+  return {};
+}
@@ -0,0 +1,150 @@
+#include <QMcu/Debug/Acquisition.hpp>
+#include <QMcu/Debug/GroupRecorder.hpp>
+#include <QMcu/Debug/VariableProxy.hpp>
+#include <QMcu/Debug/VariableProxyGroup.hpp>
+
+#include <Logging.hpp>
+
+GroupRecorder::GroupRecorder(QObject* parent) : QObject{parent}
+{
+}
+
+GroupRecorder::~GroupRecorder()
+{
+  stop();
+}
+
+void GroupRecorder::setGroup(VariableProxyGroup* group)
+{
+  if(group != group_)
+  {
+    const bool wasRecording = recording();
+    stop();
+    group_ = group;
+    emit groupChanged();
+    if(wasRecording and not start())
+    {
+      emit recordingChanged();
+    }
+  }
+}
+
+void GroupRecorder::setFile(QUrl const& file)
+{
+  if(file != file_)
+  {
+    const bool wasRecording = recording();
+    stop();
+    file_ = file;
+    emit fileChanged();
+    if(wasRecording and not start())
+    {
+      emit recordingChanged();
+    }
+  }
+}
+
+void GroupRecorder::setChunkSamples(int count)
+{
+  // applies to the next recording
+  if(count > 0 and count != chunkSamples_)
+  {
+    chunkSamples_ = count;
+    emit chunkSamplesChanged();
+  }
+}
+
+void GroupRecorder::setRecording(bool recording)
+{
+  if(recording == this->recording())
+  {
+    return;
+  }
+  if(recording)
+  {
+    if(not start())
+    {
+      return;
+    }
+  }
+  else
+  {
+    stop();
+  }
+  emit recordingChanged();
+  emit progress();
+}
+
+bool GroupRecorder::start()
+{
+  if(group_ == nullptr)
+  {
+    qWarning(lcWatcher) << "GroupRecorder: no group to record";
+    return false;
+  }
+
+  std::vector<RecordingWriter::Channel> channels;
+  channels_.clear();
+  for(auto* p : group_->proxies_)
+  {
+    auto* const v = p->variable();
+    if(v == nullptr or not v->isResolved())
+    {
+      qWarning(lcWatcher) << "GroupRecorder: not recording unresolved" << p->name();
+      continue;
+    }
+    if(p->isDirect())
+    {
+      // read straight into a plot: the proxy holds no sample
+      qWarning(lcWatcher) << "GroupRecorder: not recording zero-copy" << p->name();
+      continue;
+    }
+    // transformed basic values are published as doubles
+    const auto type        = p->sampleType();
+    const auto sample      = v->sample();
+    const bool transformed = type == QMetaType::Double and sample.typeId != QMetaType::Double;
+    channels.push_back({p->name(),
+                        type,
+                        transformed ? sizeof(double) : sample.elementSize,
+                        transformed ? sizeof(double) : v->loadSize()});
+    channels_.append(p);
+  }
+
+  auto writer = std::make_unique<RecordingWriter>(size_t(chunkSamples_));
+  if(not writer->open(file_.isLocalFile() ? file_.toLocalFile() : file_.toString(),
+                      std::move(channels)))
+  {
+    channels_.clear();
+    return false;
+  }
+  writer_ = std::move(writer);
+  row_.resize(channels_.size());
+  connection_ = connect(group_, &VariableProxyGroup::refreshed, this, &GroupRecorder::record);
+  return true;
+}
+
+void GroupRecorder::stop()
+{
+  if(writer_ == nullptr)
+  {
+    return;
+  }
+  disconnect(connection_);
+  writer_->close();
+  samples_      = writer_->rows();
+  bytesWritten_ = writer_->bytesWritten();
+  writer_.reset();
+  channels_.clear();
+}
+
+void GroupRecorder::record()
+{
+  // proxies keep their last sample until their next refresh
+  for(qsizetype ii = 0; ii < channels_.size(); ++ii)
+  {
+    auto* const p = channels_[ii].get();
+    row_[ii]      = p != nullptr ? p->sample().bytes : std::span<std::byte const>{};
+  }
+  writer_->append(Acquisition::nsTime(), row_);
+  emit progress();
+}
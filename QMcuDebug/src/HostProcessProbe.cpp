@@ -0,0 +1,199 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/HostProcessProbe.hpp>
+
+#include <Logging.hpp>
+
+#include <QTimer>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+HostProcessProbe::HostProcessProbe(QObject* parent) : AbstractProbe(parent)
+{
+  makeInstance();
+
+  // the Debugger may be declared after us
+  QTimer::singleShot(0,
+                     this,
+                     [this]
+                     {
+                       auto* dbg = Debugger::instance();
+                       if(dbg == nullptr)
+                       {
+                         return;
+                       }
+                       const auto update = [this, dbg](bool launched)
+                       { attach(launched ? qint64(dbg->process().GetProcessID()) : 0); };
+                       connect(dbg, &Debugger::launchedChanged, this, update);
+                       update(dbg->launched());
+                     });
+}
+
+HostProcessProbe::~HostProcessProbe()
+{
+  if(memFd_ >= 0)
+  {
+    ::close(memFd_);
+  }
+}
+
+void HostProcessProbe::attach(qint64 pid)
+{
+  {
+    std::lock_guard lock{mutex_};
+    if(pid == pid_)
+    {
+      return;
+    }
+    if(memFd_ >= 0)
+    {
+      ::close(memFd_);
+      memFd_ = -1;
+    }
+    pid_ = pid;
+    if(pid_ != 0)
+    {
+      const auto path = QString("/proc/%1/mem").arg(pid_).toUtf8();
+      memFd_          = ::open(path.constData(), O_RDWR | O_CLOEXEC);
+      if(memFd_ < 0)
+      {
+        memFd_ = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+      }
+    }
+    method_ = pid_ != 0 ? Method::VmReadv : Method::None;
+  }
+  emit pidChanged();
+  emit methodChanged();
+}
+
+void HostProcessProbe::fallback(int error)
+{
+  qWarning(lcWatcher)
+      << "process_vm_readv unavailable ("
+      << std::strerror(error)
+      << "), falling back to /proc/"
+      << pid_
+      << "/mem";
+  method_ = Method::ProcMem; // notified by doReadBatch(), once unlocked
+}
+
+bool HostProcessProbe::doRead(address_t address, std::span<std::byte> data)
+{
+  const ReadRequest request{address, data};
+  return doReadBatch({&request, 1});
+}
+
+bool HostProcessProbe::doReadBatch(std::span<ReadRequest const> requests)
+{
+  bool ok       = false;
+  bool fellBack = false;
+  {
+    std::lock_guard lock{mutex_};
+    switch(method_.load(std::memory_order_relaxed))
+    {
+      case Method::VmReadv:
+        ok       = vmRead(requests);
+        fellBack = method_.load(std::memory_order_relaxed) == Method::ProcMem;
+        break;
+      case Method::ProcMem:
+        ok = memRead(requests);
+        break;
+      case Method::None:
+        break;
+    }
+  }
+  if(fellBack)
+  {
+    // from the acquisition thread: slots run on the GUI thread, and may call the probe
+    QMetaObject::invokeMethod(this, [this] { emit methodChanged(); }, Qt::QueuedConnection);
+  }
+  return ok;
+}
+
+bool HostProcessProbe::vmRead(std::span<ReadRequest const> requests)
+{
+  thread_local std::vector<iovec> local;
+  thread_local std::vector<iovec> remote;
+
+  for(size_t first = 0; first < requests.size(); first += IOV_MAX)
+  {
+    auto chunk = requests.subspan(first, std::min<size_t>(IOV_MAX, requests.size() - first));
+
+    local.clear();
+    remote.clear();
+    ssize_t expected = 0;
+    for(auto const& r : chunk)
+    {
+      local.push_back({r.data.data(), r.data.size_bytes()});
+      remote.push_back({reinterpret_cast<void*>(r.address), r.data.size_bytes()});
+      expected += ssize_t(r.data.size_bytes());
+    }
+
+    const auto count = ::process_vm_readv(
+        pid_t(pid_), local.data(), local.size(), remote.data(), remote.size(), 0);
+    if(count < 0 and (errno == EPERM or errno == ENOSYS))
+    {
+      fallback(errno);
+      return memRead(requests.subspan(first));
+    }
+    if(count != expected)
+    {
+      // transfers stop at the first unreadable range
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HostProcessProbe::memRead(std::span<ReadRequest const> requests)
+{
+  if(memFd_ < 0)
+  {
+    return false;
+  }
+  bool ok = true;
+  for(auto const& r : requests)
+  {
+    size_t done = 0;
+    while(done < r.data.size_bytes())
+    {
+      const auto count = ::pread(
+          memFd_, r.data.data() + done, r.data.size_bytes() - done, off_t(r.address + done));
+      if(count <= 0)
+      {
+        break;
+      }
+      done += size_t(count);
+    }
+    ok = ok and done == r.data.size_bytes();
+  }
+  return ok;
+}
+
+bool HostProcessProbe::doWrite(address_t address, std::span<std::byte const> data)
+{
+  std::lock_guard lock{mutex_};
+  if(method_ == Method::VmReadv)
+  {
+    const iovec local{const_cast<std::byte*>(data.data()), data.size_bytes()};
+    const iovec remote{reinterpret_cast<void*>(address), data.size_bytes()};
+    const auto  count = ::process_vm_writev(pid_t(pid_), &local, 1, &remote, 1, 0);
+    if(count == ssize_t(data.size_bytes()))
+    {
+      return true;
+    }
+    // read-only mappings are only writable through /proc/<pid>/mem
+  }
+  if(memFd_ < 0)
+  {
+    return false;
+  }
+  return ::pwrite(memFd_, data.data(), data.size_bytes(), off_t(address))
+      == ssize_t(data.size_bytes());
+}
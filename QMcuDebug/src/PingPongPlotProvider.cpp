@@ -0,0 +1,267 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/PingPongPlotProvider.hpp>
+#include <QMcu/Debug/Type.hpp>
+
+#include <Logging.hpp>
+#include <ScrollWindow.hpp>
+#include <SegmentTracker.hpp>
+
+#include <chrono>
+
+namespace
+{
+// samples queued for the renderer, at least
+constexpr size_t min_ring_capacity = 1 << 16;
+
+// weight of the last completions in the measured rate
+constexpr double rate_smoothing = 0.2;
+
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+PingPongPlotProvider::PingPongPlotProvider(QObject* parent)
+    : AbstractPlotDataProvider(parent),
+      tracker_{std::make_unique<SegmentTracker>()},
+      window_{std::make_unique<ScrollWindow>()}
+{
+  connect(this, &PingPongPlotProvider::settingsChanged, this, &PingPongPlotProvider::configure);
+}
+
+PingPongPlotProvider::~PingPongPlotProvider() = default;
+
+void PingPongPlotProvider::setBuffer(VariableProxy* buffer)
+{
+  if(buffer != buffer_)
+  {
+    if(buffer_ != nullptr)
+    {
+      disconnect(buffer_, nullptr, this, nullptr);
+    }
+    buffer_ = buffer;
+    if(buffer_ != nullptr)
+    {
+      if(name().isEmpty())
+      {
+        setName(buffer_->name());
+      }
+      connect(buffer_, &VariableProxy::variableResolved, this, &PingPongPlotProvider::configure);
+    }
+    configure();
+    emit bufferChanged();
+  }
+}
+
+void PingPongPlotProvider::setIndex(VariableProxy* index)
+{
+  if(index != index_)
+  {
+    if(index_ != nullptr)
+    {
+      disconnect(index_, nullptr, this, nullptr);
+    }
+    index_ = index;
+    if(index_ != nullptr)
+    {
+      // an index back to the same value may still be a whole lap later (see SegmentTracker)
+      connect(index_, &VariableProxy::valueChanged, this, &PingPongPlotProvider::follow);
+      connect(index_, &VariableProxy::valueUnChanged, this, &PingPongPlotProvider::follow);
+      connect(index_, &VariableProxy::variableResolved, this, &PingPongPlotProvider::configure);
+    }
+    configure();
+    emit indexChanged();
+  }
+}
+
+void PingPongPlotProvider::setIndexMode(IndexMode mode)
+{
+  if(mode != indexMode_)
+  {
+    indexMode_ = mode;
+    emit settingsChanged();
+  }
+}
+
+void PingPongPlotProvider::setSegments(int segments)
+{
+  if(segments != segments_ and segments >= 0)
+  {
+    segments_ = segments;
+    emit settingsChanged();
+  }
+}
+
+void PingPongPlotProvider::setSampleRate(double rate)
+{
+  if(rate != sampleRate_ and rate >= 0.0)
+  {
+    sampleRate_ = rate;
+    emit settingsChanged();
+  }
+}
+
+void PingPongPlotProvider::setSampleCount(int count)
+{
+  if(count != sampleCount_ and count > 0)
+  {
+    sampleCount_ = count;
+    emit settingsChanged();
+  }
+}
+
+void PingPongPlotProvider::configure()
+{
+  type_           = QMetaType::UnknownType;
+  segmentSamples_ = 0;
+  lastUpdateNs_   = 0;
+  lastSampleNs_   = 0;
+
+  auto* const var = buffer_ != nullptr ? buffer_->variable() : nullptr;
+  if(var == nullptr or not var->isResolved())
+  {
+    return;
+  }
+  auto* const type = var->type();
+  if(not type->isArray() or type->elementSize() == 0)
+  {
+    qCritical(lcWatcher) << "PingPongPlotProvider:" << buffer_->name() << "is not an array";
+    return;
+  }
+
+  // the outer extent of a 2D buffer, halves of a 1D one
+  auto const& extents  = type->extents();
+  size_t      segments = extents.size() > 1 ? size_t(extents[0]) : 2;
+  if(segments_ > 0)
+  {
+    segments = size_t(segments_);
+  }
+  const auto samples = type->sizeBytes() / type->elementSize();
+  if(segments < 2 or samples % segments != 0)
+  {
+    qCritical(lcWatcher)
+        << "PingPongPlotProvider: cannot split"
+        << samples
+        << "samples of"
+        << buffer_->name()
+        << "into"
+        << segments
+        << "segments";
+    return;
+  }
+
+  type_           = type->elementTypeId();
+  segmentSamples_ = samples / segments;
+  *tracker_       = SegmentTracker{SegmentTracker::Mode(indexMode_), segments};
+  ring_.store(std::make_shared<SampleRing>(type->elementSize(),
+                                           std::max<size_t>(sampleCount_, min_ring_capacity)),
+              std::memory_order_release);
+}
+
+void PingPongPlotProvider::follow()
+{
+  auto* const var  = buffer_ != nullptr ? buffer_->variable() : nullptr;
+  auto        ring = ring_.load(std::memory_order_acquire);
+  if(segmentSamples_ == 0 or var == nullptr or ring == nullptr)
+  {
+    return;
+  }
+
+  const auto now      = now_ns();
+  const auto rate     = sampleRate_ > 0.0 ? sampleRate_ : measuredRate_;
+  const auto periodNs = sampleRate_ > 0.0 ? int64_t(segmentSamples_ * 1e9 / sampleRate_) : 0;
+  const auto update   = tracker_->next(index_->sample().toInteger(), now, periodNs);
+  if(update.count == 0 and update.lost == 0)
+  {
+    if(lastUpdateNs_ == 0)
+    {
+      lastUpdateNs_ = now; // synchronized
+    }
+    return;
+  }
+
+  // only the completed segments, in at most two transfers
+  const auto valueSize    = ring->valueSize();
+  const auto segmentBytes = segmentSamples_ * valueSize;
+  const auto segments     = tracker_->segments();
+  const auto head         = std::min(update.count, segments - update.first);
+  scratch_.resize(update.count * segmentBytes);
+  auto* const dbg = Debugger::instance();
+  bool        ok  = dbg->readMemory(var->address() + update.first * segmentBytes,
+                                    std::span{scratch_}.first(head * segmentBytes));
+  if(head < update.count)
+  {
+    ok = ok and dbg->readMemory(var->address(), std::span{scratch_}.subspan(head * segmentBytes));
+  }
+  if(not ok)
+  {
+    return;
+  }
+
+  // the rate, from the completions since the previous update
+  const auto completed = (update.count + update.lost) * segmentSamples_;
+  if(lastUpdateNs_ != 0 and now > lastUpdateNs_)
+  {
+    const double measured  = double(completed) * 1e9 / double(now - lastUpdateNs_);
+    measuredRate_         += measuredRate_ == 0.0 ? measured
+                                                  : rate_smoothing * (measured - measuredRate_);
+  }
+  lastUpdateNs_ = now;
+
+  // continues the timeline, unless it drifted away from the completion just observed
+  const auto count    = update.count * segmentSamples_;
+  const auto lost     = update.lost * segmentSamples_;
+  const auto stepNs   = rate > 0.0 ? 1e9 / rate : 0.0;
+  const auto bufferNs = int64_t(stepNs * double(segments * segmentSamples_));
+  auto       firstNs  = lastSampleNs_ != 0 ? lastSampleNs_ + int64_t(stepNs * double(lost + 1)) : 0;
+  if(const auto lastNs = firstNs + int64_t(stepNs * double(count - 1));
+     firstNs == 0 or lastNs > now or now - lastNs > bufferNs)
+  {
+    firstNs = now - int64_t(stepNs * double(count - 1));
+  }
+  for(size_t ii = 0; ii < count; ++ii)
+  {
+    const auto timestamp = firstNs + int64_t(stepNs * double(ii));
+    ring->push(timestamp, std::span{scratch_}.subspan(ii * valueSize, valueSize));
+    lastSampleNs_ = timestamp;
+  }
+
+  samples_ += count;
+  if(update.lost != 0)
+  {
+    overruns_    += update.lost;
+    lostSamples_ += lost;
+    emit overrun(update.lost);
+  }
+  emit statsChanged();
+  emit dataChanged();
+}
+
+bool PingPongPlotProvider::initializePlotContext(PlotContext& ctx)
+{
+  if(type_ == QMetaType::UnknownType)
+  {
+    return false;
+  }
+  tid_         = type_;
+  auto storage = createMappedStorageBuffer(tid_, sampleCount_ * 2);
+  std::ranges::fill(storage, std::byte(0));
+  window_->reset(storage);
+  return true;
+}
+
+PingPongPlotProvider::UpdateRange PingPongPlotProvider::update(PlotContext& ctx)
+{
+  return qplot::visitQtType(tid_,
+                            [&]<typename T>
+                            {
+                              if(auto ring = ring_.load(std::memory_order_acquire);
+                                 ring != nullptr and ring->valueSize() == sizeof(T))
+                              {
+                                ring->drainAs<T>([&](int64_t, T value) { window_->push(value); });
+                              }
+                              return window_->visible<T>();
+                            });
+}
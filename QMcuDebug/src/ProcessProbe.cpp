@@ -0,0 +1,45 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/ProcessProbe.hpp>
+
+#include <Logging.hpp>
+
+ProcessProbe::ProcessProbe(Debugger* parent) : AbstractProbe(parent)
+{
+}
+
+Debugger* ProcessProbe::debugger() const noexcept
+{
+  return static_cast<Debugger*>(parent());
+}
+
+bool ProcessProbe::doRead(address_t address, std::span<std::byte> data)
+{
+  lldb::SBError error;
+  debugger()->process().ReadMemory(address, data.data(), data.size_bytes(), error);
+  if(error.Fail())
+  {
+    qCritical(lcWatcher)
+        << "Failed to read memory at address"
+        << address
+        << ":"
+        << error.GetCString();
+    return false;
+  }
+  return true;
+}
+
+bool ProcessProbe::doWrite(address_t address, std::span<std::byte const> data)
+{
+  lldb::SBError error;
+  debugger()->process().WriteMemory(address, data.data(), data.size_bytes(), error);
+  if(error.Fail())
+  {
+    qCritical(lcWatcher)
+        << "Failed to write memory at address"
+        << address
+        << ":"
+        << error.GetCString();
+    return false;
+  }
+  return true;
+}
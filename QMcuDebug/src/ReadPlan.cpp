@@ -0,0 +1,73 @@
+#include <QMcu/Debug/Variable.hpp>
+
+#include <ReadPlan.hpp>
+
+#include <algorithm>
+
+void ReadPlan::add(Variable* variable)
+{
+  if(variable->isResolved() and variable->loadSize() != 0)
+  {
+    add({variable->loadAddress(), variable->loadSize(), variable});
+  }
+}
+
+void ReadPlan::compile(size_t maxGap)
+{
+  spans_.clear();
+
+  std::ranges::sort(entries_, {}, &Entry::address);
+
+  for(auto const& entry : entries_)
+  {
+    const auto entry_end = entry.address + entry.size;
+    if(spans_.isEmpty() or entry.address > spans_.last().end() + maxGap)
+    {
+      auto& span   = spans_.emplace_back();
+      span.address = entry.address;
+      span.data.resize(entry.size);
+      span.entries.append(entry);
+    }
+    else
+    {
+      auto& span = spans_.last();
+      if(entry_end > span.end())
+      {
+        span.data.resize(entry_end - span.address);
+      }
+      span.entries.append(entry);
+    }
+  }
+
+  requests_.clear();
+  for(auto& span : spans_)
+  {
+    requests_.push_back({span.address, span.data});
+  }
+}
+
+bool ReadPlan::execute(reader_fn const& reader)
+{
+  bool ok = true;
+  for(auto& span : spans_)
+  {
+    span.fetched = reader(span.address, span.data);
+    ok           = ok and span.fetched;
+  }
+  return ok;
+}
+
+bool ReadPlan::execute(AbstractProbe& probe)
+{
+  if(not probe.readBatch(requests_))
+  {
+    // find out which spans are valid
+    return execute([&probe](uint64_t address, std::span<std::byte> data)
+                   { return probe.read(address, data); });
+  }
+  for(auto& span : spans_)
+  {
+    span.fetched = true;
+  }
+  return true;
+}
@@ -0,0 +1,535 @@
+#include <QMcu/Debug/RecordingCodecs.hpp>
+#include <QMcu/Debug/Sample.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+namespace recording
+{
+namespace
+{
+// Rows pick() tries the codecs on
+constexpr size_t pick_rows = 1024;
+
+template <typename T> T load(std::byte const* p) noexcept
+{
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+template <typename T> void store(std::byte* p, T value) noexcept
+{
+  std::memcpy(p, &value, sizeof(T));
+}
+
+void putVarint(std::vector<std::byte>& out, uint64_t value)
+{
+  while(value >= 0x80)
+  {
+    out.push_back(std::byte(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(std::byte(value));
+}
+
+bool getVarint(std::byte const*& p, std::byte const* end, uint64_t& value) noexcept
+{
+  value = 0;
+  for(int shift = 0; p != end and shift < 64; shift += 7)
+  {
+    const auto b = uint8_t(*p++);
+    value |= uint64_t(b & 0x7f) << shift;
+    if(b < 0x80)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+constexpr uint64_t zigzag(uint64_t delta) noexcept
+{
+  return (delta << 1) ^ uint64_t(int64_t(delta) >> 63);
+}
+
+constexpr uint64_t unzigzag(uint64_t value) noexcept
+{
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Most significant bit first
+class BitWriter
+{
+public:
+  explicit BitWriter(std::vector<std::byte>& out) : out_{out}
+  {
+  }
+
+  void put(uint64_t value, int bits)
+  {
+    if(bits > 32)
+    {
+      put(value >> 32, bits - 32);
+      bits = 32;
+    }
+    acc_   = (acc_ << bits) | (value & ((uint64_t(1) << bits) - 1));
+    count_ += bits;
+    while(count_ >= 8)
+    {
+      count_ -= 8;
+      out_.push_back(std::byte(acc_ >> count_));
+    }
+  }
+
+  void flush()
+  {
+    if(count_ != 0)
+    {
+      out_.push_back(std::byte(acc_ << (8 - count_)));
+      count_ = 0;
+    }
+  }
+
+private:
+  std::vector<std::byte>& out_;
+  uint64_t                acc_   = 0;
+  int                     count_ = 0;
+};
+
+// Reads zeros past the end, which overrun() reports
+class BitReader
+{
+public:
+  explicit BitReader(std::span<std::byte const> in) : p_{in.data()}, end_{in.data() + in.size()}
+  {
+  }
+
+  uint64_t get(int bits) noexcept
+  {
+    if(bits > 32)
+    {
+      const auto high = get(bits - 32);
+      return (high << 32) | get(32);
+    }
+    while(count_ < bits)
+    {
+      overrun_ = overrun_ or p_ == end_;
+      acc_     = (acc_ << 8) | (p_ != end_ ? uint8_t(*p_++) : 0);
+      count_ += 8;
+    }
+    count_ -= bits;
+    return (acc_ >> count_) & ((uint64_t(1) << bits) - 1);
+  }
+
+  bool overrun() const noexcept
+  {
+    return overrun_;
+  }
+  bool atEnd() const noexcept
+  {
+    return p_ == end_;
+  }
+
+private:
+  std::byte const* p_;
+  std::byte const* end_;
+  uint64_t         acc_     = 0;
+  int              count_   = 0;
+  bool             overrun_ = false;
+};
+
+// Differences of `order` to the same element of the previous row, as zig-zag varints; a run of
+// zero differences is a 0 followed by the number of zeros after the first one
+template <typename T, int order>
+void encodeDelta(std::span<std::byte const> in, size_t lanes, std::vector<std::byte>& out)
+{
+  const size_t          count = in.size() / sizeof(T);
+  std::vector<uint64_t> prev(lanes, 0);
+  std::vector<uint64_t> prevDelta(lanes, 0);
+  uint64_t              zeros = 0;
+  for(size_t ii = 0, lane = 0; ii < count; ++ii)
+  {
+    // sign-extended: differences wrap, decoding truncates back to T
+    const auto value = uint64_t(load<T>(in.data() + ii * sizeof(T)));
+    uint64_t   delta = value - prev[lane];
+    prev[lane]       = value;
+    if constexpr(order == 2)
+    {
+      const auto first = delta;
+      delta -= prevDelta[lane];
+      prevDelta[lane] = first;
+    }
+    if(delta == 0)
+    {
+      ++zeros;
+    }
+    else
+    {
+      if(zeros != 0)
+      {
+        putVarint(out, 0);
+        putVarint(out, zeros - 1);
+        zeros = 0;
+      }
+      putVarint(out, zigzag(delta));
+    }
+    lane = lane + 1 == lanes ? 0 : lane + 1;
+  }
+  if(zeros != 0)
+  {
+    putVarint(out, 0);
+    putVarint(out, zeros - 1);
+  }
+}
+
+template <typename T, int order>
+bool decodeDelta(std::span<std::byte const> in, size_t lanes, std::span<std::byte> out)
+{
+  const size_t          count = out.size() / sizeof(T);
+  std::vector<uint64_t> prev(lanes, 0);
+  std::vector<uint64_t> prevDelta(lanes, 0);
+  auto const*           p     = in.data();
+  auto const* const     end   = p + in.size();
+  for(size_t ii = 0, lane = 0; ii < count;)
+  {
+    uint64_t value = 0;
+    if(p != end and uint8_t(*p) < 0x80)
+    {
+      value = uint8_t(*p++); // most differences of slowly changing values fit a byte
+    }
+    else if(not getVarint(p, end, value))
+    {
+      return false;
+    }
+
+    uint64_t repeat = 1;
+    if(value == 0)
+    {
+      // a run of zero differences
+      if(not getVarint(p, end, repeat) or repeat >= count - ii)
+      {
+        return false;
+      }
+      repeat += 1;
+    }
+
+    const uint64_t delta = unzigzag(value);
+    for(const auto last = ii + repeat; ii < last; ++ii)
+    {
+      if constexpr(order == 2)
+      {
+        prevDelta[lane] += delta;
+        prev[lane] += prevDelta[lane];
+      }
+      else
+      {
+        prev[lane] += delta;
+      }
+      store(out.data() + ii * sizeof(T), T(prev[lane]));
+      lane = lane + 1 == lanes ? 0 : lane + 1;
+    }
+  }
+  return p == end;
+}
+
+// Gorilla (Pelkonen et al., VLDB 2015): per element, a 0 bit when unchanged, otherwise 10 and
+// the changed bits of the XOR with the previous value when they fit the previous window, or 11,
+// the window (leading zeros, length - 1) and the changed bits
+template <typename U> struct GorillaState
+{
+  static constexpr int bits  = sizeof(U) * 8;
+  static constexpr int field = bits == 32 ? 5 : 6;
+
+  U   prev  = 0;
+  int lead  = -1; // -1 until a window is sent
+  int trail = 0;
+};
+
+template <typename U>
+void encodeGorilla(std::span<std::byte const> in, size_t lanes, std::vector<std::byte>& out)
+{
+  using State = GorillaState<U>;
+
+  const size_t       count = in.size() / sizeof(U);
+  std::vector<State> states(lanes);
+  BitWriter          writer{out};
+  for(size_t ii = 0, lane = 0; ii < count; ++ii)
+  {
+    auto&      s     = states[lane];
+    const auto value = load<U>(in.data() + ii * sizeof(U));
+    const U    x     = value ^ s.prev;
+    s.prev           = value;
+    lane             = lane + 1 == lanes ? 0 : lane + 1;
+    if(x == 0)
+    {
+      writer.put(0, 1);
+      continue;
+    }
+    const int lead  = std::countl_zero(x);
+    const int trail = std::countr_zero(x);
+    if(s.lead >= 0 and lead >= s.lead and trail >= s.trail)
+    {
+      writer.put(0b10, 2);
+      writer.put(x >> s.trail, State::bits - s.lead - s.trail);
+    }
+    else
+    {
+      const int length = State::bits - lead - trail;
+      writer.put(0b11, 2);
+      writer.put(lead, State::field);
+      writer.put(length - 1, State::field);
+      writer.put(x >> trail, length);
+      s.lead  = lead;
+      s.trail = trail;
+    }
+  }
+  writer.flush();
+}
+
+template <typename U>
+bool decodeGorilla(std::span<std::byte const> in, size_t lanes, std::span<std::byte> out)
+{
+  using State = GorillaState<U>;
+
+  const size_t       count = out.size() / sizeof(U);
+  std::vector<State> states(lanes);
+  BitReader          reader{in};
+  for(size_t ii = 0, lane = 0; ii < count; ++ii)
+  {
+    auto& s = states[lane];
+    lane    = lane + 1 == lanes ? 0 : lane + 1;
+    if(reader.get(1) != 0)
+    {
+      if(reader.get(1) == 0)
+      {
+        if(s.lead < 0)
+        {
+          return false;
+        }
+      }
+      else
+      {
+        const int lead   = int(reader.get(State::field));
+        const int length = int(reader.get(State::field)) + 1;
+        if(lead + length > State::bits)
+        {
+          return false;
+        }
+        s.lead  = lead;
+        s.trail = State::bits - lead - length;
+      }
+      s.prev ^= U(reader.get(State::bits - s.lead - s.trail)) << s.trail;
+    }
+    store(out.data() + ii * sizeof(U), s.prev);
+  }
+  return not reader.overrun() and reader.atEnd();
+}
+
+// Repeat count, then the row
+void encodeRunLength(std::span<std::byte const> in, size_t width, std::vector<std::byte>& out)
+{
+  for(size_t at = 0; at < in.size();)
+  {
+    const auto row = in.subspan(at, width);
+    size_t     end = at + width;
+    while(end < in.size() and std::memcmp(in.data() + end, row.data(), width) == 0)
+    {
+      end += width;
+    }
+    putVarint(out, (end - at) / width);
+    out.insert(out.end(), row.begin(), row.end());
+    at = end;
+  }
+}
+
+bool decodeRunLength(std::span<std::byte const> in, size_t width, std::span<std::byte> out)
+{
+  auto const*       p   = in.data();
+  auto const* const end = p + in.size();
+  for(size_t at = 0; at < out.size();)
+  {
+    uint64_t repeat = 0;
+    if(not getVarint(p, end, repeat) or repeat == 0 or repeat > (out.size() - at) / width
+       or size_t(end - p) < width)
+    {
+      return false;
+    }
+    if(width == 1)
+    {
+      std::memset(out.data() + at, int(*p), repeat);
+    }
+    else
+    {
+      for(uint64_t ii = 0; ii < repeat; ++ii)
+      {
+        std::memcpy(out.data() + at + ii * width, p, width);
+      }
+    }
+    at += repeat * width;
+    p += width;
+  }
+  return p == end;
+}
+
+// Calls fn.template operator()<T>() with the element type of a numeric codec, if it applies
+template <typename Fn>
+bool visitCodecType(Codec codec, QMetaType::Type type, size_t elementSize, size_t width, Fn&& fn)
+{
+  bool applies = false;
+  if(elementSize != 0 and width % elementSize == 0)
+  {
+    visitSampleType(type,
+                    [&]<typename T>
+                    {
+                      if(sizeof(T) != elementSize)
+                      {
+                        return;
+                      }
+                      if constexpr(std::is_integral_v<T>)
+                      {
+                        applies = codec == Codec::delta or codec == Codec::deltaOfDelta;
+                      }
+                      else
+                      {
+                        applies = codec == Codec::gorilla;
+                      }
+                      if(applies)
+                      {
+                        fn.template operator()<T>();
+                      }
+                    });
+  }
+  return applies;
+}
+} // namespace
+
+bool supports(Codec codec, QMetaType::Type type, size_t elementSize) noexcept
+{
+  switch(codec)
+  {
+    case Codec::none:
+    case Codec::runLength:
+      return true;
+    default:
+      return visitCodecType(codec, type, elementSize, elementSize, []<typename T> {});
+  }
+}
+
+bool encode(Codec                      codec,
+            QMetaType::Type            type,
+            size_t                     elementSize,
+            size_t                     width,
+            std::span<std::byte const> rows,
+            std::vector<std::byte>&    out)
+{
+  if(codec == Codec::none)
+  {
+    out.insert(out.end(), rows.begin(), rows.end());
+    return true;
+  }
+  if(width == 0 or rows.size() % width != 0)
+  {
+    return false;
+  }
+  if(codec == Codec::runLength)
+  {
+    encodeRunLength(rows, width, out);
+    return true;
+  }
+
+  const size_t lanes = width / std::max<size_t>(elementSize, 1);
+  return visitCodecType(codec,
+                        type,
+                        elementSize,
+                        width,
+                        [&]<typename T>
+                        {
+                          if constexpr(std::is_integral_v<T>)
+                          {
+                            codec == Codec::delta ? encodeDelta<T, 1>(rows, lanes, out)
+                                                  : encodeDelta<T, 2>(rows, lanes, out);
+                          }
+                          else
+                          {
+                            using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+                            encodeGorilla<U>(rows, lanes, out);
+                          }
+                        });
+}
+
+bool decode(Codec                      codec,
+            QMetaType::Type            type,
+            size_t                     elementSize,
+            size_t                     width,
+            std::span<std::byte const> in,
+            std::span<std::byte>       out)
+{
+  if(codec == Codec::none)
+  {
+    if(in.size() != out.size())
+    {
+      return false;
+    }
+    std::memcpy(out.data(), in.data(), in.size());
+    return true;
+  }
+  if(width == 0 or out.size() % width != 0)
+  {
+    return false;
+  }
+  if(codec == Codec::runLength)
+  {
+    return decodeRunLength(in, width, out);
+  }
+
+  const size_t lanes = width / std::max<size_t>(elementSize, 1);
+  bool         ok    = false;
+  const bool   known = visitCodecType(
+      codec,
+      type,
+      elementSize,
+      width,
+      [&]<typename T>
+      {
+        if constexpr(std::is_integral_v<T>)
+        {
+          ok = codec == Codec::delta ? decodeDelta<T, 1>(in, lanes, out)
+                                     : decodeDelta<T, 2>(in, lanes, out);
+        }
+        else
+        {
+          using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+          ok      = decodeGorilla<U>(in, lanes, out);
+        }
+      });
+  return known and ok;
+}
+
+Codec pick(QMetaType::Type type, size_t elementSize, size_t width, std::span<std::byte const> rows)
+{
+  if(width == 0)
+  {
+    return Codec::none;
+  }
+  const auto sample = rows.first(std::min(rows.size() / width, pick_rows) * width);
+
+  Codec                  best     = Codec::none;
+  size_t                 bestSize = sample.size() - sample.size() / 8; // worth decoding
+  std::vector<std::byte> encoded;
+  for(uint32_t ii = 1; ii < codecCount; ++ii)
+  {
+    const auto codec = Codec(ii);
+    encoded.clear();
+    if(supports(codec, type, elementSize)
+       and encode(codec, type, elementSize, width, sample, encoded) and encoded.size() < bestSize)
+    {
+      best     = codec;
+      bestSize = encoded.size();
+    }
+  }
+  return best;
+}
+} // namespace recording
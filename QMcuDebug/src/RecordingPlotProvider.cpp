@@ -0,0 +1,408 @@
+#include <QMcu/Debug/RecordingPlotProvider.hpp>
+#include <QMcu/Debug/Sample.hpp>
+
+#include <Logging.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// Frames requested per second while playing
+constexpr int frame_rate = 60;
+
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+RecordingPlotProvider::RecordingPlotProvider(QObject* parent) : AbstractPlotDataProvider{parent}
+{
+  timer_.setTimerType(Qt::PreciseTimer);
+  timer_.setInterval(1000 / frame_rate);
+  connect(&timer_, &QTimer::timeout, this, &RecordingPlotProvider::dataChanged);
+}
+
+RecordingPlotProvider::~RecordingPlotProvider() = default;
+
+QStringList RecordingPlotProvider::channels() const
+{
+  QStringList out;
+  if(reader_ != nullptr)
+  {
+    for(auto const& ch : reader_->channels())
+    {
+      out.append(ch.name);
+    }
+  }
+  return out;
+}
+
+double RecordingPlotProvider::duration() const noexcept
+{
+  return reader_ != nullptr ? (reader_->lastNs() - reader_->firstNs()) / 1e9 : 0.0;
+}
+
+void RecordingPlotProvider::setFile(QUrl const& file)
+{
+  if(file == file_)
+  {
+    return;
+  }
+  file_          = file;
+  levelsBuilder_ = {}; // of the previous file
+  levels_        = nullptr;
+
+  auto reader = std::make_shared<RecordingReader>();
+  if(reader->open(file_.isLocalFile() ? file_.toLocalFile() : file_.toString()))
+  {
+    reader_ = std::move(reader);
+    if(not reader_->hasLevels())
+    {
+      buildLevels();
+    }
+  }
+  else
+  {
+    reader_ = nullptr;
+  }
+  emit fileChanged();
+  select();
+}
+
+void RecordingPlotProvider::buildLevels()
+{
+  levelsBuilder_ = std::jthread(
+      [this, reader = reader_](std::stop_token stop)
+      {
+        auto levels = std::make_shared<Levels const>(reader->buildLevels(stop));
+        if(stop.stop_requested())
+        {
+          return;
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, reader, levels = std::move(levels)]
+            {
+              if(reader == reader_)
+              {
+                levels_ = levels;
+                select();
+              }
+            },
+            Qt::QueuedConnection);
+      });
+}
+
+void RecordingPlotProvider::setChannel(QString const& channel)
+{
+  if(channel != channel_)
+  {
+    channel_ = channel;
+    emit channelChanged();
+    select();
+  }
+}
+
+void RecordingPlotProvider::select()
+{
+  std::shared_ptr<Source const> source;
+  if(reader_ != nullptr)
+  {
+    auto const& channels = reader_->channels();
+    const auto  it       = std::ranges::find(channels, channel_, &RecordingReader::Channel::name);
+    if(it != channels.end())
+    {
+      source = std::make_shared<Source const>(
+          Source{reader_, size_t(it - channels.begin()), levels_});
+    }
+    else if(channel_.isEmpty() and not channels.empty())
+    {
+      source = std::make_shared<Source const>(Source{reader_, 0, levels_});
+    }
+    else
+    {
+      qWarning(lcWatcher) << "No channel" << channel_ << "in" << file_;
+    }
+  }
+  // resumes where the previous source was
+  seekNs_.store(int64_t(position_ * 1e9), std::memory_order_relaxed);
+  source_.store(std::move(source), std::memory_order_release);
+  emit dataChanged();
+}
+
+void RecordingPlotProvider::setSampleCount(int count)
+{
+  // applies when the plot is initialized
+  if(count > 0 and count != sampleCount_)
+  {
+    sampleCount_ = count;
+    emit sampleCountChanged();
+  }
+}
+
+void RecordingPlotProvider::setPlaying(bool playing)
+{
+  if(playing != this->playing())
+  {
+    if(playing and reader_ != nullptr and position_ >= duration())
+    {
+      setPosition(0.0); // from the start again
+    }
+    running_.store(playing, std::memory_order_relaxed);
+    if(playing)
+    {
+      timer_.start();
+    }
+    else
+    {
+      timer_.stop();
+    }
+    emit playingChanged();
+  }
+}
+
+void RecordingPlotProvider::setSpeed(double speed)
+{
+  speed = speed > 0.0 ? std::clamp(speed, 0.1, 100.0) : 0.0;
+  if(speed != speed_)
+  {
+    speed_ = speed;
+    pace_.store(speed, std::memory_order_relaxed);
+    emit speedChanged();
+  }
+}
+
+void RecordingPlotProvider::setLoop(bool loop)
+{
+  if(loop != loop_)
+  {
+    loop_ = loop;
+    looping_.store(loop, std::memory_order_relaxed);
+    emit loopChanged();
+  }
+}
+
+void RecordingPlotProvider::setPosition(double seconds)
+{
+  seconds = std::max(seconds, 0.0);
+  if(seconds != position_)
+  {
+    position_ = seconds;
+    seekNs_.store(int64_t(seconds * 1e9), std::memory_order_relaxed);
+    emit positionChanged();
+    emit dataChanged();
+  }
+}
+
+bool RecordingPlotProvider::initializePlotContext(PlotContext& ctx)
+{
+  const auto source = source_.load(std::memory_order_acquire);
+  if(source == nullptr or source->reader->rows() == 0)
+  {
+    qWarning(lcWatcher) << "No recording to play !";
+    return false;
+  }
+  auto const& ch          = source->reader->channels()[source->channel];
+  size_t      elementSize = 0;
+  if(not visitSampleType(ch.typeId, [&]<typename T> { elementSize = sizeof(T); })
+     or elementSize != ch.elementSize)
+  {
+    qWarning(lcWatcher) << "Cannot plot recorded" << ch.name;
+    return false;
+  }
+  capacity_   = size_t(sampleCount_);
+  mappedData_ = createMappedStorageBuffer(ch.typeId, capacity_);
+  std::ranges::fill(mappedData_, std::byte(0));
+  tid_         = ch.typeId;
+  elementSize_ = elementSize;
+  shown_       = nullptr;
+  end_         = 0;
+  shownCount_  = 0;
+  lastFrameNs_ = 0;
+  return true;
+}
+
+uint64_t RecordingPlotProvider::advance(Source const& source)
+{
+  auto const& reader = *source.reader;
+  const auto  rows   = reader.rows();
+  const auto  now    = now_ns();
+  const auto  pace   = pace_.load(std::memory_order_relaxed);
+  const auto  seek   = seekNs_.exchange(-1, std::memory_order_relaxed);
+  const bool  seeked = seek >= 0;
+  if(seeked)
+  {
+    clockNs_ = reader.firstNs() + seek;
+  }
+
+  const bool running = running_.load(std::memory_order_relaxed);
+  uint64_t   end     = 0;
+  if(running and not seeked and pace == 0.0)
+  {
+    // as fast as possible: the next window
+    end = end_ + capacity_;
+    if(end > rows and looping_.load(std::memory_order_relaxed) and end_ == rows)
+    {
+      end = capacity_;
+    }
+    end      = std::min(end, rows);
+    clockNs_ = reader.timeAt(end - 1, times_);
+  }
+  else
+  {
+    if(running and lastFrameNs_ != 0 and not seeked)
+    {
+      clockNs_ += int64_t(double(now - lastFrameNs_) * pace);
+    }
+    if(clockNs_ > reader.lastNs() and running and looping_.load(std::memory_order_relaxed))
+    {
+      clockNs_ = reader.firstNs();
+    }
+    clockNs_ = std::clamp(clockNs_, reader.firstNs(), reader.lastNs());
+    end      = reader.rowsUntil(clockNs_, times_);
+  }
+  lastFrameNs_ = running ? now : 0;
+
+  const bool atEnd = end == rows and not looping_.load(std::memory_order_relaxed);
+  if(running and atEnd)
+  {
+    running_.store(false, std::memory_order_relaxed);
+  }
+  if(running or seeked)
+  {
+    QMetaObject::invokeMethod(
+        this,
+        [this, position = (clockNs_ - reader.firstNs()) / 1e9, stop = running and atEnd]
+        {
+          if(position != position_)
+          {
+            position_ = position;
+            emit positionChanged();
+          }
+          if(stop)
+          {
+            setPlaying(false);
+          }
+        },
+        Qt::QueuedConnection);
+  }
+  return std::max<uint64_t>(end, 1);
+}
+
+void RecordingPlotProvider::copy(Source const& source, uint64_t first, uint64_t end)
+{
+  auto const& reader = *source.reader;
+  const auto  width  = reader.channels()[source.channel].width;
+  auto*       out    = mappedData_.data();
+  for(size_t ci = reader.chunkOfRow(first); ci < reader.chunks().size() and first < end; ++ci)
+  {
+    // straight from the mapped file, unless encoded
+    auto const& chunk  = reader.chunks()[ci];
+    auto        column = chunk.column(source.channel);
+    if(chunk.codec(source.channel) != recording::Codec::none)
+    {
+      if(ci != decodedChunk_)
+      {
+        decoded_.resize(chunk.count() * width);
+        decodedChunk_ = reader.read(chunk, source.channel, decoded_) ? ci : npos;
+      }
+      if(decodedChunk_ != ci)
+      {
+        break; // reported
+      }
+      column = decoded_;
+    }
+    const auto from  = first - chunk.row;
+    const auto count = std::min<uint64_t>(chunk.count() - from, end - first);
+    if(width == elementSize_)
+    {
+      std::memcpy(out, column.data() + from * width, count * width);
+    }
+    else
+    {
+      // first element of each array
+      for(uint64_t ii = 0; ii < count; ++ii)
+      {
+        std::memcpy(out + ii * elementSize_, column.data() + (from + ii) * width, elementSize_);
+      }
+    }
+    out += count * elementSize_;
+    first += count;
+  }
+}
+
+RecordingPlotProvider::UpdateRange RecordingPlotProvider::update(PlotContext& ctx)
+{
+  const auto source = source_.load(std::memory_order_acquire);
+  if(source != shown_)
+  {
+    if(source != nullptr and source->reader->channels()[source->channel].typeId != tid_)
+    {
+      qWarning(lcWatcher) << "Cannot switch the plot to recorded"
+                          << source->reader->channels()[source->channel].name
+                          << ": its type differs";
+    }
+    shown_        = source;
+    end_          = 0;
+    decodedChunk_ = npos;
+    times_        = {};
+  }
+  if(source == nullptr or source->reader->rows() == 0
+     or source->reader->channels()[source->channel].typeId != tid_)
+  {
+    return mappedData_.first(shownCount_ * elementSize_);
+  }
+
+  const auto end   = advance(*source);
+  const auto first = end > capacity_ ? end - capacity_ : 0;
+  const auto count = end - first;
+
+  // visible part of the window, from its start
+  auto [a, b] = ctx.visibleX();
+  if(not std::isfinite(a) or not std::isfinite(b) or b <= a)
+  {
+    a = 0.0;
+    b = double(count);
+  }
+  const auto lo = uint64_t(std::clamp(std::floor(a), 0.0, double(count - 1)));
+  const auto hi = uint64_t(std::clamp(std::ceil(b), double(lo), double(count - 1)));
+
+  // a few vertices per pixel column at most
+  auto const& pyramid  = source->pyramid();
+  const auto  perPixel = double(hi - lo + 1) / std::max(ctx.view.viewport.width(), 1);
+  const auto  level    = pyramid.isValid() ? pyramid.levelFor(perPixel) : 0;
+
+  if(end != end_ or level != level_ or lo != lo_ or hi != hi_)
+  {
+    if(level == 0)
+    {
+      copy(*source, first + lo, first + hi + 1);
+      shownCount_ = size_t(hi - lo + 1);
+      ctx.lod     = {double(lo), 1.0};
+    }
+    else
+    {
+      // (min, max) pairs of the buckets over the visible samples
+      const auto bucket = MinMaxPyramid::bucketSize(level);
+      const auto from   = (first + lo) / bucket;
+      const auto to     = std::min((first + hi) / bucket, pyramid.buckets(level) - 1);
+      const auto pairs  = std::min<size_t>(to - from + 1, capacity_ / 2);
+      const auto bytes  = pyramid.level(level).subspan(from * 2 * elementSize_,
+                                                       pairs * 2 * elementSize_);
+      std::memcpy(mappedData_.data(), bytes.data(), bytes.size());
+      shownCount_ = 2 * pairs;
+      // the min at the start of its bucket, the max in the middle
+      ctx.lod = {double(from * bucket) - double(first), bucket / 2.0};
+    }
+    end_   = end;
+    level_ = level;
+    lo_    = lo;
+    hi_    = hi;
+  }
+  return mappedData_.first(shownCount_ * elementSize_);
+}
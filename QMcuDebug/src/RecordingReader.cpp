@@ -0,0 +1,349 @@
+#include <QMcu/Debug/RecordingCodecs.hpp>
+#include <QMcu/Debug/RecordingReader.hpp>
+#include <QMcu/Debug/RecordingWriter.hpp>
+
+#include <Logging.hpp>
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstring>
+
+std::span<std::byte const> RecordingReader::Chunk::column(size_t channel) const noexcept
+{
+  auto const& c = columns[channel];
+  return {reinterpret_cast<std::byte const*>(header) + c.offset, size_t(c.size)};
+}
+
+RecordingReader::RecordingReader()  = default;
+RecordingReader::~RecordingReader() = default;
+
+bool RecordingReader::open(QString const& path)
+{
+  close();
+
+  auto file = std::make_unique<QFile>(path);
+  if(not file->open(QIODevice::ReadOnly) or file->size() < qint64(sizeof(recording::FileHeader)))
+  {
+    qWarning(lcWatcher) << "Cannot open recording" << path;
+    return false;
+  }
+  auto const* mapped = file->map(0, file->size());
+  if(mapped == nullptr)
+  {
+    qWarning(lcWatcher) << "Cannot map recording" << path << ":" << file->errorString();
+    return false;
+  }
+  const std::span data{reinterpret_cast<std::byte const*>(mapped), size_t(file->size())};
+
+  auto const* header = reinterpret_cast<recording::FileHeader const*>(data.data());
+  if(std::memcmp(header->magic, recording::magic, sizeof(header->magic)) != 0)
+  {
+    qWarning(lcWatcher) << path << "is not a recording";
+    return false;
+  }
+  if(header->version != recording::version)
+  {
+    qWarning(lcWatcher) << "Unsupported version" << header->version << "of recording" << path;
+    return false;
+  }
+  const size_t channelCount = header->channelCount;
+  size_t       offset       = sizeof(*header) + channelCount * sizeof(recording::ChannelHeader);
+  if(offset > data.size())
+  {
+    qWarning(lcWatcher) << "Truncated recording" << path;
+    return false;
+  }
+
+  std::vector<Channel> channels;
+  auto const* table = reinterpret_cast<recording::ChannelHeader const*>(header + 1);
+  for(size_t ii = 0; ii < channelCount; ++ii)
+  {
+    auto const& ch       = table[ii];
+    const auto  nameSize = std::min<size_t>(ch.nameSize, sizeof(ch.name));
+    channels.push_back({QString::fromUtf8(ch.name, qsizetype(nameSize)),
+                        QMetaType::Type(ch.typeId),
+                        ch.elementSize,
+                        ch.width});
+  }
+
+  // whole chunks only
+  std::vector<Chunk> chunks;
+  uint64_t           rows        = 0;
+  const size_t       headersSize = sizeof(recording::ChunkHeader)
+                             + channelCount * sizeof(recording::ColumnHeader);
+  while(offset + headersSize <= data.size())
+  {
+    auto const* chunk = reinterpret_cast<recording::ChunkHeader const*>(data.data() + offset);
+    if(chunk->magic != recording::chunkMagic or chunk->size < headersSize
+       or chunk->size > data.size() - offset)
+    {
+      break;
+    }
+    const std::span columns{reinterpret_cast<recording::ColumnHeader const*>(chunk + 1),
+                            channelCount};
+    // encoded sizes are checked when decoding
+    const auto fits = [](uint32_t codec, uint64_t size, uint64_t packed)
+    { return codec < recording::codecCount and (codec != 0 or size == packed); };
+    bool valid = chunk->timesSize <= chunk->size - headersSize
+                 and fits(chunk->timesCodec, chunk->timesSize, chunk->count * sizeof(int64_t));
+    for(size_t ii = 0; ii < channelCount and valid; ++ii)
+    {
+      auto const& c = columns[ii];
+      valid = c.offset <= chunk->size and c.size <= chunk->size - c.offset
+              and fits(c.codec, c.size, chunk->count * channels[ii].width);
+    }
+    if(not valid)
+    {
+      break;
+    }
+    const auto times = data.subspan(offset + headersSize, chunk->timesSize);
+    chunks.push_back({rows, chunk, columns, times});
+    rows += chunk->count;
+    offset += chunk->size;
+  }
+  if(offset != data.size())
+  {
+    qWarning(lcWatcher) << "Ignoring" << data.size() - offset << "trailing bytes of" << path;
+  }
+
+  file_     = std::move(file);
+  data_     = data;
+  channels_ = std::move(channels);
+  chunks_   = std::move(chunks);
+  rows_     = rows;
+
+  if(not mapLevels(RecordingWriter::levelsPath(path)))
+  {
+    pyramids_.resize(channels_.size()); // invalid, see buildLevels()
+  }
+  return true;
+}
+
+bool RecordingReader::mapLevels(QString const& path)
+{
+  auto file = std::make_unique<QFile>(path);
+  if(not file->exists())
+  {
+    return false;
+  }
+  auto const* mapped = file->open(QIODevice::ReadOnly)
+                               and file->size() >= qint64(sizeof(recording::LodHeader))
+                           ? file->map(0, file->size())
+                           : nullptr;
+  if(mapped == nullptr)
+  {
+    qWarning(lcWatcher) << "Cannot map levels of detail" << path;
+    return false;
+  }
+  const std::span data{reinterpret_cast<std::byte const*>(mapped), size_t(file->size())};
+
+  auto const* header = reinterpret_cast<recording::LodHeader const*>(data.data());
+  if(std::memcmp(header->magic, recording::lodMagic, sizeof(header->magic)) != 0
+     or header->version != recording::version or header->factor != MinMaxPyramid::factor)
+  {
+    qWarning(lcWatcher) << path << "are not levels of detail";
+    return false;
+  }
+  if(header->rows != rows_)
+  {
+    return false; // of a recording that was still running
+  }
+  const size_t levelCount = header->levelCount;
+  if(levelCount > (data.size() - sizeof(*header)) / sizeof(recording::LodLevel))
+  {
+    qWarning(lcWatcher) << "Truncated levels of detail" << path;
+    return false;
+  }
+
+  std::vector<std::vector<std::span<std::byte const>>> levels(channels_.size());
+  auto const* table = reinterpret_cast<recording::LodLevel const*>(header + 1);
+  for(size_t ii = 0; ii < levelCount; ++ii)
+  {
+    auto const& l       = table[ii];
+    const auto  buckets = (rows_ + MinMaxPyramid::bucketSize(l.level) - 1)
+                         / MinMaxPyramid::bucketSize(l.level);
+    if(l.channel >= channels_.size() or l.level != levels[l.channel].size() + 1
+       or l.offset > data.size() or l.size > data.size() - l.offset
+       or l.size != buckets * 2 * channels_[l.channel].elementSize)
+    {
+      qWarning(lcWatcher) << "Invalid levels of detail" << path;
+      return false;
+    }
+    levels[l.channel].push_back(data.subspan(l.offset, l.size));
+  }
+
+  std::vector<MinMaxPyramid> pyramids;
+  for(size_t ch = 0; ch < channels_.size(); ++ch)
+  {
+    pyramids.emplace_back(channels_[ch].typeId, rows_, std::move(levels[ch]));
+    if(pyramids.back().isValid() and pyramids.back().elementSize() != channels_[ch].elementSize)
+    {
+      pyramids.back() = {};
+    }
+  }
+  lodFile_  = std::move(file);
+  pyramids_ = std::move(pyramids);
+  return true;
+}
+
+std::vector<MinMaxPyramid> RecordingReader::buildLevels(std::stop_token stop) const
+{
+  std::vector<MinMaxPyramid> pyramids;
+  std::vector<std::byte>     decoded;
+  for(size_t ch = 0; ch < channels_.size(); ++ch)
+  {
+    MinMaxPyramid pyramid{channels_[ch].typeId};
+    if(pyramid.elementSize() == channels_[ch].elementSize)
+    {
+      for(auto const& chunk : chunks_)
+      {
+        if(stop.stop_requested())
+        {
+          return {};
+        }
+        auto rows = chunk.column(ch);
+        if(chunk.codec(ch) != recording::Codec::none)
+        {
+          decoded.resize(chunk.count() * channels_[ch].width);
+          if(not read(chunk, ch, decoded))
+          {
+            pyramid = {}; // reported; partial levels would not match the rows
+            break;
+          }
+          rows = decoded;
+        }
+        pyramid.append(rows.data(), chunk.count(), channels_[ch].width);
+      }
+    }
+    else
+    {
+      pyramid = {};
+    }
+    pyramids.push_back(std::move(pyramid));
+  }
+  return pyramids;
+}
+
+void RecordingReader::close()
+{
+  pyramids_.clear();
+  lodFile_.reset();
+  chunks_.clear();
+  channels_.clear();
+  data_ = {};
+  rows_ = 0;
+  file_.reset(); // unmaps
+}
+
+size_t RecordingReader::chunkAt(int64_t timestampNs) const noexcept
+{
+  const auto it = std::ranges::upper_bound(
+      chunks_, timestampNs, {}, [](Chunk const& c) { return c.header->firstNs; });
+  return it == chunks_.begin() ? 0 : size_t(it - chunks_.begin()) - 1;
+}
+
+size_t RecordingReader::chunkOfRow(uint64_t row) const noexcept
+{
+  const auto it = std::ranges::upper_bound(chunks_, row, {}, &Chunk::row);
+  return it == chunks_.begin() ? 0 : size_t(it - chunks_.begin()) - 1;
+}
+
+uint64_t RecordingReader::rowsUntil(int64_t timestampNs) const
+{
+  TimesCache cache;
+  return rowsUntil(timestampNs, cache);
+}
+
+uint64_t RecordingReader::rowsUntil(int64_t timestampNs, TimesCache& cache) const
+{
+  if(chunks_.empty())
+  {
+    return 0;
+  }
+  const auto  ci    = chunkAt(timestampNs);
+  auto const& chunk = chunks_[ci];
+  if(timestampNs < chunk.header->firstNs or timestampNs >= chunk.header->lastNs)
+  {
+    return chunk.row + (timestampNs < chunk.header->firstNs ? 0 : chunk.count());
+  }
+  const auto times = chunkTimes(ci, cache);
+  if(times.empty())
+  {
+    return chunk.row;
+  }
+  const auto it = std::ranges::upper_bound(times, timestampNs);
+  return chunk.row + uint64_t(it - times.begin());
+}
+
+int64_t RecordingReader::timeAt(uint64_t row) const
+{
+  TimesCache cache;
+  return timeAt(row, cache);
+}
+
+int64_t RecordingReader::timeAt(uint64_t row, TimesCache& cache) const
+{
+  if(chunks_.empty())
+  {
+    return 0;
+  }
+  const auto  ci    = chunkOfRow(row);
+  auto const& chunk = chunks_[ci];
+  const auto  at    = std::min<uint64_t>(row - chunk.row, chunk.count() - 1);
+  if(at == chunk.count() - 1)
+  {
+    return chunk.header->lastNs;
+  }
+  const auto times = chunkTimes(ci, cache);
+  return times.empty() ? chunk.header->firstNs : times[at];
+}
+
+std::span<int64_t const> RecordingReader::chunkTimes(size_t chunk, TimesCache& cache) const
+{
+  if(cache.chunk != chunk)
+  {
+    cache.chunk = chunk;
+    cache.times.resize(chunks_[chunk].count());
+    if(not times(chunks_[chunk], cache.times))
+    {
+      cache.times.clear(); // reported once
+    }
+  }
+  return cache.times;
+}
+
+bool RecordingReader::times(Chunk const& chunk, std::span<int64_t> out) const
+{
+  if(out.size() != chunk.count())
+  {
+    return false;
+  }
+  if(not recording::decode(recording::Codec(chunk.header->timesCodec),
+                           QMetaType::LongLong,
+                           sizeof(int64_t),
+                           sizeof(int64_t),
+                           chunk.times,
+                           std::as_writable_bytes(out)))
+  {
+    qWarning(lcWatcher) << "Corrupt timestamps in the chunk of row" << chunk.row;
+    return false;
+  }
+  return true;
+}
+
+bool RecordingReader::read(Chunk const& chunk, size_t channel, std::span<std::byte> out) const
+{
+  auto const& ch = channels_[channel];
+  if(out.size() != chunk.count() * ch.width)
+  {
+    return false;
+  }
+  if(not recording::decode(
+         chunk.codec(channel), ch.typeId, ch.elementSize, ch.width, chunk.column(channel), out))
+  {
+    qWarning(lcWatcher) << "Corrupt" << ch.name << "samples in the chunk of row" << chunk.row;
+    return false;
+  }
+  return true;
+}
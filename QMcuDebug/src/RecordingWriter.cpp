@@ -0,0 +1,330 @@
+#include <QMcu/Debug/RecordingCodecs.hpp>
+#include <QMcu/Debug/RecordingWriter.hpp>
+#include <QMcu/Debug/Sample.hpp>
+
+#include <Logging.hpp>
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+RecordingWriter::RecordingWriter(size_t chunkRows) : chunkRows_{std::max<size_t>(chunkRows, 1)}
+{
+}
+
+RecordingWriter::~RecordingWriter()
+{
+  close();
+}
+
+bool RecordingWriter::open(QString const& path, std::vector<Channel> channels)
+{
+  close();
+
+  auto file = std::make_unique<QFile>(path);
+  if(not file->open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    qCritical(lcWatcher) << "Cannot record to" << path << ":" << file->errorString();
+    return false;
+  }
+
+  recording::FileHeader header;
+  std::memcpy(header.magic, recording::magic, sizeof(header.magic));
+  header.channelCount = uint32_t(channels.size());
+  header.chunkRows    = chunkRows_;
+
+  std::vector<recording::ChannelHeader> table(channels.size());
+  for(size_t ii = 0; ii < channels.size(); ++ii)
+  {
+    const auto name = channels[ii].name.toUtf8().left(recording::maxNameSize);
+    auto&      ch   = table[ii];
+    ch.typeId       = uint32_t(channels[ii].typeId);
+    ch.elementSize  = uint32_t(channels[ii].elementSize);
+    ch.width        = uint32_t(channels[ii].width);
+    ch.nameSize     = uint32_t(name.size());
+    std::memcpy(ch.name, name.data(), name.size());
+  }
+  const auto tableSize = qint64(table.size() * sizeof(recording::ChannelHeader));
+  if(file->write(reinterpret_cast<char const*>(&header), sizeof(header)) != sizeof(header)
+     or file->write(reinterpret_cast<char const*>(table.data()), tableSize) != tableSize)
+  {
+    qCritical(lcWatcher) << "Cannot record to" << path << ":" << file->errorString();
+    return false;
+  }
+
+  pyramids_.clear();
+  for(auto const& ch : channels)
+  {
+    pyramids_.emplace_back(ch.typeId);
+  }
+  channels_ = std::move(channels);
+  file_     = std::move(file);
+  rows_     = 0;
+  bytesWritten_.store(sizeof(header) + tableSize, std::memory_order_relaxed);
+  failed_.store(false, std::memory_order_relaxed);
+  newChunk();
+  thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+  return true;
+}
+
+void RecordingWriter::close()
+{
+  if(file_ == nullptr)
+  {
+    return;
+  }
+  if(not current_->times.empty())
+  {
+    queue();
+  }
+  // the thread drains the queue before leaving
+  thread_.request_stop();
+  thread_.join();
+  thread_ = {};
+  file_->close();
+  if(not failed())
+  {
+    writeLevels(levelsPath(file_->fileName()), pyramids_, rows_);
+  }
+  file_.reset();
+  current_.reset();
+  pyramids_.clear();
+}
+
+void RecordingWriter::newChunk()
+{
+  current_ = std::make_unique<Chunk>();
+  current_->times.reserve(chunkRows_);
+  current_->columns.resize(channels_.size());
+  for(size_t ii = 0; ii < channels_.size(); ++ii)
+  {
+    current_->columns[ii].reserve(chunkRows_ * channels_[ii].width);
+  }
+}
+
+void RecordingWriter::queue()
+{
+  {
+    std::lock_guard lock{queueMutex_};
+    queue_.push_back(std::move(current_));
+  }
+  queueReady_.notify_one();
+}
+
+void RecordingWriter::append(int64_t timestampNs, std::span<std::span<std::byte const> const> row)
+{
+  if(file_ == nullptr)
+  {
+    return;
+  }
+  current_->times.push_back(timestampNs);
+  for(size_t ii = 0; ii < channels_.size(); ++ii)
+  {
+    auto&      column = current_->columns[ii];
+    const auto width  = channels_[ii].width;
+    const auto at     = column.size();
+    column.resize(at + width);
+    if(ii < row.size())
+    {
+      std::memcpy(column.data() + at, row[ii].data(), std::min(row[ii].size(), width));
+    }
+  }
+  ++rows_;
+
+  if(current_->times.size() == chunkRows_)
+  {
+    queue();
+    newChunk();
+  }
+}
+
+void RecordingWriter::run(std::stop_token stop)
+{
+  while(true)
+  {
+    std::unique_ptr<Chunk> chunk;
+    {
+      std::unique_lock lock{queueMutex_};
+      queueReady_.wait(lock, stop, [this] { return not queue_.empty(); });
+      if(queue_.empty())
+      {
+        return; // stopped, all written
+      }
+      chunk = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    if(not failed() and not write(*chunk))
+    {
+      qCritical(lcWatcher) << "Recording to" << file_->fileName() << "failed:"
+                           << file_->errorString();
+      failed_.store(true, std::memory_order_relaxed);
+    }
+  }
+}
+
+bool RecordingWriter::write(Chunk const& chunk)
+{
+  const auto count = chunk.times.size();
+
+  // encoded here, so that the disk only sees the encoded bytes
+  const auto encode = [](std::optional<recording::Codec> codec,
+                         QMetaType::Type                 type,
+                         size_t                          elementSize,
+                         size_t                          width,
+                         std::span<std::byte const>      rows,
+                         std::vector<std::byte>&         encoded,
+                         std::span<std::byte const>&     stored)
+  {
+    // trying the codecs is the costly part, forced ones skip it
+    const auto picked = codec ? *codec : recording::pick(type, elementSize, width, rows);
+    stored            = rows;
+    if(picked != recording::Codec::none and recording::supports(picked, type, elementSize)
+       and recording::encode(picked, type, elementSize, width, rows, encoded))
+    {
+      stored = encoded;
+      return picked;
+    }
+    return recording::Codec::none;
+  };
+
+  std::vector<recording::ColumnHeader> columns(channels_.size());
+  recording::ChunkHeader               header;
+  header.count   = uint32_t(count);
+  header.firstNs = chunk.times.front();
+  header.lastNs  = chunk.times.back();
+
+  std::vector<std::byte>     encodedTimes;
+  std::span<std::byte const> times;
+  header.timesCodec = uint32_t(encode(std::nullopt,
+                                      QMetaType::LongLong,
+                                      sizeof(int64_t),
+                                      sizeof(int64_t),
+                                      std::as_bytes(std::span{chunk.times}),
+                                      encodedTimes,
+                                      times));
+  header.timesSize  = times.size();
+
+  std::vector<std::vector<std::byte>>     encoded(channels_.size());
+  std::vector<std::span<std::byte const>> stored(channels_.size());
+
+  uint64_t offset = sizeof(header) + columns.size() * sizeof(recording::ColumnHeader);
+  offset += recording::align(times.size());
+  for(size_t ii = 0; ii < channels_.size(); ++ii)
+  {
+    auto&       column = columns[ii];
+    auto const& ch     = channels_[ii];
+    const auto& data   = chunk.columns[ii];
+    column.codec       = uint32_t(
+        encode(ch.codec, ch.typeId, ch.elementSize, ch.width, data, encoded[ii], stored[ii]));
+    column.offset = offset;
+    column.size   = stored[ii].size();
+    offset += recording::align(stored[ii].size());
+
+    // statistics for the overview, decoded here rather than on the sampling side
+    const auto decode = realDecoder(channels_[ii].typeId);
+    const auto step   = channels_[ii].elementSize;
+    if(decode == nullptr or step == 0)
+    {
+      column.min = column.max = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+    column.min = std::numeric_limits<double>::infinity();
+    column.max = -std::numeric_limits<double>::infinity();
+    for(size_t at = 0; at + step <= data.size(); at += step)
+    {
+      const double v = decode(data.data() + at);
+      column.min     = std::min(column.min, v);
+      column.max     = std::max(column.max, v);
+    }
+  }
+  header.size = offset;
+
+  static constexpr char padding[8] = {};
+  const auto            put        = [this](void const* data, size_t size)
+  {
+    const auto padded = recording::align(size);
+    return file_->write(static_cast<char const*>(data), qint64(size)) == qint64(size)
+           and file_->write(padding, qint64(padded - size)) == qint64(padded - size);
+  };
+  bool ok = put(&header, sizeof(header))
+            and put(columns.data(), columns.size() * sizeof(recording::ColumnHeader))
+            and put(times.data(), times.size());
+  for(auto const& data : stored)
+  {
+    ok = ok and put(data.data(), data.size());
+  }
+  // readers of a live recording only see whole chunks
+  ok = ok and file_->flush();
+  if(ok)
+  {
+    bytesWritten_.fetch_add(header.size, std::memory_order_relaxed);
+  }
+
+  for(size_t ii = 0; ii < channels_.size(); ++ii)
+  {
+    if(pyramids_[ii].elementSize() == channels_[ii].elementSize)
+    {
+      pyramids_[ii].append(chunk.columns[ii].data(), count, channels_[ii].width);
+    }
+  }
+  return ok;
+}
+
+bool RecordingWriter::writeLevels(QString const&                    path,
+                                  std::vector<MinMaxPyramid> const& pyramids,
+                                  uint64_t                          rows)
+{
+  std::vector<recording::LodLevel> table;
+  for(size_t ch = 0; ch < pyramids.size(); ++ch)
+  {
+    for(size_t level = 1; pyramids[ch].isValid() and level < pyramids[ch].levelCount(); ++level)
+    {
+      table.push_back({uint32_t(ch), uint32_t(level), 0, pyramids[ch].level(level).size()});
+    }
+  }
+
+  recording::LodHeader header;
+  std::memcpy(header.magic, recording::lodMagic, sizeof(header.magic));
+  header.levelCount = uint32_t(table.size());
+  header.rows       = rows;
+  header.factor     = MinMaxPyramid::factor;
+
+  uint64_t offset = sizeof(header) + table.size() * sizeof(recording::LodLevel);
+  for(auto& level : table)
+  {
+    level.offset = offset;
+    offset += recording::align(level.size);
+  }
+
+  // replaced at once: readers may have the previous levels mapped
+  QSaveFile file{path};
+  if(not file.open(QIODevice::WriteOnly))
+  {
+    qWarning(lcWatcher) << "Cannot write levels of detail to" << path << ":" << file.errorString();
+    return false;
+  }
+  static constexpr char padding[8] = {};
+  const auto            put        = [&file](void const* data, size_t size)
+  {
+    const auto padded = recording::align(size);
+    return file.write(static_cast<char const*>(data), qint64(size)) == qint64(size)
+           and file.write(padding, qint64(padded - size)) == qint64(padded - size);
+  };
+  bool ok = put(&header, sizeof(header))
+            and put(table.data(), table.size() * sizeof(recording::LodLevel));
+  for(auto const& level : table)
+  {
+    const auto data = pyramids[level.channel].level(level.level);
+    ok              = ok and put(data.data(), data.size());
+  }
+  if(not ok or not file.commit())
+  {
+    qWarning(lcWatcher) << "Cannot write levels of detail to" << path << ":" << file.errorString();
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,147 @@
+#include <QMcu/Debug/RttChannel.hpp>
+#include <QMcu/Debug/RttReader.hpp>
+
+#include <ScrollWindow.hpp>
+
+#include <algorithm>
+
+namespace
+{
+// samples queued for the renderer, at least
+constexpr size_t min_ring_capacity = 1 << 16;
+} // namespace
+
+RttChannel::RttChannel(QObject* parent)
+    : AbstractPlotDataProvider(parent), window_{std::make_unique<ScrollWindow>()}
+{
+  resetRing();
+}
+
+RttChannel::~RttChannel()
+{
+  if(reader_ != nullptr)
+  {
+    reader_->removeChannel(this);
+  }
+}
+
+quint64 RttChannel::dropped() const noexcept
+{
+  auto ring = ring_.load(std::memory_order_acquire);
+  return ring != nullptr ? ring->dropped() : 0;
+}
+
+void RttChannel::resetRing()
+{
+  const auto size     = QMetaType(int(format_)).sizeOf();
+  const auto capacity = std::max<size_t>(sampleCount_, min_ring_capacity);
+  ring_.store(std::make_shared<SampleRing>(size, capacity), std::memory_order_release);
+  partial_.clear();
+}
+
+void RttChannel::setReader(RttReader* reader)
+{
+  if(reader != reader_)
+  {
+    if(reader_ != nullptr)
+    {
+      reader_->removeChannel(this);
+    }
+    reader_ = reader;
+    if(reader_ != nullptr)
+    {
+      reader_->addChannel(this);
+    }
+    emit readerChanged();
+  }
+}
+
+void RttChannel::setIndex(int index)
+{
+  if(index != index_ and index >= 0)
+  {
+    index_ = index;
+    partial_.clear();
+    emit indexChanged();
+  }
+}
+
+void RttChannel::setFormat(Format format)
+{
+  if(format != format_)
+  {
+    format_ = format;
+    resetRing();
+    emit formatChanged();
+  }
+}
+
+void RttChannel::setSampleCount(int count)
+{
+  if(count != sampleCount_ and count > 0)
+  {
+    sampleCount_ = count;
+    emit sampleCountChanged();
+  }
+}
+
+void RttChannel::receive(std::span<std::byte const> bytes, int64_t timestampNs)
+{
+  auto ring = ring_.load(std::memory_order_acquire);
+  if(ring == nullptr or bytes.empty())
+  {
+    return;
+  }
+  const auto size  = ring->valueSize();
+  size_t     count = 0;
+
+  // a sample split between two polls
+  if(not partial_.empty())
+  {
+    const auto missing = std::min(size - partial_.size(), bytes.size());
+    partial_.insert(partial_.end(), bytes.begin(), bytes.begin() + missing);
+    bytes = bytes.subspan(missing);
+    if(partial_.size() == size)
+    {
+      ring->push(timestampNs, partial_);
+      partial_.clear();
+      ++count;
+    }
+  }
+  for(; bytes.size() >= size; bytes = bytes.subspan(size))
+  {
+    ring->push(timestampNs, bytes.first(size));
+    ++count;
+  }
+  partial_.assign(bytes.begin(), bytes.end());
+
+  if(count != 0)
+  {
+    samples_ += count;
+    emit samplesChanged();
+    emit dataChanged();
+  }
+}
+
+bool RttChannel::initializePlotContext(PlotContext& ctx)
+{
+  tid_         = QMetaType::Type(format_);
+  auto storage = createMappedStorageBuffer(tid_, sampleCount_ * 2);
+  std::ranges::fill(storage, std::byte(0));
+  window_->reset(storage);
+  return true;
+}
+
+RttChannel::UpdateRange RttChannel::update(PlotContext& ctx)
+{
+  return qplot::visitQtType(tid_,
+                            [&]<typename T>
+                            {
+                              if(auto ring = ring_.load(std::memory_order_acquire);
+                                 ring != nullptr and ring->valueSize() == sizeof(T))
+                              {
+                                ring->drainAs<T>([&](int64_t, T value) { window_->push(value); });
+                              }
+                              return window_->visible<T>();
+                            });
+}
@@ -0,0 +1,227 @@
+#include <RttControlBlock.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace
+{
+// the largest channel name read from the target
+constexpr size_t max_name_size = 32;
+
+// chunk read while scanning for the control block
+constexpr size_t scan_chunk_size = 4096;
+} // namespace
+
+RttControlBlock::RttControlBlock(AbstractProbe& probe, address_t address, size_t pointerSize)
+    : probe_{probe}, address_{address}, pointerSize_{pointerSize}
+{
+}
+
+std::optional<RttControlBlock::address_t> RttControlBlock::find(AbstractProbe&   probe,
+                                                                 address_t        begin,
+                                                                 size_t           size,
+                                                                 std::string_view magic)
+{
+  // the id is NUL terminated, which also skips longer strings starting with the magic
+  std::string pattern{magic};
+  pattern.push_back('\0');
+
+  std::vector<char> chunk(scan_chunk_size + pattern.size() - 1);
+  const auto        end = begin + size;
+  // consecutive chunks overlap by the pattern size, not to miss a match across them
+  for(auto address = begin; address < end; address += scan_chunk_size)
+  {
+    const auto count = std::min<size_t>(chunk.size(), end - address);
+    if(count < pattern.size())
+    {
+      break;
+    }
+    if(not probe.read(address, std::as_writable_bytes(std::span{chunk}.first(count))))
+    {
+      return std::nullopt;
+    }
+    const auto view = std::string_view{chunk.data(), count};
+    if(const auto pos = view.find(pattern); pos != std::string_view::npos)
+    {
+      return address + pos;
+    }
+  }
+  return std::nullopt;
+}
+
+RttControlBlock::address_t
+    RttControlBlock::pointerAt(std::span<std::byte const> bytes) const noexcept
+{
+  // the target is little endian, like the host
+  address_t value = 0;
+  std::memcpy(&value, bytes.data(), std::min(pointerSize_, sizeof(value)));
+  return value;
+}
+
+uint32_t RttControlBlock::wordAt(std::span<std::byte const> bytes) const noexcept
+{
+  uint32_t value;
+  std::memcpy(&value, bytes.data(), sizeof(value));
+  return value;
+}
+
+void RttControlBlock::readName(Channel& channel, address_t name)
+{
+  channel.name.clear();
+  if(name == 0)
+  {
+    return;
+  }
+  std::array<char, max_name_size> bytes{};
+  if(probe_.read(name, std::as_writable_bytes(std::span{bytes})))
+  {
+    channel.name.assign(bytes.data(), strnlen(bytes.data(), bytes.size()));
+  }
+}
+
+bool RttControlBlock::open(std::string_view magic)
+{
+  up_.clear();
+
+  std::array<std::byte, headerSize_> header;
+  if(not probe_.read(address_, header))
+  {
+    return false;
+  }
+  const auto id = std::string_view{reinterpret_cast<char const*>(header.data()), idSize_};
+  if(not id.starts_with(magic))
+  {
+    return false;
+  }
+
+  int32_t upCount;
+  std::memcpy(&upCount, header.data() + idSize_, sizeof(upCount));
+  if(upCount <= 0 or upCount > 256)
+  {
+    return false;
+  }
+
+  std::vector<std::byte> descriptors(upCount * descriptorSize());
+  if(not probe_.read(descriptorAddress(0), descriptors))
+  {
+    return false;
+  }
+
+  up_.resize(upCount);
+  for(size_t ii = 0; ii < up_.size(); ++ii)
+  {
+    auto       bytes   = std::span{descriptors}.subspan(ii * descriptorSize(), descriptorSize());
+    auto&      channel = up_[ii];
+    const auto name    = pointerAt(bytes);
+    channel.buffer     = pointerAt(bytes.subspan(pointerSize_));
+    channel.size       = wordAt(bytes.subspan(2 * pointerSize_));
+    channel.readOffset = wordAt(bytes.subspan(2 * pointerSize_ + 8));
+    channel.valid      = channel.buffer != 0 and channel.size != 0;
+    readName(channel, name);
+  }
+  return true;
+}
+
+bool RttControlBlock::poll(std::vector<std::vector<std::byte>>& data)
+{
+  if(not isOpen())
+  {
+    return false;
+  }
+  data.resize(std::max(data.size(), up_.size()));
+
+  // the descriptors are contiguous: all the write offsets within a single transfer
+  offsets_.resize(up_.size() * descriptorSize());
+  if(not probe_.read(descriptorAddress(0), offsets_))
+  {
+    return false;
+  }
+
+  struct Pending
+  {
+    size_t   index       = 0;
+    size_t   offset      = 0; // within data[index]
+    uint32_t first       = 0; // bytes before the wrap
+    uint32_t second      = 0; // bytes after the wrap
+    uint32_t writeOffset = 0;
+  };
+  std::vector<Pending> pending;
+  const auto           discard = [&]
+  {
+    for(auto const& p : pending)
+    {
+      data[p.index].resize(p.offset);
+    }
+  };
+
+  for(size_t ii = 0; ii < up_.size(); ++ii)
+  {
+    auto& channel = up_[ii];
+    if(not channel.valid)
+    {
+      continue;
+    }
+    const auto bytes       = std::span{offsets_}.subspan(ii * descriptorSize(), descriptorSize());
+    const auto writeOffset = wordAt(bytes.subspan(2 * pointerSize_ + 4));
+    if(writeOffset >= channel.size)
+    {
+      // corrupted, or re-initialized by the target: needs to be opened again
+      discard();
+      up_.clear();
+      return false;
+    }
+    const auto readOffset = channel.readOffset;
+    if(writeOffset == readOffset)
+    {
+      continue;
+    }
+
+    Pending p{.index = ii, .offset = data[ii].size(), .writeOffset = writeOffset};
+    if(writeOffset > readOffset)
+    {
+      p.first = writeOffset - readOffset;
+    }
+    else
+    {
+      p.first  = channel.size - readOffset;
+      p.second = writeOffset;
+    }
+    data[ii].resize(p.offset + p.first + p.second);
+    pending.push_back(p);
+  }
+  if(pending.empty())
+  {
+    return true;
+  }
+
+  // spans are taken once every buffer has its final size
+  requests_.clear();
+  for(auto const& p : pending)
+  {
+    auto const& channel = up_[p.index];
+    auto        out     = std::span{data[p.index]}.subspan(p.offset);
+    requests_.push_back({channel.buffer + channel.readOffset, out.first(p.first)});
+    if(p.second != 0)
+    {
+      requests_.push_back({channel.buffer, out.subspan(p.first)});
+    }
+  }
+  if(not probe_.readBatch(requests_))
+  {
+    discard();
+    return false;
+  }
+
+  bool ok = true;
+  for(auto const& p : pending)
+  {
+    auto& channel      = up_[p.index];
+    channel.readOffset = p.writeOffset;
+    channel.received  += p.first + p.second;
+
+    const auto readOffsetAddress = descriptorAddress(p.index) + 2 * pointerSize_ + 8;
+    ok &= probe_.write(readOffsetAddress, std::as_bytes(std::span{&channel.readOffset, 1}));
+  }
+  return ok;
+}
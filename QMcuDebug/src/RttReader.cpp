@@ -0,0 +1,253 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/RttChannel.hpp>
+#include <QMcu/Debug/RttReader.hpp>
+
+#include <Logging.hpp>
+#include <RttControlBlock.hpp>
+
+#include <chrono>
+
+namespace
+{
+constexpr int64_t scan_period_ns = 1'000'000'000;
+
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+RttReader::RttReader(QObject* parent) : QObject{parent}
+{
+  timer_.setTimerType(Qt::PreciseTimer);
+  timer_.setInterval(int(1000.0 / rate_));
+  connect(&timer_, &QTimer::timeout, this, &RttReader::poll);
+  connect(this, &RttReader::settingsChanged, this, &RttReader::reset);
+}
+
+RttReader::~RttReader()
+{
+  for(auto* channel : QList{channels_})
+  {
+    channel->setReader(nullptr);
+  }
+}
+
+quint64 RttReader::address() const noexcept
+{
+  return connected() ? block_->address() : 0;
+}
+
+bool RttReader::connected() const noexcept
+{
+  return block_ != nullptr and block_->isOpen();
+}
+
+QStringList RttReader::channelNames() const
+{
+  QStringList names;
+  if(connected())
+  {
+    for(auto const& channel : block_->channels())
+    {
+      names.append(QString::fromStdString(channel.name));
+    }
+  }
+  return names;
+}
+
+void RttReader::addChannel(RttChannel* channel)
+{
+  if(not channels_.contains(channel))
+  {
+    channels_.append(channel);
+    channel->setReader(this);
+  }
+}
+
+void RttReader::removeChannel(RttChannel* channel)
+{
+  if(channels_.contains(channel))
+  {
+    channels_.removeAll(channel);
+    channel->setReader(nullptr);
+  }
+}
+
+void RttReader::setControlBlock(QString const& symbol)
+{
+  if(symbol != controlBlock_)
+  {
+    controlBlock_ = symbol;
+    emit settingsChanged();
+  }
+}
+
+void RttReader::setMagic(QString const& magic)
+{
+  if(magic != magic_ and not magic.isEmpty())
+  {
+    magic_ = magic;
+    emit settingsChanged();
+  }
+}
+
+void RttReader::setSearchAddress(quint64 address)
+{
+  if(address != searchAddress_)
+  {
+    searchAddress_ = address;
+    emit settingsChanged();
+  }
+}
+
+void RttReader::setSearchSize(quint64 size)
+{
+  if(size != searchSize_)
+  {
+    searchSize_ = size;
+    emit settingsChanged();
+  }
+}
+
+void RttReader::setRate(double rate)
+{
+  if(rate != rate_ and rate > 0.0)
+  {
+    rate_ = rate;
+    timer_.setInterval(std::max(1, int(1000.0 / rate_)));
+    emit rateChanged();
+  }
+}
+
+void RttReader::setRunning(bool running)
+{
+  if(running != this->running())
+  {
+    if(running)
+    {
+      timer_.start();
+    }
+    else
+    {
+      timer_.stop();
+    }
+    emit runningChanged();
+  }
+}
+
+void RttReader::reset()
+{
+  const bool wasConnected = connected();
+  block_.reset();
+  lastScanNs_ = 0;
+  if(wasConnected)
+  {
+    emit connectedChanged();
+  }
+}
+
+void RttReader::poll()
+{
+  auto* const dbg = Debugger::instance();
+  if(dbg == nullptr or not dbg->ready())
+  {
+    return;
+  }
+  if(not dbg->probe()->hasCapability(AbstractProbe::CapabilityBits::NonIntrusive))
+  {
+    dbg->whenStopped(this, [this] { receive(); });
+    return;
+  }
+  receive();
+}
+
+bool RttReader::locate()
+{
+  auto* const dbg   = Debugger::instance();
+  auto* const probe = dbg->probe();
+
+  if(block_ == nullptr)
+  {
+    uint64_t address = 0;
+    if(not controlBlock_.isEmpty())
+    {
+      address = dbg->symbolAddress(controlBlock_).value_or(0);
+    }
+    // scanning is expensive over a probe: at most once per second
+    if(const auto now = now_ns();
+       address == 0 and searchSize_ != 0 and now - lastScanNs_ > scan_period_ns)
+    {
+      lastScanNs_      = now;
+      const auto found =
+          RttControlBlock::find(*probe, searchAddress_, searchSize_, magic_.toStdString());
+      address = found.value_or(0);
+    }
+    if(address == 0)
+    {
+      return false;
+    }
+    const auto pointerSize = dbg->addressByteSize();
+    block_                 = std::make_unique<RttControlBlock>(*probe, address, pointerSize);
+  }
+
+  // the target may not have initialized it yet
+  if(not block_->open(magic_.toStdString()))
+  {
+    return false;
+  }
+  qInfo(lcWatcher)
+      << "RttReader: control block at"
+      << Qt::hex
+      << block_->address()
+      << Qt::dec
+      << "with"
+      << block_->channels().size()
+      << "up buffers";
+  emit connectedChanged();
+  return true;
+}
+
+void RttReader::receive()
+{
+  if(block_ != nullptr and &block_->probe() != Debugger::instance()->probe())
+  {
+    reset(); // a probe was declared meanwhile
+  }
+  if(not connected() and not locate())
+  {
+    return;
+  }
+
+  const auto now = now_ns();
+  if(not block_->poll(data_))
+  {
+    if(not block_->isOpen())
+    {
+      qWarning(lcWatcher) << "RttReader: control block lost, looking for it again";
+      block_.reset();
+      emit connectedChanged();
+    }
+    return;
+  }
+
+  size_t received = 0;
+  for(auto* channel : channels_)
+  {
+    if(size_t(channel->index()) < data_.size())
+    {
+      channel->receive(data_[channel->index()], now);
+    }
+  }
+  for(auto& bytes : data_)
+  {
+    received += bytes.size();
+    bytes.clear();
+  }
+  if(received != 0)
+  {
+    bytesReceived_ += received;
+    emit bytesReceivedChanged();
+  }
+}
@@ -0,0 +1,72 @@
+#include <QMcu/Debug/Sample.hpp>
+
+#include <QByteArray>
+#include <QList>
+
+namespace
+{
+template <typename T> QVariant box(SampleView const& sample)
+{
+  if(not sample.isArray)
+  {
+    return QVariant::fromValue(sample.first<T>());
+  }
+  QList<T> list(qsizetype(sample.count()));
+  std::memcpy(list.data(), sample.bytes.data(), list.size() * sizeof(T));
+  return QVariant::fromValue(std::move(list));
+}
+
+template <typename T> double decode(std::byte const* data) noexcept
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return double(value);
+}
+} // namespace
+
+RealDecoder realDecoder(QMetaType::Type typeId) noexcept
+{
+  if(typeId == QMetaType::Bool)
+  {
+    return &decode<bool>;
+  }
+  RealDecoder out = nullptr;
+  visitSampleType(typeId, [&]<typename T> { out = &decode<T>; });
+  return out;
+}
+
+qint64 SampleView::toInteger() const noexcept
+{
+  if(typeId == QMetaType::Bool)
+  {
+    return first<bool>() ? 1 : 0;
+  }
+  qint64 value = 0;
+  visitSampleType(typeId, [&]<typename T> { value = qint64(first<T>()); });
+  return value;
+}
+
+double SampleView::toReal() const noexcept
+{
+  const auto decoder = realDecoder(typeId);
+  return decoder != nullptr and isValid() ? decoder(bytes.data()) : 0.0;
+}
+
+QVariant SampleView::toVariant() const
+{
+  if(not isValid())
+  {
+    return {};
+  }
+  if(typeId == QMetaType::Bool)
+  {
+    return box<bool>(*this);
+  }
+  QVariant out;
+  if(not visitSampleType(typeId, [&]<typename T> { out = box<T>(*this); }))
+  {
+    // structs: raw bytes, decoded with the fields of their type
+    out = QByteArray(reinterpret_cast<char const*>(bytes.data()), qsizetype(bytes.size()));
+  }
+  return out;
+}
@@ -0,0 +1,59 @@
+#include <SampleScheduler.hpp>
+
+#include <algorithm>
+
+std::vector<size_t> const&
+    SampleScheduler::tick(std::span<Task> tasks, int64_t nowNs, double budget)
+{
+  due_.clear();
+  selected_.clear();
+
+  for(size_t ii = 0; ii < tasks.size(); ++ii)
+  {
+    if(tasks[ii].nextDueNs <= nowNs)
+    {
+      due_.push_back(ii);
+    }
+  }
+
+  std::ranges::sort(due_,
+                    [&](size_t lhs, size_t rhs)
+                    {
+                      auto const& l = tasks[lhs];
+                      auto const& r = tasks[rhs];
+                      if(l.priority != r.priority)
+                      {
+                        return l.priority > r.priority;
+                      }
+                      return l.nextDueNs < r.nextDueNs;
+                    });
+
+  double spent = 0.0;
+  for(auto index : due_)
+  {
+    auto& task = tasks[index];
+    // the first task is always served, whatever its size
+    if(budget > 0.0 and not selected_.empty() and spent + double(task.size) > budget)
+    {
+      ++skipped_;
+      continue;
+    }
+    spent += double(task.size);
+    selected_.push_back(index);
+
+    if(task.rate > 0.0)
+    {
+      const auto period = int64_t(1e9 / task.rate);
+      task.nextDueNs += period;
+      if(task.nextDueNs <= nowNs)
+      {
+        // late: skip the missed samples instead of bursting
+        task.nextDueNs = nowNs + period;
+      }
+    }
+  }
+
+  // keep the plan ordered like the tasks
+  std::ranges::sort(selected_);
+  return selected_;
+}
@@ -24,44 +24,46 @@ void ScrollPlotProvider::setSampleCount(int count)
   }
 }
 
-void ScrollPlotProvider::pushLastValue()
+template <typename T> void ScrollPlotProvider::pushValue(T value)
 {
-  if(mappedData_.empty())
-  {
-    return;
-  }
-
-  qplot::visitQtType(QMetaType::Type(lastValue_.typeId()),
-                     [&]<typename T>
-                     {
-                       auto       data  = std::span(reinterpret_cast<T*>(mappedData_.data()),
-                                             mappedData_.size_bytes() / sizeof(T));
-                       const auto value = lastValue_.value<T>();
-                       readIndex_       = currentOffset_;
+  auto data =
+      std::span(reinterpret_cast<T*>(mappedData_.data()), mappedData_.size_bytes() / sizeof(T));
+  readIndex_ = currentOffset_;
 
-                       const auto index           = (sampleCount_ + currentOffset_) % sampleCount_;
-                       data[index]                = value;
-                       data[index + sampleCount_] = value;
+  const auto index           = (sampleCount_ + currentOffset_) % sampleCount_;
+  data[index]                = value;
+  data[index + sampleCount_] = value;
 
-                       ++currentOffset_;
-                       if(currentOffset_ >= sampleCount_)
-                       {
-                         currentOffset_ = 0;
-                       }
+  ++currentOffset_;
+  if(currentOffset_ >= sampleCount_)
+  {
+    currentOffset_ = 0;
+  }
+}
 
-                       dataChanged();
-                     });
+template <typename T> void ScrollPlotProvider::pushSample(SampleView const& sample)
+{
+  // T was selected from the sample type when the plot context was initialized
+  if(sample.typeId == tid_)
+  {
+    pushValue(sample.first<T>());
+    dataChanged();
+  }
 }
 
 void ScrollPlotProvider::onValueChanged()
 {
-  lastValue_ = proxy()->value();
-  pushLastValue();
+  if(sampleRing() or pushSample_ == nullptr)
+  {
+    return; // fed by the acquisition thread, or not plotted yet
+  }
+  (this->*pushSample_)(proxy()->sample());
 }
 
 void ScrollPlotProvider::onValueUnChanged()
 {
-  pushLastValue();
+  // the same value, once more
+  onValueChanged();
 }
 
 bool ScrollPlotProvider::initializePlotContext(PlotContext& ctx)
@@ -73,24 +75,29 @@ bool ScrollPlotProvider::initializePlotContext(PlotContext& ctx)
   }
   else
   {
-    auto val = p->value();
-    auto tid = QMetaType::Type(val.typeId());
-    if(tid == QMetaType::Type::UnknownType)
+    const auto tid  = sampleRing() ? sampleType() : p->sampleType();
+    PushFn     push = nullptr;
+    if(not visitSampleType(tid, [&]<typename T> { push = &ScrollPlotProvider::pushSample<T>; }))
     {
       return false;
     }
-    mappedData_ = createMappedStorageBuffer(QMetaType::Type(val.typeId()), sampleCount_ * 2);
+    tid_        = tid;
+    mappedData_ = createMappedStorageBuffer(tid_, sampleCount_ * 2);
     std::ranges::fill(mappedData_, std::byte(0));
+    pushSample_ = push;
     return true;
   }
 }
 
 ScrollPlotProvider::UpdateRange ScrollPlotProvider::update(PlotContext& ctx)
 {
-  auto val = proxy()->value();
-  return qplot::visitQtType(QMetaType::Type(val.typeId()),
+  return qplot::visitQtType(tid_,
                             [&]<typename T>
                             {
+                              if(auto ring = sampleRing())
+                              {
+                                ring->drainAs<T>([this](int64_t, T value) { pushValue(value); });
+                              }
                               const auto data = std::span(reinterpret_cast<T*>(mappedData_.data()),
                                                           mappedData_.size_bytes() / sizeof(T));
                               return std::as_bytes(data.subspan(currentOffset_, sampleCount_));
@@ -0,0 +1,74 @@
+#include <SegmentTracker.hpp>
+
+#include <algorithm>
+
+namespace
+{
+int64_t wrap(int64_t value, int64_t n) noexcept
+{
+  return ((value % n) + n) % n;
+}
+} // namespace
+
+SegmentTracker::Update
+    SegmentTracker::next(int64_t index, int64_t nowNs, int64_t periodNs) noexcept
+{
+  const auto n = int64_t(segments_);
+  if(n < 2)
+  {
+    return {};
+  }
+
+  auto position = mode_ == Mode::Completed ? index + 1 : index;
+  if(mode_ != Mode::Count)
+  {
+    position = wrap(position, n);
+  }
+  if(not synchronized_)
+  {
+    synchronized_ = true;
+    last_         = position;
+    lastNs_       = nowNs;
+    return {};
+  }
+
+  int64_t completed = 0;
+  if(mode_ == Mode::Count)
+  {
+    completed = position - last_;
+    if(completed < 0)
+    {
+      // the target restarted
+      last_   = position;
+      lastNs_ = nowNs;
+      return {};
+    }
+  }
+  else
+  {
+    completed = wrap(position - last_, n);
+    // whole laps are invisible from the index: guessed from the time it took
+    if(periodNs > 0)
+    {
+      const auto expected = (nowNs - lastNs_) / periodNs;
+      if(expected - completed >= n)
+      {
+        completed += (expected - completed) / n * n;
+      }
+    }
+  }
+  if(completed == 0)
+  {
+    return {};
+  }
+
+  // the segment being written is not readable, neither are the older ones it went over
+  const auto readable = std::min(completed, n - 1);
+  last_               = position;
+  lastNs_             = nowNs;
+  return {
+      .first = size_t(wrap(position - readable, n)),
+      .count = size_t(readable),
+      .lost  = uint64_t(completed - readable),
+  };
+}
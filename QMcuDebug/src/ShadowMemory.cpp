@@ -0,0 +1,72 @@
+#include <ShadowMemory.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+bool ShadowMemory::read(uint64_t address, std::span<std::byte> data, reader_fn const& reader)
+{
+  if(auto it = ranges_.upper_bound(address); it != ranges_.begin())
+  {
+    --it;
+    if(address + data.size_bytes() <= it->first + it->second.size())
+    {
+      std::memcpy(data.data(), it->second.data() + (address - it->first), data.size_bytes());
+      ++hits_;
+      return true;
+    }
+  }
+
+  ++misses_;
+  if(not reader(address, data))
+  {
+    return false;
+  }
+  fill(address, data);
+  return true;
+}
+
+void ShadowMemory::fill(uint64_t address, std::span<std::byte const> data)
+{
+  if(data.empty())
+  {
+    return;
+  }
+
+  uint64_t begin = address;
+  uint64_t end   = address + data.size_bytes();
+
+  // first range overlapping or touching [address, end)
+  auto first = ranges_.upper_bound(address);
+  if(first != ranges_.begin())
+  {
+    auto prev = std::prev(first);
+    if(prev->first + prev->second.size() >= address)
+    {
+      first = prev;
+    }
+  }
+  auto last = first;
+  while(last != ranges_.end() and last->first <= end)
+  {
+    begin = std::min(begin, last->first);
+    end   = std::max(end, last->first + last->second.size());
+    ++last;
+  }
+
+  if(first == last)
+  {
+    ranges_.emplace(address, std::vector<std::byte>{data.begin(), data.end()});
+    return;
+  }
+
+  // merge, the new data taking precedence
+  std::vector<std::byte> merged(end - begin);
+  for(auto it = first; it != last; ++it)
+  {
+    std::memcpy(merged.data() + (it->first - begin), it->second.data(), it->second.size());
+  }
+  std::memcpy(merged.data() + (address - begin), data.data(), data.size_bytes());
+
+  ranges_.erase(first, last);
+  ranges_.emplace(begin, std::move(merged));
+}
@@ -0,0 +1,242 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/SignalGenerator.hpp>
+#include <QMcu/Debug/Type.hpp>
+#include <QMcu/Plot/VK/Types.hpp>
+
+#include <Logging.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace
+{
+bool is_renderable(QMetaType::Type type) noexcept
+{
+  switch(type)
+  {
+#define X(__type, __qt_type) case __qt_type:
+    QPLOT_BASIC_TYPE_MAP(X)
+#undef X
+    return true;
+    default:
+      return false;
+  }
+}
+
+// Deterministic white noise in [-1, 1] (splitmix64 of the sample time)
+double noise(double t) noexcept
+{
+  uint64_t z = uint64_t(int64_t(t * 1e9)) + 0x9e3779b97f4a7c15ull;
+  z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z          = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z          = z ^ (z >> 31);
+  return double(z >> 11) * 0x1.0p-52 - 1.0;
+}
+
+// Nearest value of an integer type, out of range values being undefined behavior to convert
+template <typename T> T to_sample(double value) noexcept
+{
+  if constexpr(std::is_integral_v<T>)
+  {
+    constexpr auto lo = double(std::numeric_limits<T>::min());
+    constexpr auto hi = double(std::numeric_limits<T>::max()); // rounded up for 64 bits
+    value             = std::round(value);
+    if(std::isnan(value))
+    {
+      return T{0};
+    }
+    if(value <= lo)
+    {
+      return std::numeric_limits<T>::min();
+    }
+    if(value >= hi)
+    {
+      return std::numeric_limits<T>::max();
+    }
+  }
+  return static_cast<T>(value);
+}
+} // namespace
+
+size_t SignalGenerator::State::size() const noexcept
+{
+  return QMetaType(type).sizeOf() * count;
+}
+
+double SignalGenerator::State::valueAt(double t) const noexcept
+{
+  const double cycles = t * frequency + phase;
+  const double frac   = cycles - std::floor(cycles);
+  switch(waveform)
+  {
+    case Waveform::Constant:
+      return offset + amplitude;
+    case Waveform::Sine:
+      return offset + amplitude * std::sin(2.0 * std::numbers::pi * cycles);
+    case Waveform::Square:
+      return offset + (frac < 0.5 ? amplitude : -amplitude);
+    case Waveform::Triangle:
+      return offset + amplitude * (frac < 0.5 ? 4.0 * frac - 1.0 : 3.0 - 4.0 * frac);
+    case Waveform::Sawtooth:
+      return offset + amplitude * (2.0 * frac - 1.0);
+    case Waveform::Counter:
+      return offset + amplitude * std::floor(cycles);
+    case Waveform::Noise:
+      return offset + amplitude * noise(t);
+  }
+  return offset;
+}
+
+void SignalGenerator::State::render(double t, std::span<std::byte> out) const noexcept
+{
+  qplot::visitQtType(type,
+                     [&]<typename T>
+                     {
+                       for(size_t ii = 0; ii < count; ++ii)
+                       {
+                         // oldest element first, the last one being sampled at `t`
+                         const double dt    = interval * double(count - 1 - ii);
+                         const T      value = to_sample<T>(valueAt(t - dt));
+                         std::memcpy(out.data() + ii * sizeof(T), &value, sizeof(T));
+                       }
+                     });
+}
+
+SignalGenerator::State SignalGenerator::state() const
+{
+  State state{
+      .address   = address_,
+      .type      = QMetaType::Type(format_),
+      .count     = size_t(std::max(count_, 1)),
+      .waveform  = waveform_,
+      .frequency = frequency_,
+      .amplitude = amplitude_,
+      .offset    = offset_,
+      .phase     = phase_,
+      .interval  = interval_,
+  };
+
+  if(not name_.isEmpty())
+  {
+    auto* dbg = Debugger::instance();
+    auto* var = (dbg != nullptr and dbg->ready()) ? dbg->variable(name_) : nullptr;
+    if(var == nullptr)
+    {
+      return {};
+    }
+    auto* type    = var->type();
+    state.address = var->address();
+    if(format_ == Format::Auto)
+    {
+      state.type = type->elementTypeId();
+    }
+    if(count_ == 0 and type->elementSize() != 0)
+    {
+      state.count = type->sizeBytes() / type->elementSize();
+    }
+    if(not is_renderable(state.type))
+    {
+      qCritical(lcWatcher) << "SignalGenerator: unsupported type" << type->name() << "for" << name_;
+      return {};
+    }
+  }
+
+  if(not is_renderable(state.type))
+  {
+    return {};
+  }
+  return state;
+}
+
+void SignalGenerator::setName(QString const& name)
+{
+  if(name != name_)
+  {
+    name_ = name;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setAddress(quint64 address)
+{
+  if(address != address_)
+  {
+    address_ = address;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setFormat(Format format)
+{
+  if(format != format_)
+  {
+    format_ = format;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setCount(int count)
+{
+  if(count != count_)
+  {
+    count_ = count;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setWaveform(Waveform waveform)
+{
+  if(waveform != waveform_)
+  {
+    waveform_ = waveform;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setFrequency(double frequency)
+{
+  if(frequency != frequency_)
+  {
+    frequency_ = frequency;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setAmplitude(double amplitude)
+{
+  if(amplitude != amplitude_)
+  {
+    amplitude_ = amplitude;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setOffset(double offset)
+{
+  if(offset != offset_)
+  {
+    offset_ = offset;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setPhase(double phase)
+{
+  if(phase != phase_)
+  {
+    phase_ = phase;
+    emit changed();
+  }
+}
+
+void SignalGenerator::setInterval(double interval)
+{
+  if(interval != interval_)
+  {
+    interval_ = interval;
+    emit changed();
+  }
+}
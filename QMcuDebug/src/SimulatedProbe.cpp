@@ -0,0 +1,328 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/SimulatedProbe.hpp>
+
+#include <ElfFile.hpp>
+#include <Logging.hpp>
+
+#include <QTimer>
+
+#include <chrono>
+
+namespace
+{
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void load_section(lldb::SBSection section, auto&& fn)
+{
+  if(const auto count = section.GetNumSubSections(); count != 0)
+  {
+    for(size_t ii = 0; ii < count; ++ii)
+    {
+      load_section(section.GetSubSectionAtIndex(ii), fn);
+    }
+    return;
+  }
+  // only allocated sections are readable (ie. not debug info)
+  if((section.GetPermissions() & lldb::ePermissionsReadable) == 0
+     or section.GetFileByteSize() == 0)
+  {
+    return;
+  }
+  std::vector<std::byte> bytes(section.GetFileByteSize());
+  lldb::SBError          error;
+  section.GetSectionData().ReadRawData(error, 0, bytes.data(), bytes.size());
+  if(error.Fail())
+  {
+    qCritical(lcWatcher)
+        << "SimulatedProbe: cannot read section"
+        << section.GetName()
+        << ":"
+        << error.GetCString();
+    return;
+  }
+  fn(section.GetFileAddress(), std::span<std::byte const>{bytes});
+}
+} // namespace
+
+SimulatedProbe::SimulatedProbe(QObject* parent) : AbstractProbe(parent), epochNs_{now_ns()}
+{
+  makeInstance();
+
+  // the Debugger may be declared after us
+  QTimer::singleShot(0,
+                     this,
+                     [this]
+                     {
+                       auto* dbg = Debugger::instance();
+                       if(dbg == nullptr)
+                       {
+                         return;
+                       }
+                       connect(dbg,
+                               &Debugger::readyChanged,
+                               this,
+                               [this](bool ready)
+                               {
+                                 if(ready)
+                                 {
+                                   reloadImage();
+                                   updateGenerators();
+                                 }
+                               });
+                       if(dbg->ready())
+                       {
+                         reloadImage();
+                         updateGenerators();
+                       }
+                     });
+}
+
+SimulatedProbe::~SimulatedProbe() = default;
+
+double SimulatedProbe::time() const noexcept
+{
+  return double(now_ns() - epochNs_) / 1e9;
+}
+
+void SimulatedProbe::setLatency(double latency)
+{
+  if(latency != this->latency())
+  {
+    latencyNs_.store(int64_t(latency * 1e3), std::memory_order_relaxed);
+    emit latencyChanged();
+  }
+}
+
+void SimulatedProbe::setBandwidth(double bandwidth)
+{
+  if(bandwidth != this->bandwidth())
+  {
+    bandwidth_.store(bandwidth, std::memory_order_relaxed);
+    emit bandwidthChanged();
+  }
+}
+
+void SimulatedProbe::setLoadSections(bool load)
+{
+  if(load != loadSections_)
+  {
+    loadSections_ = load;
+    reloadImage();
+    emit loadSectionsChanged();
+  }
+}
+
+void SimulatedProbe::addGenerator(SignalGenerator* generator)
+{
+  if(not generators_.contains(generator))
+  {
+    generators_.append(generator);
+    connect(generator, &SignalGenerator::changed, this, &SimulatedProbe::updateGenerators);
+    updateGenerators();
+    emit generatorsChanged();
+  }
+}
+
+void SimulatedProbe::removeGenerator(SignalGenerator* generator)
+{
+  if(generators_.contains(generator))
+  {
+    generators_.removeAll(generator);
+    disconnect(generator, nullptr, this, nullptr);
+    updateGenerators();
+    emit generatorsChanged();
+  }
+}
+
+QQmlListProperty<SignalGenerator> SimulatedProbe::generators()
+{
+  return QQmlListProperty<SignalGenerator>(
+      this,
+      this,
+      [](QQmlListProperty<SignalGenerator>* pl, SignalGenerator* g)
+      {
+        auto* self = static_cast<SimulatedProbe*>(pl->object);
+        self->addGenerator(g);
+      },
+      [](QQmlListProperty<SignalGenerator>* pl)
+      {
+        auto* self = static_cast<SimulatedProbe*>(pl->object);
+        return self->generators_.count();
+      },
+      [](QQmlListProperty<SignalGenerator>* pl, qsizetype at)
+      {
+        auto* self = static_cast<SimulatedProbe*>(pl->object);
+        return self->generators_.at(at);
+      },
+      [](QQmlListProperty<SignalGenerator>* pl)
+      {
+        auto* self = static_cast<SimulatedProbe*>(pl->object);
+        for(auto* g : QList{self->generators_})
+        {
+          self->removeGenerator(g);
+        }
+      });
+}
+
+void SimulatedProbe::updateGenerators()
+{
+  std::vector<SignalGenerator::State> states;
+  for(auto* g : generators_)
+  {
+    if(auto state = g->state(); state.valid())
+    {
+      states.push_back(state);
+    }
+  }
+  std::lock_guard lock{mutex_};
+  states_ = std::move(states);
+}
+
+void SimulatedProbe::reloadImage()
+{
+  std::lock_guard lock{mutex_};
+  pages_.clear();
+
+  auto* dbg = Debugger::instance();
+  if(not loadSections_ or dbg == nullptr or not dbg->ready())
+  {
+    return;
+  }
+  if(ElfFile elf; elf.open(dbg->executablePath()))
+  {
+    for(auto const& section : elf.sections())
+    {
+      if(section.isAllocated() and section.hasContents() and section.size != 0)
+      {
+        copyTo(section.address, elf.contents(section));
+      }
+    }
+    return;
+  }
+
+  auto target = dbg->target();
+  for(uint32_t ii = 0; ii < target.GetNumModules(); ++ii)
+  {
+    auto module = target.GetModuleAtIndex(ii);
+    for(size_t jj = 0; jj < module.GetNumSections(); ++jj)
+    {
+      load_section(module.GetSectionAtIndex(jj),
+                   [this](address_t address, std::span<std::byte const> data)
+                   { copyTo(address, data); });
+    }
+  }
+}
+
+void SimulatedProbe::copyFrom(address_t address, std::span<std::byte> data)
+{
+  for(size_t done = 0; done < data.size_bytes();)
+  {
+    const auto addr   = address + done;
+    const auto base   = addr & ~address_t(pageSize_ - 1);
+    const auto offset = size_t(addr - base);
+    const auto count  = std::min(pageSize_ - offset, data.size_bytes() - done);
+    if(auto it = pages_.find(base); it != pages_.end())
+    {
+      std::memcpy(data.data() + done, it->second->data() + offset, count);
+    }
+    else
+    {
+      std::memset(data.data() + done, 0, count);
+    }
+    done += count;
+  }
+}
+
+void SimulatedProbe::copyTo(address_t address, std::span<std::byte const> data)
+{
+  for(size_t done = 0; done < data.size_bytes();)
+  {
+    const auto addr   = address + done;
+    const auto base   = addr & ~address_t(pageSize_ - 1);
+    const auto offset = size_t(addr - base);
+    const auto count  = std::min(pageSize_ - offset, data.size_bytes() - done);
+    auto&      page   = pages_[base];
+    if(page == nullptr)
+    {
+      page = std::make_unique<page_t>();
+    }
+    std::memcpy(page->data() + offset, data.data() + done, count);
+    done += count;
+  }
+}
+
+void SimulatedProbe::generate(address_t address, size_t size, double t)
+{
+  for(auto const& state : states_)
+  {
+    const auto state_size = state.size();
+    if(state.address < address + size and address < state.address + state_size)
+    {
+      scratch_.resize(state_size);
+      state.render(t, scratch_);
+      copyTo(state.address, scratch_);
+    }
+  }
+}
+
+void SimulatedProbe::wait(size_t bytes) const noexcept
+{
+  auto       ns        = latencyNs_.load(std::memory_order_relaxed);
+  const auto bandwidth = bandwidth_.load(std::memory_order_relaxed);
+  if(bandwidth > 0.0)
+  {
+    ns += int64_t(double(bytes) * 1e9 / bandwidth);
+  }
+  if(ns <= 0)
+  {
+    return;
+  }
+  // busy wait: sleeping overshoots by far more than a USB round trip
+  const auto deadline = now_ns() + ns;
+  while(now_ns() < deadline)
+  {
+  }
+}
+
+bool SimulatedProbe::doRead(address_t address, std::span<std::byte> data)
+{
+  {
+    std::lock_guard lock{mutex_};
+    generate(address, data.size_bytes(), time());
+    copyFrom(address, data);
+  }
+  wait(data.size_bytes());
+  return true;
+}
+
+bool SimulatedProbe::doWrite(address_t address, std::span<std::byte const> data)
+{
+  {
+    std::lock_guard lock{mutex_};
+    copyTo(address, data);
+  }
+  wait(data.size_bytes());
+  return true;
+}
+
+bool SimulatedProbe::doReadBatch(std::span<ReadRequest const> requests)
+{
+  size_t bytes = 0;
+  {
+    std::lock_guard lock{mutex_};
+    const auto      t = time();
+    for(auto const& r : requests)
+    {
+      generate(r.address, r.data.size_bytes(), t);
+      copyFrom(r.address, r.data);
+      bytes += r.data.size_bytes();
+    }
+  }
+  // a single round trip for the whole batch
+  wait(bytes);
+  return true;
+}
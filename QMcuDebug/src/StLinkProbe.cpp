@@ -2,18 +2,13 @@
 
 #include <QTimer>
 
-#include <stlink.h>
+#include <MemoryAccess.hpp>
 
-StLinkProbe* StLinkProbe::instance_ = nullptr;
+#include <stlink.h>
 
-StLinkProbe::StLinkProbe(QObject* parent) : QObject(parent)
+StLinkProbe::StLinkProbe(QObject* parent) : AbstractProbe(parent)
 {
-  if(instance_ != nullptr)
-  {
-    throw std::runtime_error("StLinkProbe is a singleton");
-  }
-
-  instance_ = this;
+  makeInstance();
 
   QTimer::singleShot(
       0,
@@ -44,59 +39,74 @@ StLinkProbe::~StLinkProbe()
   }
 }
 
-constexpr bool is_aligned(std::integral auto addr, std::size_t alignment) noexcept
+namespace
 {
-  return (addr & (alignment - 1)) == 0;
-}
-
-constexpr auto align_up(std::integral auto addr, std::size_t alignment) noexcept
+// Adapts the stlink backend to the memory_access_backend_c interface.
+struct StLinkMemoryAccess
 {
-  return (addr + alignment - 1) & ~(alignment - 1);
-}
+  // Same chunk size as stlink's own `stlink_fread`, and the 8-bit transfer limit of the adapters.
+  static constexpr size_t maxBlock32 = 0x1800;
+  static constexpr size_t maxBlock8  = 64;
 
-constexpr auto align_down(std::integral auto addr, std::size_t alignment) noexcept
-{
-  return addr & ~(alignment - 1);
-}
+  _stlink* sl;
 
-bool StLinkProbe::read(address_t address, std::span<std::byte> data)
-{
-  static constexpr auto expected_alignment = sizeof(uint32_t);
-  size_t                buffer_offset      = 0;
+  bool readWord(uint32_t address, uint32_t& value)
+  {
+    return sl->backend->read_debug32(sl, address, &value) == 0;
+  }
 
-  if(not is_aligned(address, expected_alignment))
+  bool readBlock32(uint32_t address, std::span<std::byte> data)
   {
-    // read until address
-    const auto   down          = align_down(address, expected_alignment);
-    const size_t bytes_to_drop = address - down;
-    const size_t bytes_to_read =
-        std::max(expected_alignment,
-                 std::min(expected_alignment - bytes_to_drop, data.size_bytes()));
-
-    uint32_t   value = 0;
-    const auto res   = sl_->backend->read_debug32(sl_, down, &value);
-
-    std::memcpy(data.data(),
-                reinterpret_cast<uint8_t*>(&value) + bytes_to_drop,
-                std::min(bytes_to_read, data.size_bytes()));
-    buffer_offset += bytes_to_read;
-    if(buffer_offset > data.size_bytes())
+    if(sl->backend->read_mem32(sl, address, uint16_t(data.size_bytes())) != 0)
     {
-      return true;
+      return false;
     }
+    std::memcpy(data.data(), sl->q_buf, data.size_bytes());
+    return true;
   }
 
-  assert(is_aligned(address + buffer_offset, expected_alignment));
+  bool readBlock8(uint32_t address, std::span<std::byte> data)
+  {
+    if(sl->backend->read_mem8(sl, address, uint16_t(data.size_bytes())) != 0)
+    {
+      return false;
+    }
+    std::memcpy(data.data(), sl->q_buf, data.size_bytes());
+    return true;
+  }
 
-  for(; buffer_offset < data.size_bytes(); buffer_offset += expected_alignment)
+  bool writeBlock32(uint32_t address, std::span<std::byte const> data)
   {
-    const uint32_t addr  = address + buffer_offset;
-    uint32_t       value = 0;
-    const auto     res   = sl_->backend->read_debug32(sl_, addr, &value);
+    std::memcpy(sl->q_buf, data.data(), data.size_bytes());
+    return sl->backend->write_mem32(sl, address, uint16_t(data.size_bytes())) == 0;
+  }
 
-    const size_t bytes_to_read = std::min(expected_alignment, data.size_bytes() - buffer_offset);
-    std::memcpy(data.data() + buffer_offset, &value, bytes_to_read);
+  bool writeBlock8(uint32_t address, std::span<std::byte const> data)
+  {
+    std::memcpy(sl->q_buf, data.data(), data.size_bytes());
+    return sl->backend->write_mem8(sl, address, uint16_t(data.size_bytes())) == 0;
   }
+};
+static_assert(memory_access_backend_c<StLinkMemoryAccess>);
+static_assert(memory_write_backend_c<StLinkMemoryAccess>);
+} // namespace
 
-  return true;
+bool StLinkProbe::doRead(address_t address, std::span<std::byte> data)
+{
+  if(sl_ == nullptr)
+  {
+    return false;
+  }
+  auto access = StLinkMemoryAccess{sl_};
+  return block_read(access, address, data);
+}
+
+bool StLinkProbe::doWrite(address_t address, std::span<std::byte const> data)
+{
+  if(sl_ == nullptr)
+  {
+    return false;
+  }
+  auto access = StLinkMemoryAccess{sl_};
+  return block_write(access, address, data);
 }
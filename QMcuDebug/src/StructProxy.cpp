@@ -0,0 +1,126 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/StructProxy.hpp>
+
+#include <Logging.hpp>
+
+#include <algorithm>
+
+StructProxy::StructProxy(QObject* parent) : VariableProxy{parent}
+{
+  connect(this, &VariableProxy::variableResolved, this, [this] { bind(); });
+}
+
+StructProxy::~StructProxy()
+{
+  // the channel variables belong to the debugger (Variable reads through its parent)
+  for(auto* channel : std::as_const(channels_))
+  {
+    delete channel->variable_;
+    channel->variable_ = nullptr;
+  }
+}
+
+QStringList StructProxy::fields() const
+{
+  QStringList names;
+  for(auto const& field : fields_)
+  {
+    names.append(field.name);
+  }
+  return names;
+}
+
+VariableProxy* StructProxy::channel(QString const& name)
+{
+  if(auto* channel = channels_.value(name); channel != nullptr)
+  {
+    return channel;
+  }
+  auto* channel = new VariableProxy(this);
+  // bound to a field by us, not looked up by name
+  disconnect(Debugger::instance(), nullptr, channel, nullptr);
+  channels_.insert(name, channel);
+  bind(name, channel);
+  return channel;
+}
+
+void StructProxy::bind()
+{
+  auto* const var = variable();
+  fields_.clear();
+  bindings_.clear();
+  if(var == nullptr or not var->type()->hasFields())
+  {
+    qCritical(lcWatcher) << "Variable is not a struct:" << name();
+  }
+  else
+  {
+    fields_ = var->type()->fields();
+    for(auto it = channels_.cbegin(); it != channels_.cend(); ++it)
+    {
+      bind(it.key(), it.value());
+    }
+  }
+  emit fieldsChanged();
+}
+
+void StructProxy::bind(QString const& name, VariableProxy* channel)
+{
+  const auto fullName = this->name() + (name.startsWith('[') ? "" : ".") + name;
+  if(fullName != channel->name_)
+  {
+    channel->name_ = fullName;
+    emit channel->nameChanged();
+  }
+
+  auto* const var   = variable();
+  const auto  field = std::ranges::find(fields_, name, &Type::Field::name);
+  if(var == nullptr or field == fields_.end())
+  {
+    if(var != nullptr)
+    {
+      qCritical(lcWatcher) << "No field" << name << "in" << var->name();
+    }
+    return;
+  }
+
+  Type::Layout layout;
+  layout.name          = QMetaType(field->typeId).name();
+  layout.kind          = Type::KindBits::Builtin;
+  layout.sizeBytes     = field->size;
+  layout.align         = field->size;
+  layout.elementTypeId = field->typeId;
+  layout.elementSize   = field->size;
+
+  if(channel->variable_ != nullptr)
+  {
+    channel->variable_->deleteLater();
+  }
+  channel->variable_ = new Variable(
+      fullName, var->address() + field->offset, std::move(layout), Debugger::instance());
+  bindings_.append(Binding{*field, channel});
+  emit channel->variableChanged();
+  emit channel->variableResolved();
+}
+
+void StructProxy::publish(SampleView const& sample, bool changed)
+{
+  // channels are views into the struct bytes, decoded before any transform; a field changed
+  // when its bytes differ from the ones before the last change
+  const auto previous = variable()->previousSample().bytes;
+  for(auto const& [field, channel] : bindings_)
+  {
+    if(field.offset + field.size > sample.bytes.size())
+    {
+      continue;
+    }
+    SampleView element;
+    element.typeId      = field.typeId;
+    element.elementSize = field.size;
+    element.bytes       = sample.bytes.subspan(field.offset, field.size);
+
+    const auto before = previous.subspan(field.offset, field.size);
+    channel->publish(element, changed and not std::ranges::equal(element.bytes, before));
+  }
+  VariableProxy::publish(sample, changed);
+}
@@ -0,0 +1,237 @@
+#include <SymbolIndex.hpp>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+constexpr char magic[8] = "QMCUSYM";
+} // namespace
+
+struct SymbolIndex::Header
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t count;
+  uint32_t extentCount;
+  uint32_t stringSize;
+  uint32_t key;
+  uint32_t keySize;
+};
+
+struct SymbolIndex::Record
+{
+  uint64_t address;
+  uint64_t size;
+  uint32_t name;
+  uint32_t nameSize;
+  uint32_t typeName;
+  uint32_t typeNameSize;
+  int32_t  type;
+  uint32_t firstExtent;
+  uint32_t extentCount;
+  uint32_t depth;
+};
+
+SymbolIndex::SymbolIndex()  = default;
+SymbolIndex::~SymbolIndex() = default;
+
+QString SymbolIndex::cachePath(QString const& key)
+{
+  const QDir dir{QStandardPaths::writableLocation(QStandardPaths::CacheLocation)};
+  return dir.filePath(QStringLiteral("symbols/%1.idx").arg(key));
+}
+
+bool SymbolIndex::save(QString const& path, std::string_view key, std::vector<Symbol> symbols)
+{
+  static_assert(sizeof(Header) == 32 and sizeof(Record) == 48, "mapped layout");
+
+  std::ranges::stable_sort(symbols, {}, &Symbol::name);
+  const auto [last, end] = std::ranges::unique(symbols, {}, &Symbol::name);
+  symbols.erase(last, end);
+
+  std::vector<Record>   records;
+  std::vector<uint32_t> extents;
+  std::string           strings{key};
+  records.reserve(symbols.size());
+  const auto intern = [&strings](std::string const& s)
+  {
+    const auto offset  = uint32_t(strings.size());
+    strings           += s;
+    return offset;
+  };
+  for(auto const& symbol : symbols)
+  {
+    records.push_back({
+        .address      = symbol.address,
+        .size         = symbol.size,
+        .name         = intern(symbol.name),
+        .nameSize     = uint32_t(symbol.name.size()),
+        .typeName     = intern(symbol.typeName),
+        .typeNameSize = uint32_t(symbol.typeName.size()),
+        .type         = symbol.type,
+        .firstExtent  = uint32_t(extents.size()),
+        .extentCount  = uint32_t(symbol.extents.size()),
+        .depth        = symbol.depth,
+    });
+    extents.insert(extents.end(), symbol.extents.begin(), symbol.extents.end());
+  }
+  // records stay 8 bytes aligned when mapped
+  if(extents.size() % 2 != 0)
+  {
+    extents.push_back(0);
+  }
+
+  Header header{
+      .magic       = {},
+      .version     = version,
+      .count       = uint32_t(records.size()),
+      .extentCount = uint32_t(extents.size()),
+      .stringSize  = uint32_t(strings.size()),
+      .key         = 0,
+      .keySize     = uint32_t(key.size()),
+  };
+  std::memcpy(header.magic, magic, sizeof(magic));
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file{path};
+  if(not file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+  const auto write = [&file](auto const* data, size_t bytes)
+  { return file.write(reinterpret_cast<char const*>(data), qint64(bytes)) == qint64(bytes); };
+  return write(&header, sizeof(header))
+     and write(records.data(), records.size() * sizeof(Record))
+     and write(extents.data(), extents.size() * sizeof(uint32_t))
+     and write(strings.data(), strings.size())
+     and file.commit();
+}
+
+bool SymbolIndex::load(QString const& path, std::string_view key)
+{
+  unload();
+
+  auto file = std::make_unique<QFile>(path);
+  if(not file->open(QIODevice::ReadOnly) or size_t(file->size()) < sizeof(Header))
+  {
+    return false;
+  }
+  const auto  fileSize = size_t(file->size());
+  auto const* data     = file->map(0, file->size());
+  if(data == nullptr)
+  {
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, data, sizeof(header));
+  const auto recordsBytes = size_t(header.count) * sizeof(Record);
+  const auto extentsBytes = size_t(header.extentCount) * sizeof(uint32_t);
+  if(std::memcmp(header.magic, magic, sizeof(magic)) != 0
+     or header.version != version
+     or sizeof(Header) + recordsBytes + extentsBytes + header.stringSize != fileSize
+     or size_t(header.key) + header.keySize > header.stringSize)
+  {
+    return false;
+  }
+
+  auto const* records = reinterpret_cast<Record const*>(data + sizeof(Header));
+  auto const* extents = reinterpret_cast<uint32_t const*>(data + sizeof(Header) + recordsBytes);
+  const std::string_view strings{
+      reinterpret_cast<char const*>(data + sizeof(Header) + recordsBytes + extentsBytes),
+      header.stringSize};
+  if(strings.substr(header.key, header.keySize) != key)
+  {
+    return false;
+  }
+
+  // a corrupted file must not lead to reading past the mapping
+  for(const auto& record : std::span{records, header.count})
+  {
+    if(size_t(record.name) + record.nameSize > strings.size()
+       or size_t(record.typeName) + record.typeNameSize > strings.size()
+       or size_t(record.firstExtent) + record.extentCount > header.extentCount)
+    {
+      return false;
+    }
+  }
+
+  file_    = std::move(file);
+  records_ = records;
+  count_   = header.count;
+  extents_ = {extents, header.extentCount};
+  strings_ = strings;
+  return true;
+}
+
+void SymbolIndex::unload()
+{
+  file_.reset();
+  records_ = nullptr;
+  count_   = 0;
+  extents_ = {};
+  strings_ = {};
+}
+
+SymbolIndex::Entry SymbolIndex::at(size_t index) const noexcept
+{
+  auto const& record = records_[index];
+  return {
+      .name     = strings_.substr(record.name, record.nameSize),
+      .typeName = strings_.substr(record.typeName, record.typeNameSize),
+      .address  = record.address,
+      .size     = record.size,
+      .type     = record.type,
+      .extents  = extents_.subspan(record.firstExtent, record.extentCount),
+      .depth    = record.depth,
+  };
+}
+
+size_t SymbolIndex::lowerBound(std::string_view name) const noexcept
+{
+  size_t first = 0;
+  size_t count = count_;
+  while(count > 0)
+  {
+    const auto half = count / 2;
+    if(at(first + half).name < name)
+    {
+      first += half + 1;
+      count -= half + 1;
+    }
+    else
+    {
+      count = half;
+    }
+  }
+  return first;
+}
+
+std::optional<SymbolIndex::Entry> SymbolIndex::find(std::string_view name) const noexcept
+{
+  if(const auto index = lowerBound(name); index < count_ and at(index).name == name)
+  {
+    return at(index);
+  }
+  return std::nullopt;
+}
+
+std::pair<size_t, size_t> SymbolIndex::members(std::string_view name) const noexcept
+{
+  // names starting with "name." are contiguous
+  const auto prefix = std::string{name} + '.';
+  const auto first  = lowerBound(prefix);
+  auto       last   = first;
+  while(last < count_ and at(last).name.starts_with(prefix))
+  {
+    ++last;
+  }
+  return {first, last};
+}
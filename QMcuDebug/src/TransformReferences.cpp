@@ -0,0 +1,37 @@
+#include <TransformReferences.hpp>
+
+TransformReferences::~TransformReferences()
+{
+  reset();
+}
+
+void TransformReferences::reset(QList<Variable*> const& variables)
+{
+  qDeleteAll(variables_);
+  variables_.clear();
+  for(auto* const variable : variables)
+  {
+    variables_.append(variable);
+  }
+}
+
+bool TransformReferences::load(std::span<double> inputs)
+{
+  bool complete = true;
+  for(qsizetype ii = 0; ii < variables_.size() and size_t(ii) < inputs.size(); ++ii)
+  {
+    auto* const variable = variables_[ii].data();
+    if(variable != nullptr and variable->isResolved())
+    {
+      // a failed read keeps the value loaded before
+      variable->load();
+      inputs[ii] = variable->sample().toReal();
+    }
+    else
+    {
+      inputs[ii] = 0.0;
+      complete   = false;
+    }
+  }
+  return complete;
+}
@@ -0,0 +1,113 @@
+#include <QMcu/Debug/Trigger.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+Trigger::Trigger(size_t valueSize, Settings const& settings)
+    : valueSize_{valueSize},
+      settings_{[&]
+                {
+                  auto s = settings;
+                  s.post = std::max<size_t>(s.post, 1); // the triggering sample
+                  return s;
+                }()},
+      preTimes_(settings_.pre),
+      preValues_(settings_.pre * valueSize_)
+{
+}
+
+bool Trigger::fires(double level) const noexcept
+{
+  const double threshold = settings_.level;
+  switch(settings_.edge)
+  {
+    case Edge::Rising:
+      return hasLast_ and last_ < threshold and level >= threshold;
+    case Edge::Falling:
+      return hasLast_ and last_ > threshold and level <= threshold;
+    case Edge::Level:
+      return level >= threshold;
+  }
+  return false;
+}
+
+void Trigger::keep(int64_t timestampNs, std::span<std::byte const> value)
+{
+  if(settings_.pre == 0)
+  {
+    return;
+  }
+  preTimes_[preHead_] = timestampNs;
+  std::memcpy(preValues_.data() + preHead_ * valueSize_,
+              value.data(),
+              std::min(value.size(), valueSize_));
+  preHead_  = (preHead_ + 1) % settings_.pre;
+  preCount_ = std::min(preCount_ + 1, settings_.pre);
+}
+
+void Trigger::append(int64_t timestampNs, std::span<std::byte const> value)
+{
+  current_->times.push_back(timestampNs);
+  const auto at = current_->values.size();
+  current_->values.resize(at + valueSize_);
+  std::memcpy(current_->values.data() + at, value.data(), std::min(value.size(), valueSize_));
+}
+
+bool Trigger::push(int64_t timestampNs, double level, std::span<std::byte const> value)
+{
+  bool completed = false;
+  if(current_ != nullptr)
+  {
+    append(timestampNs, value);
+    --remaining_;
+  }
+  else if(armed())
+  {
+    if(not waiting_)
+    {
+      waiting_     = true;
+      waitingFrom_ = timestampNs;
+    }
+    const bool holdoff = triggered_ and timestampNs - lastTrigger_ < settings_.holdoffNs;
+    const bool fired   = not holdoff and fires(level);
+    const bool forced  = not fired and settings_.mode == Mode::Auto
+                     and timestampNs - waitingFrom_ >= settings_.autoNs;
+    if(fired or forced)
+    {
+      current_ = std::make_unique<Capture>();
+      current_->times.reserve(preCount_ + settings_.post);
+      current_->values.reserve((preCount_ + settings_.post) * valueSize_);
+      // oldest first
+      for(size_t ii = 0; ii < preCount_; ++ii)
+      {
+        const size_t index = (preHead_ + settings_.pre - preCount_ + ii) % settings_.pre;
+        append(preTimes_[index], std::span{preValues_}.subspan(index * valueSize_, valueSize_));
+      }
+      current_->triggerIndex = preCount_;
+      current_->forced       = forced;
+      append(timestampNs, value);
+
+      remaining_   = settings_.post - 1;
+      lastTrigger_ = timestampNs;
+      triggered_   = true;
+      waiting_     = false;
+    }
+  }
+
+  if(current_ != nullptr and remaining_ == 0)
+  {
+    current_->sequence = ++sequence_;
+    capture_.store(std::shared_ptr<Capture const>{std::move(current_)},
+                   std::memory_order_release);
+    if(settings_.mode == Mode::Single)
+    {
+      armed_.store(false, std::memory_order_release);
+    }
+    completed = true;
+  }
+
+  keep(timestampNs, value);
+  last_    = level;
+  hasLast_ = true;
+  return completed;
+}
@@ -0,0 +1,197 @@
+#include <QMcu/Debug/TriggerPlotProvider.hpp>
+
+#include <Logging.hpp>
+
+#include <cstring>
+
+TriggerPlotProvider::TriggerPlotProvider(QObject* parent) : AbstractVariablePlotDataProvider(parent)
+{
+  connect(this, &TriggerPlotProvider::settingsChanged, this, &TriggerPlotProvider::restart);
+}
+
+TriggerPlotProvider::~TriggerPlotProvider() = default;
+
+bool TriggerPlotProvider::armed() const noexcept
+{
+  const auto trigger = trigger_.load(std::memory_order_acquire);
+  return trigger != nullptr and trigger->armed();
+}
+
+void TriggerPlotProvider::rearm()
+{
+  if(auto trigger = trigger_.load(std::memory_order_acquire))
+  {
+    trigger->rearm();
+    emit stateChanged();
+  }
+}
+
+void TriggerPlotProvider::setEdge(Edge edge)
+{
+  if(Trigger::Edge(edge) != settings_.edge)
+  {
+    settings_.edge = Trigger::Edge(edge);
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setMode(Mode mode)
+{
+  if(Trigger::Mode(mode) != settings_.mode)
+  {
+    settings_.mode = Trigger::Mode(mode);
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setLevel(double level)
+{
+  if(level != settings_.level)
+  {
+    settings_.level = level;
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setPreSamples(int count)
+{
+  if(count >= 0 and size_t(count) != settings_.pre)
+  {
+    settings_.pre = size_t(count);
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setPostSamples(int count)
+{
+  if(count > 0 and size_t(count) != settings_.post)
+  {
+    settings_.post = size_t(count);
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setHoldoff(double seconds)
+{
+  const auto ns = int64_t(seconds * 1e9);
+  if(ns >= 0 and ns != settings_.holdoffNs)
+  {
+    settings_.holdoffNs = ns;
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::setAutoTimeout(double seconds)
+{
+  const auto ns = int64_t(seconds * 1e9);
+  if(ns > 0 and ns != settings_.autoNs)
+  {
+    settings_.autoNs = ns;
+    emit settingsChanged();
+  }
+}
+
+void TriggerPlotProvider::restart()
+{
+  trigger_.store(nullptr, std::memory_order_release);
+  captures_     = 0;
+  triggerIndex_ = 0;
+  if(sampleRing() != nullptr)
+  {
+    subscribe(); // a new trigger for the acquisition thread
+  }
+  if(settings_.pre + settings_.post > capacity_.load(std::memory_order_relaxed))
+  {
+    reinitialize(); // captures would be cut to the previous window
+  }
+  emit stateChanged();
+}
+
+std::shared_ptr<Trigger> TriggerPlotProvider::createTrigger(size_t valueSize)
+{
+  auto trigger = std::make_shared<Trigger>(valueSize, settings_);
+  trigger_.store(trigger, std::memory_order_release);
+  return trigger;
+}
+
+void TriggerPlotProvider::onValueChanged()
+{
+  if(sampleRing() != nullptr)
+  {
+    return; // the acquisition thread feeds the trigger
+  }
+  const auto sample = proxy()->sample();
+  if(not sample.isValid())
+  {
+    return;
+  }
+  auto trigger = trigger_.load(std::memory_order_acquire);
+  if(trigger == nullptr or trigger->valueSize() != sample.bytes.size())
+  {
+    trigger = createTrigger(sample.bytes.size());
+  }
+  if(trigger->push(nsTime(), sample.toReal(), sample.bytes))
+  {
+    dataChanged();
+  }
+}
+
+void TriggerPlotProvider::onValueUnChanged()
+{
+  // the same value, one period later
+  onValueChanged();
+}
+
+bool TriggerPlotProvider::initializePlotContext(PlotContext& ctx)
+{
+  auto* const p = proxy();
+  if(p == nullptr)
+  {
+    qWarning(lcWatcher) << "No proxy attached !";
+    return false;
+  }
+  const auto tid         = sampleRing() ? sampleType() : p->sampleType();
+  size_t     elementSize = 0;
+  if(not visitSampleType(tid, [&]<typename T> { elementSize = sizeof(T); }))
+  {
+    return false;
+  }
+  const auto capacity = std::max<size_t>(settings_.pre + settings_.post, 1);
+  mappedData_         = createMappedStorageBuffer(tid, capacity);
+  std::ranges::fill(mappedData_, std::byte(0));
+  capacity_.store(capacity, std::memory_order_relaxed);
+  elementSize_ = elementSize;
+  shown_       = nullptr;
+  shownCount_  = capacity;
+  return true;
+}
+
+TriggerPlotProvider::UpdateRange TriggerPlotProvider::update(PlotContext& ctx)
+{
+  const auto trigger = trigger_.load(std::memory_order_acquire);
+  const auto capture = trigger != nullptr ? trigger->capture() : nullptr;
+  if(capture != nullptr and capture != shown_)
+  {
+    // first element of each sample; captures may be longer than the buffer until it grows
+    const auto valueSize = trigger->valueSize();
+    const auto count     = std::min(capture->size(), mappedData_.size() / elementSize_);
+    for(size_t ii = 0; ii < count; ++ii)
+    {
+      std::memcpy(mappedData_.data() + ii * elementSize_,
+                  capture->values.data() + ii * valueSize,
+                  std::min(elementSize_, valueSize));
+    }
+    shown_      = capture;
+    shownCount_ = count;
+    QMetaObject::invokeMethod(
+        this,
+        [this, sequence = capture->sequence, index = int(capture->triggerIndex)]
+        {
+          captures_     = sequence;
+          triggerIndex_ = index;
+          emit stateChanged();
+        },
+        Qt::QueuedConnection);
+  }
+  return mappedData_.first(shownCount_ * elementSize_);
+}
@@ -1,40 +1,180 @@
 #include <QMcu/Debug/Debugger.hpp>
 #include <QMcu/Debug/Type.hpp>
 
+#include <Logging.hpp>
+
 using namespace lldb;
 
-Type::Type(SBType type, Variable* parent)
-    : QObject(parent), type_(type), kind_(Kind(type_.GetTypeClass()))
+namespace
+{
+// nested structs described, at most (as in the symbol index)
+constexpr uint32_t max_member_depth = 8;
+
+// Enumerations are read as their underlying integer
+QMetaType::Type basic_type_of(SBType type)
+{
+  type = type.GetCanonicalType();
+  if(type.GetTypeClass() & lldb::eTypeClassEnumeration)
+  {
+    type = type.GetEnumerationIntegerType().GetCanonicalType();
+  }
+  if(type.GetBasicType() == lldb::eBasicTypeInvalid)
+  {
+    return QMetaType::UnknownType;
+  }
+  const auto id = Type::getQtType(type);
+  return id != QMetaType::Void ? id : QMetaType::UnknownType;
+}
+
+// Members of the struct `type`, or of the structs it is an array of
+std::vector<Type::Member> members_of(SBType type, uint32_t depth)
+{
+  std::vector<Type::Member> out;
+  type = type.GetCanonicalType();
+  while(type.IsArrayType())
+  {
+    type = type.GetArrayElementType().GetCanonicalType();
+  }
+  const auto count = depth < max_member_depth ? type.GetNumberOfFields() : 0;
+  for(uint32_t ii = 0; ii < count; ++ii)
+  {
+    auto field = type.GetFieldAtIndex(ii);
+    if(not field.IsValid() or field.IsBitfield() or field.GetName() == nullptr)
+    {
+      continue;
+    }
+    Type::Member member;
+    member.name      = field.GetName();
+    member.offset    = field.GetOffsetInBytes();
+    member.sizeBytes = field.GetType().GetByteSize();
+
+    auto element = field.GetType().GetCanonicalType();
+    while(element.IsArrayType())
+    {
+      auto       next   = element.GetArrayElementType().GetCanonicalType();
+      const auto extent = element.GetByteSize() / std::max<uint64_t>(next.GetByteSize(), 1);
+      member.extents.append(int(extent));
+      element = next;
+    }
+    member.elementTypeId = basic_type_of(element);
+    member.members       = members_of(element, depth + 1);
+    out.push_back(std::move(member));
+  }
+  return out;
+}
+
+// "[1][2]", element `index` of an array of `extents`, row-major
+QString subscript(QList<int> const& extents, size_t index)
+{
+  QString out;
+  for(auto it = extents.rbegin(); it != extents.rend(); ++it)
+  {
+    const auto extent = size_t(std::max(*it, 1));
+    out.prepend(QString("[%1]").arg(index % extent));
+    index /= extent;
+  }
+  return out;
+}
+
+// Appends the fields of `member` located at `base` within the variable; false once full
+bool flatten(QList<Type::Field>& out,
+             Type::Member const& member,
+             QString const&      prefix,
+             size_t              base,
+             qsizetype           maxFields)
 {
+  size_t count = 1;
+  for(const auto extent : member.extents)
+  {
+    count *= size_t(std::max(extent, 0));
+  }
+  const auto stride = count != 0 ? member.sizeBytes / count : 0;
+  for(size_t ii = 0; ii < count; ++ii)
+  {
+    const auto name   = prefix + member.name + subscript(member.extents, ii);
+    const auto offset = base + member.offset + ii * stride;
+    if(not member.members.empty())
+    {
+      for(auto const& child : member.members)
+      {
+        if(not flatten(out, child, name.isEmpty() ? name : name + '.', offset, maxFields))
+        {
+          return false;
+        }
+      }
+    }
+    else if(member.elementTypeId != QMetaType::UnknownType)
+    {
+      if(out.size() >= maxFields)
+      {
+        return false;
+      }
+      out.append(Type::Field{name, offset, member.elementTypeId, stride});
+    }
+  }
+  return true;
+}
+} // namespace
+
+QList<Type::Field> Type::compile(Layout const& layout, qsizetype maxFields)
+{
+  QList<Field> out;
+  if(layout.members.empty())
+  {
+    return out;
+  }
+  // the variable itself is the unnamed root member
+  const Member root{
+      .name          = {},
+      .offset        = 0,
+      .sizeBytes     = layout.sizeBytes,
+      .elementTypeId = QMetaType::UnknownType,
+      .extents       = layout.extents,
+      .members       = layout.members,
+  };
+  if(not flatten(out, root, {}, 0, maxFields))
+  {
+    qWarning(lcWatcher) << layout.name << "has more than" << maxFields << "fields, truncated";
+  }
+  return out;
+}
+
+Type::Type(SBType type, Variable* parent) : QObject(parent)
+{
+  layout_.name      = type.GetName();
+  layout_.kind      = Kind(type.GetTypeClass());
+  layout_.sizeBytes = type.GetByteSize();
+  layout_.align     = type.GetByteAlign();
+
+  SBType elemType = type;
   if(isArray())
   {
-    SBType elemType = type_;
     while(elemType.IsArrayType())
     {
       auto       nextElement = elemType.GetArrayElementType();
       const auto extentSize  = elemType.GetByteSize() / nextElement.GetByteSize();
-      extents_.append(static_cast<int>(extentSize));
+      layout_.extents.append(static_cast<int>(extentSize));
       elemType = nextElement;
     }
-    elementType_ = elemType;
   }
-  else if(type_.IsTypedefType())
+  else if(type.IsTypedefType())
   {
-    elementType_ = type_.GetTypedefedType();
-    kind_        = Kind(elementType_.GetTypeClass());
-  }
-  else
-  {
-    elementType_ = type_;
+    elemType     = type.GetTypedefedType();
+    layout_.kind = Kind(elemType.GetTypeClass());
   }
+  layout_.elementSize   = elemType.GetByteSize();
+  layout_.elementTypeId = basic_type_of(elemType);
+  layout_.members       = members_of(elemType, 0);
+  fields_               = compile(layout_);
 }
 
-Variable* Type::variable()
+Type::Type(Layout layout, Variable* parent)
+    : QObject(parent), layout_(std::move(layout)), fields_(compile(layout_))
 {
-  return static_cast<Variable*>(parent());
 }
 
-QString Type::name()
+Variable* Type::variable()
 {
-  return type_.GetName();
+  return static_cast<Variable*>(parent());
 }
+
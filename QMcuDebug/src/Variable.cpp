@@ -1,25 +1,23 @@
 #include <QMcu/Debug/Debugger.hpp>
-#include <QMcu/Debug/StLinkProbe.hpp>
 #include <QMcu/Debug/Type.hpp>
+#include <QMcu/Debug/ArraySlice.hpp>
+#include <QMcu/Debug/DirtyRanges.hpp>
 #include <QMcu/Debug/Variable.hpp>
 
 #include <Logging.hpp>
 
-#include <magic_enum/magic_enum.hpp>
-
 using namespace lldb;
 
-Variable::Variable(SBValue value, Debugger* parent) : QObject(parent), value_(value)
+Variable::Variable(SBValue value, Debugger* parent)
+    : QObject(parent), value_(value), name_(value.GetName())
 {
-  cache_.detach();
-
-  if(StLinkProbe::instance() != nullptr)
+  if(not debugger()->probe()->hasCapability(AbstractProbe::CapabilityBits::LoadAddresses))
   {
     resolve(); // direct resolution possible
   }
   else
   {
-    loadValue_ = [](QVariant& out) { return false; };
+    loadValue_ = [](std::span<std::byte>) { return false; };
     connect(Debugger::instance(),
             &Debugger::launchedChanged,
             this,
@@ -33,438 +31,110 @@ Variable::Variable(SBValue value, Debugger* parent) : QObject(parent), value_(va
   }
 }
 
-void Variable::resolve()
+Variable::Variable(QString name, uint64_t address, Type::Layout layout, Debugger* parent)
+    : QObject(parent), name_(std::move(name)), address_(address)
 {
-  using reader_fn       = std::function<bool(std::span<std::byte>)>;
-  const auto get_reader = [dbg = debugger()](uint64_t address) -> reader_fn
-  {
-    if(auto* sl = StLinkProbe::instance(); sl != nullptr)
-    {
-      return [sl, address](std::span<std::byte> data)
-      {
-        // qDebug(lcWatcher) << "reading" << address;
-        return sl->read(address, data);
-      };
-    }
-    else
-    {
-      return [sl, address, dbg](std::span<std::byte> data)
-      {
-        // qDebug(lcWatcher) << "reading" << address;
-        lldb::SBError error;
-        dbg->process().ReadMemory(address, data.data(), data.size_bytes(), error);
-        if(error.Fail())
-        {
-          qCritical(lcWatcher)
-              << "Failed to read memory at address"
-              << address
-              << ":"
-              << error.GetCString();
-          return false;
-        }
-        return true;
-      };
-    }
-  };
-
-  const auto get_address = [dbg = debugger()](lldb::SBValue& value)
-  {
-    if(StLinkProbe::instance())
-    {
-      return value.GetAddress().GetFileAddress();
-    }
-    else
-    {
-      return value.GetAddress().GetLoadAddress(dbg->target());
-    }
-  };
-
-  const auto get_reader_for =
-      [dbg = debugger(), &get_reader, &get_address]<typename T>(lldb::SBValue& value)
-  {
-    const auto address = get_address(value);
-    return [reader = get_reader(address)](void* output)
-    { return reader(std::span<std::byte>{reinterpret_cast<std::byte*>(output), sizeof(T)}); };
-  };
+  new Type(std::move(layout), this);
+  resolve();
+}
 
-  const auto get_meta_type = [](lldb::SBValue& value)
-  {
-    auto type = value.GetType();
-    if(type.IsTypedefType())
-    {
-      type = type.GetTypedefedType();
-    }
-    if(type.GetTypeClass() & lldb::eTypeClassEnumeration)
-    {
-      type = type.GetEnumerationIntegerType();
-    }
-    auto ctype = type.GetCanonicalType();
-    qDebug(lcWatcher) << "query canonical loader for" << type.GetName();
-    const auto btype = ctype.GetBasicType();
-    assert(btype != lldb::eBasicTypeInvalid);
-    const auto size = type.GetByteSize();
-    switch(btype)
-    {
-      case lldb::eBasicTypeBool:
-        assert(sizeof(bool) == size);
-        return QMetaType::Bool;
-      case lldb::eBasicTypeChar:
-      case lldb::eBasicTypeChar8:
-      case lldb::eBasicTypeSignedChar:
-        assert(sizeof(int8_t) == size);
-        return QMetaType::Char;
-      case lldb::eBasicTypeChar16:
-      case lldb::eBasicTypeSignedWChar:
-      case lldb::eBasicTypeShort:
-      case lldb::eBasicTypeHalf:
-        assert(sizeof(int16_t) == size);
-        return QMetaType::Short;
-      case lldb::eBasicTypeInt:
-      case lldb::eBasicTypeLong:
-        assert(sizeof(int32_t) == size);
-        return QMetaType::Int;
-      case lldb::eBasicTypeLongLong:
-        assert(sizeof(int64_t) == size);
-        return QMetaType::LongLong;
-      case lldb::eBasicTypeUnsignedChar:
-        assert(sizeof(uint8_t) == size);
-        return QMetaType::UChar;
-      case lldb::eBasicTypeUnsignedShort:
-        assert(sizeof(uint16_t) == size);
-        return QMetaType::UShort;
-      case lldb::eBasicTypeUnsignedInt:
-      case lldb::eBasicTypeUnsignedLong:
-        assert(sizeof(uint32_t) == size);
-        return QMetaType::UInt;
-      case lldb::eBasicTypeUnsignedLongLong:
-        assert(sizeof(uint64_t) == size);
-        return QMetaType::ULongLong;
-      case lldb::eBasicTypeFloat:
-        assert(sizeof(float) == size);
-        return QMetaType::Float;
-      case lldb::eBasicTypeDouble:
-        assert(sizeof(double) == size);
-        return QMetaType::Double;
-      default:
-        return QMetaType::Void;
-    }
-  };
+void Variable::resolve()
+{
+  const auto tid = type()->elementTypeId();
 
-  using var_reader_fn = std::function<bool(QVariant&)>;
-  const auto get_canonical_loader =
-      [this, &get_reader_for, &get_meta_type](lldb::SBValue& value) -> var_reader_fn
+  sample_ = {};
+  if(type()->isBasic())
   {
-    switch(get_meta_type(value))
-    {
-      case QMetaType::Bool:
-        return [this, reader = get_reader_for.template operator()<bool>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Bool)
-          {
-            var.emplace<bool>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::Char:
-        return [this, reader = get_reader_for.template operator()<int8_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Char)
-          {
-            var.emplace<int8_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::Short:
-        return [this, reader = get_reader_for.template operator()<int16_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Short)
-          {
-            var.emplace<int16_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::Int:
-        return [this, reader = get_reader_for.template operator()<int32_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Int)
-          {
-            var.emplace<int32_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::LongLong:
-        return [this, reader = get_reader_for.template operator()<int64_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::LongLong)
-          {
-            var.emplace<int64_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::UChar:
-        return [this, reader = get_reader_for.template operator()<uint8_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::UChar)
-          {
-            var.emplace<uint8_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::UShort:
-        return [this, reader = get_reader_for.template operator()<uint16_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::UShort)
-          {
-            var.emplace<uint16_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::UInt:
-        return [this, reader = get_reader_for.template operator()<uint32_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::UInt)
-          {
-            var.emplace<uint32_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::ULongLong:
-        return [this, reader = get_reader_for.template operator()<uint64_t>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::ULongLong)
-          {
-            var.emplace<uint64_t>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::Float:
-        return [this, reader = get_reader_for.template operator()<float>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Float)
-          {
-            var.emplace<float>();
-          }
-          return reader(var.data());
-        };
-        break;
-      case QMetaType::Double:
-        return [this, reader = get_reader_for.template operator()<double>(value_)](QVariant& var)
-        {
-          if(var.metaType().id() != QMetaType::Double)
-          {
-            var.emplace<double>();
-          }
-          return reader(var.data());
-        };
-        break;
-      default:
-        qFatal(lcWatcher) << "unhandled type for " << value.GetName();
-        return [](QVariant& var) { return false; };
-    }
-  };
-
-  const auto ctype = type()->canonicalBasicType();
-  if(ctype != lldb::eBasicTypeInvalid)
+    loadAddress_        = address();
+    loadSize_           = type()->sizeBytes();
+    sample_.typeId      = tid;
+    sample_.elementSize = loadSize_;
+  }
+  else if(type()->hasFields())
   {
-    loadValue_ = get_canonical_loader(value_);
+    // structs and arrays of structs: raw bytes, decoded with type()->fields()
+    loadAddress_        = address();
+    loadSize_           = type()->sizeBytes();
+    sample_.elementSize = loadSize_;
   }
   else if(type()->isArray())
   {
-    QList<int> extents = type()->extents();
-    if(extents.size() > 1)
-    {
-      qFatal(lcWatcher) << "Multidimensional arrays not handled yet";
-    }
+    // N-D arrays are read at once, flattened in row-major order: the element count and offset
+    // select rows (indices of the outermost dimension)
+    QList<int>   extents = type()->extents();
+    const size_t rows    = extents[0];
+    const size_t inner   = ArraySlice::elements(extents.sliced(1));
+    const size_t first   = std::min(arrayElementOffset_, uint64_t(rows));
 
-    const size_t dimension_size = std::min(uint64_t(extents[0]), arrayElementCount_);
+    const size_t dimension_size = std::min(uint64_t(rows - first), arrayElementCount_) * inner;
     const auto   valuesize      = type()->elementSize();
 
-    const auto tid     = type()->elementTypeId();
-    const auto address = get_address(value_) + (arrayElementOffset_ * valuesize);
-    auto       reader  = get_reader(address);
-    void*      local_data;
-    void*      cache_data;
-    switch(tid)
-    {
-      case QMetaType::Bool:
-      {
-        // TODO: check for vector-of-bool potential problems
-        using VecT = QVector<bool>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::Char:
-      {
-        using VecT = QVector<int8_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::UChar:
-      {
-        using VecT = QVector<uint8_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::Short:
-      {
-        using VecT = QVector<int16_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::UShort:
-      {
-        using VecT = QVector<uint16_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::Int:
-      {
-        using VecT = QVector<int32_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::UInt:
-      {
-        using VecT = QVector<uint32_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::LongLong:
-      {
-        using VecT = QVector<int64_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
-
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      case QMetaType::ULongLong:
-      {
-        using VecT = QVector<uint64_t>;
-
-        auto& local_v = local_.emplace<VecT>();
-        local_v.resize(dimension_size);
-
-        auto& cache_v = cache_.emplace<VecT>();
-        cache_v.resize(dimension_size);
+    loadAddress_        = address() + (first * inner * valuesize);
+    loadSize_           = dimension_size * valuesize;
+    sample_.typeId      = tid;
+    sample_.elementSize = valuesize;
+    sample_.isArray     = true;
+  }
+  else
+  {
+    qFatal(lcWatcher) << "unhandled type: " << type()->name();
+  }
 
-        local_data = local_v.data();
-        cache_data = cache_v.data();
-      }
-      break;
-      default:
-        qFatal(lcWatcher) << "Unhandled array type" << type()->name();
-    }
+  if(sample_.typeId != QMetaType::UnknownType and sample_.typeId != QMetaType::Bool and
+     not visitSampleType(sample_.typeId, []<typename T> {}))
+  {
+    qFatal(lcWatcher) << "unhandled type for " << name();
+  }
 
-    const auto s0 = std::span{reinterpret_cast<std::byte*>(local_data), dimension_size * valuesize};
-    const auto s1 = std::span{reinterpret_cast<std::byte*>(cache_data), dimension_size * valuesize};
+  // double-buffered: the front buffer holds the last value, the back one the value before
+  for(auto& buffer : samples_)
+  {
+    buffer.assign(loadSize_, std::byte{0});
+  }
+  front_   = 0;
+  changed_ = false;
+  dirty_.clear();
 
-    // load cache
-    // reader(std::span{reinterpret_cast<std::byte*>(cache_data), dimension_size * valuesize});
-    reader(s0);
-    std::ranges::copy(s0, s1.begin());
+  loadValue_ = [this, address = loadAddress_](std::span<std::byte> data)
+  {
+    return debugger()->readMemory(address, data);
+  };
 
-    loadValue_ = [this,
-                  dimension_size,
-                  valuesize,
-                  &var0  = local_,
-                  &var1  = cache_,
-                  s0     = s0,
-                  s1     = s1,
-                  reader = std::move(reader)](QVariant& out) mutable -> bool
-    {
-      const bool ok = reader(s1);
-      if(ok)
-      {
-        if(not std::ranges::equal(s0, s1))
-        {
-          // swap local/cache data
-          std::swap(var0, var1);
-          std::swap(s0, s1);
+  qDebug(lcWatcher) << name() << "resolved";
+  emit resolved();
+}
 
-          out = var0;
-        }
-      }
-      return ok;
-    };
+bool Variable::load()
+{
+  auto& back = samples_[front_ ^ 1];
+  if(not loadValue_(back))
+  {
+    changed_ = false;
+    dirty_.clear();
+    return false;
   }
-  else
+  // vectorized, and tells consumers what to copy
+  changed_ = findDirtyRanges(samples_[front_], back, dirty_);
+  if(changed_)
   {
-    qFatal(lcWatcher) << "unhandled type: " << type()->name();
+    front_ ^= 1;
   }
+  return true;
+}
 
-  qDebug(lcWatcher) << value_.GetName() << "resolved";
-  emit resolved();
+SampleView Variable::sample() const noexcept
+{
+  auto out  = sample_;
+  out.bytes = samples_[front_];
+  out.dirty = dirty_;
+  return out;
+}
+
+SampleView Variable::previousSample() const noexcept
+{
+  auto out  = sample_;
+  out.bytes = samples_[front_ ^ 1];
+  return out;
 }
 
 Debugger* Variable::debugger()
@@ -474,20 +144,16 @@ Debugger* Variable::debugger()
 
 QString Variable::name()
 {
-  return value_.GetName();
+  return name_;
 }
 
 uint64_t Variable::address()
 {
-  if(StLinkProbe::instance())
-  {
-    return value_.GetAddress().GetFileAddress();
-  }
-  else
+  if(value_.IsValid())
   {
-    auto dbg = debugger();
-    return value_.GetAddress().GetLoadAddress(dbg->target());
+    return debugger()->probeAddress(value_.GetAddress());
   }
+  return address_;
 }
 
 QString Variable::display()
@@ -507,78 +173,52 @@ Type* Variable::type()
 
 bool Variable::read(std::span<std::byte> data)
 {
-  auto const address = this->address();
-  if(auto* sl = StLinkProbe::instance(); sl != nullptr)
-  {
-    return sl->read(address, data);
-  }
-  else
-  {
-    lldb::SBError error;
-    debugger()->process().ReadMemory(address, data.data(), data.size_bytes(), error);
-    if(error.Fail())
-    {
-      qCritical(lcWatcher)
-          << "Failed to read memory at address"
-          << address
-          << ":"
-          << error.GetCString();
-      return false;
-    }
-    return true;
-  }
+  return debugger()->readMemory(address(), data);
 }
 
 qreal Variable::readAsReal()
 {
   qreal value = 0.0;
 
-  const auto ctype = type()->canonicalBasicType();
+  const auto tid = type()->isBasic() ? type()->elementTypeId() : QMetaType::UnknownType;
 
-  switch(ctype)
+  switch(tid)
   {
-    case lldb::eBasicTypeBool:
+    case QMetaType::Bool:
       value = read<bool>().value_or(false) ? 1 : 0;
       break;
-    case lldb::eBasicTypeChar:
-    case lldb::eBasicTypeChar8:
-    case lldb::eBasicTypeSignedChar:
+    case QMetaType::Char:
       value = read<int8_t>().value_or(0);
       break;
-    case lldb::eBasicTypeChar16:
-    case lldb::eBasicTypeSignedWChar:
-    case lldb::eBasicTypeShort:
-    case lldb::eBasicTypeHalf:
+    case QMetaType::Short:
       value = read<int16_t>().value_or(0);
       break;
-    case lldb::eBasicTypeInt:
-    case lldb::eBasicTypeLong:
+    case QMetaType::Int:
       value = read<int32_t>().value_or(0);
       break;
-    case lldb::eBasicTypeLongLong:
+    case QMetaType::LongLong:
       value = read<int64_t>().value_or(0);
       break;
-    case lldb::eBasicTypeUnsignedChar:
+    case QMetaType::UChar:
       value = read<uint8_t>().value_or(0);
       break;
-    case lldb::eBasicTypeUnsignedShort:
+    case QMetaType::UShort:
       value = read<uint16_t>().value_or(0);
       break;
-    case lldb::eBasicTypeUnsignedInt:
-    case lldb::eBasicTypeUnsignedLong:
+    case QMetaType::UInt:
       value = read<uint32_t>().value_or(0);
       break;
-    case lldb::eBasicTypeUnsignedLongLong:
+    case QMetaType::ULongLong:
       value = read<uint64_t>().value_or(0);
       break;
-    case lldb::eBasicTypeFloat:
+    case QMetaType::Float:
       value = read<float>().value_or(0);
       break;
-    case lldb::eBasicTypeDouble:
+    case QMetaType::Double:
       value = read<double>().value_or(0);
       break;
     default:
-      qFatal(lcWatcher) << "unhandled type: " << magic_enum::enum_name(ctype);
+      qFatal(lcWatcher) << "unhandled type: " << QMetaType(tid).name();
   }
   return value;
 }
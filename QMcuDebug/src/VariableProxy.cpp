@@ -1,19 +1,40 @@
 #include <QMcu/Debug/Debugger.hpp>
-#include <QMcu/Debug/StLinkProbe.hpp>
 #include <QMcu/Debug/VariableProxy.hpp>
 #include <QMcu/Debug/VariableProxyGroup.hpp>
 
 #include <Logging.hpp>
+#include <TransformReferences.hpp>
 
 #include <QQmlEngine>
 
+#include <cmath>
+
 Debugger* VariableProxy::debugger() noexcept
 {
   return Debugger::instance();
 }
 
-VariableProxy::VariableProxy(QObject* parent) : QObject{parent}
+VariableProxy::VariableProxy(QObject* parent)
+    : QObject{parent}, references_{std::make_unique<TransformReferences>()}
 {
+  // samples are views into the buffers of the variable, reallocated when it is resolved; the
+  // variables the transform reads are looked up again as well. A direct reader targets the
+  // previous address: its consumer sets it again once it followed the variable
+  const auto reset = [this]
+  {
+    sample_    = {};
+    boxed_     = false;
+    published_ = false;
+    references_->reset();
+    warned_ = false;
+    if(directReader_)
+    {
+      setDirectReader({});
+    }
+  };
+  connect(this, &VariableProxy::variableChanged, this, reset);
+  connect(this, &VariableProxy::variableResolved, this, reset);
+
   connect(Debugger::instance(),
           &Debugger::readyChanged,
           this,
@@ -34,14 +55,12 @@ VariableProxy::VariableProxy(QObject* parent) : QObject{parent}
               {
                 emit variableResolved();
               }
-              if(StLinkProbe::instance() == nullptr)
-              {
-                connect(dbg, &Debugger::processStopped, this, &VariableProxy::refresh);
-              }
             }
           });
 }
 
+VariableProxy::~VariableProxy() = default;
+
 VariableProxyGroup* VariableProxy::group() noexcept
 {
   return group_;
@@ -82,9 +101,37 @@ void VariableProxy::setName(QString const& name)
   }
 }
 
+void VariableProxy::setRate(double rate)
+{
+  if(rate != rate_ and rate >= 0.0)
+  {
+    rate_ = rate;
+    emit rateChanged();
+  }
+}
+
+void VariableProxy::setPriority(int priority)
+{
+  if(priority != priority_)
+  {
+    priority_ = priority;
+    emit priorityChanged();
+  }
+}
+
 void VariableProxy::setTransform(QJSValue const& fn)
 {
-  if(not fn.isCallable())
+  std::shared_ptr<Expression> expression;
+  if(fn.isString())
+  {
+    expression = std::make_shared<Expression>();
+    if(not expression->compile(fn.toString()))
+    {
+      qCritical(lcWatcher) << "Invalid transform" << fn.toString() << ":" << expression->error();
+      expression.reset();
+    }
+  }
+  else if(not fn.isCallable())
   {
     qCritical(lcWatcher) << fn.toString() << "is not callable";
   }
@@ -92,20 +139,54 @@ void VariableProxy::setTransform(QJSValue const& fn)
   {
     return;
   }
-  transform_ = fn;
+  transform_  = fn;
+  expression_ = std::move(expression);
+  references_->reset();
+  warned_ = false;
   emit transformChanged();
 }
 
 void VariableProxy::update()
 {
-  if(StLinkProbe::instance())
+  auto* dbg = Debugger::instance();
+  if(dbg->probe()->hasCapability(AbstractProbe::CapabilityBits::NonIntrusive))
   {
     refresh();
   }
   else
   {
-    Debugger::instance()->process().Stop();
+    dbg->whenStopped(this, [this] { refresh(); });
+  }
+}
+
+QVariant const& VariableProxy::value() const
+{
+  if(not boxed_)
+  {
+    value_ = sample_.toVariant();
+    boxed_ = true;
   }
+  return value_;
+}
+
+QMetaType::Type VariableProxy::sampleType() noexcept
+{
+  if(variable_ == nullptr or not variable_->isResolved())
+  {
+    return QMetaType::UnknownType;
+  }
+  const auto sample = variable_->sample();
+  if(hasTransform() and not sample.isArray and sample.typeId != QMetaType::UnknownType)
+  {
+    return QMetaType::Double;
+  }
+  return sample.typeId;
+}
+
+void VariableProxy::setDirectReader(std::function<void()> reader)
+{
+  directReader_ = std::move(reader);
+  emit directChanged();
 }
 
 void VariableProxy::refresh()
@@ -114,18 +195,103 @@ void VariableProxy::refresh()
   {
     return;
   }
+  if(directReader_)
+  {
+    directReader_();
+    emit triggered();
+    return;
+  }
+  const bool ok = variable_->load();
+  if(variable_->sample().isValid())
+  {
+    publish(variable_->sample(), ok and variable_->changed());
+  }
+}
+
+double VariableProxy::evaluate(SampleView const& sample)
+{
+  // looked up again with every new symbols, when the variable changes (see the constructor)
+  const auto& names = expression_->references();
+  if(references_->size() != names.size() and debugger()->ready())
+  {
+    QList<Variable*> variables;
+    for(const auto& name : names)
+    {
+      auto* const ref = debugger()->variable(name);
+      if(ref == nullptr)
+      {
+        qWarning(lcWatcher) << name_ << ": transform reads unknown variable" << name << "as 0";
+      }
+      variables.append(ref);
+    }
+    references_->reset(variables);
+  }
+
+  // other variables are loaded along, from the shadow memory if read within the tick
+  inputs_.assign(expression_->inputCount(), 0.0);
+  inputs_[0] = sample.toReal();
+  if(not references_->load(std::span{inputs_}.subspan(1)) and not warned_)
+  {
+    qWarning(lcWatcher) << name_ << ": transform reads" << names
+                        << "as 0 until they are resolved";
+    warned_ = true;
+  }
+  return expression_->evaluate(inputs_);
+}
+
+void VariableProxy::publish(SampleView const& sample, bool changed)
+{
+  // transforms only apply to basic values on the sample path
+  const bool transformed = hasTransform() and not sample.isArray and
+                           sample.typeId != QMetaType::UnknownType;
+  if(not transformed)
+  {
+    sample_ = sample;
+  }
+  if(hasTransform() and sample.isArray and not published_)
+  {
+    qWarning(lcWatcher) << name_ << ": arrays are plotted without their transform";
+  }
 
-  auto value = variable_->read();
-  if(value != value_)
+  // reading other variables, the result may change with them alone
+  const bool compiled = expression_ != nullptr and transformed;
+  double     result   = transformed_;
+  if(compiled and (changed or not published_ or not expression_->references().isEmpty()))
   {
-    if(transform_.isCallable())
+    result = evaluate(sample);
+    if(not changed and published_)
     {
+      const bool nan = std::isnan(result) and std::isnan(transformed_);
+      changed        = result != transformed_ and not nan;
+    }
+  }
+
+  if(changed or not published_)
+  {
+    published_ = true;
+    boxed_     = false;
+    if(compiled)
+    {
+      transformed_ = result;
+      value_       = transformed_;
+      boxed_       = true;
+    }
+    else if(transform_.isCallable())
+    {
+      // slow path: boxed, through the JS engine
       QQmlEngine* const e = qmlEngine(this);
-      value_              = transform_.call(QJSValueList() << e->toScriptValue(value)).toVariant();
+      value_ = transform_.call(QJSValueList() << e->toScriptValue(sample.toVariant())).toVariant();
+      boxed_ = true;
+
+      transformed_ = value_.toDouble();
     }
-    else
+    if(transformed)
     {
-      value_ = std::move(value);
+      sample_.typeId      = QMetaType::Double;
+      sample_.elementSize = sizeof(double);
+      sample_.bytes       = std::as_bytes(std::span{&transformed_, 1});
+      sample_.isArray     = false;
+      sample_.dirty       = {};
     }
     emit valueChanged();
   }
@@ -1,16 +1,217 @@
+#include <QMcu/Debug/Debugger.hpp>
 #include <QMcu/Debug/VariableProxy.hpp>
 #include <QMcu/Debug/VariableProxyGroup.hpp>
 
-VariableProxyGroup::VariableProxyGroup(QObject* parent) : QObject{parent}
+#include <Logging.hpp>
+#include <ReadPlan.hpp>
+#include <SampleScheduler.hpp>
+
+#include <chrono>
+#include <cmath>
+
+namespace
 {
+// Share of the measured link bandwidth the scheduler plans for
+constexpr double link_usage = 0.9;
+
+int64_t now_ns() noexcept
+{
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 }
+} // namespace
 
-void VariableProxyGroup::update()
+VariableProxyGroup::VariableProxyGroup(QObject* parent)
+    : QObject{parent},
+      plan_{std::make_unique<ReadPlan>()},
+      scheduler_{std::make_unique<SampleScheduler>()}
+{
+  timer_.setTimerType(Qt::PreciseTimer);
+  connect(&timer_, &QTimer::timeout, this, &VariableProxyGroup::update);
+  connect(this, &VariableProxyGroup::proxiesChanged, this, &VariableProxyGroup::invalidatePlan);
+  connect(this, &VariableProxyGroup::proxiesChanged, this, &VariableProxyGroup::updateTimer);
+}
+
+VariableProxyGroup::~VariableProxyGroup() = default;
+
+void VariableProxyGroup::setCoalesceGap(int gap)
+{
+  if(gap != coalesceGap_)
+  {
+    coalesceGap_ = gap;
+    invalidatePlan();
+    emit coalesceGapChanged();
+  }
+}
+
+quint64 VariableProxyGroup::skippedSamples() const noexcept
+{
+  return scheduler_->skipped();
+}
+
+void VariableProxyGroup::setRate(double rate)
+{
+  if(rate != rate_ and rate > 0.0)
+  {
+    rate_ = rate;
+    updateTimer();
+    emit rateChanged();
+  }
+}
+
+void VariableProxyGroup::setRunning(bool running)
+{
+  if(running != this->running())
+  {
+    if(running)
+    {
+      lastTickNs_ = 0;
+      timer_.start();
+      updateTimer();
+    }
+    else
+    {
+      timer_.stop();
+    }
+    emit runningChanged();
+  }
+}
+
+void VariableProxyGroup::updateTimer()
+{
+  double fastest = rate_;
+  for(auto* p : proxies_)
+  {
+    fastest = std::max(fastest, p->rate());
+  }
+  timer_.setInterval(std::max(1, int(1000.0 / fastest)));
+}
+
+void VariableProxyGroup::compilePlan(QList<VariableProxy*> const& proxies)
+{
+  plan_->clear();
+  planned_ = proxies;
+  for(auto* p : proxies)
+  {
+    // direct proxies read into their consumer's storage, not through the shadow memory
+    if(auto* v = p->variable(); v != nullptr and not p->isDirect())
+    {
+      plan_->add(v);
+    }
+  }
+  plan_->compile(std::max(coalesceGap_, 0));
+  planDirty_ = false;
+
+  const int count = plan_->spans().size();
+  if(count != transferCount_)
+  {
+    transferCount_ = count;
+    emit transferCountChanged();
+  }
+}
+
+void VariableProxyGroup::schedule(AbstractProbe& probe)
 {
+  const auto now = now_ns();
+
+  // tick period, as driven by the timer or by the caller
+  const double period = lastTickNs_ != 0 ? double(now - lastTickNs_) / 1e9 : 1.0 / rate_;
+  lastTickNs_         = now;
+
+  QList<VariableProxy*>              candidates;
+  std::vector<SampleScheduler::Task> tasks;
   for(auto* p : proxies_)
   {
-    p->update();
+    if(auto* v = p->variable(); v != nullptr and v->isResolved())
+    {
+      candidates.append(p);
+      const auto rate = SampleScheduler::resolveRate(p->rate(), rate_);
+      tasks.push_back({rate, p->priority(), v->loadSize(), p->nextDueNs_});
+    }
+  }
+
+  const double bandwidth = probe.stats().bandwidth();
+  const double budget    = bandwidth * period * link_usage;
+  const auto   skipped   = scheduler_->skipped();
+
+  due_.clear();
+  for(auto index : scheduler_->tick(tasks, now, budget))
+  {
+    due_.append(candidates[index]);
+  }
+  for(qsizetype ii = 0; ii < candidates.size(); ++ii)
+  {
+    candidates[ii]->nextDueNs_ = tasks[ii].nextDueNs;
+  }
+
+  // requested bandwidth
+  double requested = 0.0;
+  for(auto const& task : tasks)
+  {
+    requested += double(task.size) * task.rate;
+  }
+  const double load = bandwidth > 0.0 ? requested / bandwidth : 0.0;
+  if(load > 1.0 and not overloaded())
+  {
+    qWarning(lcWatcher)
+        << "VariableProxyGroup: requesting"
+        << requested
+        << "B/s, the link delivers"
+        << bandwidth
+        << "B/s";
+  }
+  if(std::abs(load - load_) > 0.01 or skipped != scheduler_->skipped())
+  {
+    load_ = load;
+    emit loadChanged();
+  }
+}
+
+void VariableProxyGroup::update()
+{
+  auto* const dbg   = Debugger::instance();
+  auto* const probe = dbg->probe();
+
+  schedule(*probe);
+  if(due_.isEmpty())
+  {
+    return;
+  }
+
+  if(not probe->hasCapability(AbstractProbe::CapabilityBits::NonIntrusive))
+  {
+    // a single stop window for the whole group
+    dbg->whenStopped(this, [this, probe, due = due_] { refresh(*probe, due); });
+    return;
+  }
+  refresh(*probe, due_);
+}
+
+void VariableProxyGroup::refresh(AbstractProbe& probe, QList<VariableProxy*> due)
+{
+  // proxies may have left while waiting for a stop window
+  due.removeIf([this](VariableProxy* p) { return not proxies_.contains(p); });
+  if(planDirty_ or due != planned_)
+  {
+    compilePlan(due);
+  }
+
+  // a new tick, served from the fetched spans
+  auto* const dbg = Debugger::instance();
+  dbg->invalidateShadowMemory();
+  plan_->execute(probe);
+  for(auto const& span : plan_->spans())
+  {
+    if(span.fetched)
+    {
+      dbg->shadowMemory(span.address, span.data);
+    }
+  }
+  for(auto* p : due)
+  {
+    p->refresh();
   }
+  emit refreshed();
 }
 
 void VariableProxyGroup::addProxy(VariableProxy* proxy)
@@ -19,6 +220,10 @@ void VariableProxyGroup::addProxy(VariableProxy* proxy)
   {
     proxies_.append(proxy);
     proxy->setGroup(this);
+    connect(proxy, &VariableProxy::variableChanged, this, &VariableProxyGroup::invalidatePlan);
+    connect(proxy, &VariableProxy::variableResolved, this, &VariableProxyGroup::invalidatePlan);
+    connect(proxy, &VariableProxy::directChanged, this, &VariableProxyGroup::invalidatePlan);
+    connect(proxy, &VariableProxy::rateChanged, this, &VariableProxyGroup::updateTimer);
     emit proxiesChanged();
   }
 }
@@ -27,6 +232,7 @@ void VariableProxyGroup::removeProxy(VariableProxy* proxy)
   if(proxies_.contains(proxy))
   {
     proxies_.removeAll(proxy);
+    disconnect(proxy, nullptr, this, nullptr);
     proxy->setGroup(nullptr);
     emit proxiesChanged();
   }
@@ -7,7 +7,6 @@ ComboBox {
     id: root
     required property QtObject dbg
 
-    model: dbg.globals
-
-    textRole: "display"
+    // names from the symbol index, variables are resolved once selected
+    model: dbg.globalNames
 }
@@ -6,11 +6,10 @@ import QtQuick.Controls.Material
 ListView {
     required property QtObject dbg
 
-    model: dbg.globals
+    model: dbg.globalNames
 
     delegate: Label {
-        required property string name
-        required property QtObject type
-        text: type.name + " " + name
+        required property string modelData
+        text: dbg.symbol(modelData).typeName + " " + modelData
     }
 }
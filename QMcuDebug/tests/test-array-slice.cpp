@@ -0,0 +1,101 @@
+#include <QMcu/Debug/ArraySlice.hpp>
+
+#include <QTest>
+
+#include <array>
+#include <numeric>
+
+class ArraySliceTests : public QObject
+{
+  Q_OBJECT
+
+  // int16_t adc[4][3]: 4 frames of 3 interleaved channels
+  static constexpr int frames   = 4;
+  static constexpr int channels = 3;
+
+  std::array<int16_t, frames * channels> adc_;
+
+  std::span<int16_t> data() noexcept
+  {
+    return adc_;
+  }
+
+private slots:
+  void init()
+  {
+    std::iota(adc_.begin(), adc_.end(), int16_t(0));
+  }
+
+  void test_row()
+  {
+    const auto slice = ArraySlice::row({frames, channels}, 2);
+    QCOMPARE(slice.offset, size_t(6));
+    QCOMPARE(slice.count, size_t(channels));
+    QCOMPARE(slice.stride, size_t(1));
+
+    const auto view = slice.view(data());
+    QVERIFY(view.isContiguous());
+    QCOMPARE(view[0], int16_t(6));
+    QCOMPARE(view[2], int16_t(8));
+  }
+
+  void test_column()
+  {
+    const auto view = ArraySlice::column({frames, channels}, 1).view(data());
+    QCOMPARE(view.size(), size_t(frames));
+    QCOMPARE(view.stride(), size_t(channels));
+    QCOMPARE(view[0], int16_t(1));
+    QCOMPARE(view[3], int16_t(10));
+
+    // the view shares the array storage
+    adc_[4] = 42;
+    QCOMPARE(view[1], int16_t(42));
+  }
+
+  void test_every()
+  {
+    const auto slice = ArraySlice::all({frames, channels}).every(5);
+    QCOMPARE(slice.count, size_t(3));
+
+    std::array<int16_t, 3> out{};
+    QCOMPARE(slice.view(data()).copyTo(out), size_t(3));
+    QCOMPARE(out[1], int16_t(5));
+    QCOMPARE(out[2], int16_t(10));
+  }
+
+  void test_gather()
+  {
+    const auto bytes = std::as_bytes(std::span{adc_});
+
+    std::array<int16_t, frames> out{};
+    const auto copied = ArraySlice::column({frames, channels}, 2)
+                            .gather(bytes, sizeof(int16_t), std::as_writable_bytes(std::span{out}));
+    QCOMPARE(copied, size_t(frames));
+    QCOMPARE(out[0], int16_t(2));
+    QCOMPARE(out[3], int16_t(11));
+  }
+
+  void test_out_of_bounds()
+  {
+    QCOMPARE(ArraySlice::row({frames, channels}, frames).count, size_t(0));
+    QCOMPARE(ArraySlice::column({frames, channels}, channels).count, size_t(0));
+
+    // an array limited to its first rows
+    const auto slice = ArraySlice::column({frames, channels}, 0);
+    QVERIFY(slice.fits(adc_.size()));
+    QVERIFY(not slice.fits(6));
+    QVERIFY(slice.view(data().first(6)).empty());
+  }
+
+  void test_three_dimensions()
+  {
+    // [2][2][3]: columns go across both outer dimensions
+    const auto slice = ArraySlice::column({2, 2, channels}, 2);
+    QCOMPARE(slice.count, size_t(4));
+    QCOMPARE(slice.view(data())[3], int16_t(11));
+    QCOMPARE(ArraySlice::row({2, 2, channels}, 1).offset, size_t(6));
+  }
+};
+
+QTEST_GUILESS_MAIN(ArraySliceTests)
+#include "test-array-slice.moc"
@@ -0,0 +1,112 @@
+#include <QMcu/Debug/DirtyRanges.hpp>
+
+#include <QTest>
+
+#include <random>
+
+class DirtyRangesTests : public QObject
+{
+  Q_OBJECT
+
+  std::vector<std::byte>  previous_;
+  std::vector<std::byte>  next_;
+  std::vector<DirtyRange> out_;
+
+  // 32 bytes blocks, compared one byte at a time
+  static std::vector<size_t> dirtyBlocks(std::span<std::byte const> a,
+                                         std::span<std::byte const> b)
+  {
+    std::vector<size_t> blocks;
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+      if(a[i] != b[i] and (blocks.empty() or blocks.back() != i / 32))
+      {
+        blocks.push_back(i / 32);
+      }
+    }
+    return blocks;
+  }
+
+private slots:
+  void init()
+  {
+    previous_.assign(1000, std::byte{0x5a});
+    next_ = previous_;
+    out_  = {DirtyRange{1, 2}}; // cleared by the scan
+  }
+
+  void test_equal()
+  {
+    QVERIFY(not findDirtyRanges(previous_, next_, out_));
+    QVERIFY(out_.empty());
+    QVERIFY(not findDirtyRanges({}, {}, out_));
+  }
+
+  void test_single_byte()
+  {
+    next_[300] = std::byte{1};
+    QVERIFY(findDirtyRanges(previous_, next_, out_));
+    QCOMPARE(out_.size(), size_t(1));
+    QCOMPARE(out_[0], (DirtyRange{288, 32}));
+  }
+
+  void test_tail()
+  {
+    // 1000 is not a multiple of the block size: the tail is clipped
+    next_[999] = std::byte{1};
+    QVERIFY(findDirtyRanges(previous_, next_, out_));
+    QCOMPARE(out_.size(), size_t(1));
+    QCOMPARE(out_[0], (DirtyRange{992, 8}));
+  }
+
+  void test_merge()
+  {
+    next_[0]   = std::byte{1};
+    next_[100] = std::byte{1}; // block 96, 64 bytes after the first one ends
+    next_[600] = std::byte{1};
+
+    QVERIFY(findDirtyRanges(previous_, next_, out_));
+    QCOMPARE(out_.size(), size_t(2));
+    QCOMPARE(out_[0], (DirtyRange{0, 128}));
+    QCOMPARE(out_[1], (DirtyRange{576, 32}));
+
+    QVERIFY(findDirtyRanges(previous_, next_, out_, 0));
+    QCOMPARE(out_.size(), size_t(3));
+  }
+
+  void test_sizes_differ()
+  {
+    next_.resize(1040, std::byte{0x5a});
+    QVERIFY(findDirtyRanges(previous_, next_, out_));
+    QCOMPARE(out_.size(), size_t(1));
+    QCOMPARE(out_[0], (DirtyRange{1000, 40}));
+  }
+
+  void test_random()
+  {
+    // every changed byte is covered, blocks without changes are not
+    std::mt19937 rng{42};
+    for(int round = 0; round < 50; ++round)
+    {
+      next_ = previous_;
+      for(int n = int(rng() % 20); n > 0; --n)
+      {
+        next_[rng() % next_.size()] = std::byte(rng() & 0xff);
+      }
+
+      findDirtyRanges(previous_, next_, out_, 0);
+      std::vector<size_t> blocks;
+      for(const auto& range : out_)
+      {
+        for(size_t i = range.offset; i < range.end(); i += 32)
+        {
+          blocks.push_back(i / 32);
+        }
+      }
+      QCOMPARE(blocks, dirtyBlocks(previous_, next_));
+    }
+  }
+};
+
+QTEST_GUILESS_MAIN(DirtyRangesTests)
+#include "test-dirty-ranges.moc"
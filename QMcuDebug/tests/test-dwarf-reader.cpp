@@ -0,0 +1,94 @@
+#include <DwarfReader.hpp>
+#include <ElfFile.hpp>
+
+#include <QCoreApplication>
+#include <QTest>
+
+#include <algorithm>
+
+// Read back from the debug information of this test
+namespace dwarf_test
+{
+struct Gains
+{
+  float   kp;
+  int16_t history[4];
+};
+Gains    gains   = {1.f, {1, 2, 3, 4}};
+uint32_t counter = 42;
+} // namespace dwarf_test
+
+class DwarfReaderTests : public QObject
+{
+  Q_OBJECT
+
+  ElfFile                          elf_;
+  std::vector<SymbolIndex::Symbol> globals_;
+
+  SymbolIndex::Symbol const* find(std::string_view name) const
+  {
+    const auto it = std::ranges::find(globals_, name, &SymbolIndex::Symbol::name);
+    return it != globals_.end() ? &*it : nullptr;
+  }
+
+private slots:
+  void initTestCase()
+  {
+    if(not elf_.open(QCoreApplication::applicationFilePath()))
+    {
+      QSKIP("not an ELF executable");
+    }
+    DwarfReader dwarf{elf_};
+    if(not dwarf.isValid())
+    {
+      QSKIP("built without debug information");
+    }
+    globals_ = dwarf.globals(2);
+  }
+
+  void test_elf()
+  {
+    QVERIFY(elf_.section(".text") != nullptr);
+    QCOMPARE(elf_.addressSize(), sizeof(void*));
+
+    const auto symbols = elf_.symbols();
+    QVERIFY(std::ranges::any_of(symbols, [](auto const& s) { return s.isObject(); }));
+  }
+
+  void test_basic()
+  {
+    auto const* counter = find("dwarf_test::counter");
+    QVERIFY(counter != nullptr);
+    QVERIFY(counter->typeName == "uint32_t");
+    QCOMPARE(counter->size, uint64_t(4));
+    QCOMPARE(counter->type, int(QMetaType::UInt));
+    QCOMPARE(counter->depth, uint32_t(0));
+    QVERIFY(counter->extents.empty());
+  }
+
+  void test_members()
+  {
+    auto const* gains   = find("dwarf_test::gains");
+    auto const* kp      = find("dwarf_test::gains.kp");
+    auto const* history = find("dwarf_test::gains.history");
+    QVERIFY(gains != nullptr and kp != nullptr and history != nullptr);
+
+    QCOMPARE(gains->size, uint64_t(sizeof(dwarf_test::Gains)));
+    QCOMPARE(gains->type, int(QMetaType::UnknownType));
+    QCOMPARE(kp->type, int(QMetaType::Float));
+    QCOMPARE(kp->depth, uint32_t(1));
+    QCOMPARE(history->type, int(QMetaType::Short));
+    QCOMPARE(history->extents.size(), size_t(1));
+    QCOMPARE(history->extents[0], uint32_t(4));
+
+    // file addresses, relocated as a whole when loaded
+    const auto base = reinterpret_cast<uint64_t>(&dwarf_test::gains);
+    QCOMPARE(history->address - gains->address,
+             reinterpret_cast<uint64_t>(&dwarf_test::gains.history) - base);
+    QCOMPARE(find("dwarf_test::counter")->address - gains->address,
+             reinterpret_cast<uint64_t>(&dwarf_test::counter) - base);
+  }
+};
+
+QTEST_GUILESS_MAIN(DwarfReaderTests)
+#include "test-dwarf-reader.moc"
@@ -0,0 +1,82 @@
+#include <QMcu/Debug/FrameSlots.hpp>
+
+#include <QTest>
+
+#include <deque>
+#include <random>
+
+class FrameSlotsTests : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void test_nothing_published()
+  {
+    FrameSlots frameSlots{2};
+    QCOMPARE(frameSlots.count(), size_t(4));
+    QVERIFY(not frameSlots.present().has_value());
+  }
+
+  void test_latest_wins()
+  {
+    FrameSlots frameSlots{1};
+    const auto first = frameSlots.acquire();
+    frameSlots.publish(first);
+    const auto second = frameSlots.acquire();
+    QVERIFY(second != first);
+    frameSlots.publish(second);
+
+    // the first one was never drawn, it is free again
+    QCOMPARE(frameSlots.present().value_or(99), second);
+    QCOMPARE(frameSlots.present().value_or(99), second); // nothing new: drawn again
+    QCOMPARE(frameSlots.acquire(), first);
+  }
+
+  void test_failed_write()
+  {
+    FrameSlots frameSlots{1};
+    const auto slot = frameSlots.acquire();
+    frameSlots.release(slot);
+    QVERIFY(not frameSlots.present().has_value());
+    QCOMPARE(frameSlots.acquire(), slot);
+  }
+
+  void test_never_writes_drawn_slots()
+  {
+    // writes and frames interleaved at random: a slot drawn by one of the last `frames` frames is
+    // never handed to the writer
+    for(size_t frames = 1; frames <= 3; ++frames)
+    {
+      FrameSlots         frameSlots{frames};
+      std::deque<size_t> drawn; // by the frames in flight
+      std::mt19937       rng{42};
+      for(int ii = 0; ii < 10000; ++ii)
+      {
+        if(rng() % 2 == 0)
+        {
+          const auto slot = frameSlots.acquire();
+          QVERIFY(std::ranges::find(drawn, slot) == drawn.end());
+          if(rng() % 8 == 0)
+          {
+            frameSlots.release(slot);
+          }
+          else
+          {
+            frameSlots.publish(slot);
+          }
+        }
+        else if(const auto slot = frameSlots.present())
+        {
+          drawn.push_back(*slot);
+          if(drawn.size() > frames)
+          {
+            drawn.pop_front();
+          }
+        }
+      }
+    }
+  }
+};
+
+QTEST_GUILESS_MAIN(FrameSlotsTests)
+#include "test-frame-slots.moc"
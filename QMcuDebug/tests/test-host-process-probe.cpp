@@ -0,0 +1,83 @@
+#include <QMcu/Debug/HostProcessProbe.hpp>
+
+#include <QCoreApplication>
+#include <QTest>
+
+#include <array>
+
+namespace
+{
+int32_t                 counter = 42;
+double                  reading = 3.5;
+std::array<uint8_t, 37> buffer  = {1, 2, 3};
+
+template <typename T> uint64_t address_of(T& value)
+{
+  return reinterpret_cast<uint64_t>(&value);
+}
+} // namespace
+
+// The probe is attached to this very process.
+class HostProcessProbeTests : public QObject
+{
+  Q_OBJECT
+
+private slots:
+
+  void test_read()
+  {
+    HostProcessProbe probe;
+    probe.attach(QCoreApplication::applicationPid());
+    QCOMPARE(probe.method(), HostProcessProbe::Method::VmReadv);
+
+    QCOMPARE(probe.read<int32_t>(address_of(counter)), 42);
+    QCOMPARE(probe.read<double>(address_of(reading)), 3.5);
+
+    counter = 43;
+    QCOMPARE(probe.read<int32_t>(address_of(counter)), 43);
+  }
+
+  void test_batch()
+  {
+    HostProcessProbe probe;
+    probe.attach(QCoreApplication::applicationPid());
+
+    int32_t                 c = 0;
+    double                  r = 0.0;
+    std::array<uint8_t, 37> b = {};
+
+    const std::array requests{
+        AbstractProbe::ReadRequest{address_of(counter), std::as_writable_bytes(std::span{&c, 1})},
+        AbstractProbe::ReadRequest{address_of(reading), std::as_writable_bytes(std::span{&r, 1})},
+        AbstractProbe::ReadRequest{address_of(buffer), std::as_writable_bytes(std::span{b})},
+    };
+    QVERIFY(probe.readBatch(requests));
+    QCOMPARE(c, counter);
+    QCOMPARE(r, reading);
+    QVERIFY(b == buffer);
+    QCOMPARE(probe.stats().transfers, quint64(1));
+  }
+
+  void test_write()
+  {
+    HostProcessProbe probe;
+    probe.attach(QCoreApplication::applicationPid());
+
+    const int32_t value = -7;
+    QVERIFY(probe.write(address_of(counter), std::as_bytes(std::span{&value, 1})));
+    QCOMPARE(counter, -7);
+  }
+
+  void test_unmapped()
+  {
+    HostProcessProbe probe;
+    probe.attach(QCoreApplication::applicationPid());
+
+    int32_t value = 0;
+    QVERIFY(not probe.read(0x10, std::as_writable_bytes(std::span{&value, 1})));
+    QCOMPARE(probe.stats().errors, quint64(1));
+  }
+};
+
+QTEST_GUILESS_MAIN(HostProcessProbeTests)
+#include "test-host-process-probe.moc"
@@ -0,0 +1,232 @@
+#include <MemoryAccess.hpp>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTest>
+
+#include <numeric>
+#include <vector>
+
+// In-memory probe backend counting round trips, with an optional simulated per-transfer latency
+// (a full-speed USB transaction costs ~125us on real adapters).
+struct MockMemoryAccess
+{
+  static constexpr size_t maxBlock32 = 0x1800;
+  static constexpr size_t maxBlock8  = 64;
+
+  uint32_t               base = 0x20000000;
+  std::vector<std::byte> memory;
+  int64_t                latencyNs     = 0;
+  size_t                 roundTrips    = 0;
+  bool                   blockFailures = false;
+
+  MockMemoryAccess(size_t size) : memory(size)
+  {
+    std::ranges::generate(memory, [ii = 0] mutable { return std::byte(ii++ * 7 + 3); });
+  }
+
+  void transfer()
+  {
+    ++roundTrips;
+    if(latencyNs > 0)
+    {
+      QElapsedTimer t;
+      t.start();
+      while(t.nsecsElapsed() < latencyNs)
+      {
+      }
+    }
+  }
+
+  bool copy(uint32_t address, std::span<std::byte> data)
+  {
+    if(address < base or address + data.size_bytes() > base + memory.size())
+    {
+      return false;
+    }
+    std::memcpy(data.data(), memory.data() + (address - base), data.size_bytes());
+    return true;
+  }
+
+  bool readWord(uint32_t address, uint32_t& value)
+  {
+    Q_ASSERT(is_aligned(address, sizeof(uint32_t)));
+    transfer();
+    return copy(address, std::as_writable_bytes(std::span{&value, 1}));
+  }
+
+  bool readBlock32(uint32_t address, std::span<std::byte> data)
+  {
+    Q_ASSERT(is_aligned(address, sizeof(uint32_t)));
+    Q_ASSERT(is_aligned(data.size_bytes(), sizeof(uint32_t)));
+    Q_ASSERT(data.size_bytes() <= maxBlock32);
+    transfer();
+    return not blockFailures and copy(address, data);
+  }
+
+  bool readBlock8(uint32_t address, std::span<std::byte> data)
+  {
+    Q_ASSERT(data.size_bytes() <= maxBlock8);
+    transfer();
+    return not blockFailures and copy(address, data);
+  }
+
+  bool writeBlock32(uint32_t address, std::span<std::byte const> data)
+  {
+    Q_ASSERT(is_aligned(address, sizeof(uint32_t)));
+    Q_ASSERT(is_aligned(data.size_bytes(), sizeof(uint32_t)));
+    Q_ASSERT(data.size_bytes() <= maxBlock32);
+    transfer();
+    return store(address, data);
+  }
+
+  bool writeBlock8(uint32_t address, std::span<std::byte const> data)
+  {
+    Q_ASSERT(data.size_bytes() <= maxBlock8);
+    transfer();
+    return store(address, data);
+  }
+
+  bool store(uint32_t address, std::span<std::byte const> data)
+  {
+    if(address < base or address + data.size_bytes() > base + memory.size())
+    {
+      return false;
+    }
+    std::memcpy(memory.data() + (address - base), data.data(), data.size_bytes());
+    return true;
+  }
+
+  std::span<std::byte const> expected(uint32_t address, size_t size) const
+  {
+    return std::span{memory}.subspan(address - base, size);
+  }
+};
+static_assert(memory_access_backend_c<MockMemoryAccess>);
+static_assert(memory_write_backend_c<MockMemoryAccess>);
+
+class MemoryAccessTests : public QObject
+{
+  Q_OBJECT
+
+private slots:
+
+  void test_block_read_data()
+  {
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("roundTrips");
+
+    QTest::newRow("u8") << 0 << 1 << 1;
+    QTest::newRow("unaligned u16") << 1 << 2 << 1;
+    QTest::newRow("u32") << 4 << 4 << 1;
+    QTest::newRow("straddling u32") << 3 << 4 << 1;
+    QTest::newRow("u64") << 8 << 8 << 1;
+    QTest::newRow("unaligned u64") << 6 << 8 << 3;
+    QTest::newRow("1KiB") << 0 << 1024 << 1;
+    QTest::newRow("unaligned 1KiB") << 1 << 1024 << 3;
+    QTest::newRow("unaligned head") << 2 << 1022 << 2;
+    QTest::newRow("unaligned tail") << 0 << 1023 << 2;
+    QTest::newRow("16KiB") << 0 << 16384 << 3;
+    QTest::newRow("unaligned 16KiB") << 3 << 16384 << 5;
+  }
+
+  void test_block_read()
+  {
+    QFETCH(int, offset);
+    QFETCH(int, size);
+    QFETCH(int, roundTrips);
+
+    MockMemoryAccess       mock{32768};
+    std::vector<std::byte> out(size);
+    const uint32_t         address = mock.base + offset;
+
+    QVERIFY(block_read(mock, address, out));
+    QVERIFY(std::ranges::equal(out, mock.expected(address, size)));
+    QCOMPARE(mock.roundTrips, size_t(roundTrips));
+
+    // word reads must produce the same data
+    std::ranges::fill(out, std::byte(0));
+    QVERIFY(word_read(mock, address, out));
+    QVERIFY(std::ranges::equal(out, mock.expected(address, size)));
+  }
+
+  void test_block_read_fallback()
+  {
+    MockMemoryAccess mock{4096};
+    mock.blockFailures = true;
+
+    std::vector<std::byte> out(1021);
+    const uint32_t         address = mock.base + 3;
+    QVERIFY(block_read(mock, address, out));
+    QVERIFY(std::ranges::equal(out, mock.expected(address, out.size())));
+  }
+
+  void test_block_write_data()
+  {
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("roundTrips");
+
+    QTest::newRow("u8") << 0 << 1 << 1;
+    QTest::newRow("u32") << 4 << 4 << 1;
+    QTest::newRow("straddling u32") << 3 << 4 << 1;
+    QTest::newRow("unaligned 1KiB") << 1 << 1024 << 3;
+    QTest::newRow("16KiB") << 0 << 16384 << 3;
+  }
+
+  void test_block_write()
+  {
+    QFETCH(int, offset);
+    QFETCH(int, size);
+    QFETCH(int, roundTrips);
+
+    MockMemoryAccess       mock{32768};
+    std::vector<std::byte> in(size);
+    std::ranges::generate(in, [ii = 0] mutable { return std::byte(ii++ * 11 + 5); });
+    const uint32_t address = mock.base + offset;
+
+    QVERIFY(block_write(mock, address, in));
+    QVERIFY(std::ranges::equal(in, mock.expected(address, size)));
+    QCOMPARE(mock.roundTrips, size_t(roundTrips));
+  }
+
+  void test_out_of_range()
+  {
+    MockMemoryAccess       mock{64};
+    std::vector<std::byte> out(128);
+    QVERIFY(not block_read(mock, mock.base, out));
+  }
+
+  void bench_read_data()
+  {
+    QTest::addColumn<bool>("block");
+    QTest::newRow("word") << false;
+    QTest::newRow("block") << true;
+  }
+
+  // counterBuffers-like 1KiB array refresh, with 125us per transfer
+  void bench_read()
+  {
+    QFETCH(bool, block);
+
+    MockMemoryAccess mock{1024};
+    mock.latencyNs = 125'000;
+
+    std::vector<std::byte> out(1024);
+    QBENCHMARK
+    {
+      if(block)
+      {
+        block_read(mock, mock.base, out);
+      }
+      else
+      {
+        word_read(mock, mock.base, out);
+      }
+    }
+  }
+};
+
+QTEST_GUILESS_MAIN(MemoryAccessTests)
+#include "test-memory-access.moc"
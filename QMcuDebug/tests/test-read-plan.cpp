@@ -0,0 +1,91 @@
+#include <ReadPlan.hpp>
+
+#include <QTest>
+
+#include <numeric>
+
+class ReadPlanTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr uint64_t bss = 0x20000100;
+
+private slots:
+
+  void test_packed_globals()
+  {
+    // 40 packed 32-bit globals, declared in no particular order
+    ReadPlan plan;
+    for(int ii = 39; ii >= 0; --ii)
+    {
+      plan.add({bss + ii * 4, 4});
+    }
+    plan.compile(0);
+
+    QCOMPARE(plan.spans().size(), qsizetype(1));
+    QCOMPARE(plan.spans()[0].address, bss);
+    QCOMPARE(plan.spans()[0].data.size(), size_t(160));
+    QCOMPARE(plan.spans()[0].entries.size(), qsizetype(40));
+  }
+
+  void test_gap_threshold()
+  {
+    ReadPlan plan;
+    plan.add({bss, 4});
+    plan.add({bss + 16, 2});
+    plan.add({bss + 1024, 8});
+    plan.add({bss + 1040, 4});
+
+    plan.compile(4);
+    QCOMPARE(plan.spans().size(), qsizetype(4));
+
+    plan.compile(16);
+    QCOMPARE(plan.spans().size(), qsizetype(2));
+    QCOMPARE(plan.spans()[0].data.size(), size_t(18));
+    QCOMPARE(plan.spans()[1].address, bss + 1024);
+    QCOMPARE(plan.spans()[1].data.size(), size_t(20));
+
+    plan.compile(4096);
+    QCOMPARE(plan.spans().size(), qsizetype(1));
+  }
+
+  void test_overlapping()
+  {
+    // a whole array and one of its elements
+    ReadPlan plan;
+    plan.add({bss + 8, 4});
+    plan.add({bss, 64});
+    plan.compile(0);
+
+    QCOMPARE(plan.spans().size(), qsizetype(1));
+    QCOMPARE(plan.spans()[0].data.size(), size_t(64));
+  }
+
+  void test_execute()
+  {
+    std::vector<std::byte> memory(2048);
+    std::iota(reinterpret_cast<uint8_t*>(memory.data()),
+              reinterpret_cast<uint8_t*>(memory.data() + memory.size()),
+              uint8_t(0));
+
+    ReadPlan plan;
+    plan.add({bss, 4});
+    plan.add({bss + 1024, 4});
+    plan.compile(32);
+
+    int        transfers = 0;
+    const bool ok        = plan.execute(
+        [&](uint64_t address, std::span<std::byte> data)
+        {
+          ++transfers;
+          std::memcpy(data.data(), memory.data() + (address - bss), data.size_bytes());
+          return true;
+        });
+    QVERIFY(ok);
+    QCOMPARE(transfers, 2);
+    QVERIFY(plan.spans()[1].data[0] == memory[1024]);
+  }
+};
+
+QTEST_GUILESS_MAIN(ReadPlanTests)
+#include "test-read-plan.moc"
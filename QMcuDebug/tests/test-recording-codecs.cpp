@@ -0,0 +1,150 @@
+#include <QMcu/Debug/RecordingCodecs.hpp>
+
+#include <QTest>
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+using recording::Codec;
+
+class RecordingCodecsTests : public QObject
+{
+  Q_OBJECT
+
+  // Rows of `lanes` elements: a random walk, with runs and the extremes of T
+  template <typename T> static std::vector<std::byte> samples(size_t rows, size_t lanes)
+  {
+    std::mt19937                    rng{1234};
+    std::uniform_int_distribution<> step{-3, 3};
+    std::bernoulli_distribution     hold{0.7};
+    std::vector<T>                  values(rows * lanes);
+    constexpr auto                  limits = std::numeric_limits<T>();
+    for(size_t ii = lanes; ii < values.size(); ++ii)
+    {
+      const T prev = values[ii - lanes];
+      values[ii]   = hold(rng) ? prev : T(prev + T(step(rng)));
+    }
+    values[values.size() / 2]     = limits.max();
+    values[values.size() / 2 + 1] = limits.lowest();
+    std::vector<std::byte> out(values.size() * sizeof(T));
+    std::memcpy(out.data(), values.data(), out.size());
+    return out;
+  }
+
+  template <typename T> static void roundTrip(Codec codec, QMetaType::Type type, size_t lanes)
+  {
+    const auto             rows = samples<T>(5000, lanes);
+    std::vector<std::byte> encoded;
+    QVERIFY(recording::supports(codec, type, sizeof(T)));
+    QVERIFY(recording::encode(codec, type, sizeof(T), lanes * sizeof(T), rows, encoded));
+
+    std::vector<std::byte> decoded(rows.size());
+    QVERIFY(recording::decode(codec, type, sizeof(T), lanes * sizeof(T), encoded, decoded));
+    QVERIFY(decoded == rows);
+
+    // truncated, or with trailing bytes
+    if(not encoded.empty())
+    {
+      const std::span truncated{encoded.data(), encoded.size() - 1};
+      QVERIFY(not recording::decode(codec, type, sizeof(T), lanes * sizeof(T), truncated, decoded));
+    }
+    encoded.push_back(std::byte(0x55));
+    QVERIFY(not recording::decode(codec, type, sizeof(T), lanes * sizeof(T), encoded, decoded));
+  }
+
+  template <typename T> static void roundTrips(QMetaType::Type type)
+  {
+    for(const size_t lanes : {1, 3})
+    {
+      if constexpr(std::is_integral_v<T>)
+      {
+        roundTrip<T>(Codec::delta, type, lanes);
+        roundTrip<T>(Codec::deltaOfDelta, type, lanes);
+      }
+      else
+      {
+        roundTrip<T>(Codec::gorilla, type, lanes);
+      }
+      roundTrip<T>(Codec::runLength, type, lanes);
+      roundTrip<T>(Codec::none, type, lanes);
+    }
+  }
+
+private slots:
+  void test_round_trips()
+  {
+    roundTrips<float>(QMetaType::Float);
+    roundTrips<double>(QMetaType::Double);
+    roundTrips<int32_t>(QMetaType::Int);
+    roundTrips<uint32_t>(QMetaType::UInt);
+    roundTrips<int64_t>(QMetaType::LongLong);
+    roundTrips<uint64_t>(QMetaType::ULongLong);
+    roundTrips<int16_t>(QMetaType::Short);
+    roundTrips<uint16_t>(QMetaType::UShort);
+    roundTrips<int8_t>(QMetaType::Char);
+    roundTrips<uint8_t>(QMetaType::UChar);
+  }
+
+  void test_supports()
+  {
+    QVERIFY(recording::supports(Codec::delta, QMetaType::Short, 2));
+    QVERIFY(not recording::supports(Codec::delta, QMetaType::Float, 4));
+    QVERIFY(not recording::supports(Codec::gorilla, QMetaType::Int, 4));
+    QVERIFY(not recording::supports(Codec::delta, QMetaType::Int, 2)); // not its size
+    QVERIFY(recording::supports(Codec::runLength, QMetaType::UnknownType, 12));
+
+    std::vector<std::byte> encoded;
+    const std::byte        row[4] = {};
+    QVERIFY(not recording::encode(Codec::gorilla, QMetaType::Int, 4, 4, row, encoded));
+  }
+
+  void test_pick()
+  {
+    std::vector<int16_t> slow(4096);
+    std::vector<float>   noisy(4096);
+    std::vector<double>  flat(4096, 2.5);
+    std::mt19937         rng{99};
+    for(size_t ii = 0; ii < slow.size(); ++ii)
+    {
+      slow[ii]  = int16_t(ii / 10);
+      noisy[ii] = std::uniform_real_distribution<float>{-1.0f, 1.0f}(rng);
+    }
+    QCOMPARE(recording::pick(QMetaType::Short, 2, 2, std::as_bytes(std::span{slow})),
+             Codec::delta);
+    QCOMPARE(recording::pick(QMetaType::Double, 8, 8, std::as_bytes(std::span{flat})),
+             Codec::runLength);
+    // nothing to gain
+    QCOMPARE(recording::pick(QMetaType::Float, 4, 4, std::as_bytes(std::span{noisy})),
+             Codec::none);
+  }
+
+  void benchmark_decode_delta()
+  {
+    const auto             rows = samples<int32_t>(1'000'000, 1);
+    std::vector<std::byte> encoded;
+    QVERIFY(recording::encode(Codec::delta, QMetaType::Int, 4, 4, rows, encoded));
+    std::vector<std::byte> decoded(rows.size());
+    QBENCHMARK
+    {
+      recording::decode(Codec::delta, QMetaType::Int, 4, 4, encoded, decoded);
+    }
+    QVERIFY(decoded == rows);
+  }
+
+  void benchmark_decode_gorilla()
+  {
+    const auto             rows = samples<float>(1'000'000, 1);
+    std::vector<std::byte> encoded;
+    QVERIFY(recording::encode(Codec::gorilla, QMetaType::Float, 4, 4, rows, encoded));
+    std::vector<std::byte> decoded(rows.size());
+    QBENCHMARK
+    {
+      recording::decode(Codec::gorilla, QMetaType::Float, 4, 4, encoded, decoded);
+    }
+    QVERIFY(decoded == rows);
+  }
+};
+
+QTEST_GUILESS_MAIN(RecordingCodecsTests)
+#include "test-recording-codecs.moc"
@@ -0,0 +1,260 @@
+#include <QMcu/Debug/RecordingReader.hpp>
+#include <QMcu/Debug/RecordingWriter.hpp>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <cstring>
+
+class RecordingTests : public QObject
+{
+  Q_OBJECT
+
+  QTemporaryDir dir_;
+
+  QString path(QString const& name) const
+  {
+    return dir_.filePath(name);
+  }
+
+  // rows of (int16_t t, float[2] {t / 2, -t}) at t ns
+  static void record(QString const& file, int rows, size_t chunkRows)
+  {
+    RecordingWriter writer{chunkRows};
+    QVERIFY(writer.open(file,
+                        {{"counter", QMetaType::Short, sizeof(int16_t), sizeof(int16_t)},
+                         {"pair", QMetaType::Float, sizeof(float), 2 * sizeof(float)}}));
+    for(int t = 0; t < rows; ++t)
+    {
+      const int16_t                    counter = int16_t(t);
+      const float                      pair[2] = {t / 2.0f, -float(t)};
+      const std::span<std::byte const> row[]   = {std::as_bytes(std::span{&counter, 1}),
+                                                  std::as_bytes(std::span{pair})};
+      writer.append(t, row);
+    }
+    QCOMPARE(writer.rows(), uint64_t(rows));
+    writer.close();
+    QVERIFY(not writer.failed());
+    QCOMPARE(writer.bytesWritten(), uint64_t(QFile(file).size()));
+  }
+
+private slots:
+  void initTestCase()
+  {
+    QVERIFY(dir_.isValid());
+  }
+
+  void test_round_trip()
+  {
+    record(path("round-trip.rec"), 10, 4);
+
+    RecordingReader reader;
+    QVERIFY(reader.open(path("round-trip.rec")));
+    QCOMPARE(reader.rows(), uint64_t(10));
+    QCOMPARE(reader.channels().size(), size_t(2));
+    QCOMPARE(reader.channels()[0].name, QString("counter"));
+    QCOMPARE(reader.channels()[1].typeId, QMetaType::Float);
+    QCOMPARE(reader.channels()[1].width, 2 * sizeof(float));
+
+    // 4 + 4 + the partial last one
+    QCOMPARE(reader.chunks().size(), size_t(3));
+    QCOMPARE(reader.chunks()[2].count(), size_t(2));
+    QCOMPARE(reader.chunks()[2].row, uint64_t(8));
+    QCOMPARE(reader.firstNs(), int64_t(0));
+    QCOMPARE(reader.lastNs(), int64_t(9));
+
+    for(auto const& chunk : reader.chunks())
+    {
+      std::vector<int64_t>   times(chunk.count());
+      std::vector<std::byte> counters(chunk.count() * sizeof(int16_t));
+      std::vector<std::byte> pairs(chunk.count() * 2 * sizeof(float));
+      QVERIFY(reader.times(chunk, times));
+      QVERIFY(reader.read(chunk, 0, counters));
+      QVERIFY(reader.read(chunk, 1, pairs));
+      QVERIFY(not reader.read(chunk, 1, counters)); // not sized for them
+      for(size_t ii = 0; ii < chunk.count(); ++ii)
+      {
+        int16_t counter;
+        float   pair[2];
+        std::memcpy(&counter, counters.data() + ii * sizeof(int16_t), sizeof(counter));
+        std::memcpy(pair, pairs.data() + ii * sizeof(pair), sizeof(pair));
+        const auto t = times[ii];
+        QCOMPARE(t, int64_t(chunk.row + ii));
+        QCOMPARE(counter, int16_t(t));
+        QCOMPARE(pair[0], t / 2.0f);
+        QCOMPARE(pair[1], -float(t));
+      }
+    }
+  }
+
+  void test_statistics()
+  {
+    record(path("statistics.rec"), 6, 4);
+
+    RecordingReader reader;
+    QVERIFY(reader.open(path("statistics.rec")));
+    auto const& second = reader.chunks()[1]; // t = 4, 5
+    QCOMPARE(second.columns[0].min, 4.0);
+    QCOMPARE(second.columns[0].max, 5.0);
+    // over both elements of the pair
+    QCOMPARE(second.columns[1].min, -5.0);
+    QCOMPARE(second.columns[1].max, 2.5);
+  }
+
+  void test_lookup()
+  {
+    record(path("lookup.rec"), 10, 4);
+
+    RecordingReader reader;
+    QVERIFY(reader.open(path("lookup.rec")));
+    QCOMPARE(reader.chunkAt(-1), size_t(0));
+    QCOMPARE(reader.chunkAt(3), size_t(0));
+    QCOMPARE(reader.chunkAt(4), size_t(1));
+    QCOMPARE(reader.chunkAt(100), size_t(2));
+    QCOMPARE(reader.chunkOfRow(7), size_t(1));
+    QCOMPARE(reader.chunkOfRow(8), size_t(2));
+    QCOMPARE(reader.rowsUntil(-1), uint64_t(0));
+    QCOMPARE(reader.rowsUntil(0), uint64_t(1));
+    QCOMPARE(reader.rowsUntil(5), uint64_t(6));
+    QCOMPARE(reader.rowsUntil(100), uint64_t(10));
+    QCOMPARE(reader.timeAt(0), int64_t(0));
+    QCOMPARE(reader.timeAt(6), int64_t(6));
+    QCOMPARE(reader.timeAt(9), int64_t(9));
+  }
+
+  void test_compression()
+  {
+    // a slowly changing counter, a toggling state and noise, as in soak tests
+    const auto path = this->path("compression.rec");
+    RecordingWriter writer{4096};
+    QVERIFY(writer.open(path,
+                        {{"slow", QMetaType::Int, sizeof(int32_t), sizeof(int32_t)},
+                         {"toggle", QMetaType::Double, sizeof(double), sizeof(double)},
+                         {"raw",
+                          QMetaType::Short,
+                          sizeof(int16_t),
+                          sizeof(int16_t),
+                          recording::Codec::none}}));
+    for(int t = 0; t < 100'000; ++t)
+    {
+      const int32_t                    slow   = t / 100;
+      const double                     toggle = t % 2;
+      const int16_t                    raw    = int16_t(t * 7919);
+      const std::span<std::byte const> row[]  = {std::as_bytes(std::span{&slow, 1}),
+                                                 std::as_bytes(std::span{&toggle, 1}),
+                                                 std::as_bytes(std::span{&raw, 1})};
+      writer.append(1'000'000 * int64_t(t), row); // 1 kHz
+    }
+    writer.close();
+    QVERIFY(not writer.failed());
+    // 22 bytes a row as sampled, most of what is left is the raw column
+    QVERIFY(writer.bytesWritten() < 100'000 * 22 / 5);
+
+    RecordingReader reader;
+    QVERIFY(reader.open(path));
+    QCOMPARE(reader.rows(), uint64_t(100'000));
+    auto const& chunk = reader.chunks()[3]; // rows 12288 to 16383
+    QCOMPARE(chunk.codec(0), recording::Codec::delta);
+    QCOMPARE(chunk.codec(1), recording::Codec::gorilla);
+    QCOMPARE(chunk.codec(2), recording::Codec::none);
+    QCOMPARE(recording::Codec(chunk.header->timesCodec), recording::Codec::deltaOfDelta);
+
+    std::vector<std::byte> slow(chunk.count() * sizeof(int32_t));
+    QVERIFY(reader.read(chunk, 0, slow));
+    for(size_t ii = 0; ii < chunk.count(); ++ii)
+    {
+      int32_t value;
+      std::memcpy(&value, slow.data() + ii * sizeof(value), sizeof(value));
+      QCOMPARE(value, int32_t((chunk.row + ii) / 100));
+    }
+    QCOMPARE(reader.rowsUntil(12'345'678'901), uint64_t(12346));
+
+    // decoded once for the lookups in the same chunk
+    RecordingReader::TimesCache cache;
+    QCOMPARE(reader.rowsUntil(12'345'678'901, cache), uint64_t(12346));
+    QCOMPARE(cache.chunk, reader.chunkOfRow(12345));
+    QCOMPARE(reader.timeAt(12'300, cache), int64_t(12'300'000'000));
+    QCOMPARE(reader.rowsUntil(13'000'000'000, cache), uint64_t(13001));
+    QCOMPARE(cache.chunk, reader.chunkOfRow(12345));
+  }
+
+  void test_levels_of_detail()
+  {
+    record(path("levels.rec"), 100, 16);
+    const auto levels = RecordingWriter::levelsPath(path("levels.rec"));
+    QVERIFY(QFile::exists(levels));
+
+    const auto check = [](MinMaxPyramid const& counters, MinMaxPyramid const& values)
+    {
+      // 25, 7, 2 and 1 buckets
+      QCOMPARE(counters.samples(), size_t(100));
+      QCOMPARE(counters.levelCount(), size_t(5));
+      int16_t pair[2];
+      std::memcpy(pair, counters.level(1).data() + 24 * sizeof(pair), sizeof(pair));
+      QCOMPARE(pair[0], int16_t(96));
+      QCOMPARE(pair[1], int16_t(99));
+      std::memcpy(pair, counters.level(4).data(), sizeof(pair));
+      QCOMPARE(pair[0], int16_t(0));
+      QCOMPARE(pair[1], int16_t(99));
+      // first element of the pairs
+      float halves[2];
+      std::memcpy(halves, values.level(2).data() + sizeof(halves), sizeof(halves));
+      QCOMPARE(halves[0], 8.0f);
+      QCOMPARE(halves[1], 15.5f);
+    };
+    {
+      RecordingReader reader;
+      QVERIFY(reader.open(path("levels.rec")));
+      QVERIFY(reader.hasLevels());
+      check(reader.pyramid(0), reader.pyramid(1)); // mapped
+    }
+
+    // opening neither builds missing levels nor writes them
+    QVERIFY(QFile::remove(levels));
+    RecordingReader reader;
+    QVERIFY(reader.open(path("levels.rec")));
+    QVERIFY(not reader.hasLevels());
+    QVERIFY(not reader.pyramid(0).isValid());
+    QVERIFY(not QFile::exists(levels));
+
+    const auto built = reader.buildLevels();
+    QCOMPARE(built.size(), size_t(2));
+    check(built[0], built[1]);
+
+    std::stop_source stop;
+    stop.request_stop();
+    QVERIFY(reader.buildLevels(stop.get_token()).empty());
+  }
+
+  void test_truncated()
+  {
+    // killed while writing the last chunk
+    record(path("truncated.rec"), 10, 4);
+    QFile file{path("truncated.rec")};
+    QVERIFY(file.resize(file.size() - 8));
+
+    RecordingReader reader;
+    QVERIFY(reader.open(path("truncated.rec")));
+    QCOMPARE(reader.chunks().size(), size_t(2));
+    QCOMPARE(reader.rows(), uint64_t(8));
+    // the levels of the whole recording are out of date
+    QVERIFY(not reader.hasLevels());
+    QCOMPARE(reader.buildLevels()[0].samples(), size_t(8));
+  }
+
+  void test_not_a_recording()
+  {
+    QFile file{path("other.bin")};
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(128, 'x'));
+    file.close();
+
+    RecordingReader reader;
+    QVERIFY(not reader.open(path("other.bin")));
+    QVERIFY(not reader.isOpen());
+  }
+};
+
+QTEST_GUILESS_MAIN(RecordingTests)
+#include "test-recording.moc"
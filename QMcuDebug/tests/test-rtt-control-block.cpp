@@ -0,0 +1,144 @@
+#include <QMcu/Debug/SimulatedProbe.hpp>
+
+#include <RttControlBlock.hpp>
+
+#include <QTest>
+
+#include <cstring>
+#include <numeric>
+
+class RttControlBlockTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr uint64_t ram        = 0x20000000;
+  static constexpr uint64_t block      = ram + 0x1ff8; // spans two scan chunks
+  static constexpr uint64_t names      = ram + 0x3000;
+  static constexpr uint64_t buffers    = ram + 0x4000;
+  static constexpr uint32_t bufferSize = 64;
+
+  // 32 bits target layout
+  static constexpr uint64_t descriptor(size_t index)
+  {
+    return block + 24 + index * 24;
+  }
+  static constexpr uint64_t buffer(size_t index)
+  {
+    return buffers + index * bufferSize;
+  }
+
+  std::unique_ptr<SimulatedProbe> probe_;
+
+  void write32(uint64_t address, uint32_t value)
+  {
+    QVERIFY(probe_->write(address, std::as_bytes(std::span{&value, 1})));
+  }
+
+  // Target side of SEGGER_RTT_Write()
+  void targetWrite(size_t index, std::span<uint8_t const> bytes)
+  {
+    auto writeOffset = probe_->read<uint32_t>(descriptor(index) + 12);
+    for(auto byte : bytes)
+    {
+      QVERIFY(probe_->write(buffer(index) + writeOffset, std::as_bytes(std::span{&byte, 1})));
+      writeOffset = (writeOffset + 1) % bufferSize;
+    }
+    write32(descriptor(index) + 12, writeOffset);
+  }
+
+  uint32_t hostReadOffset(size_t index)
+  {
+    return probe_->read<uint32_t>(descriptor(index) + 16);
+  }
+
+private slots:
+
+  void init()
+  {
+    probe_ = std::make_unique<SimulatedProbe>();
+
+    char id[16] = "SEGGER RTT";
+    QVERIFY(probe_->write(block, std::as_bytes(std::span{id})));
+    write32(block + 16, 2); // up buffers
+    write32(block + 20, 0); // down buffers
+
+    QVERIFY(probe_->write(names, std::as_bytes(std::span{"Terminal"})));
+    for(uint32_t ii = 0; ii < 2; ++ii)
+    {
+      write32(descriptor(ii) + 0, ii == 0 ? names : 0);
+      write32(descriptor(ii) + 4, buffer(ii));
+      write32(descriptor(ii) + 8, bufferSize);
+    }
+  }
+
+  void cleanup()
+  {
+    probe_.reset();
+  }
+
+  void test_find()
+  {
+    QVERIFY(RttControlBlock::find(*probe_, ram, 0x10000) == block);
+    QVERIFY(not RttControlBlock::find(*probe_, ram, 0x1000));
+    QVERIFY(not RttControlBlock::find(*probe_, ram, 0x10000, "Other magic"));
+  }
+
+  void test_open()
+  {
+    RttControlBlock rtt{*probe_, block};
+    QVERIFY(rtt.open());
+    QCOMPARE(rtt.channels().size(), size_t(2));
+    QVERIFY(rtt.channels()[0].name == "Terminal");
+    QCOMPARE(rtt.channels()[0].buffer, buffer(0));
+    QCOMPARE(rtt.channels()[1].size, bufferSize);
+
+    RttControlBlock uninitialized{*probe_, ram};
+    QVERIFY(not uninitialized.open());
+  }
+
+  void test_poll()
+  {
+    RttControlBlock rtt{*probe_, block};
+    QVERIFY(rtt.open());
+
+    std::vector<std::vector<std::byte>> data;
+    QVERIFY(rtt.poll(data));
+    QCOMPARE(data.size(), size_t(2));
+    QVERIFY(data[0].empty() and data[1].empty());
+
+    std::vector<uint8_t> sent(100);
+    std::iota(sent.begin(), sent.end(), uint8_t(0));
+
+    // wraps around the end of the buffer within the second poll
+    std::vector<std::byte> received;
+    for(size_t offset = 0; offset < sent.size(); offset += 40)
+    {
+      const auto size  = std::min<size_t>(40, sent.size() - offset);
+      const auto chunk = std::span<uint8_t const>{sent}.subspan(offset, size);
+      targetWrite(1, chunk);
+      QVERIFY(rtt.poll(data));
+      QVERIFY(data[0].empty());
+      received.insert(received.end(), data[1].begin(), data[1].end());
+      data[1].clear();
+      // the space is released on the target
+      QCOMPARE(hostReadOffset(1), probe_->read<uint32_t>(descriptor(1) + 12));
+    }
+    QCOMPARE(received.size(), sent.size());
+    QVERIFY(std::memcmp(received.data(), sent.data(), sent.size()) == 0);
+    QCOMPARE(rtt.channels()[1].received, uint64_t(sent.size()));
+  }
+
+  void test_corrupted()
+  {
+    RttControlBlock rtt{*probe_, block};
+    QVERIFY(rtt.open());
+
+    write32(descriptor(0) + 12, bufferSize + 1);
+    std::vector<std::vector<std::byte>> data;
+    QVERIFY(not rtt.poll(data));
+    QVERIFY(not rtt.isOpen());
+  }
+};
+
+QTEST_GUILESS_MAIN(RttControlBlockTests)
+#include "test-rtt-control-block.moc"
@@ -0,0 +1,84 @@
+#include <QMcu/Debug/SampleRing.hpp>
+
+#include <QTest>
+
+#include <thread>
+
+class SampleRingTests : public QObject
+{
+  Q_OBJECT
+
+private slots:
+
+  void test_push_drain()
+  {
+    SampleRing ring{sizeof(int32_t), 8};
+    QCOMPARE(ring.capacity(), size_t(8));
+
+    for(int32_t ii = 0; ii < 5; ++ii)
+    {
+      QVERIFY(ring.push(ii * 10, std::as_bytes(std::span{&ii, 1})));
+    }
+    QCOMPARE(ring.size(), size_t(5));
+
+    int32_t expected = 0;
+    ring.drainAs<int32_t>(
+        [&](int64_t t, int32_t value)
+        {
+          QCOMPARE(t, int64_t(expected * 10));
+          QCOMPARE(value, expected);
+          ++expected;
+        });
+    QCOMPARE(expected, 5);
+    QCOMPARE(ring.size(), size_t(0));
+  }
+
+  void test_overrun()
+  {
+    SampleRing ring{sizeof(double), 4};
+    for(double v = 0; v < 6; ++v)
+    {
+      ring.push(0, std::as_bytes(std::span{&v, 1}));
+    }
+    QCOMPARE(ring.dropped(), size_t(2));
+
+    double latest = -1;
+    QVERIFY(ring.drainLatest([&](int64_t, std::span<std::byte const> bytes)
+                             { std::memcpy(&latest, bytes.data(), sizeof(latest)); }));
+    QCOMPARE(latest, 3.0);
+    QVERIFY(not ring.drainLatest([](int64_t, std::span<std::byte const>) {}));
+  }
+
+  void test_concurrent()
+  {
+    static constexpr uint32_t count = 1'000'000;
+
+    SampleRing   ring{sizeof(uint32_t), 1024};
+    std::jthread producer{[&]
+                          {
+                            for(uint32_t ii = 0; ii < count;)
+                            {
+                              if(ring.push(ii, std::as_bytes(std::span{&ii, 1})))
+                              {
+                                ++ii;
+                              }
+                            }
+                          }};
+
+    uint32_t next = 0;
+    bool     ok   = true;
+    while(next < count)
+    {
+      ring.drainAs<uint32_t>(
+          [&](int64_t t, uint32_t value)
+          {
+            ok = ok and value == next and t == next;
+            ++next;
+          });
+    }
+    QVERIFY(ok);
+  }
+};
+
+QTEST_GUILESS_MAIN(SampleRingTests)
+#include "test-sample-ring.moc"
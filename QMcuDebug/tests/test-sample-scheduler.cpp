@@ -0,0 +1,109 @@
+#include <SampleScheduler.hpp>
+
+#include <QTest>
+
+class SampleSchedulerTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr int64_t ms = 1'000'000;
+
+private slots:
+
+  void test_rates()
+  {
+    SampleScheduler scheduler;
+
+    std::vector<SampleScheduler::Task> tasks = {
+        {.rate = 1000.0, .size = 4},
+        {.rate = 1.0, .size = 4},
+        {.rate = 0.0, .size = 4}, // every tick
+    };
+
+    std::array<int, 3> samples = {};
+    for(int64_t now = 0; now < 1000 * ms; now += ms)
+    {
+      for(auto index : scheduler.tick(tasks, now, 0.0))
+      {
+        ++samples[index];
+      }
+    }
+
+    QCOMPARE(samples[0], 1000);
+    QCOMPARE(samples[1], 1);
+    QCOMPARE(samples[2], 1000);
+    QCOMPARE(scheduler.skipped(), size_t(0));
+  }
+
+  void test_group_rate()
+  {
+    SampleScheduler scheduler;
+
+    // a group at 10 Hz, ticking at 1 kHz for its fastest variable
+    std::vector<SampleScheduler::Task> tasks = {
+        {.rate = SampleScheduler::resolveRate(1000.0, 10.0), .size = 4},
+        {.rate = SampleScheduler::resolveRate(0.0, 10.0), .size = 4},
+    };
+
+    std::array<int, 2> samples = {};
+    for(int64_t now = 0; now < 1000 * ms; now += ms)
+    {
+      for(auto index : scheduler.tick(tasks, now, 0.0))
+      {
+        ++samples[index];
+      }
+    }
+
+    QCOMPARE(samples[0], 1000);
+    QCOMPARE(samples[1], 10);
+  }
+
+  void test_late_tasks_skip_missed_samples()
+  {
+    SampleScheduler scheduler;
+
+    std::vector<SampleScheduler::Task> tasks = {{.rate = 1000.0, .size = 4}};
+
+    QCOMPARE(scheduler.tick(tasks, 0, 0.0).size(), size_t(1));
+    // 10 periods late: a single sample, then back on the period
+    QCOMPARE(scheduler.tick(tasks, 10 * ms, 0.0).size(), size_t(1));
+    QCOMPARE(tasks[0].nextDueNs, 11 * ms);
+  }
+
+  void test_budget_serves_priorities()
+  {
+    SampleScheduler scheduler;
+
+    std::vector<SampleScheduler::Task> tasks = {
+        {.priority = 0, .size = 100},
+        {.priority = 5, .size = 100},
+        {.priority = 1, .size = 100},
+    };
+
+    auto const& selected = scheduler.tick(tasks, 0, 250.0);
+    QCOMPARE(selected, (std::vector<size_t>{1, 2}));
+    QCOMPARE(scheduler.skipped(), size_t(1));
+
+    // the first task is served even when larger than the budget
+    tasks[1].size = 1000;
+    QCOMPARE(scheduler.tick(tasks, 0, 250.0), (std::vector<size_t>{1}));
+    QCOMPARE(scheduler.skipped(), size_t(3));
+  }
+
+  void test_postponed_tasks_stay_due()
+  {
+    SampleScheduler scheduler;
+
+    std::vector<SampleScheduler::Task> tasks = {
+        {.rate = 100.0, .priority = 1, .size = 100},
+        {.rate = 100.0, .priority = 0, .size = 100},
+    };
+
+    QCOMPARE(scheduler.tick(tasks, 0, 150.0), (std::vector<size_t>{0}));
+    // the high priority one is not due anymore, the postponed one is served
+    QCOMPARE(scheduler.tick(tasks, 1 * ms, 150.0), (std::vector<size_t>{1}));
+  }
+};
+
+QTEST_GUILESS_MAIN(SampleSchedulerTests)
+#include "test-sample-scheduler.moc"
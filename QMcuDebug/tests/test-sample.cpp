@@ -0,0 +1,71 @@
+#include <QMcu/Debug/Sample.hpp>
+
+#include <QTest>
+
+#include <array>
+
+class SampleTests : public QObject
+{
+  Q_OBJECT
+
+  template <typename T, size_t N> static SampleView view(std::span<T const, N> values, bool isArray)
+  {
+    SampleView sample;
+    sample.typeId      = qplot::typeIdOf<T>().qt;
+    sample.elementSize = sizeof(T);
+    sample.bytes       = std::as_bytes(values);
+    sample.isArray     = isArray;
+    return sample;
+  }
+
+private slots:
+  void test_typed_view()
+  {
+    const std::array<int16_t, 3> adc    = {1, -2, 3};
+    const auto                   sample = view(std::span{adc}, true);
+    QCOMPARE(sample.count(), size_t(3));
+
+    const auto values = sample.as<int16_t>();
+    QCOMPARE(values.size(), size_t(3));
+    QCOMPARE(values.data(), adc.data()); // no copy
+    QVERIFY(sample.as<uint16_t>().empty());
+    QVERIFY(sample.as<float>().empty());
+  }
+
+  void test_boxing()
+  {
+    const std::array<float, 2> gains = {0.5f, 2.f};
+
+    const auto list = view(std::span{gains}, true).toVariant();
+    QCOMPARE(list.value<QList<float>>(), (QList<float>{0.5f, 2.f}));
+
+    const auto basic = view(std::span{gains}.first(1), false);
+    QCOMPARE(basic.toVariant().typeId(), QMetaType::Float);
+    QCOMPARE(basic.toVariant().toFloat(), 0.5f);
+    QCOMPARE(basic.toInteger(), qint64(0));
+  }
+
+  void test_struct_bytes()
+  {
+    const std::array<uint8_t, 4> raw = {1, 2, 3, 4};
+
+    SampleView sample;
+    sample.elementSize = raw.size();
+    sample.bytes       = std::as_bytes(std::span{raw});
+    QCOMPARE(sample.count(), size_t(1));
+    QCOMPARE(sample.toVariant().toByteArray(), QByteArray("\x01\x02\x03\x04"));
+    QVERIFY(not visitSampleType(sample.typeId, []<typename T> {}));
+    QVERIFY(not visitSampleType(QMetaType::Bool, []<typename T> {}));
+  }
+
+  void test_integer()
+  {
+    const std::array<uint32_t, 1> index = {7};
+    QCOMPARE(view(std::span{index}, false).toInteger(), qint64(7));
+    QCOMPARE(SampleView{}.toInteger(), qint64(0));
+    QVERIFY(not SampleView{}.isValid());
+  }
+};
+
+QTEST_GUILESS_MAIN(SampleTests)
+#include "test-sample.moc"
@@ -0,0 +1,91 @@
+#include <SegmentTracker.hpp>
+
+#include <QTest>
+
+class SegmentTrackerTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr int64_t ms = 1'000'000;
+
+private slots:
+
+  void test_active()
+  {
+    SegmentTracker tracker{SegmentTracker::Mode::Active, 2};
+
+    // the first value only synchronizes
+    auto update = tracker.next(0, 0);
+    QCOMPARE(update.count, size_t(0));
+
+    QCOMPARE(tracker.next(0, 1 * ms).count, size_t(0));
+
+    update = tracker.next(1, 2 * ms);
+    QCOMPARE(update.first, size_t(0));
+    QCOMPARE(update.count, size_t(1));
+    QCOMPARE(update.lost, uint64_t(0));
+
+    update = tracker.next(0, 3 * ms);
+    QCOMPARE(update.first, size_t(1));
+    QCOMPARE(update.count, size_t(1));
+  }
+
+  void test_completed()
+  {
+    SegmentTracker tracker{SegmentTracker::Mode::Completed, 4};
+    tracker.next(3, 0);
+
+    // segments 0 and 1 completed since
+    const auto update = tracker.next(1, 1 * ms);
+    QCOMPARE(update.first, size_t(0));
+    QCOMPARE(update.count, size_t(2));
+    QCOMPARE(update.lost, uint64_t(0));
+  }
+
+  void test_count()
+  {
+    SegmentTracker tracker{SegmentTracker::Mode::Count, 4};
+    tracker.next(10, 0);
+
+    auto update = tracker.next(12, 1 * ms);
+    QCOMPARE(update.first, size_t(2));
+    QCOMPARE(update.count, size_t(2));
+    QCOMPARE(update.lost, uint64_t(0));
+
+    // 7 completions: the 3 last ones are still intact, segment 3 is being written
+    update = tracker.next(19, 2 * ms);
+    QCOMPARE(update.first, size_t(0));
+    QCOMPARE(update.count, size_t(3));
+    QCOMPARE(update.lost, uint64_t(4));
+
+    // target restart
+    QCOMPARE(tracker.next(0, 3 * ms).count, size_t(0));
+    QCOMPARE(tracker.next(1, 4 * ms).count, size_t(1));
+  }
+
+  void test_laps_from_period()
+  {
+    SegmentTracker tracker{SegmentTracker::Mode::Active, 2};
+    tracker.next(0, 0, 10 * ms);
+
+    // in time
+    auto update = tracker.next(1, 12 * ms, 10 * ms);
+    QCOMPARE(update.count, size_t(1));
+    QCOMPARE(update.lost, uint64_t(0));
+
+    // 5 segments completed within 52 ms, only the last one can be read
+    update = tracker.next(0, 64 * ms, 10 * ms);
+    QCOMPARE(update.first, size_t(1));
+    QCOMPARE(update.count, size_t(1));
+    QCOMPARE(update.lost, uint64_t(4));
+
+    // a whole lap, the index did not move
+    update = tracker.next(0, 86 * ms, 10 * ms);
+    QCOMPARE(update.first, size_t(1));
+    QCOMPARE(update.count, size_t(1));
+    QCOMPARE(update.lost, uint64_t(1));
+  }
+};
+
+QTEST_GUILESS_MAIN(SegmentTrackerTests)
+#include "test-segment-tracker.moc"
@@ -0,0 +1,105 @@
+#include <ShadowMemory.hpp>
+
+#include <QTest>
+
+#include <numeric>
+
+class ShadowMemoryTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr uint64_t bss = 0x20000000;
+
+  std::vector<std::byte> memory_    = std::vector<std::byte>(4096);
+  int                    transfers_ = 0;
+
+  ShadowMemory::reader_fn reader()
+  {
+    return [this](uint64_t address, std::span<std::byte> data)
+    {
+      ++transfers_;
+      std::memcpy(data.data(), memory_.data() + (address - bss), data.size_bytes());
+      return true;
+    };
+  }
+
+  std::span<std::byte const> expected(uint64_t address, size_t size) const
+  {
+    return std::span{memory_}.subspan(address - bss, size);
+  }
+
+private slots:
+
+  void init()
+  {
+    std::iota(reinterpret_cast<uint8_t*>(memory_.data()),
+              reinterpret_cast<uint8_t*>(memory_.data() + memory_.size()),
+              uint8_t(0));
+    transfers_ = 0;
+  }
+
+  // a struct and two of its members shown by three widgets
+  void test_shared_ranges()
+  {
+    ShadowMemory           shadow;
+    std::vector<std::byte> out(16);
+
+    QVERIFY(shadow.read(bss + 16, out, reader()));
+    QVERIFY(shadow.read(bss + 20, std::span{out}.first(4), reader()));
+    QVERIFY(std::ranges::equal(std::span{out}.first(4), expected(bss + 20, 4)));
+    QVERIFY(shadow.read(bss + 28, std::span{out}.first(4), reader()));
+
+    QCOMPARE(transfers_, 1);
+    QCOMPARE(shadow.hits(), size_t(2));
+    QCOMPARE(shadow.misses(), size_t(1));
+  }
+
+  void test_merge()
+  {
+    ShadowMemory           shadow;
+    std::vector<std::byte> out(64);
+
+    QVERIFY(shadow.read(bss, std::span{out}.first(8), reader()));
+    QVERIFY(shadow.read(bss + 8, std::span{out}.first(8), reader()));
+    QCOMPARE(shadow.rangeCount(), size_t(1)); // adjacent ranges are merged
+
+    shadow.fill(bss + 100, expected(bss + 100, 10));
+    QCOMPARE(shadow.rangeCount(), size_t(2));
+
+    shadow.fill(bss, expected(bss, 200));
+    QCOMPARE(shadow.rangeCount(), size_t(1));
+
+    QVERIFY(shadow.read(bss + 150, std::span{out}.first(50), reader()));
+    QVERIFY(std::ranges::equal(std::span{out}.first(50), expected(bss + 150, 50)));
+    QCOMPARE(transfers_, 2);
+  }
+
+  void test_invalidate()
+  {
+    ShadowMemory           shadow;
+    std::vector<std::byte> out(4);
+
+    QVERIFY(shadow.read(bss, out, reader()));
+    memory_[0] = std::byte(0xAA);
+    QVERIFY(shadow.read(bss, out, reader()));
+    QVERIFY(out[0] == std::byte(0)); // same tick
+
+    shadow.invalidate();
+    QVERIFY(shadow.empty());
+    QVERIFY(shadow.read(bss, out, reader()));
+    QVERIFY(out[0] == std::byte(0xAA));
+    QCOMPARE(transfers_, 2);
+  }
+
+  void test_failed_read()
+  {
+    ShadowMemory           shadow;
+    std::vector<std::byte> out(4);
+
+    QVERIFY(not shadow.read(bss, out, [](uint64_t, std::span<std::byte>) { return false; }));
+    QVERIFY(shadow.empty());
+  }
+};
+
+QTEST_GUILESS_MAIN(ShadowMemoryTests)
+#include "test-shadow-memory.moc"
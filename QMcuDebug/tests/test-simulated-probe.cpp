@@ -0,0 +1,165 @@
+#include <QMcu/Debug/SignalGenerator.hpp>
+#include <QMcu/Debug/SimulatedProbe.hpp>
+
+#include <ReadPlan.hpp>
+
+#include <QTest>
+
+#include <limits>
+#include <numeric>
+
+class SimulatedProbeTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr uint64_t ram = 0x20000000;
+
+private slots:
+
+  void test_read_write()
+  {
+    SimulatedProbe probe;
+    QCOMPARE(AbstractProbe::instance(), &probe);
+
+    // unmapped memory reads as zeros
+    QCOMPARE(probe.read<uint32_t>(ram), uint32_t(0));
+
+    // writes are kept, across page boundaries too
+    std::vector<std::byte> in(10000);
+    std::ranges::generate(in, [ii = 0] mutable { return std::byte(ii++ * 13 + 1); });
+    QVERIFY(probe.write(ram + 4090, in));
+
+    std::vector<std::byte> out(in.size());
+    QVERIFY(probe.read(ram + 4090, out));
+    QVERIFY(std::ranges::equal(in, out));
+  }
+
+  void test_single_instance()
+  {
+    SimulatedProbe probe;
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, SimulatedProbe{});
+    QCOMPARE(AbstractProbe::instance(), &probe);
+  }
+
+  void test_generators()
+  {
+    SimulatedProbe probe;
+
+    SignalGenerator constant;
+    constant.setAddress(ram);
+    constant.setFormat(SignalGenerator::Format::Float);
+    constant.setWaveform(SignalGenerator::Waveform::Constant);
+    constant.setAmplitude(3.0);
+    constant.setOffset(1.0);
+    probe.addGenerator(&constant);
+
+    SignalGenerator counter;
+    counter.setAddress(ram + 8);
+    counter.setFormat(SignalGenerator::Format::UInt16);
+    counter.setCount(4);
+    counter.setWaveform(SignalGenerator::Waveform::Counter);
+    counter.setFrequency(1000.0);
+    counter.setInterval(1e-3);
+    probe.addGenerator(&counter);
+
+    QCOMPARE(probe.read<float>(ram), 4.0f);
+
+    // array elements are consecutive samples, oldest first
+    auto values = probe.read<std::array<uint16_t, 4>>(ram + 8);
+    QCOMPARE(values[1] - values[0], 1);
+    QCOMPARE(values[2] - values[1], 1);
+    QCOMPARE(values[3] - values[2], 1);
+
+    // generators follow their settings
+    constant.setOffset(-1.0);
+    QCOMPARE(probe.read<float>(ram), 2.0f);
+
+    probe.removeGenerator(&constant);
+    QVERIFY(probe.write(ram, std::as_bytes(std::span{std::array{42.0f}})));
+    QCOMPARE(probe.read<float>(ram), 42.0f);
+  }
+
+  void test_generator_range()
+  {
+    SimulatedProbe probe;
+
+    SignalGenerator generator;
+    generator.setAddress(ram);
+    generator.setFormat(SignalGenerator::Format::UInt8);
+    generator.setWaveform(SignalGenerator::Waveform::Constant);
+    generator.setAmplitude(1000.0);
+    probe.addGenerator(&generator);
+
+    // integer formats saturate, and round
+    QCOMPARE(probe.read<uint8_t>(ram), uint8_t(255));
+    generator.setAmplitude(-1000.0);
+    QCOMPARE(probe.read<uint8_t>(ram), uint8_t(0));
+    generator.setAmplitude(41.6);
+    QCOMPARE(probe.read<uint8_t>(ram), uint8_t(42));
+
+    generator.setFormat(SignalGenerator::Format::Int64);
+    generator.setAmplitude(1e30);
+    QCOMPARE(probe.read<int64_t>(ram), std::numeric_limits<int64_t>::max());
+  }
+
+  void test_batch_stats()
+  {
+    SimulatedProbe probe;
+
+    ReadPlan plan;
+    plan.add({ram, 4});
+    plan.add({ram + 1024, 4});
+    plan.add({ram + 4096, 64});
+    plan.compile(16);
+    QCOMPARE(plan.spans().size(), qsizetype(3));
+
+    QVERIFY(plan.execute(probe));
+
+    const auto stats = probe.stats();
+    QCOMPARE(stats.transfers, quint64(1));
+    QCOMPARE(stats.bytesRead, quint64(72));
+    QCOMPARE(stats.errors, quint64(0));
+
+    probe.resetStats();
+    QCOMPARE(probe.stats().transfers, quint64(0));
+  }
+
+  void bench_batch_data()
+  {
+    QTest::addColumn<bool>("batch");
+    QTest::newRow("spans") << false;
+    QTest::newRow("batch") << true;
+  }
+
+  // 16 scattered variables over a 125us link
+  void bench_batch()
+  {
+    QFETCH(bool, batch);
+
+    SimulatedProbe probe;
+    probe.setLatency(125.0);
+
+    ReadPlan plan;
+    for(uint64_t ii = 0; ii < 16; ++ii)
+    {
+      plan.add({ram + ii * 1024, 4});
+    }
+    plan.compile(0);
+
+    QBENCHMARK
+    {
+      if(batch)
+      {
+        plan.execute(probe);
+      }
+      else
+      {
+        plan.execute([&probe](uint64_t address, std::span<std::byte> data)
+                     { return probe.read(address, data); });
+      }
+    }
+  }
+};
+
+QTEST_GUILESS_MAIN(SimulatedProbeTests)
+#include "test-simulated-probe.moc"
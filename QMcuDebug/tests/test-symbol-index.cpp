@@ -0,0 +1,107 @@
+#include <SymbolIndex.hpp>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+class SymbolIndexTests : public QObject
+{
+  Q_OBJECT
+
+  QTemporaryDir dir_;
+
+  QString path() const
+  {
+    return dir_.filePath("index.idx");
+  }
+
+  static std::vector<SymbolIndex::Symbol> symbols()
+  {
+    return {
+        {.name = "state", .typeName = "State", .address = 0x20000100, .size = 12},
+        {.name     = "state.gain",
+         .typeName = "float",
+         .address  = 0x20000100,
+         .size     = 4,
+         .type     = QMetaType::Float,
+         .depth    = 1},
+        {.name     = "state.samples",
+         .typeName = "int16_t[2][2]",
+         .address  = 0x20000104,
+         .size     = 8,
+         .type     = QMetaType::Short,
+         .extents  = {2, 2},
+         .depth    = 1},
+        {.name = "counter", .typeName = "uint32_t", .address = 0x20000000, .size = 4},
+        {.name = "counter", .typeName = "uint32_t", .address = 0x20000200, .size = 4},
+        {.name = "stateCount", .typeName = "int", .address = 0x20000010, .size = 4},
+    };
+  }
+
+private slots:
+  void test_round_trip()
+  {
+    QVERIFY(SymbolIndex::save(path(), "build-id", symbols()));
+
+    SymbolIndex index;
+    QVERIFY(index.load(path(), "build-id"));
+    QCOMPARE(index.size(), size_t(5)); // duplicates dropped
+
+    const auto counter = index.find("counter");
+    QVERIFY(counter.has_value());
+    QCOMPARE(counter->address, uint64_t(0x20000000));
+    QVERIFY(counter->isGlobal());
+
+    const auto samples = index.find("state.samples");
+    QVERIFY(samples.has_value());
+    QVERIFY(samples->typeName == "int16_t[2][2]");
+    QCOMPARE(samples->type, int(QMetaType::Short));
+    QCOMPARE(samples->extents.size(), size_t(2));
+    QCOMPARE(samples->extents[0], uint32_t(2));
+
+    QVERIFY(not index.find("state.").has_value());
+    QVERIFY(not index.find("missing").has_value());
+  }
+
+  void test_members()
+  {
+    QVERIFY(SymbolIndex::save(path(), "build-id", symbols()));
+    SymbolIndex index;
+    QVERIFY(index.load(path(), "build-id"));
+
+    // "stateCount" shares the prefix without being a member
+    const auto [first, last] = index.members("state");
+    QCOMPARE(last - first, size_t(2));
+    QVERIFY(index.at(first).name == "state.gain");
+    QVERIFY(index.at(first + 1).name == "state.samples");
+
+    size_t globals = 0;
+    index.forEachGlobal([&globals](SymbolIndex::Entry const&) { ++globals; });
+    QCOMPARE(globals, size_t(3));
+  }
+
+  void test_stale()
+  {
+    QVERIFY(SymbolIndex::save(path(), "build-id", symbols()));
+
+    SymbolIndex index;
+    QVERIFY(not index.load(path(), "other-build-id"));
+    QVERIFY(not index.isLoaded());
+    QVERIFY(not index.load(dir_.filePath("missing.idx"), "build-id"));
+  }
+
+  void test_corrupted()
+  {
+    QVERIFY(SymbolIndex::save(path(), "build-id", symbols()));
+    {
+      QFile file{path()};
+      QVERIFY(file.open(QIODevice::ReadWrite));
+      QVERIFY(file.resize(file.size() - 1));
+    }
+    SymbolIndex index;
+    QVERIFY(not index.load(path(), "build-id"));
+  }
+};
+
+QTEST_GUILESS_MAIN(SymbolIndexTests)
+#include "test-symbol-index.moc"
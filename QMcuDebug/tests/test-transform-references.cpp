@@ -0,0 +1,94 @@
+#include <QMcu/Debug/Debugger.hpp>
+#include <QMcu/Debug/SimulatedProbe.hpp>
+#include <QMcu/Debug/Variable.hpp>
+#include <QMcu/Plot/Expression.hpp>
+
+#include <TransformReferences.hpp>
+
+#include <QTest>
+
+class TransformReferencesTests : public QObject
+{
+  Q_OBJECT
+
+  static constexpr uint64_t ram = 0x20000000;
+
+  static Type::Layout basic(QMetaType::Type type, size_t size)
+  {
+    Type::Layout layout;
+    layout.name          = QMetaType(type).name();
+    layout.kind          = Type::KindBits::Builtin;
+    layout.sizeBytes     = size;
+    layout.align         = size;
+    layout.elementTypeId = type;
+    layout.elementSize   = size;
+    return layout;
+  }
+
+private slots:
+
+  void test_references_are_loaded()
+  {
+    SimulatedProbe probe;
+    Debugger       dbg;
+    QVERIFY(probe.write(ram, std::as_bytes(std::span{std::array{3.3f}})));
+
+    Expression expression;
+    QVERIFY(expression.compile("(x & 0xfff) * vref / 4096"));
+    QCOMPARE(expression.references(), QStringList{"vref"});
+
+    TransformReferences references;
+    references.reset({new Variable("vref", ram, basic(QMetaType::Float, 4), &dbg)});
+    QCOMPARE(references.size(), qsizetype(1));
+
+    std::vector<double> inputs(expression.inputCount());
+    inputs[0] = 0x1800;
+    QVERIFY(references.load(std::span{inputs}.subspan(1)));
+    QCOMPARE(inputs[1], double(3.3f));
+    QCOMPARE(expression.evaluate(inputs), 0x800 * double(3.3f) / 4096);
+
+    // loaded again with every evaluation, once the tick is over
+    QVERIFY(probe.write(ram, std::as_bytes(std::span{std::array{1.25f}})));
+    dbg.invalidateShadowMemory();
+    QVERIFY(references.load(std::span{inputs}.subspan(1)));
+    QCOMPARE(expression.evaluate(inputs), 0x800 * 1.25 / 4096);
+  }
+
+  void test_unknown_references()
+  {
+    TransformReferences references;
+    references.reset({nullptr});
+
+    std::vector<double> inputs{5.0};
+    QVERIFY(not references.load(inputs));
+    QCOMPARE(inputs[0], 0.0);
+  }
+
+  void test_references_are_owned()
+  {
+    SimulatedProbe probe;
+    Debugger       dbg;
+
+    QPointer<Variable> first = new Variable("a", ram, basic(QMetaType::Int, 4), &dbg);
+    QPointer<Variable> other = new Variable("b", ram + 4, basic(QMetaType::Int, 4), &dbg);
+    {
+      TransformReferences references;
+      references.reset({first});
+      references.reset({other});
+      QVERIFY(first.isNull());
+      QVERIFY(not other.isNull());
+    }
+    QVERIFY(other.isNull());
+
+    // the debugger may delete them first
+    TransformReferences references;
+    references.reset({new Variable("c", ram, basic(QMetaType::Int, 4), &dbg)});
+    qDeleteAll(dbg.findChildren<Variable*>());
+
+    std::vector<double> inputs{5.0};
+    QVERIFY(not references.load(inputs));
+  }
+};
+
+QTEST_GUILESS_MAIN(TransformReferencesTests)
+#include "test-transform-references.moc"
@@ -0,0 +1,140 @@
+#include <QMcu/Debug/Trigger.hpp>
+
+#include <QTest>
+
+#include <cstring>
+
+class TriggerTests : public QObject
+{
+  Q_OBJECT
+
+  // pushes value v at time t (in ns), captured as an int32_t
+  static bool push(Trigger& trigger, int64_t t, int32_t v)
+  {
+    return trigger.push(t, double(v), std::as_bytes(std::span{&v, 1}));
+  }
+
+  static std::vector<int32_t> values(Trigger::Capture const& capture)
+  {
+    std::vector<int32_t> out(capture.size());
+    std::memcpy(out.data(), capture.values.data(), capture.values.size());
+    return out;
+  }
+
+private slots:
+  void test_rising()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.edge = Trigger::Edge::Rising, .level = 5, .pre = 3, .post = 4}};
+
+    // 0 1 2 ... 9: crosses 5 upwards at 5
+    bool completed = false;
+    for(int32_t v = 0; v < 10; ++v)
+    {
+      if(push(trigger, v, v))
+      {
+        QCOMPARE(v, 8);
+        completed = true;
+      }
+    }
+    QVERIFY(completed);
+
+    const auto capture = trigger.capture();
+    QVERIFY(capture != nullptr);
+    QCOMPARE(capture->triggerIndex, size_t(3));
+    QCOMPARE(values(*capture), (std::vector<int32_t>{2, 3, 4, 5, 6, 7, 8}));
+    QCOMPARE(capture->times.front(), int64_t(2));
+    QCOMPARE(capture->sequence, uint64_t(1));
+    QVERIFY(not capture->forced);
+  }
+
+  void test_falling()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.edge = Trigger::Edge::Falling, .level = 0, .pre = 2, .post = 1}};
+
+    // no edge on the first sample, whatever it is
+    QVERIFY(not push(trigger, 0, -1));
+    QVERIFY(not push(trigger, 1, 3));
+    QVERIFY(push(trigger, 2, 0));
+    QCOMPARE(values(*trigger.capture()), (std::vector<int32_t>{-1, 3, 0}));
+  }
+
+  void test_level_holdoff()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.edge      = Trigger::Edge::Level,
+                     .level     = 1,
+                     .pre       = 0,
+                     .post      = 1,
+                     .holdoffNs = 10}};
+
+    int captures = 0;
+    for(int64_t t = 0; t < 35; ++t)
+    {
+      captures += push(trigger, t, 1);
+    }
+    QCOMPARE(captures, 4); // at 0, 10, 20, 30
+    QCOMPARE(trigger.capture()->times.front(), int64_t(30));
+  }
+
+  void test_short_pre()
+  {
+    // triggers before the pre-trigger samples were all seen
+    Trigger trigger{sizeof(int32_t),
+                    {.edge = Trigger::Edge::Level, .level = 1, .pre = 10, .post = 2}};
+    QVERIFY(not push(trigger, 0, 0));
+    QVERIFY(not push(trigger, 1, 1));
+    QVERIFY(push(trigger, 2, 2));
+    QCOMPARE(trigger.capture()->triggerIndex, size_t(1));
+    QCOMPARE(values(*trigger.capture()), (std::vector<int32_t>{0, 1, 2}));
+  }
+
+  void test_single()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.edge = Trigger::Edge::Level,
+                     .mode = Trigger::Mode::Single,
+                     .pre  = 0,
+                     .post = 1}};
+    QVERIFY(trigger.armed());
+    QVERIFY(push(trigger, 0, 1));
+    QVERIFY(not trigger.armed());
+    QVERIFY(not push(trigger, 1, 1));
+    QCOMPARE(trigger.capture()->sequence, uint64_t(1));
+
+    trigger.rearm();
+    QVERIFY(push(trigger, 2, 1));
+    QCOMPARE(trigger.capture()->sequence, uint64_t(2));
+  }
+
+  void test_auto()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.mode = Trigger::Mode::Auto, .level = 100, .pre = 1, .post = 2, .autoNs = 5}};
+
+    // never crosses the level: forced after 5 ns of waiting
+    int64_t t = 0;
+    while(not push(trigger, t, 0))
+    {
+      ++t;
+    }
+    QCOMPARE(t, int64_t(6));
+    QVERIFY(trigger.capture()->forced);
+    QCOMPARE(trigger.capture()->times[trigger.capture()->triggerIndex], int64_t(5));
+  }
+
+  void test_captures_are_frozen()
+  {
+    Trigger trigger{sizeof(int32_t),
+                    {.edge = Trigger::Edge::Level, .level = 0, .pre = 1, .post = 1}};
+    QVERIFY(push(trigger, 0, 1));
+    const auto first = trigger.capture();
+    QVERIFY(push(trigger, 1, 2));
+    QCOMPARE(values(*first), std::vector<int32_t>{1});
+    QCOMPARE(values(*trigger.capture()), (std::vector<int32_t>{1, 2}));
+  }
+};
+
+QTEST_GUILESS_MAIN(TriggerTests)
+#include "test-trigger.moc"
@@ -0,0 +1,104 @@
+#include <QMcu/Debug/Type.hpp>
+
+#include <QTest>
+
+class TypeLayoutTests : public QObject
+{
+  Q_OBJECT
+
+  // struct Axis { float gain; int16_t history[2]; };  (8 bytes)
+  static Type::Member axis(QString name, size_t offset, int count = 0)
+  {
+    Type::Member member;
+    member.name      = std::move(name);
+    member.offset    = offset;
+    member.sizeBytes = 8 * std::max(count, 1);
+    if(count != 0)
+    {
+      member.extents = {count};
+    }
+    member.members = {
+        {.name = "gain", .offset = 0, .sizeBytes = 4, .elementTypeId = QMetaType::Float},
+        {.name          = "history",
+         .offset        = 4,
+         .sizeBytes     = 4,
+         .elementTypeId = QMetaType::Short,
+         .extents       = {2}},
+    };
+    return member;
+  }
+
+private slots:
+  void test_nested_struct()
+  {
+    // struct Controller { uint32_t mode; Axis pitch; }
+    Type::Layout layout;
+    layout.name      = "Controller";
+    layout.sizeBytes = 12;
+    layout.members   = {
+        {.name = "mode", .offset = 0, .sizeBytes = 4, .elementTypeId = QMetaType::UInt},
+        axis("pitch", 4),
+    };
+
+    const auto fields = Type::compile(layout);
+    QCOMPARE(fields.size(), qsizetype(4));
+    QCOMPARE(fields[0].name, QString("mode"));
+    QCOMPARE(fields[1].name, QString("pitch.gain"));
+    QCOMPARE(fields[1].offset, size_t(4));
+    QCOMPARE(fields[1].typeId, QMetaType::Float);
+    QCOMPARE(fields[3].name, QString("pitch.history[1]"));
+    QCOMPARE(fields[3].offset, size_t(10));
+    QCOMPARE(fields[3].size, size_t(2));
+  }
+
+  void test_array_of_structs()
+  {
+    // Axis axes[3]
+    Type::Layout layout;
+    layout.name      = "Axis[3]";
+    layout.kind      = Type::KindBits::Array;
+    layout.sizeBytes = 24;
+    layout.extents   = {3};
+    layout.members   = axis({}, 0).members;
+
+    const auto fields = Type::compile(layout);
+    QCOMPARE(fields.size(), qsizetype(9));
+    QCOMPARE(fields[3].name, QString("[1].gain"));
+    QCOMPARE(fields[3].offset, size_t(8));
+    QCOMPARE(fields[8].name, QString("[2].history[1]"));
+    QCOMPARE(fields[8].offset, size_t(22));
+  }
+
+  void test_member_array_of_structs()
+  {
+    Type::Layout layout;
+    layout.sizeBytes = 16;
+    layout.members   = {axis("axes", 0, 2)};
+
+    const auto fields = Type::compile(layout);
+    QCOMPARE(fields.size(), qsizetype(6));
+    QCOMPARE(fields[3].name, QString("axes[1].gain"));
+    QCOMPARE(fields[3].offset, size_t(8));
+  }
+
+  void test_truncated()
+  {
+    Type::Layout layout;
+    layout.sizeBytes = 8000;
+    layout.members   = {axis("axes", 0, 1000)};
+
+    QCOMPARE(Type::compile(layout, 100).size(), qsizetype(100));
+  }
+
+  void test_basic_has_no_fields()
+  {
+    Type::Layout layout;
+    layout.sizeBytes     = 4;
+    layout.elementTypeId = QMetaType::Float;
+
+    QVERIFY(Type::compile(layout).isEmpty());
+  }
+};
+
+QTEST_GUILESS_MAIN(TypeLayoutTests)
+#include "test-type-layout.moc"
@@ -47,6 +47,16 @@ shaders_config = {
             "use_integral_converters": True,
             "decode_expression": "decodeU32(byteIndex)",
         },
+        "line-plot-series-i64.vert": {
+            "ssbo_buffer_type": "uint",
+            "use_integral_converters": True,
+            "decode_expression": "decodeI64(byteIndex)",
+        },
+        "line-plot-series-u64.vert": {
+            "ssbo_buffer_type": "uint",
+            "use_integral_converters": True,
+            "decode_expression": "decodeU64(byteIndex)",
+        },
     }
 }
 
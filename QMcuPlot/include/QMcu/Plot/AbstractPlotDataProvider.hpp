@@ -56,6 +56,9 @@ protected:
   // Called on render thread before draw; implement to update mapped VBO range.
   virtual UpdateRange update(PlotContext& ctx) = 0;
 
+  // Has initializePlotContext() called again before the next frame, ie. when the size changes
+  void reinitialize();
+
   template <typename T> std::span<T> createMappedArrayBuffer(size_t count, uint32_t binding = 0)
   {
     return std::span(
@@ -10,6 +10,7 @@
 #include <QAbstractAxis>
 
 class Plot;
+class PlotMathSeries;
 class PlotScene;
 class PlotContext;
 class AbstractPlotDataProvider;
@@ -36,6 +37,7 @@ static inline QMatrix4x4 rectTransform(const QRectF& src, const QRectF& dst)
 class AbstractPlotSeries : public PlotSceneItem
 {
   friend Plot;
+  friend PlotMathSeries;
   friend PlotScene;
   friend PlotContext;
   friend AbstractPlotDataProvider;
@@ -127,6 +129,7 @@ protected:
 
   auto initializeDataProvider()
   {
+    ctx_.frame.inFlight = vkContext().framesInFlight;
     return provider_->initializePlotContext(ctx_);
   }
 
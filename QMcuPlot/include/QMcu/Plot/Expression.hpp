@@ -0,0 +1,129 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Arithmetic expression compiled to a small stack bytecode, evaluated over doubles.
+//
+// `x` (or `value`) is the sample being transformed; other identifiers name other channels
+// (variables, series), read as inputs 1..N in order of appearance. Operators follow C
+// precedence: ?: || && | ^ & == != < <= > >= << >> + - * / % and unary - ! ~; bit operators and
+// % work on 64 bits integers. Functions: abs min max clamp lerp sqrt pow exp log floor ceil
+// round sin cos, and the constant pi.
+//
+// Constant sub-expressions are folded. evaluate() runs the whole program one sample at a time;
+// the batch overload runs each instruction over blocks of samples, in loops compilers vectorize.
+class Expression
+{
+public:
+  // Replaces the program; on failure, error() tells why and the expression is invalid
+  bool compile(QString const& source);
+
+  bool isValid() const noexcept
+  {
+    return not code_.empty();
+  }
+  QString const& source() const noexcept
+  {
+    return source_;
+  }
+  QString const& error() const noexcept
+  {
+    return error_;
+  }
+  // Variables read by the expression, inputs 1..N
+  QStringList const& references() const noexcept
+  {
+    return references_;
+  }
+  size_t inputCount() const noexcept
+  {
+    return size_t(references_.size()) + 1;
+  }
+  // Instructions, once folded
+  size_t size() const noexcept
+  {
+    return code_.size();
+  }
+  // Stack registers the program needs
+  size_t depth() const noexcept
+  {
+    return depth_;
+  }
+
+  // inputs[0] is x, then the references
+  double evaluate(std::span<double const> inputs) const noexcept;
+
+  // inputs[i] holds input i for every sample, out the result of each of them
+  void evaluate(std::span<std::span<double const> const> inputs, std::span<double> out) const;
+
+  // Values are shared with shaders/line-plot-math.vert
+  enum class Op : uint8_t
+  {
+    Constant,
+    Input,
+    Negate,
+    Not,
+    BitNot,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    BitAnd,
+    BitOr,
+    BitXor,
+    ShiftLeft,
+    ShiftRight,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    And,
+    Or,
+    Select,
+    Abs,
+    Min,
+    Max,
+    Clamp,
+    Lerp,
+    Sqrt,
+    Pow,
+    Exp,
+    Log,
+    Floor,
+    Ceil,
+    Round,
+    Sin,
+    Cos,
+  };
+
+  struct Instruction
+  {
+    Op       op       = Op::Constant;
+    uint32_t input    = 0;
+    double   constant = 0.0;
+  };
+
+  // The program, for other interpreters (see PlotMathSeries)
+  std::span<Instruction const> code() const noexcept
+  {
+    return code_;
+  }
+
+private:
+  class Parser;
+
+  QString                  source_;
+  QString                  error_;
+  QStringList              references_;
+  std::vector<Instruction> code_;
+  size_t                   depth_ = 0;
+};
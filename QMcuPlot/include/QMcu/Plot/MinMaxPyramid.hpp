@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QMcu/Plot/VK/Types.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Multi-resolution min/max envelope of a series of samples, to draw any number of them with about
+// two vertices per pixel column, without losing peaks.
+//
+// Level k > 0 holds a (min, max) pair per bucket of factor^k samples, in the sample type; level 0
+// stands for the samples themselves. append() updates the last, partial, bucket of each level,
+// so that pyramids are built while samples arrive. A pyramid can also be a read-only view of
+// levels stored elsewhere (ie. a mapped file).
+class MinMaxPyramid
+{
+public:
+  static constexpr size_t factor = 4;
+
+  MinMaxPyramid() = default;
+  // Empty pyramid of samples of a basic type; invalid for other types
+  explicit MinMaxPyramid(QMetaType::Type type);
+  // View of `levels`, from level 1, over `samples` samples
+  MinMaxPyramid(QMetaType::Type                         type,
+                size_t                                  samples,
+                std::vector<std::span<std::byte const>> levels);
+
+  MinMaxPyramid(MinMaxPyramid&&)            = default;
+  MinMaxPyramid& operator=(MinMaxPyramid&&) = default;
+
+  bool isValid() const noexcept
+  {
+    return elementSize_ != 0;
+  }
+  QMetaType::Type type() const noexcept
+  {
+    return type_;
+  }
+  size_t elementSize() const noexcept
+  {
+    return elementSize_;
+  }
+  size_t samples() const noexcept
+  {
+    return samples_;
+  }
+
+  // Appends the first element of `count` samples, `stride` bytes apart
+  void append(std::byte const* data, size_t count, size_t stride);
+
+  // Levels, the samples included
+  size_t levelCount() const noexcept
+  {
+    return levels_.size() + 1;
+  }
+  static constexpr size_t bucketSize(size_t level) noexcept
+  {
+    size_t size = 1;
+    while(level-- > 0)
+    {
+      size *= factor;
+    }
+    return size;
+  }
+  size_t buckets(size_t level) const noexcept
+  {
+    return (samples_ + bucketSize(level) - 1) / bucketSize(level);
+  }
+  // (min, max) pairs of a level > 0, the last bucket possibly partial
+  std::span<std::byte const> level(size_t level) const noexcept
+  {
+    return level > 0 and level <= levels_.size() ? levels_[level - 1]
+                                                 : std::span<std::byte const>{};
+  }
+
+  // Coarsest level whose buckets hold at most `samplesPerBucket` samples
+  size_t levelFor(double samplesPerBucket) const noexcept;
+
+private:
+  template <typename T> void appendAs(std::byte const* data, size_t count, size_t stride);
+
+  QMetaType::Type                         type_        = QMetaType::UnknownType;
+  size_t                                  elementSize_ = 0;
+  size_t                                  samples_     = 0;
+  bool                                    view_        = false;
+  std::vector<std::vector<std::byte>>     owned_;
+  std::vector<std::span<std::byte const>> levels_; // of owned_, or of the viewed storage
+};
@@ -60,6 +60,19 @@ struct PlotContext
 
   } view;
 
+  // Where the vertices of the current range are: vertex i at x = origin + i * step, in samples.
+  // Set by providers drawing a part of their samples, or a summary of them (see MinMaxPyramid)
+  struct LodInfo
+  {
+    real_t origin = 0.0;
+    real_t step   = 1.0;
+  } lod;
+
+  struct FrameInfo
+  {
+    size_t inFlight = 1; /// Frames the GPU may be rendering at once
+  } frame;
+
   struct GLInfo
   {
     size_t stride    = 0; /// Stride between elements
@@ -127,6 +140,13 @@ struct PlotContext
 
   } vbo;
 
+  // Range of x (samples) visible through the axes and the view transform
+  std::pair<real_t, real_t> visibleX() const
+  {
+    const auto ndcToX = unit.ndcToData * view.transform.inverted();
+    return {ndcToX.map(QPointF{-1.0, 0.0}).x(), ndcToX.map(QPointF{1.0, 0.0}).x()};
+  }
+
   template <bool fatal, typename Fn> void visitType(Fn&& fn)
   {
     if(false)
@@ -110,6 +110,11 @@ private:
     glm::uint sampleStride; // sample stride
 
     glm::uint tid;
+
+    float     xOrigin; // x of the first vertex, in samples
+    float     xStep;   // samples between two vertices
+    glm::uint bucket;  // samples per (min, max) pair of vertices, 0 to draw every sample
+    float     padding; // std140 blocks are a multiple of 16 bytes
   } ubo;
 
   QColor lineColor_ = Qt::red;
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <QtQmlIntegration>
+
+#include <QMcu/Plot/AbstractPlotSeries.hpp>
+#include <QMcu/Plot/Expression.hpp>
+
+#include <QColor>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+// A series derived from other series of the same plot, computed on the GPU.
+//
+// The expression (see Expression) is compiled once, then interpreted by the vertex shader
+// straight from the storage buffers of its sources: `x` is the first source, other identifiers
+// are the names of the others. Sources are aligned on their latest samples, and the derived
+// series is as long as the shortest of them; they must be drawn by the same plot.
+//
+//   PlotMathSeries {
+//     sources: [current, voltage]
+//     expression: "x * voltage"
+//     average: 16
+//   }
+class PlotMathSeries : public AbstractPlotSeries
+{
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QList<AbstractPlotSeries*> sources READ sources WRITE setSources NOTIFY
+                 sourcesChanged)
+  Q_PROPERTY(QString expression READ expression WRITE setExpression NOTIFY expressionChanged)
+  Q_PROPERTY(int average READ average WRITE setAverage NOTIFY averageChanged)
+  Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+  Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth FINAL)
+
+public:
+  // What the shader has room for
+  static constexpr int maxSources      = 4;
+  static constexpr int maxInstructions = 64;
+  static constexpr int maxDepth        = 16;
+  static constexpr int maxAverage      = 256;
+
+  explicit PlotMathSeries(QObject* parent = nullptr);
+  virtual ~PlotMathSeries();
+
+  QList<AbstractPlotSeries*> const& sources() const noexcept
+  {
+    return sources_;
+  }
+  QString const& expression() const noexcept
+  {
+    return expression_;
+  }
+  // Moving average window, in samples: 1 plots the expression as is
+  int average() const noexcept
+  {
+    return average_;
+  }
+  QColor const& lineColor() const noexcept
+  {
+    return lineColor_;
+  }
+  float lineWidth() const noexcept
+  {
+    return lineWidth_;
+  }
+
+public slots:
+  void setSources(QList<AbstractPlotSeries*> const& sources);
+  void setExpression(QString const& expression);
+  void setAverage(int average);
+
+  void setLineColor(QColor const& color)
+  {
+    if(color != lineColor_)
+    {
+      lineColor_ = color;
+      emit lineColorChanged();
+    }
+  }
+
+  void setLineWidth(float width)
+  {
+    lineWidth_ = width;
+  }
+
+signals:
+  void sourcesChanged();
+  void expressionChanged();
+  void averageChanged();
+  void lineColorChanged();
+
+protected:
+  bool doInitialize() final;
+  void doDraw() final;
+  void doReleaseResources() final;
+
+private:
+  // What the shader runs: built by compile() on the GUI thread, drawn from the render thread
+  struct Program
+  {
+    QList<AbstractPlotSeries*> sources;
+    std::vector<glm::uint>     code;
+    std::vector<float>         constants;
+  };
+
+  // Translates the expression for the shader
+  void compile();
+
+  struct UBO
+  {
+    glm::mat4 mvp;
+
+    glm::mat4 dataToNdc;     // data -> NDC
+    glm::mat4 viewTransform; // zoom & pan in NDC space
+
+    glm::vec4 color; // base color
+
+    glm::vec2 boundingSize;
+
+    glm::uint count;   // samples drawn
+    glm::uint average; // moving average window
+
+    glm::uvec4 sourceOffset; // byte offset of the first sample drawn
+    glm::uvec4 sourceStride; // sample stride
+    glm::uvec4 sourceType;   // QMetaType::Type
+
+    glm::uint codeSize;
+    glm::uint padding[3];
+
+    glm::uvec4 code[maxInstructions / 4];      // op | input << 8
+    glm::vec4  constants[maxInstructions / 4]; // operand of Op::Constant, per instruction
+  } ubo;
+
+  static_assert(sizeof(UBO) == 800, "must match the std140 layout of line-plot-math.vert");
+
+  QList<AbstractPlotSeries*> sources_;
+  QString                    expression_;
+  int                        average_   = 1;
+  QColor                     lineColor_ = Qt::white;
+  float                      lineWidth_ = 2.0f;
+
+  // Swapped by compile(), null when the expression or its sources are invalid
+  std::atomic<std::shared_ptr<Program const>> program_;
+
+  vk::Buffer       ubuf_    = nullptr;
+  vk::DeviceMemory ubufMem_ = nullptr;
+
+  vk::DescriptorSetLayout uniformsSetLayout_;
+  vk::DescriptorSetLayout dataSetLayout_;
+
+  using Sources = std::array<vk::Buffer, maxSources>;
+
+  vk::DescriptorPool               descriptorPool_{};
+  vk::DescriptorSet                ubufDescriptor_{};
+  std::array<vk::DescriptorSet, 3> sbufDescriptors_{}; // per frame slot
+  std::array<Sources, 3>           bound_{};           // buffers of each of them
+
+  size_t allocPerUbuf_ = 0;
+};
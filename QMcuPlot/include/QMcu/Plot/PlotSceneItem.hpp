@@ -5,6 +5,8 @@
 #include <QMcu/Plot/PlotContext.hpp>
 #include <QMcu/Plot/VK/VulkanContext.hpp>
 
+#include <atomic>
+
 class PlotScene;
 
 class PlotSceneItem : public QObject
@@ -30,6 +32,12 @@ public:
   bool initialize(VulkanContext& ctx);
   void release();
 
+  // Releases the item before its next frame, to initialize it again, from any thread
+  void requestReinitialize() noexcept
+  {
+    reinitialize_.store(true, std::memory_order_relaxed);
+  }
+
   inline void draw()
   {
     doDraw();
@@ -56,6 +64,7 @@ protected:
 private:
   VulkanContext* vk_ = nullptr;
 
-  bool dirty_       = true;
-  bool initialized_ = false;
+  bool              dirty_        = true;
+  bool              initialized_  = false;
+  std::atomic<bool> reinitialize_ = false;
 };
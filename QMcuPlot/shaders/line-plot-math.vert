@@ -0,0 +1,265 @@
+#version 450
+
+// Plots an Expression (see Expression.hpp) of up to 4 series: its bytecode is interpreted per
+// vertex, straight from the storage buffers of the series. Integer operators work on 32 bits.
+
+layout(set = 1, binding = 0) buffer InputData {
+    uint data[];
+} sources[4];
+
+layout(binding = 0) uniform UBO {
+    mat4 mvp;
+
+    mat4 dataToNdc;       // data -> NDC
+    mat4 viewTransform;   // zoom & pan in NDC space
+
+    vec4  color;    // base color
+
+    vec2 boundingSize;
+
+    uint count;     // samples drawn
+    uint average;   // moving average window
+
+    uvec4 sourceOffset; // byte offset of the first sample drawn
+    uvec4 sourceStride; // sample stride
+    uvec4 sourceType;   // QMetaType::Type
+
+    uint codeSize;
+
+    uvec4 code[16];      // op | input << 8
+    vec4  constants[16]; // operand of OP_CONSTANT, per instruction
+} ubo;
+
+layout(location = 0) out vec4 vPosNdc;
+
+// QMetaType::Type
+const uint TYPE_INT       = 2u;
+const uint TYPE_UINT      = 3u;
+const uint TYPE_LONGLONG  = 4u;
+const uint TYPE_ULONGLONG = 5u;
+const uint TYPE_DOUBLE    = 6u;
+const uint TYPE_SHORT     = 33u;
+const uint TYPE_CHAR      = 34u;
+const uint TYPE_USHORT    = 36u;
+const uint TYPE_UCHAR     = 37u;
+const uint TYPE_FLOAT     = 38u;
+
+// Expression::Op
+const uint OP_CONSTANT      = 0u;
+const uint OP_INPUT         = 1u;
+const uint OP_NEGATE        = 2u;
+const uint OP_NOT           = 3u;
+const uint OP_BITNOT        = 4u;
+const uint OP_ADD           = 5u;
+const uint OP_SUBTRACT      = 6u;
+const uint OP_MULTIPLY      = 7u;
+const uint OP_DIVIDE        = 8u;
+const uint OP_MODULO        = 9u;
+const uint OP_BITAND        = 10u;
+const uint OP_BITOR         = 11u;
+const uint OP_BITXOR        = 12u;
+const uint OP_SHIFTLEFT     = 13u;
+const uint OP_SHIFTRIGHT    = 14u;
+const uint OP_LESS          = 15u;
+const uint OP_LESSEQUAL     = 16u;
+const uint OP_GREATER       = 17u;
+const uint OP_GREATEREQUAL  = 18u;
+const uint OP_EQUAL         = 19u;
+const uint OP_NOTEQUAL      = 20u;
+const uint OP_AND           = 21u;
+const uint OP_OR            = 22u;
+const uint OP_SELECT        = 23u;
+const uint OP_ABS           = 24u;
+const uint OP_MIN           = 25u;
+const uint OP_MAX           = 26u;
+const uint OP_CLAMP         = 27u;
+const uint OP_LERP          = 28u;
+const uint OP_SQRT          = 29u;
+const uint OP_POW           = 30u;
+const uint OP_EXP           = 31u;
+const uint OP_LOG           = 32u;
+const uint OP_FLOOR         = 33u;
+const uint OP_CEIL          = 34u;
+const uint OP_ROUND         = 35u;
+const uint OP_SIN           = 36u;
+const uint OP_COS           = 37u;
+
+const int MAX_DEPTH = 16;
+
+uint word(uint source, uint index) {
+    // constant indices: indexing buffer arrays dynamically is an optional feature
+    switch(source) {
+        case 0u: return sources[0].data[index];
+        case 1u: return sources[1].data[index];
+        case 2u: return sources[2].data[index];
+        default: return sources[3].data[index];
+    }
+}
+
+uint decodeU8(uint source, uint byteIndex) {
+    return (word(source, byteIndex / 4u) >> ((byteIndex % 4u) * 8u)) & 0xFFu;
+}
+
+uint decodeU16(uint source, uint byteIndex) {
+    return decodeU8(source, byteIndex) | (decodeU8(source, byteIndex + 1u) << 8u);
+}
+
+uint decodeU32(uint source, uint byteIndex) {
+    const uint shift = (byteIndex % 4u) * 8u;
+    const uint lo = word(source, byteIndex / 4u);
+    if(shift == 0u) {
+        return lo;
+    }
+    return (lo >> shift) | (word(source, byteIndex / 4u + 1u) << (32u - shift));
+}
+
+// Nearest float of a double, without the 64-bit type (an optional device feature); what falls
+// below the normal floats is flushed to zero
+float decodeDouble(uint source, uint byteIndex) {
+    const uint lo = decodeU32(source, byteIndex);
+    const uint hi = decodeU32(source, byteIndex + 4u);
+    const uint sign = hi & 0x80000000u;
+    const int exponent = int((hi >> 20u) & 0x7FFu);
+    if(exponent == 0x7FF) {
+        return uintBitsToFloat(((hi & 0xFFFFFu) | lo) != 0u ? 0x7FC00000u : sign | 0x7F800000u);
+    }
+    const int e = exponent - 1023 + 127;
+    if(e >= 255) {
+        return uintBitsToFloat(sign | 0x7F800000u);
+    }
+    if(e <= 0) {
+        return uintBitsToFloat(sign);
+    }
+    // rounded on the first dropped bit: a carry moves to the exponent, up to infinity
+    const uint bits = sign | (uint(e) << 23u) | ((hi & 0xFFFFFu) << 3u) | (lo >> 29u);
+    return uintBitsToFloat(bits + ((lo >> 28u) & 1u));
+}
+
+// Sample `index` of a source, counted from the first one drawn
+float sampleAt(uint source, uint index) {
+    const uint b = ubo.sourceOffset[source] + index * ubo.sourceStride[source];
+    switch(ubo.sourceType[source]) {
+        case TYPE_FLOAT:     return uintBitsToFloat(decodeU32(source, b));
+        case TYPE_DOUBLE:    return decodeDouble(source, b);
+        case TYPE_INT:       return float(int(decodeU32(source, b)));
+        case TYPE_UINT:      return float(decodeU32(source, b));
+        case TYPE_LONGLONG:  return float(int(decodeU32(source, b + 4u))) * 4294967296.0
+                                    + float(decodeU32(source, b));
+        case TYPE_ULONGLONG: return float(decodeU32(source, b + 4u)) * 4294967296.0
+                                    + float(decodeU32(source, b));
+        case TYPE_SHORT:     return float((int(decodeU16(source, b)) << 16) >> 16);
+        case TYPE_USHORT:    return float(decodeU16(source, b));
+        case TYPE_CHAR:      return float((int(decodeU8(source, b)) << 24) >> 24);
+        case TYPE_UCHAR:     return float(decodeU8(source, b));
+        default:             return 0.0;
+    }
+}
+
+uint arity(uint op) {
+    if(op == OP_SELECT || op == OP_CLAMP || op == OP_LERP) {
+        return 3u;
+    }
+    if(op <= OP_BITNOT || op == OP_ABS || op == OP_SQRT || op >= OP_EXP) {
+        return 1u;
+    }
+    return 2u;
+}
+
+float truth(bool b) {
+    return b ? 1.0 : 0.0;
+}
+
+float apply(uint op, float a, float b, float c) {
+    const int ia = int(a);
+    const int ib = int(b);
+    switch(op) {
+        case OP_NEGATE:       return -a;
+        case OP_NOT:          return truth(a == 0.0);
+        case OP_BITNOT:       return float(~ia);
+        case OP_ADD:          return a + b;
+        case OP_SUBTRACT:     return a - b;
+        case OP_MULTIPLY:     return a * b;
+        case OP_DIVIDE:       return a / b;
+        // C remainder, % of GLSL is undefined for negative operands
+        case OP_MODULO:       return ib == 0 ? uintBitsToFloat(0x7FC00000u)
+                                             : ib == -1 ? 0.0 : float(ia - ib * (ia / ib));
+        case OP_BITAND:       return float(ia & ib);
+        case OP_BITOR:        return float(ia | ib);
+        case OP_BITXOR:       return float(ia ^ ib);
+        case OP_SHIFTLEFT:    return float(ia << (ib & 31));
+        case OP_SHIFTRIGHT:   return float(ia >> (ib & 31));
+        case OP_LESS:         return truth(a < b);
+        case OP_LESSEQUAL:    return truth(a <= b);
+        case OP_GREATER:      return truth(a > b);
+        case OP_GREATEREQUAL: return truth(a >= b);
+        case OP_EQUAL:        return truth(a == b);
+        case OP_NOTEQUAL:     return truth(a != b);
+        case OP_AND:          return truth(a != 0.0 && b != 0.0);
+        case OP_OR:           return truth(a != 0.0 || b != 0.0);
+        case OP_SELECT:       return a != 0.0 ? b : c;
+        case OP_ABS:          return abs(a);
+        case OP_MIN:          return min(a, b);
+        case OP_MAX:          return max(a, b);
+        case OP_CLAMP:        return min(max(a, b), c);
+        case OP_LERP:         return mix(a, b, c);
+        case OP_SQRT:         return sqrt(a);
+        case OP_POW:          return pow(a, b);
+        case OP_EXP:          return exp(a);
+        case OP_LOG:          return log(a);
+        case OP_FLOOR:        return floor(a);
+        case OP_CEIL:         return ceil(a);
+        case OP_ROUND:        return sign(a) * floor(abs(a) + 0.5); // halves away from zero
+        case OP_SIN:          return sin(a);
+        case OP_COS:          return cos(a);
+        default:              return 0.0;
+    }
+}
+
+float evaluate(uint index) {
+    float stack[MAX_DEPTH];
+    int sp = 0;
+    for(uint pc = 0u; pc < ubo.codeSize; ++pc) {
+        const uint ins = ubo.code[pc / 4u][pc % 4u];
+        const uint op = ins & 0xFFu;
+        if(op == OP_CONSTANT) {
+            stack[sp++] = ubo.constants[pc / 4u][pc % 4u];
+        } else if(op == OP_INPUT) {
+            stack[sp++] = sampleAt(ins >> 8u, index);
+        } else {
+            const uint n = arity(op);
+            sp -= int(n);
+            const float a = stack[sp];
+            const float b = n > 1u ? stack[sp + 1] : 0.0;
+            const float c = n > 2u ? stack[sp + 2] : 0.0;
+            stack[sp++] = apply(op, a, b, c);
+        }
+    }
+    return stack[0];
+}
+
+void main() {
+    const uint index = uint(gl_VertexIndex);
+
+    // the first samples average what they have
+    const uint window = min(ubo.average, index + 1u);
+    float sum = 0.0;
+    for(uint k = 0u; k < window; ++k) {
+        sum += evaluate(index - k);
+    }
+    const float y = sum / float(window);
+
+    const vec4 raw = vec4(float(gl_VertexIndex), y, 0.0, 1.0);
+    const vec4 ndc = ubo.dataToNdc * raw;
+
+    // Apply zoom/pan
+    const vec4 view = ubo.viewTransform * ndc;
+
+    const vec4 pixel = vec4(
+        (((view.x + 1.0) * 0.5) * ubo.boundingSize.x),
+        ((1.0 - view.y) * 0.5) * ubo.boundingSize.y, // flip Y for top-left origin
+        0.0, 1.0);
+
+    gl_Position = ubo.mvp * pixel;
+
+    vPosNdc = vec4(view.xy, 0.0, 1.0);
+}
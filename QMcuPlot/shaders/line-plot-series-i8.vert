@@ -22,6 +22,10 @@ layout(binding = 0) uniform UBO {
     uint sampleStride;  // sample stride
 
     uint tid;
+
+    float xOrigin;      // x of the first vertex, in samples
+    float xStep;        // samples between two vertices
+    uint  bucket;       // samples per (min, max) pair of vertices, 0 to draw every sample
 } ubo;
 
 layout(location = 0) out vec4 vPosNdc;
@@ -37,7 +41,7 @@ uint decodeU8(uint byteIndex) {
 // 8-bit signed
 int decodeI8(uint byteIndex) {
     const uint uval = decodeU8(byteIndex);
-    return (int(uval) << 8) >> 8; // sign-extend
+    return (int(uval) << 24) >> 24; // sign-extend
 }
 
 // 16-bit unsigned (little-endian)
@@ -67,12 +71,38 @@ int decodeI32(uint byteIndex) {
     return int(decodeU32(byteIndex));
 }
 
+// 64-bit unsigned (little-endian), rounded
+float decodeU64(uint byteIndex) {
+    return float(decodeU32(byteIndex + 4u)) * 4294967296.0 + float(decodeU32(byteIndex));
+}
 
-void main() {
-    const uint byteIndex = ubo.byteOffset + uint(gl_VertexIndex) * ubo.sampleStride;
-    const float rawY = decodeI8(byteIndex);
+// 64-bit signed (little-endian), rounded
+float decodeI64(uint byteIndex) {
+    return float(decodeI32(byteIndex + 4u)) * 4294967296.0 + float(decodeU32(byteIndex));
+}
 
-    const vec4 raw = vec4(float(gl_VertexIndex), rawY, 0.0, 1.0);
+
+float decodeSample(uint byteIndex) {
+    return decodeI8(byteIndex);
+}
+
+void main() {
+    float rawY;
+    if(ubo.bucket == 0u) {
+        rawY = decodeSample(ubo.byteOffset + uint(gl_VertexIndex) * ubo.sampleStride);
+    } else {
+        // decimation: even vertices are the min of a bucket of samples, odd ones its max
+        const uint first = (uint(gl_VertexIndex) / 2u) * ubo.bucket;
+        const uint last  = min(first + ubo.bucket, ubo.byteCount / ubo.sampleStride);
+        const bool isMax = (gl_VertexIndex & 1) == 1;
+        rawY = decodeSample(ubo.byteOffset + first * ubo.sampleStride);
+        for(uint ii = first + 1u; ii < last; ++ii) {
+            const float y = decodeSample(ubo.byteOffset + ii * ubo.sampleStride);
+            rawY = isMax ? max(rawY, y) : min(rawY, y);
+        }
+    }
+
+    const vec4 raw = vec4(ubo.xOrigin + float(gl_VertexIndex) * ubo.xStep, rawY, 0.0, 1.0);
     const vec4 ndc = ubo.dataToNdc * raw;
 
     // Apply zoom/pan
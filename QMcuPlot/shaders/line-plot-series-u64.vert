@@ -0,0 +1,119 @@
+#version 450
+
+layout(set = 1, binding = 0) buffer InputData {
+    uint data[];
+} inData;
+
+layout(binding = 0) uniform UBO {
+    mat4 mvp;
+    
+    mat4 dataToNdc;       // data -> NDC
+    mat4 viewTransform;   // zoom & pan in NDC space
+
+    vec4  color;    // base color
+    
+    vec2 boundingSize;
+
+    float thickness;
+    float glow;
+
+    uint byteCount;     // byte count
+    uint byteOffset;    // byte offset
+    uint sampleStride;  // sample stride
+
+    uint tid;
+
+    float xOrigin;      // x of the first vertex, in samples
+    float xStep;        // samples between two vertices
+    uint  bucket;       // samples per (min, max) pair of vertices, 0 to draw every sample
+} ubo;
+
+layout(location = 0) out vec4 vPosNdc;
+
+
+// 8-bit unsigned
+uint decodeU8(uint byteIndex) {
+    const uint wordIndex = byteIndex / 4u;
+    const uint byteInWord = byteIndex % 4u;
+    return (inData.data[wordIndex] >> (byteInWord * 8u)) & 0xFFu;
+}
+
+// 8-bit signed
+int decodeI8(uint byteIndex) {
+    const uint uval = decodeU8(byteIndex);
+    return (int(uval) << 24) >> 24; // sign-extend
+}
+
+// 16-bit unsigned (little-endian)
+uint decodeU16(uint byteIndex) {
+    const uint b0 = decodeU8(byteIndex + 0u);
+    const uint b1 = decodeU8(byteIndex + 1u);
+    return b0 | (b1 << 8u);
+}
+
+// 16-bit signed (little-endian)
+int decodeI16(uint byteIndex) {
+    const uint uval = decodeU16(byteIndex);
+    return (int(uval) << 16) >> 16; // sign-extend
+}
+
+// 32-bit unsigned (little-endian)
+uint decodeU32(uint byteIndex) {
+    const uint b0 = decodeU8(byteIndex + 0u);
+    const uint b1 = decodeU8(byteIndex + 1u);
+    const uint b2 = decodeU8(byteIndex + 2u);
+    const uint b3 = decodeU8(byteIndex + 3u);
+    return b0 | (b1 << 8u) | (b2 << 16u) | (b3 << 24u);
+}
+
+// 32-bit signed (little-endian)
+int decodeI32(uint byteIndex) {
+    return int(decodeU32(byteIndex));
+}
+
+// 64-bit unsigned (little-endian), rounded
+float decodeU64(uint byteIndex) {
+    return float(decodeU32(byteIndex + 4u)) * 4294967296.0 + float(decodeU32(byteIndex));
+}
+
+// 64-bit signed (little-endian), rounded
+float decodeI64(uint byteIndex) {
+    return float(decodeI32(byteIndex + 4u)) * 4294967296.0 + float(decodeU32(byteIndex));
+}
+
+
+float decodeSample(uint byteIndex) {
+    return decodeU64(byteIndex);
+}
+
+void main() {
+    float rawY;
+    if(ubo.bucket == 0u) {
+        rawY = decodeSample(ubo.byteOffset + uint(gl_VertexIndex) * ubo.sampleStride);
+    } else {
+        // decimation: even vertices are the min of a bucket of samples, odd ones its max
+        const uint first = (uint(gl_VertexIndex) / 2u) * ubo.bucket;
+        const uint last  = min(first + ubo.bucket, ubo.byteCount / ubo.sampleStride);
+        const bool isMax = (gl_VertexIndex & 1) == 1;
+        rawY = decodeSample(ubo.byteOffset + first * ubo.sampleStride);
+        for(uint ii = first + 1u; ii < last; ++ii) {
+            const float y = decodeSample(ubo.byteOffset + ii * ubo.sampleStride);
+            rawY = isMax ? max(rawY, y) : min(rawY, y);
+        }
+    }
+
+    const vec4 raw = vec4(ubo.xOrigin + float(gl_VertexIndex) * ubo.xStep, rawY, 0.0, 1.0);
+    const vec4 ndc = ubo.dataToNdc * raw;
+
+    // Apply zoom/pan
+    const vec4 view = ubo.viewTransform * ndc;
+
+    const vec4 pixel = vec4(
+        (((view.x + 1.0) * 0.5) * ubo.boundingSize.x),
+        ((1.0 - view.y) * 0.5) * ubo.boundingSize.y, // flip Y for top-left origin
+        0.0, 1.0);
+
+    gl_Position = ubo.mvp * pixel;
+
+    vPosNdc = vec4(view.xy, 0.0, 1.0);
+}
\ No newline at end of file
@@ -7,3 +7,12 @@ void* AbstractPlotDataProvider::createMappedBuffer(qplot::TypeId           tid,
 {
   return series_->createMappedBuffer(tid, count, usage);
 }
+
+void AbstractPlotDataProvider::reinitialize()
+{
+  if(series_ != nullptr)
+  {
+    series_->requestReinitialize();
+  }
+  emit dataChanged();
+}
@@ -9,6 +9,8 @@ uint32_t AbstractPlotSeries::s_instanceCount_ = 0;
 AbstractPlotSeries::AbstractPlotSeries(QObject* parent)
     : PlotSceneItem{parent}, id_(++s_instanceCount_)
 {
+  // providers may draw a level of detail that depends on the view
+  connect(this, &AbstractPlotSeries::transformsChanged, this, [this] { setDirty(); });
 }
 
 void* AbstractPlotSeries::createMappedBuffer(qplot::TypeId           tid,
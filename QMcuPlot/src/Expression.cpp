@@ -0,0 +1,603 @@
+#include <QMcu/Plot/Expression.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <string>
+#include <string_view>
+
+using Op = Expression::Op;
+
+namespace
+{
+// Registers of evaluate(), and samples per block of the batch evaluation
+constexpr size_t maxDepth  = 64;
+constexpr size_t blockSize = 256;
+// Nested sub-expressions the parser recurses into, long before the stack runs out
+constexpr size_t maxNesting = 256;
+
+constexpr int arity(Op op) noexcept
+{
+  switch(op)
+  {
+    case Op::Constant:
+    case Op::Input:
+      return 0;
+    case Op::Negate:
+    case Op::Not:
+    case Op::BitNot:
+    case Op::Abs:
+    case Op::Sqrt:
+    case Op::Exp:
+    case Op::Log:
+    case Op::Floor:
+    case Op::Ceil:
+    case Op::Round:
+    case Op::Sin:
+    case Op::Cos:
+      return 1;
+    case Op::Select:
+    case Op::Clamp:
+    case Op::Lerp:
+      return 3;
+    default:
+      return 2;
+  }
+}
+
+int64_t toInt(double v) noexcept
+{
+  // NaN and out of range values would be undefined behavior
+  return (v > -9.2e18 and v < 9.2e18) ? int64_t(v) : 0;
+}
+
+double shiftLeft(double a, double b) noexcept
+{
+  return double(int64_t(uint64_t(toInt(a)) << (toInt(b) & 63)));
+}
+
+double truth(bool b) noexcept
+{
+  return b ? 1.0 : 0.0;
+}
+
+template <Op op> double apply(double a, double b, double c) noexcept
+{
+  // clang-format off
+  if constexpr(op == Op::Negate)            return -a;
+  else if constexpr(op == Op::Not)          return truth(a == 0.0);
+  else if constexpr(op == Op::BitNot)       return double(~toInt(a));
+  else if constexpr(op == Op::Add)          return a + b;
+  else if constexpr(op == Op::Subtract)     return a - b;
+  else if constexpr(op == Op::Multiply)     return a * b;
+  else if constexpr(op == Op::Divide)       return a / b;
+  else if constexpr(op == Op::Modulo)
+  {
+    const auto d = toInt(b);
+    return d == 0 ? std::numeric_limits<double>::quiet_NaN() : d == -1 ? 0.0 : double(toInt(a) % d);
+  }
+  else if constexpr(op == Op::BitAnd)       return double(toInt(a) & toInt(b));
+  else if constexpr(op == Op::BitOr)        return double(toInt(a) | toInt(b));
+  else if constexpr(op == Op::BitXor)       return double(toInt(a) ^ toInt(b));
+  else if constexpr(op == Op::ShiftLeft)    return shiftLeft(a, b);
+  else if constexpr(op == Op::ShiftRight)   return double(toInt(a) >> (toInt(b) & 63));
+  else if constexpr(op == Op::Less)         return truth(a < b);
+  else if constexpr(op == Op::LessEqual)    return truth(a <= b);
+  else if constexpr(op == Op::Greater)      return truth(a > b);
+  else if constexpr(op == Op::GreaterEqual) return truth(a >= b);
+  else if constexpr(op == Op::Equal)        return truth(a == b);
+  else if constexpr(op == Op::NotEqual)     return truth(a != b);
+  else if constexpr(op == Op::And)          return truth(a != 0.0 and b != 0.0);
+  else if constexpr(op == Op::Or)           return truth(a != 0.0 or b != 0.0);
+  else if constexpr(op == Op::Select)       return a != 0.0 ? b : c;
+  else if constexpr(op == Op::Abs)          return std::abs(a);
+  else if constexpr(op == Op::Min)          return std::min(a, b);
+  else if constexpr(op == Op::Max)          return std::max(a, b);
+  else if constexpr(op == Op::Clamp)        return std::min(std::max(a, b), c);
+  else if constexpr(op == Op::Lerp)         return std::lerp(a, b, c);
+  else if constexpr(op == Op::Sqrt)         return std::sqrt(a);
+  else if constexpr(op == Op::Pow)          return std::pow(a, b);
+  else if constexpr(op == Op::Exp)          return std::exp(a);
+  else if constexpr(op == Op::Log)          return std::log(a);
+  else if constexpr(op == Op::Floor)        return std::floor(a);
+  else if constexpr(op == Op::Ceil)         return std::ceil(a);
+  else if constexpr(op == Op::Round)        return std::round(a);
+  else if constexpr(op == Op::Sin)          return std::sin(a);
+  else if constexpr(op == Op::Cos)          return std::cos(a);
+  // clang-format on
+}
+
+// One instruction over n samples: the top registers are replaced by the result
+template <Op op> void step(double* stack, size_t& sp, size_t n, size_t stride) noexcept
+{
+  constexpr int args = arity(op);
+  double*       a    = stack + (sp - args) * stride;
+  double const* b    = a + stride;
+  double const* c    = b + stride;
+  for(size_t i = 0; i < n; ++i)
+  {
+    if constexpr(args == 1)
+    {
+      a[i] = apply<op>(a[i], 0.0, 0.0);
+    }
+    else if constexpr(args == 2)
+    {
+      a[i] = apply<op>(a[i], b[i], 0.0);
+    }
+    else
+    {
+      a[i] = apply<op>(a[i], b[i], c[i]);
+    }
+  }
+  sp -= args - 1;
+}
+
+void run(std::span<Expression::Instruction const> code,
+         double const*                            inputs,
+         size_t                                   inputStride,
+         size_t                                   n,
+         double*                                  stack,
+         size_t                                   stride) noexcept
+{
+  size_t sp = 0;
+  for(const auto& ins : code)
+  {
+    switch(ins.op)
+    {
+      case Op::Constant:
+        std::fill_n(stack + sp++ * stride, n, ins.constant);
+        break;
+      case Op::Input:
+        std::copy_n(inputs + ins.input * inputStride, n, stack + sp++ * stride);
+        break;
+#define X(__op)                           \
+  case Op::__op:                          \
+    step<Op::__op>(stack, sp, n, stride); \
+    break;
+        X(Negate)
+        X(Not)
+        X(BitNot)
+        X(Add)
+        X(Subtract)
+        X(Multiply)
+        X(Divide)
+        X(Modulo)
+        X(BitAnd)
+        X(BitOr)
+        X(BitXor)
+        X(ShiftLeft)
+        X(ShiftRight)
+        X(Less)
+        X(LessEqual)
+        X(Greater)
+        X(GreaterEqual)
+        X(Equal)
+        X(NotEqual)
+        X(And)
+        X(Or)
+        X(Select)
+        X(Abs)
+        X(Min)
+        X(Max)
+        X(Clamp)
+        X(Lerp)
+        X(Sqrt)
+        X(Pow)
+        X(Exp)
+        X(Log)
+        X(Floor)
+        X(Ceil)
+        X(Round)
+        X(Sin)
+        X(Cos)
+#undef X
+    }
+  }
+}
+
+struct Function
+{
+  std::string_view name;
+  Op               op;
+  int              args;
+};
+
+constexpr std::array functions = {
+    Function{"abs", Op::Abs, 1},
+    Function{"min", Op::Min, 2},
+    Function{"max", Op::Max, 2},
+    Function{"clamp", Op::Clamp, 3},
+    Function{"lerp", Op::Lerp, 3},
+    Function{"sqrt", Op::Sqrt, 1},
+    Function{"pow", Op::Pow, 2},
+    Function{"exp", Op::Exp, 1},
+    Function{"log", Op::Log, 1},
+    Function{"floor", Op::Floor, 1},
+    Function{"ceil", Op::Ceil, 1},
+    Function{"round", Op::Round, 1},
+    Function{"sin", Op::Sin, 1},
+    Function{"cos", Op::Cos, 1},
+};
+
+struct Binary
+{
+  std::string_view token;
+  Op               op;
+  std::string_view notBefore = {}; // ie. "&" is not "&&"
+};
+
+// Lowest precedence first
+const std::array<std::vector<Binary>, 10> binaries = {{
+    {{"||", Op::Or}},
+    {{"&&", Op::And}},
+    {{"|", Op::BitOr, "|"}},
+    {{"^", Op::BitXor}},
+    {{"&", Op::BitAnd, "&"}},
+    {{"==", Op::Equal}, {"!=", Op::NotEqual}},
+    {{"<=", Op::LessEqual},
+     {">=", Op::GreaterEqual},
+     {"<", Op::Less, "<"},
+     {">", Op::Greater, ">"}},
+    {{"<<", Op::ShiftLeft}, {">>", Op::ShiftRight}},
+    {{"+", Op::Add}, {"-", Op::Subtract}},
+    {{"*", Op::Multiply}, {"/", Op::Divide}, {"%", Op::Modulo}},
+}};
+} // namespace
+
+// Recursive descent over the source, emitting postfix code
+class Expression::Parser
+{
+public:
+  Parser(std::string text, Expression& out) : text_(std::move(text)), out_(out)
+  {
+  }
+
+  bool parse()
+  {
+    if(not ternary())
+    {
+      return false;
+    }
+    skipSpaces();
+    if(pos_ != text_.size())
+    {
+      return fail("unexpected character");
+    }
+    return true;
+  }
+
+private:
+  // One more level of nesting while in scope
+  struct Nested
+  {
+    explicit Nested(size_t& level) : level_{++level}
+    {
+    }
+    ~Nested()
+    {
+      --level_;
+    }
+    size_t& level_;
+  };
+
+  bool fail(QString const& what)
+  {
+    if(out_.error_.isEmpty())
+    {
+      out_.error_ = QString("%1 at column %2").arg(what).arg(pos_ + 1);
+    }
+    return false;
+  }
+
+  void skipSpaces()
+  {
+    while(pos_ < text_.size() and std::isspace(uint8_t(text_[pos_])))
+    {
+      ++pos_;
+    }
+  }
+
+  bool accept(std::string_view token, std::string_view notBefore = {})
+  {
+    skipSpaces();
+    const auto rest = std::string_view{text_}.substr(pos_);
+    if(not rest.starts_with(token) or
+       (not notBefore.empty() and rest.substr(token.size()).starts_with(notBefore)))
+    {
+      return false;
+    }
+    pos_ += token.size();
+    return true;
+  }
+
+  // Appends an instruction, folding it with constant operands
+  void push(Instruction ins)
+  {
+    auto&      code = out_.code_;
+    const auto args = size_t(arity(ins.op));
+    code.push_back(ins);
+    if(args == 0 or code.size() <= args or
+       not std::all_of(code.end() - args - 1,
+                       code.end() - 1,
+                       [](Instruction const& i) { return i.op == Op::Constant; }))
+    {
+      return;
+    }
+    std::array<double, 3> stack{};
+    run(std::span{code}.last(args + 1), nullptr, 0, 1, stack.data(), 1);
+    code.resize(code.size() - args - 1);
+    code.push_back({Op::Constant, 0, stack[0]});
+  }
+
+  bool ternary()
+  {
+    const Nested nested{nesting_};
+    if(nesting_ > maxNesting)
+    {
+      return fail("too deeply nested");
+    }
+    if(not binary(0))
+    {
+      return false;
+    }
+    if(accept("?"))
+    {
+      if(not ternary())
+      {
+        return false;
+      }
+      if(not accept(":"))
+      {
+        return fail("expected ':'");
+      }
+      if(not ternary())
+      {
+        return false;
+      }
+      push({Op::Select});
+    }
+    return true;
+  }
+
+  bool binary(size_t level)
+  {
+    if(level == binaries.size())
+    {
+      return unary();
+    }
+    if(not binary(level + 1))
+    {
+      return false;
+    }
+    for(;;)
+    {
+      const auto it = std::ranges::find_if(binaries[level],
+                                           [this](Binary const& b)
+                                           { return accept(b.token, b.notBefore); });
+      if(it == binaries[level].end())
+      {
+        return true;
+      }
+      if(not binary(level + 1))
+      {
+        return false;
+      }
+      push({it->op});
+    }
+  }
+
+  bool unary()
+  {
+    static constexpr std::array<std::pair<std::string_view, Op>, 3> prefixes = {{
+        {"-", Op::Negate},
+        {"!", Op::Not},
+        {"~", Op::BitNot},
+    }};
+    const Nested nested{nesting_};
+    if(nesting_ > maxNesting)
+    {
+      return fail("too deeply nested");
+    }
+    for(const auto& [token, op] : prefixes)
+    {
+      if(accept(token))
+      {
+        if(not unary())
+        {
+          return false;
+        }
+        push({op});
+        return true;
+      }
+    }
+    if(accept("+"))
+    {
+      return unary();
+    }
+    return primary();
+  }
+
+  bool primary()
+  {
+    skipSpaces();
+    if(accept("("))
+    {
+      if(not ternary())
+      {
+        return false;
+      }
+      return accept(")") or fail("expected ')'");
+    }
+    if(pos_ < text_.size() and (std::isdigit(uint8_t(text_[pos_])) or text_[pos_] == '.'))
+    {
+      return number();
+    }
+    if(pos_ < text_.size() and (std::isalpha(uint8_t(text_[pos_])) or text_[pos_] == '_'))
+    {
+      return identifier();
+    }
+    return fail(pos_ < text_.size() ? "unexpected character" : "unexpected end");
+  }
+
+  bool number()
+  {
+    auto const* first = text_.data() + pos_;
+    auto const* last  = text_.data() + text_.size();
+    double      value = 0.0;
+    if(std::string_view{first, last}.starts_with("0x") or
+       std::string_view{first, last}.starts_with("0X"))
+    {
+      uint64_t   bits = 0;
+      const auto r    = std::from_chars(first + 2, last, bits, 16);
+      if(r.ec != std::errc{})
+      {
+        return fail("invalid number");
+      }
+      value = double(bits);
+      first = r.ptr;
+    }
+    else
+    {
+      const auto r = std::from_chars(first, last, value);
+      if(r.ec != std::errc{})
+      {
+        return fail("invalid number");
+      }
+      first = r.ptr;
+    }
+    pos_ = size_t(first - text_.data());
+    push({Op::Constant, 0, value});
+    return true;
+  }
+
+  bool identifier()
+  {
+    const auto start = pos_;
+    while(pos_ < text_.size() and
+          (std::isalnum(uint8_t(text_[pos_])) or text_[pos_] == '_' or text_[pos_] == '.'))
+    {
+      ++pos_;
+    }
+    const auto name  = std::string_view{text_}.substr(start, pos_ - start);
+    const auto qname = QString::fromUtf8(name.data(), qsizetype(name.size()));
+
+    if(const auto fn = std::ranges::find(functions, name, &Function::name); fn != functions.end())
+    {
+      if(not accept("("))
+      {
+        return fail("expected '('");
+      }
+      for(int ii = 0; ii < fn->args; ++ii)
+      {
+        if((ii != 0 and not accept(",")) or not ternary())
+        {
+          return fail(QString("%1 takes %2 arguments").arg(qname).arg(fn->args));
+        }
+      }
+      if(not accept(")"))
+      {
+        return fail(QString("%1 takes %2 arguments").arg(qname).arg(fn->args));
+      }
+      push({fn->op});
+    }
+    else if(name == "pi")
+    {
+      push({Op::Constant, 0, std::numbers::pi});
+    }
+    else if(name == "x" or name == "value")
+    {
+      push({Op::Input, 0});
+    }
+    else if(accept("("))
+    {
+      return fail(QString("unknown function %1").arg(qname));
+    }
+    else
+    {
+      auto& refs  = out_.references_;
+      auto  index = refs.indexOf(qname);
+      if(index < 0)
+      {
+        index = refs.size();
+        refs.append(qname);
+      }
+      push({Op::Input, uint32_t(index + 1)});
+    }
+    return true;
+  }
+
+  std::string text_;
+  size_t      pos_     = 0;
+  size_t      nesting_ = 0;
+  Expression& out_;
+};
+
+bool Expression::compile(QString const& source)
+{
+  source_ = source;
+  error_.clear();
+  references_.clear();
+  code_.clear();
+  depth_ = 0;
+
+  if(not Parser{source.toStdString(), *this}.parse())
+  {
+    code_.clear();
+    references_.clear();
+    return false;
+  }
+
+  size_t sp = 0;
+  for(const auto& ins : code_)
+  {
+    sp     = sp + 1 - arity(ins.op);
+    depth_ = std::max(depth_, sp);
+  }
+  if(depth_ > maxDepth)
+  {
+    error_ = "expression too deeply nested";
+    code_.clear();
+    references_.clear();
+    return false;
+  }
+  return true;
+}
+
+double Expression::evaluate(std::span<double const> inputs) const noexcept
+{
+  if(not isValid() or inputs.size() < inputCount())
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  std::array<double, maxDepth> stack;
+  ::run(code_, inputs.data(), 1, 1, stack.data(), 1);
+  return stack[0];
+}
+
+void Expression::evaluate(std::span<std::span<double const> const> inputs,
+                          std::span<double>                        out) const
+{
+  if(not isValid() or inputs.size() < inputCount())
+  {
+    std::ranges::fill(out, std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+
+  // inputs are staged per block: input k of sample i at k * blockSize + i
+  std::vector<double> staged(inputCount() * blockSize);
+  std::vector<double> stack(depth_ * blockSize);
+  for(size_t first = 0; first < out.size(); first += blockSize)
+  {
+    const size_t n = std::min(blockSize, out.size() - first);
+    for(size_t k = 0; k < inputCount(); ++k)
+    {
+      std::copy_n(inputs[k].data() + first, n, staged.data() + k * blockSize);
+    }
+    ::run(code_, staged.data(), blockSize, n, stack.data(), blockSize);
+    std::copy_n(stack.data(), n, out.data() + first);
+  }
+}
@@ -0,0 +1,126 @@
+#include <QMcu/Plot/MinMaxPyramid.hpp>
+
+#include <Logging.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+size_t basicTypeSize(QMetaType::Type type) noexcept
+{
+#define X(__type, __qt_type) \
+  if(type == __qt_type)      \
+  {                          \
+    return sizeof(__type);   \
+  }
+  QPLOT_BASIC_TYPE_MAP(X)
+#undef X
+  return 0;
+}
+} // namespace
+
+MinMaxPyramid::MinMaxPyramid(QMetaType::Type type)
+    : type_{type},
+      elementSize_{basicTypeSize(type)}
+{
+}
+
+MinMaxPyramid::MinMaxPyramid(QMetaType::Type                         type,
+                             size_t                                  samples,
+                             std::vector<std::span<std::byte const>> levels)
+    : type_{type},
+      elementSize_{basicTypeSize(type)},
+      samples_{samples},
+      view_{true},
+      levels_{std::move(levels)}
+{
+}
+
+size_t MinMaxPyramid::levelFor(double samplesPerBucket) const noexcept
+{
+  size_t level = 0;
+  while(level + 1 < levelCount() and double(bucketSize(level + 1)) <= samplesPerBucket)
+  {
+    ++level;
+  }
+  return level;
+}
+
+void MinMaxPyramid::append(std::byte const* data, size_t count, size_t stride)
+{
+  if(view_)
+  {
+    qWarning(lcPlot) << "MinMaxPyramid: cannot append to a view";
+    return;
+  }
+  if(isValid() and count != 0)
+  {
+    qplot::visitQtType(type_, [&]<typename T> { appendAs<T>(data, count, stride); });
+  }
+}
+
+template <typename T>
+void MinMaxPyramid::appendAs(std::byte const* data, size_t count, size_t stride)
+{
+  const auto pairs = [](std::vector<std::byte>& level, size_t buckets)
+  {
+    level.resize(buckets * 2 * sizeof(T));
+    return reinterpret_cast<T*>(level.data());
+  };
+
+  // level 1, from the samples
+  const size_t from = samples_;
+  samples_ += count;
+  if(owned_.empty())
+  {
+    owned_.emplace_back();
+  }
+  T* out = pairs(owned_[0], buckets(1));
+  for(size_t ii = 0; ii < count; ++ii)
+  {
+    T value;
+    std::memcpy(&value, data + ii * stride, sizeof(T));
+    const size_t sample = from + ii;
+    T*           pair   = out + 2 * (sample / factor);
+    if(sample % factor == 0)
+    {
+      pair[0] = pair[1] = value;
+    }
+    else
+    {
+      pair[0] = std::min(pair[0], value);
+      pair[1] = std::max(pair[1], value);
+    }
+  }
+
+  // coarser levels, from the buckets that changed below them, while there is more than one
+  size_t dirty = from / factor;
+  for(size_t level = 1; buckets(level) > 1; ++level)
+  {
+    if(owned_.size() == level)
+    {
+      owned_.emplace_back();
+    }
+    const auto* in       = reinterpret_cast<T const*>(owned_[level - 1].data());
+    const auto  children = buckets(level);
+    T*          parents  = pairs(owned_[level], buckets(level + 1));
+
+    dirty /= factor;
+    for(size_t jj = dirty; jj < buckets(level + 1); ++jj)
+    {
+      const size_t last = std::min((jj + 1) * factor, children);
+      T            lo   = in[2 * jj * factor];
+      T            hi   = in[2 * jj * factor + 1];
+      for(size_t cc = jj * factor + 1; cc < last; ++cc)
+      {
+        lo = std::min(lo, in[2 * cc]);
+        hi = std::max(hi, in[2 * cc + 1]);
+      }
+      parents[2 * jj]     = lo;
+      parents[2 * jj + 1] = hi;
+    }
+  }
+
+  levels_.assign(owned_.begin(), owned_.end());
+}
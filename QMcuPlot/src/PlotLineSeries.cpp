@@ -8,6 +8,12 @@
 
 #include <QSurfaceFormat>
 
+#include <algorithm>
+#include <cmath>
+
+// Samples per pixel column from which only their min/max envelope is drawn
+static constexpr size_t decimationThreshold = 4;
+
 static const QColor defaultColors[] = {
     QColorConstants::Svg::cyan,
     QColorConstants::Svg::magenta,
@@ -103,6 +109,16 @@ void PlotLineSeries::updateMetadata()
       make_integer_binding(std::type_identity<uint8_t>());
     }
     break;
+    case QMetaType::LongLong:
+    {
+      make_integer_binding(std::type_identity<int64_t>());
+    }
+    break;
+    case QMetaType::ULongLong:
+    {
+      make_integer_binding(std::type_identity<uint64_t>());
+    }
+    break;
     default:
       qFatal() << "Unhandled type";
   }
@@ -169,10 +185,16 @@ bool PlotLineSeries::doInitialize()
       builder.addStage("line-plot-series-u16.vert.spv", vk::ShaderStageFlagBits::eVertex);
       break;
     case QMetaType::Type::Int:
-      builder.addStage("line-plot-series-i16.vert.spv", vk::ShaderStageFlagBits::eVertex);
+      builder.addStage("line-plot-series-i32.vert.spv", vk::ShaderStageFlagBits::eVertex);
       break;
     case QMetaType::Type::UInt:
-      builder.addStage("line-plot-series-u16.vert.spv", vk::ShaderStageFlagBits::eVertex);
+      builder.addStage("line-plot-series-u32.vert.spv", vk::ShaderStageFlagBits::eVertex);
+      break;
+    case QMetaType::Type::LongLong:
+      builder.addStage("line-plot-series-i64.vert.spv", vk::ShaderStageFlagBits::eVertex);
+      break;
+    case QMetaType::Type::ULongLong:
+      builder.addStage("line-plot-series-u64.vert.spv", vk::ShaderStageFlagBits::eVertex);
       break;
     default:
       qFatal(lcPlot) << "Unhandled data type";
@@ -294,6 +316,10 @@ void PlotLineSeries::doDraw()
 {
   if(isDirty())
   {
+    // providers pick their level of detail from it
+    ctx_.view.viewport = QSize(vkContext().boundingRect.extent.width,
+                               vkContext().boundingRect.extent.height);
+
     const auto rng = updateDataProvider();
 
     if(rng.size() != ctx_.vbo._current_range.size())
@@ -317,8 +343,42 @@ void PlotLineSeries::doDraw()
     setDirty(false);
   }
 
-  const GLuint byte_offset = ctx_.vbo.current_byte_offset();
-  const GLuint byte_count  = ctx_.vbo.current_byte_count();
+  // Only the visible samples are drawn; past a few per pixel column, the vertex shader reduces
+  // each column to a (min, max) pair, so that the vertex count follows the plot width rather
+  // than the buffer length. It scans the storage buffer already bound: a compute pre-pass would
+  // need a buffer of its own per series, and a submission of its own, since PlotScene::prepare()
+  // has no command buffer of the frame.
+  const size_t stride = ctx_.vbo.stride;
+  const size_t count  = ctx_.vbo.current_byte_count() / stride;
+  size_t       first  = 0;
+  size_t       last   = count; // past the last visible sample
+  size_t       bucket = 0;     // samples per column, 0 when drawing them all
+  if(count > 1)
+  {
+    const auto [a, b] = ctx_.visibleX();
+    const auto from   = (a - ctx_.lod.origin) / ctx_.lod.step;
+    const auto to     = (b - ctx_.lod.origin) / ctx_.lod.step;
+    double     span   = double(count);
+    if(std::isfinite(from) and std::isfinite(to) and from < to)
+    {
+      // and the neighbours of the visible ones, for the lines to reach the edges
+      first = size_t(std::clamp(std::floor(from) - 1.0, 0.0, double(count - 1)));
+      last  = size_t(std::clamp(std::ceil(to) + 2.0, double(first + 1), double(count)));
+      span  = to - from;
+    }
+    // from the visible width, and on sample indices: panning does not move the buckets
+    const size_t columns = std::max<size_t>(vkContext().boundingRect.extent.width, 1);
+    if(span >= double(decimationThreshold * columns))
+    {
+      bucket = size_t(std::ceil(span / double(columns)));
+      first  = first / bucket * bucket;
+    }
+  }
+
+  const size_t vertices = bucket == 0 ? last - first : 2 * ((last - first + bucket - 1) / bucket);
+
+  const GLuint byte_offset = ctx_.vbo.current_byte_offset() + first * stride;
+  const GLuint byte_count  = (last - first) * stride;
 
   auto& vk  = vkContext();
   auto& dev = vk.dev;
@@ -347,6 +407,9 @@ void PlotLineSeries::doDraw()
     ubo.byteCount    = byte_count;
     ubo.byteOffset   = byte_offset;
     ubo.sampleStride = ctx_.vbo.stride;
+    ubo.xOrigin      = float(ctx_.lod.origin + first * ctx_.lod.step);
+    ubo.xStep        = float(bucket == 0 ? ctx_.lod.step : ctx_.lod.step * bucket / 2.0);
+    ubo.bucket       = bucket;
 
     auto* p = dev.mapMemory(ubufMem_, ubufOffset, allocPerUbuf_);
     memcpy(p, &ubo, sizeof(ubo));
@@ -373,5 +436,5 @@ void PlotLineSeries::doDraw()
                         2,
                         dynamicOffsets);
 
-  cb.draw(byte_count / ctx_.vbo.stride, 2, 0, 0);
+  cb.draw(vertices, 2, 0, 0);
 }
@@ -0,0 +1,353 @@
+#include <QMcu/Plot/PlotMathSeries.hpp>
+#include <QMcu/Plot/VK/VulkanPipelineBuilder.hpp>
+
+#include <Logging.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using Op = Expression::Op;
+
+// line-plot-math.vert numbers the opcodes the same
+static_assert(uint8_t(Op::Input) == 1 and uint8_t(Op::Select) == 23 and uint8_t(Op::Cos) == 37);
+static_assert(PlotMathSeries::maxSources <= 4, "sources are described by uvec4s");
+
+PlotMathSeries::PlotMathSeries(QObject* parent) : AbstractPlotSeries(parent)
+{
+}
+
+PlotMathSeries::~PlotMathSeries()
+{
+}
+
+void PlotMathSeries::setSources(QList<AbstractPlotSeries*> const& sources)
+{
+  if(sources == sources_)
+  {
+    return;
+  }
+  if(sources.size() > maxSources)
+  {
+    qWarning(lcPlot).noquote() << name() << ": only the first" << maxSources
+                               << "sources are used";
+  }
+  for(auto* s : sources_)
+  {
+    disconnect(s, nullptr, this, nullptr);
+  }
+  sources_ = sources.first(std::min(sources.size(), qsizetype(maxSources)));
+  for(auto* s : sources_)
+  {
+    connect(s, &AbstractPlotSeries::nameChanged, this, &PlotMathSeries::compile);
+    connect(s,
+            &QObject::destroyed,
+            this,
+            [this, s]
+            {
+              sources_.removeAll(s);
+              compile();
+              emit sourcesChanged();
+            });
+  }
+  compile();
+  emit sourcesChanged();
+}
+
+void PlotMathSeries::setExpression(QString const& expression)
+{
+  if(expression != expression_)
+  {
+    expression_ = expression;
+    compile();
+    emit expressionChanged();
+  }
+}
+
+void PlotMathSeries::setAverage(int average)
+{
+  average = std::clamp(average, 1, maxAverage);
+  if(average != average_)
+  {
+    average_ = average;
+    emit averageChanged();
+  }
+}
+
+void PlotMathSeries::compile()
+{
+  program_.store(nullptr, std::memory_order_release);
+  if(expression_.isEmpty() or sources_.isEmpty())
+  {
+    return;
+  }
+
+  Expression e;
+  if(not e.compile(expression_))
+  {
+    qWarning(lcPlot).noquote() << name() << ": invalid expression" << expression_ << ":"
+                               << e.error();
+    return;
+  }
+  if(e.size() > maxInstructions or e.depth() > maxDepth)
+  {
+    qWarning(lcPlot).noquote() << name() << ": expression" << expression_
+                               << "is too long to run on the GPU";
+    return;
+  }
+
+  // input 0 is x, the first source, then the others by name
+  std::vector<glm::uint> sourceOf{0};
+  for(auto const& reference : e.references())
+  {
+    const auto it = std::ranges::find(sources_, reference, &AbstractPlotSeries::name);
+    if(it == sources_.end())
+    {
+      qWarning(lcPlot).noquote() << name() << ": no source named" << reference;
+      return;
+    }
+    sourceOf.push_back(glm::uint(it - sources_.begin()));
+  }
+
+  // never changed once published: the render thread may be drawing the previous one
+  auto program     = std::make_shared<Program>();
+  program->sources = sources_;
+  for(auto const& ins : e.code())
+  {
+    const glm::uint source = ins.op == Op::Input ? sourceOf[ins.input] : 0;
+    program->code.push_back(glm::uint(ins.op) | (source << 8));
+    program->constants.push_back(float(ins.constant));
+  }
+  program_.store(std::move(program), std::memory_order_release);
+}
+
+bool PlotMathSeries::doInitialize()
+{
+  // sources may be initialized after this series: retried on next frame
+  const auto program = program_.load(std::memory_order_acquire);
+  if(program == nullptr)
+  {
+    return false;
+  }
+  for(auto* s : program->sources)
+  {
+    if(not s->isInitialized() or s->ctx_.vbo._buffer == nullptr)
+    {
+      return false;
+    }
+  }
+
+  auto& vk = vkContext();
+
+  auto builder = VulkanPipelineBuilder(vk);
+
+  builder.inputAssemblyInfo.setTopology(vk::PrimitiveTopology::eLineStrip);
+
+  vk::PipelineRasterizationLineStateCreateInfo lineInfo{};
+  lineInfo.lineRasterizationMode = vk::LineRasterizationModeEXT::eRectangularKHR;
+  lineInfo.stippledLineEnable    = false;
+  lineInfo.lineStippleFactor     = 1;
+  lineInfo.lineStipplePattern    = 0xFFFF;
+  builder.rasterizationInfo.setPNext(&lineInfo);
+  builder.rasterizationInfo.setLineWidth(lineWidth_);
+
+  builder.addStage("line-plot-math.vert.spv", vk::ShaderStageFlagBits::eVertex);
+  // only reads the color, laid out the same
+  builder.addStage("line-plot-series.frag.spv", vk::ShaderStageFlagBits::eFragment);
+
+  Q_ASSERT(vk.framesInFlight <= 3);
+
+  size_t ubufSize;
+  std::tie(allocPerUbuf_, ubufSize, ubuf_, ubufMem_) = vk.allocateDynamicBuffer(
+      sizeof(ubo),
+      vk::BufferUsageFlagBits::eUniformBuffer,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+  vk.dev.bindBufferMemory(ubuf_, ubufMem_, 0);
+
+  vk::DescriptorSetLayoutBinding descSetLayoutBinding{};
+
+  // set 0
+  descSetLayoutBinding.setBinding(0);
+  descSetLayoutBinding.setDescriptorCount(1);
+  descSetLayoutBinding.setDescriptorType(vk::DescriptorType::eUniformBufferDynamic);
+  descSetLayoutBinding.setStageFlags(vk::ShaderStageFlagBits::eVertex
+                                     | vk::ShaderStageFlagBits::eFragment);
+
+  builder.descSetLayoutBindings.emplace_back(descSetLayoutBinding);
+
+  // set 1: the sources buffers
+  descSetLayoutBinding.setBinding(0);
+  descSetLayoutBinding.setDescriptorCount(maxSources);
+  descSetLayoutBinding.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+  descSetLayoutBinding.setStageFlags(vk::ShaderStageFlagBits::eVertex);
+
+  builder.descSetLayoutBindings.emplace_back(descSetLayoutBinding);
+
+  std::vector<vk::DescriptorSetLayout> dsl;
+  std::tie(pipeline_, pipelineLayout_, dsl) = builder.build();
+
+  uniformsSetLayout_ = dsl.at(0);
+  dataSetLayout_     = dsl.at(1);
+
+  // one sources set per frame slot: a slot rebinds its own when sources change
+  const auto slotCount = uint32_t(vk.framesInFlight);
+
+  vk::DescriptorPoolSize descPoolSizes[] = {
+      {vk::DescriptorType::eUniformBufferDynamic, 1},
+      {vk::DescriptorType::eStorageBuffer, maxSources * slotCount},
+  };
+  vk::DescriptorPoolCreateInfo descPoolInfo{vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet};
+  descPoolInfo.maxSets = 1 + slotCount;
+  descPoolInfo.setPoolSizes(descPoolSizes);
+  descriptorPool_ = vk.dev.createDescriptorPool(descPoolInfo);
+
+  vk::DescriptorSetAllocateInfo descAllocInfo{};
+  vk::WriteDescriptorSet        writeInfo{};
+  vk::DescriptorBufferInfo      bufInfo{};
+
+  // set 0: uniforms
+  descAllocInfo.descriptorPool     = descriptorPool_;
+  descAllocInfo.descriptorSetCount = 1;
+  descAllocInfo.pSetLayouts        = &uniformsSetLayout_;
+  ubufDescriptor_                  = vk.dev.allocateDescriptorSets(descAllocInfo)[0];
+
+  writeInfo.dstSet          = ubufDescriptor_;
+  writeInfo.dstBinding      = 0;
+  writeInfo.descriptorCount = 1;
+  writeInfo.descriptorType  = vk::DescriptorType::eUniformBufferDynamic;
+
+  bufInfo.buffer        = ubuf_;
+  bufInfo.offset        = 0; // dynamic offset is used so this is ignored
+  bufInfo.range         = sizeof(ubo);
+  writeInfo.pBufferInfo = &bufInfo;
+  vk.dev.updateDescriptorSets(1, &writeInfo, 0, nullptr);
+
+  // set 1: written by doDraw()
+  const std::vector<vk::DescriptorSetLayout> layouts(slotCount, dataSetLayout_);
+  descAllocInfo.descriptorSetCount = slotCount;
+  descAllocInfo.pSetLayouts        = layouts.data();
+  const auto sets                  = vk.dev.allocateDescriptorSets(descAllocInfo);
+  std::ranges::copy(sets, sbufDescriptors_.begin());
+  bound_ = {};
+
+  return true;
+}
+
+void PlotMathSeries::doReleaseResources()
+{
+  if(pipeline_ != nullptr)
+  {
+    auto& vk  = vkContext();
+    auto& dev = vk.dev;
+    dev.destroy(pipeline_);
+    dev.destroy(pipelineLayout_);
+
+    dev.free(ubufMem_);
+    dev.destroy(ubuf_);
+
+    dev.destroy(uniformsSetLayout_);
+    dev.destroy(dataSetLayout_);
+
+    dev.freeDescriptorSets(descriptorPool_, ubufDescriptor_);
+    dev.freeDescriptorSets(descriptorPool_, uint32_t(vk.framesInFlight), sbufDescriptors_.data());
+    dev.destroy(descriptorPool_);
+  }
+
+  AbstractPlotSeries::doReleaseResources();
+}
+
+void PlotMathSeries::doDraw()
+{
+  const auto program = program_.load(std::memory_order_acquire);
+  if(program == nullptr)
+  {
+    return;
+  }
+  auto const& sources = program->sources;
+
+  // sources are aligned on their latest samples
+  Sources buffers{};
+  size_t  count = std::numeric_limits<size_t>::max();
+  for(auto* s : sources)
+  {
+    auto& vbo = s->ctx_.vbo;
+    if(vbo._buffer == nullptr or vbo.stride == 0)
+    {
+      return;
+    }
+    count = std::min(count, vbo.current_byte_count() / vbo.stride);
+  }
+  for(int k = 0; k < maxSources; ++k)
+  {
+    auto& ctx  = sources[std::min(k, int(sources.size()) - 1)]->ctx_;
+    auto& vbo  = ctx.vbo;
+    buffers[k] = vbo._buffer;
+
+    const size_t skipped = vbo.current_byte_count() / vbo.stride - count;
+    ubo.sourceOffset[k]  = glm::uint(vbo.current_byte_offset() + skipped * vbo.stride);
+    ubo.sourceStride[k]  = glm::uint(vbo.stride);
+    ubo.sourceType[k]    = glm::uint(ctx.data.type);
+  }
+  if(count < 2)
+  {
+    return;
+  }
+
+  auto& vk   = vkContext();
+  auto& dev  = vk.dev;
+  auto& cb   = vk.commandBuffer;
+  const auto slot = vk.currentFrameSlot;
+
+  // the set of this slot is not used by the frames in flight
+  if(buffers != bound_[slot])
+  {
+    std::array<vk::DescriptorBufferInfo, maxSources> bufInfos;
+    for(int k = 0; k < maxSources; ++k)
+    {
+      bufInfos[k] = {buffers[k], 0, vk::WholeSize};
+    }
+    vk::WriteDescriptorSet writeInfo{};
+    writeInfo.dstSet          = sbufDescriptors_[slot];
+    writeInfo.dstBinding      = 0;
+    writeInfo.descriptorCount = maxSources;
+    writeInfo.descriptorType  = vk::DescriptorType::eStorageBuffer;
+    writeInfo.pBufferInfo     = bufInfos.data();
+    dev.updateDescriptorSets(1, &writeInfo, 0, nullptr);
+    bound_[slot] = buffers;
+  }
+
+  const uint32_t ubufOffset = allocPerUbuf_ * slot;
+  {
+    ubo.mvp            = vk.modelViewProjection;
+    ubo.boundingSize.x = vk.boundingRect.extent.width;
+    ubo.boundingSize.y = vk.boundingRect.extent.height;
+
+    ubo.dataToNdc     = toGlm(ctx_.unit.dataToNdc); // data -> NDC
+    ubo.viewTransform = toGlm(ctx_.view.transform); // zoom & pan in NDC space
+
+    ubo.color   = toGlm(lineColor_);
+    ubo.count   = glm::uint(count);
+    ubo.average = average_;
+
+    ubo.codeSize = glm::uint(program->code.size());
+    std::ranges::copy(program->code, &ubo.code[0][0]);
+    std::ranges::copy(program->constants, &ubo.constants[0][0]);
+
+    auto* p = dev.mapMemory(ubufMem_, ubufOffset, allocPerUbuf_);
+    memcpy(p, &ubo, sizeof(ubo));
+    vk.dev.unmapMemory(ubufMem_);
+  }
+
+  cb.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline_);
+
+  vk::DescriptorSet sets[] = {ubufDescriptor_, sbufDescriptors_[slot]};
+  cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                        pipelineLayout_,
+                        0,
+                        2,
+                        sets,
+                        1,
+                        &ubufOffset);
+
+  cb.draw(count, 1, 0, 0);
+}
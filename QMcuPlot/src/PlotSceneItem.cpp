@@ -6,6 +6,12 @@ PlotSceneItem::PlotSceneItem(QObject* parent) : QObject{parent}
 
 bool PlotSceneItem::initialize(VulkanContext& ctx)
 {
+  if(reinitialize_.exchange(false, std::memory_order_relaxed) and initialized_)
+  {
+    // frames in flight may still read its buffers
+    ctx.dev.waitIdle();
+    release();
+  }
   if(initialized_)
   {
     return true;
@@ -13,6 +19,7 @@ bool PlotSceneItem::initialize(VulkanContext& ctx)
   vk_ = &ctx;
 
   initialized_ = doInitialize();
+  dirty_       = true;
 
   return initialized_;
 }
@@ -0,0 +1,123 @@
+#include <QMcu/Plot/Expression.hpp>
+
+#include <QTest>
+
+#include <cmath>
+#include <vector>
+
+class ExpressionTests : public QObject
+{
+  Q_OBJECT
+
+  static double eval(QString const& source, std::vector<double> const& inputs = {0.0})
+  {
+    Expression e;
+    if(not e.compile(source))
+    {
+      qWarning() << source << e.error();
+      return std::nan("");
+    }
+    return e.evaluate(inputs);
+  }
+
+private slots:
+  void test_arithmetic()
+  {
+    QCOMPARE(eval("1 + 2 * 3"), 7.0);
+    QCOMPARE(eval("(1 + 2) * 3"), 9.0);
+    QCOMPARE(eval("2 - 1 - 1"), 0.0);
+    QCOMPARE(eval("x * 3.3 / 4096", {2048.0}), 1.65);
+    QCOMPARE(eval("-x + 1e3", {5.0}), 995.0);
+    QCOMPARE(eval("7 % 3"), 1.0);
+  }
+
+  void test_bits()
+  {
+    QCOMPARE(eval("x & 0xff", {double(0x1234)}), double(0x34));
+    QCOMPARE(eval("x >> 4 & 0xf", {double(0x1234)}), 3.0);
+    QCOMPARE(eval("1 << 4 | 1"), 17.0);
+    QCOMPARE(eval("~0"), -1.0);
+    QCOMPARE(eval("5 ^ 1"), 4.0);
+  }
+
+  void test_logic()
+  {
+    QCOMPARE(eval("x > 10 ? 1 : 2", {5.0}), 2.0);
+    QCOMPARE(eval("x > 10 && x < 20", {15.0}), 1.0);
+    QCOMPARE(eval("x < 10 || x > 20", {15.0}), 0.0);
+    QCOMPARE(eval("!x"), 1.0);
+    QCOMPARE(eval("x == 2 != 0", {2.0}), 1.0);
+    QCOMPARE(eval("1 ? 2 : 0 ? 3 : 4"), 2.0);
+  }
+
+  void test_functions()
+  {
+    QCOMPARE(eval("clamp(x, 0, 10)", {50.0}), 10.0);
+    QCOMPARE(eval("lerp(0, 10, 0.25)"), 2.5);
+    QCOMPARE(eval("abs(min(x, -3))", {1.0}), 3.0);
+    QCOMPARE(eval("round(pi * 100)"), 314.0);
+  }
+
+  void test_references()
+  {
+    Expression e;
+    QVERIFY(e.compile("gain * value + motor.offset - gain"));
+    QCOMPARE(e.references(), QStringList({"gain", "motor.offset"}));
+    QCOMPARE(e.inputCount(), size_t(3));
+    QCOMPARE(e.evaluate(std::vector{3.0, 2.0, 1.0}), 5.0);
+
+    // missing inputs
+    QVERIFY(std::isnan(e.evaluate(std::vector{3.0})));
+  }
+
+  void test_folding()
+  {
+    Expression e;
+    QVERIFY(e.compile("4096 / (2 * 1.5)"));
+    QCOMPARE(e.size(), size_t(1));
+    QVERIFY(e.compile("x * (3.3 / 4096)"));
+    QCOMPARE(e.size(), size_t(3));
+  }
+
+  void test_errors()
+  {
+    Expression e;
+    for(const auto* source : {"", "1 +", "(1", "foo(1)", "min(1)", "clamp(1, 2)", "1 2", "x $"})
+    {
+      QVERIFY2(not e.compile(source), source);
+      QVERIFY(not e.error().isEmpty());
+      QVERIFY(not e.isValid());
+    }
+    QVERIFY(std::isnan(e.evaluate(std::vector{1.0})));
+
+    // rejected before the parser runs out of stack
+    const auto nested = [](int n) { return QString(n, '(') + "x" + QString(n, ')'); };
+    QVERIFY(e.compile(nested(100)));
+    QVERIFY(not e.compile(nested(100'000)));
+    QVERIFY(not e.compile(QString(100'000, '-') + "x"));
+    QVERIFY(e.error().startsWith("too deeply nested"));
+  }
+
+  void test_batch()
+  {
+    Expression e;
+    QVERIFY(e.compile("x * k + 1 > 5 ? sqrt(x) : -x"));
+
+    // more than a block, not a multiple of it
+    std::vector<double> xs(1000), ks(1000), out(1000);
+    for(size_t ii = 0; ii < xs.size(); ++ii)
+    {
+      xs[ii] = ii * 0.37;
+      ks[ii] = double(ii % 7);
+    }
+    const std::vector<std::span<double const>> inputs{xs, ks};
+    e.evaluate(inputs, out);
+    for(size_t ii = 0; ii < xs.size(); ++ii)
+    {
+      QCOMPARE(out[ii], e.evaluate(std::vector{xs[ii], ks[ii]}));
+    }
+  }
+};
+
+QTEST_GUILESS_MAIN(ExpressionTests)
+#include "test-expression.moc"
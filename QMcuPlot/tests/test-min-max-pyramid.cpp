@@ -0,0 +1,108 @@
+#include <QMcu/Plot/MinMaxPyramid.hpp>
+
+#include <QTest>
+
+#include <cstring>
+#include <random>
+
+class MinMaxPyramidTests : public QObject
+{
+  Q_OBJECT
+
+  template <typename T> static void append(MinMaxPyramid& pyramid, std::vector<T> const& samples)
+  {
+    pyramid.append(reinterpret_cast<std::byte const*>(samples.data()), samples.size(), sizeof(T));
+  }
+
+  template <typename T> static std::vector<T> level(MinMaxPyramid const& pyramid, size_t level)
+  {
+    const auto      bytes = pyramid.level(level);
+    std::vector<T> out(bytes.size() / sizeof(T));
+    std::memcpy(out.data(), bytes.data(), bytes.size());
+    return out;
+  }
+
+private slots:
+  void test_levels()
+  {
+    MinMaxPyramid pyramid{QMetaType::Short};
+    QVERIFY(pyramid.isValid());
+    append<int16_t>(pyramid, {0, 5, -3, 2, 7, 1, 1, 1, -9});
+
+    QCOMPARE(pyramid.samples(), size_t(9));
+    QCOMPARE(pyramid.levelCount(), size_t(3));
+    QCOMPARE(level<int16_t>(pyramid, 1), (std::vector<int16_t>{-3, 5, 1, 7, -9, -9}));
+    QCOMPARE(level<int16_t>(pyramid, 2), (std::vector<int16_t>{-9, 7}));
+    QVERIFY(pyramid.level(3).empty());
+  }
+
+  void test_incremental()
+  {
+    // the same pyramid, whatever the batches
+    std::mt19937                          rng{42};
+    std::uniform_real_distribution<float> dist{-1000.0f, 1000.0f};
+    std::vector<float>                    samples(10'000);
+    for(auto& s : samples)
+    {
+      s = dist(rng);
+    }
+    samples[7777] = 5000.0f; // a single peak
+
+    MinMaxPyramid whole{QMetaType::Float};
+    append(whole, samples);
+
+    MinMaxPyramid batched{QMetaType::Float};
+    for(size_t at = 0; at < samples.size();)
+    {
+      const size_t count = std::min<size_t>(1 + rng() % 300, samples.size() - at);
+      batched.append(reinterpret_cast<std::byte const*>(samples.data() + at), count, sizeof(float));
+      at += count;
+    }
+
+    QCOMPARE(batched.levelCount(), whole.levelCount());
+    for(size_t ll = 1; ll < whole.levelCount(); ++ll)
+    {
+      QCOMPARE(level<float>(batched, ll), level<float>(whole, ll));
+      QCOMPARE(whole.level(ll).size(), whole.buckets(ll) * 2 * sizeof(float));
+      // the peak survives every level
+      QCOMPARE(std::ranges::max(level<float>(whole, ll)), 5000.0f);
+    }
+    QCOMPARE(whole.buckets(whole.levelCount() - 1), size_t(1));
+  }
+
+  void test_stride()
+  {
+    // first element of each sample
+    const int32_t samples[][2] = {{1, 100}, {-4, 100}, {2, -100}, {3, 0}};
+    MinMaxPyramid pyramid{QMetaType::Int};
+    pyramid.append(reinterpret_cast<std::byte const*>(samples), 4, sizeof(samples[0]));
+    QCOMPARE(level<int32_t>(pyramid, 1), (std::vector<int32_t>{-4, 3}));
+  }
+
+  void test_level_for()
+  {
+    MinMaxPyramid pyramid{QMetaType::UChar};
+    append(pyramid, std::vector<uint8_t>(1000, 1));
+    QCOMPARE(pyramid.levelFor(1.0), size_t(0));
+    QCOMPARE(pyramid.levelFor(3.9), size_t(0));
+    QCOMPARE(pyramid.levelFor(4.0), size_t(1));
+    QCOMPARE(pyramid.levelFor(100.0), size_t(3));
+    QCOMPARE(pyramid.levelFor(1e9), pyramid.levelCount() - 1);
+  }
+
+  void test_view()
+  {
+    const int16_t level1[] = {-1, 1, -2, 2};
+    MinMaxPyramid view{QMetaType::Short, 8, {std::as_bytes(std::span{level1})}};
+    QCOMPARE(view.levelCount(), size_t(2));
+    QCOMPARE(level<int16_t>(view, 1), (std::vector<int16_t>{-1, 1, -2, 2}));
+  }
+
+  void test_not_basic()
+  {
+    QVERIFY(not MinMaxPyramid{QMetaType::QString}.isValid());
+  }
+};
+
+QTEST_GUILESS_MAIN(MinMaxPyramidTests)
+#include "test-min-max-pyramid.moc"
@@ -53,6 +53,17 @@ ApplicationWindow {
         }
     }
 
+    // samples every watch, at the configuration "rate" unless the watch has its own
+    VariableProxyGroup {
+        id: watchGroup
+        running: true
+    }
+
+    Component {
+        id: watchProxy
+        VariableProxy {}
+    }
+
     Connections {
         target: dbg
         function onTargetLoadingCompleted() {
@@ -60,13 +71,21 @@ ApplicationWindow {
                 console.debug(`Setting up watch for '${watch.variable}'`);
                 var v = dbg.variable(watch.variable);
                 console.debug(`Got variable '${v.type.name} ${v.name}'`);
+                watchProxy.createObject(root, {
+                    name: watch.variable,
+                    rate: Number(watch.rate ?? 0),
+                    priority: Number(watch.priority ?? 0),
+                    group: watchGroup
+                });
             }
         }
     }
 
     Component.onCompleted: {
         console.debug(config);
-        dbg.rate = config.rate;
+        if (config.rate !== undefined) {
+            watchGroup.rate = Number(config.rate);
+        }
         dbg.load(config.executable);
     }
 }
@@ -60,7 +60,7 @@ ApplicationWindow {
                 focus: true
 
                 Layout.fillWidth: true
-                onCurrentIndexChanged: dbg.watcher.variable = varCombo.valueAt(varCombo.currentIndex)
+                onCurrentIndexChanged: dbg.watcher.variable = dbg.variable(varCombo.valueAt(varCombo.currentIndex))
                 // text: Shared.settings.comDevice
                 dbg: root.dbg
             }
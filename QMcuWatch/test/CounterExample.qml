@@ -23,17 +23,26 @@ ApplicationWindow {
         executable: "QMcuWatchCounterExample"
     }
 
+    // reads the counter without stopping it
+    HostProcessProbe {}
+
+    VariableProxyGroup {
+        id: counterProxies
+        rate: 3 // Hz
+        running: true
+    }
+
     VariableProxy {
         id: counter
         name: "counter"
-        rate: 3 // Hz
-        running: true
+        group: counterProxies
+        priority: 1
     }
     VariableProxy {
         id: noiseCounter
         name: "noiseCounter"
-        rate: 3 // Hz
-        running: true
+        group: counterProxies
+        rate: 10 // Hz, faster than the group
         transform: value => value * 2
     }
 
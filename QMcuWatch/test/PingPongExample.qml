@@ -0,0 +1,100 @@
+import QtCore
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Controls.Material
+import QtQuick.Layouts
+import QtQuick.Window
+
+import QMcu.Debug
+import QMcu.Plot
+import QMcu.Utils
+
+ApplicationWindow {
+    id: root
+    visible: true
+    minimumWidth: 800
+    minimumHeight: 600
+
+    title: `Ping-pong buffers example ${dbg.targetArchitecture}`
+
+    Material.theme: Material.Light
+
+    LoggingErrorDialog {}
+
+    Debugger {
+        id: dbg
+        executable: "QMcuWatchCounterExample"
+    }
+
+    HostProcessProbe {}
+
+    Timer {
+        running: dbg.ready
+        interval: 500
+        onTriggered: dbg.launched = true
+    }
+
+    // only the index is polled, the halves are read once completed
+    VariableProxyGroup {
+        id: proxies
+        rate: 20 // Hz
+        running: dbg.launched
+    }
+
+    VariableProxy {
+        id: buffersCount
+        name: "buffersCount"
+        group: proxies
+    }
+
+    Timer {
+        interval: 50
+        repeat: true
+        running: dbg.launched
+        onTriggered: plot.update()
+    }
+
+    header: RowLayout {
+        Label {
+            text: `Samples: ${stream.samples} (${stream.measuredRate.toFixed(1)} Hz)`
+        }
+        Label {
+            text: `Overruns: ${stream.overruns}`
+        }
+    }
+
+    PlotView {
+        id: plot
+        anchors.fill: parent
+        title: "Ping-pong stream"
+
+        axisX: ValueAxis {
+            min: 0
+            max: stream.sampleCount
+        }
+
+        axisY: ValueAxis {
+            min: -20
+            max: 500
+        }
+
+        PlotLineSeries {
+            PingPongPlotProvider {
+                id: stream
+                index: buffersCount
+                indexMode: PingPongPlotProvider.Count
+                sampleRate: 4 // Hz, one sample every 250 ms
+                sampleCount: 200
+                VariableProxy {
+                    name: "counterBuffers"
+                }
+            }
+        }
+    }
+
+    BusyIndicator {
+        running: !dbg.launched
+        visible: !dbg.launched // disable it in order to prevent event grabbing
+        anchors.centerIn: parent
+    }
+}
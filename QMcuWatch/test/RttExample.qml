@@ -0,0 +1,91 @@
+import QtCore
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Controls.Material
+import QtQuick.Layouts
+import QtQuick.Window
+
+import QMcu.Debug
+import QMcu.Plot
+import QMcu.Utils
+
+ApplicationWindow {
+    id: root
+    visible: true
+    minimumWidth: 800
+    minimumHeight: 600
+
+    title: `RTT streaming example ${dbg.targetArchitecture}`
+
+    Material.theme: Material.Light
+
+    LoggingErrorDialog {}
+
+    Debugger {
+        id: dbg
+        executable: "QMcuWatchRttExample"
+    }
+
+    // reads the ring buffers without stopping the process
+    HostProcessProbe {}
+
+    Timer {
+        running: dbg.ready
+        interval: 500
+        onTriggered: dbg.launched = true
+    }
+
+    RttReader {
+        id: rtt
+        rate: 100 // Hz, the 4 KiB buffer holds 100 ms of samples
+        running: dbg.launched
+    }
+
+    Timer {
+        interval: 16
+        repeat: true
+        running: dbg.launched
+        onTriggered: plot.update()
+    }
+
+    header: RowLayout {
+        Label {
+            text: rtt.connected ? `Channels: ${rtt.channelNames.join(", ")}` : "Looking for RTT..."
+        }
+        Label {
+            text: `Samples: ${signal.samples}`
+        }
+    }
+
+    PlotView {
+        id: plot
+        anchors.fill: parent
+        title: "RTT Plot"
+
+        axisX: ValueAxis {
+            min: 0
+            max: signal.sampleCount
+        }
+
+        axisY: ValueAxis {
+            min: -1.2
+            max: 1.2
+        }
+
+        PlotLineSeries {
+            RttChannel {
+                id: signal
+                reader: rtt
+                index: 1
+                format: RttChannel.Float
+                sampleCount: 4000
+            }
+        }
+    }
+
+    BusyIndicator {
+        running: !rtt.connected
+        visible: !rtt.connected // disable it in order to prevent event grabbing
+        anchors.centerIn: parent
+    }
+}
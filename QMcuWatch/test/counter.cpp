@@ -9,9 +9,14 @@ int noiseCounter = 0;
 
 static constexpr auto n_data = 16;
 
-int buffersIndex           = 0;
-int counterBuffer[n_data]     = {42};
-int counterBuffers[2][n_data] = {{0}};
+int bufferIndex           = 0;
+int counterBuffer[n_data] = {42};
+
+// ping-pong: the target fills counterBuffers[buffersIndex] while the other half is read
+int      buffersIndex              = 0;
+unsigned buffersCount              = 0; // completed halves
+int      counterBuffers[2][n_data] = {{0}};
+int      sampleIndex               = 0;
 
 int main()
 {
@@ -24,14 +29,20 @@ int main()
 
     std::println("counter: {}", counter);
 
-    counterBuffer[buffersIndex]     = counter;
-    counterBuffers[buffersIndex][0] = counter;
-    counterBuffers[buffersIndex][1] = noiseCounter;
+    counterBuffer[bufferIndex] = counter;
+    ++bufferIndex;
+    if(bufferIndex >= n_data)
+    {
+      bufferIndex = 0;
+    }
 
-    ++buffersIndex;
-    if(buffersIndex >= n_data)
+    counterBuffers[buffersIndex][sampleIndex] = noiseCounter;
+    ++sampleIndex;
+    if(sampleIndex >= n_data)
     {
-      buffersIndex = 0;
+      sampleIndex  = 0;
+      buffersIndex = 1 - buffersIndex;
+      ++buffersCount;
     }
     std::this_thread::sleep_for(std::chrono::milliseconds(250));
   }
@@ -0,0 +1,100 @@
+// Host-side RTT target: streams a sine over a SEGGER RTT compatible control block.
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <numbers>
+#include <thread>
+
+#include <print>
+
+struct RttUpBuffer
+{
+  char const*       name;
+  char*             buffer;
+  unsigned          size;
+  volatile unsigned writeOffset;
+  volatile unsigned readOffset; // written by the host
+  unsigned          flags;
+};
+
+struct RttControlBlock
+{
+  char        id[16];
+  int         maxNumUpBuffers;
+  int         maxNumDownBuffers;
+  RttUpBuffer up[2]; // no down buffer
+};
+
+static constexpr auto sample_rate = 10000; // Hz
+
+static char terminalBuffer[256];
+static char signalBuffer[4096];
+
+RttControlBlock _SEGGER_RTT;
+
+unsigned overruns = 0;
+
+// Skips the whole write when there is not enough room, like SEGGER_RTT_MODE_NO_BLOCK_SKIP
+static bool rttWrite(RttUpBuffer& up, void const* data, unsigned size)
+{
+  const auto readOffset  = up.readOffset;
+  auto       writeOffset = up.writeOffset;
+  const auto available   = readOffset > writeOffset ? readOffset - writeOffset - 1
+                                                    : up.size - (writeOffset - readOffset) - 1;
+  if(size > available)
+  {
+    ++overruns;
+    return false;
+  }
+  auto const* bytes = static_cast<char const*>(data);
+  for(unsigned ii = 0; ii < size; ++ii)
+  {
+    up.buffer[writeOffset] = bytes[ii];
+    writeOffset            = (writeOffset + 1) % up.size;
+  }
+  // data before the offset
+  std::atomic_thread_fence(std::memory_order_release);
+  up.writeOffset = writeOffset;
+  return true;
+}
+
+int main()
+{
+  _SEGGER_RTT.maxNumUpBuffers   = 2;
+  _SEGGER_RTT.maxNumDownBuffers = 0;
+  _SEGGER_RTT.up[0]             = {"Terminal", terminalBuffer, sizeof(terminalBuffer), 0, 0, 0};
+  _SEGGER_RTT.up[1]             = {"Signal", signalBuffer, sizeof(signalBuffer), 0, 0, 0};
+  // the id is written last, at run time: the host never finds a half initialized block
+  std::atomic_thread_fence(std::memory_order_release);
+  std::strcpy(_SEGGER_RTT.id, "SEGGER ");
+  std::strcat(_SEGGER_RTT.id, "RTT");
+
+  using clock       = std::chrono::steady_clock;
+  const auto t0     = clock::now();
+  uint64_t   n      = 0;
+  uint64_t   logged = 0;
+  while(true)
+  {
+    // catches up with the wall clock, one sample at a time
+    const auto due = uint64_t((clock::now() - t0) * sample_rate / std::chrono::seconds(1));
+    for(; n < due; ++n)
+    {
+      const float value = std::sin(2 * std::numbers::pi * 5 * double(n) / sample_rate);
+      rttWrite(_SEGGER_RTT.up[1], &value, sizeof(value));
+    }
+    if(n >= logged)
+    {
+      char       line[64];
+      const auto size = std::snprintf(line, sizeof(line), "%llu samples\n", (unsigned long long)n);
+      rttWrite(_SEGGER_RTT.up[0], line, size);
+      std::println("samples: {}, overruns: {}", n, overruns);
+      logged += sample_rate;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return 0;
+}